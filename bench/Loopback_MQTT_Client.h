@@ -0,0 +1,129 @@
+#ifndef Loopback_MQTT_Client_h
+#define Loopback_MQTT_Client_h
+
+// Local include.
+#include "IMQTT_Client.h"
+
+
+/// @brief MQTT client stand-in for the host-native benchmark harness that never opens a network connection.
+/// Published messages are only counted and discarded, received messages are injected directly with simulate_incoming(),
+/// which hands the given topic and payload to the data callback the ThingsBoard client registered,
+/// exactly like a real client implementation would on message arrival.
+/// This isolates the cpu cost of the library itself (serialization, topic matching, deserialization, dispatching)
+/// from the network stack, so the hot paths can be profiled with desktop tooling
+class Loopback_MQTT_Client : public IMQTT_Client {
+  public:
+    void set_data_callback(Callback<void, char *, uint8_t *, unsigned int>::function callback) override {
+        m_data_callback = callback;
+    }
+
+    void set_connect_callback(Callback<void>::function callback) override {
+        m_connect_callback = callback;
+    }
+
+    bool set_buffer_size(uint16_t receive_buffer_size, uint16_t send_buffer_size) override {
+        m_receive_buffer_size = receive_buffer_size;
+        m_send_buffer_size = send_buffer_size;
+        return true;
+    }
+
+    uint16_t get_receive_buffer_size() override {
+        return m_receive_buffer_size;
+    }
+
+    uint16_t get_send_buffer_size() override {
+        return m_send_buffer_size;
+    }
+
+    void set_server(char const * domain, uint16_t port) override {
+        // Nothing to do, there is no actual connection
+    }
+
+    bool connect(char const * client_id, char const * user_name, char const * password) override {
+        m_connected = true;
+        if (m_connect_callback) {
+            m_connect_callback();
+        }
+        return true;
+    }
+
+    void disconnect() override {
+        m_connected = false;
+    }
+
+    bool loop() override {
+        return m_connected;
+    }
+
+    bool publish(char const * topic, uint8_t const * payload, size_t const & length) override {
+        m_published_messages++;
+        m_published_bytes += length;
+        return true;
+    }
+
+    bool subscribe(char const * topic) override {
+        return true;
+    }
+
+    bool unsubscribe(char const * topic) override {
+        return true;
+    }
+
+    bool connected() override {
+        return m_connected;
+    }
+
+    bool begin_publish(char const * topic, size_t const & length) override {
+        m_published_messages++;
+        return true;
+    }
+
+    bool end_publish() override {
+        return true;
+    }
+
+    size_t write(uint8_t payload_byte) override {
+        m_published_bytes++;
+        return 1U;
+    }
+
+    size_t write(uint8_t const * buffer, size_t const & size) override {
+        m_published_bytes += size;
+        return size;
+    }
+
+    /// @brief Hands the given message to the data callback the ThingsBoard client registered, simulating its arrival over the network.
+    /// Both the topic and the payload may be modified in place by the receive path (zero-copy deserialization),
+    /// meaning the caller has to pass mutable buffers and restore their content before injecting the same message again
+    /// @param topic Topic the message is simulated to have been received on
+    /// @param payload Payload of the simulated message
+    /// @param length Length of the payload in bytes
+    void simulate_incoming(char * topic, uint8_t * payload, unsigned int length) {
+        if (m_data_callback) {
+            m_data_callback(topic, payload, length);
+        }
+    }
+
+    /// @brief Gets the total amount of messages that have been published over this client
+    /// @return Amount of published messages
+    size_t published_messages() const {
+        return m_published_messages;
+    }
+
+    /// @brief Gets the total amount of payload bytes that have been published over this client
+    /// @return Amount of published payload bytes
+    size_t published_bytes() const {
+        return m_published_bytes;
+    }
+
+  private:
+    Callback<void, char *, uint8_t *, unsigned int>::function m_data_callback = {};    // Callback the received messages are handed to
+    Callback<void>::function                                  m_connect_callback = {}; // Callback that is called once a connection has been established
+    uint16_t                                                  m_receive_buffer_size = {}; // Requested receive buffer size, only stored and returned
+    uint16_t                                                  m_send_buffer_size = {};    // Requested send buffer size, only stored and returned
+    bool                                                      m_connected = {};           // Whether connect() has been called without a following disconnect()
+    size_t                                                    m_published_messages = {};  // Total amount of published messages
+    size_t                                                    m_published_bytes = {};     // Total amount of published payload bytes
+};
+
+#endif // Loopback_MQTT_Client_h
@@ -0,0 +1,60 @@
+#ifndef Memory_Updater_h
+#define Memory_Updater_h
+
+// Local include.
+#include "IUpdater.h"
+
+// Library includes.
+#include <stdint.h>
+#include <string.h>
+
+
+/// @brief Updater stand-in for the host-native benchmark harness that writes the received firmware into a heap buffer instead of a flash partition.
+/// Lets the OTA chunk processing benchmark exercise the complete OTA_Handler pipeline (chunk bookkeeping, hashing, verification)
+/// on a desktop machine, where the measured duration then isolates the cpu cost the library adds per chunk from the flash write itself
+class Memory_Updater : public IUpdater {
+  public:
+    ~Memory_Updater() {
+        delete[] m_buffer;
+    }
+
+    bool begin(size_t const & firmware_size) override {
+        delete[] m_buffer;
+        m_buffer = new uint8_t[firmware_size];
+        m_capacity = firmware_size;
+        m_written_bytes = 0U;
+        return true;
+    }
+
+    size_t write(uint8_t * payload, size_t const & total_bytes) override {
+        if (m_written_bytes + total_bytes > m_capacity) {
+            return 0U;
+        }
+        memcpy(m_buffer + m_written_bytes, payload, total_bytes);
+        m_written_bytes += total_bytes;
+        return total_bytes;
+    }
+
+    size_t read_current(size_t const & offset, uint8_t * payload, size_t const & length) override {
+        if (offset + length > m_written_bytes) {
+            return 0U;
+        }
+        memcpy(payload, m_buffer + offset, length);
+        return length;
+    }
+
+    void reset() override {
+        m_written_bytes = 0U;
+    }
+
+    bool end() override {
+        return m_written_bytes != 0U;
+    }
+
+  private:
+    uint8_t *m_buffer = {};       // Heap buffer the received firmware is written into instead of a flash partition
+    size_t  m_capacity = {};      // Size of the heap buffer in bytes, given to begin()
+    size_t  m_written_bytes = {}; // Amount of firmware bytes that have been written so far
+};
+
+#endif // Memory_Updater_h
@@ -0,0 +1,231 @@
+// Local includes.
+#include "Loopback_MQTT_Client.h"
+#include "Memory_Updater.h"
+
+// Library includes.
+#include <ThingsBoard.h>
+#include <Server_Side_RPC.h>
+#include <OTA_Handler.h>
+#include <Helper.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cinttypes>
+#include <array>
+#include <vector>
+
+
+// Host-native microbenchmarks over the hot paths of the library, built with the TB_BUILD_HOST_BENCHMARKS CMake option.
+// Every benchmark prints one machine-readable BENCH, prefixed comma-separated line, the same format the on-device
+// benchmark example uses, so results can be diffed between SDK versions before a change ships to a complete fleet.
+// Because all benchmarks run in one ordinary process, algorithmic regressions can additionally be located
+// by running this executable under perf, callgrind or a sampling profiler of choice.
+
+// Amount of iterations per benchmark, big enough that the per-iteration timer overhead vanishes
+constexpr size_t SEND_JSON_ITERATIONS = 100000U;
+constexpr size_t DISPATCH_ITERATIONS = 100000U;
+constexpr size_t OCCURENCES_ITERATIONS = 100000U;
+// Amount of key-value pairs the serialized telemetry message contains
+constexpr size_t SEND_JSON_RECORDS = 16U;
+// Amount of simultaneously subscribed RPC methods, the dispatched method is deliberately the last one
+// so a regression back to a linear scan over the subscriptions becomes visible immediately
+constexpr size_t RPC_SUBSCRIPTIONS = 16U;
+// Length of the payload the delimiter scan benchmark runs over
+constexpr size_t OCCURENCES_PAYLOAD_LENGTH = 4096U;
+// Synthetic firmware size and chunk size of the OTA chunk processing benchmark,
+// deliberately not a multiple of the chunk size so the last chunk exercises the remainder handling
+constexpr size_t OTA_FIRMWARE_SIZE = (1U * 1024U * 1024U) + 123U;
+constexpr uint16_t OTA_CHUNK_SIZE = 4096U;
+
+
+/// @brief Gets the current monotonic time in microseconds, used to measure every benchmark
+/// @return Monotonic time in microseconds
+static int64_t timestamp_microseconds() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// @brief Measures how fast a telemetry message with multiple key-value pairs is serialized and handed to the (loopback) client,
+/// which covers the complete send hot path (json measuring, serialization into the scratch buffer, publishing)
+static void Benchmark_Send_Json() {
+    Loopback_MQTT_Client client;
+    ThingsBoard tb(client, 1024U, 1024U);
+    (void)tb.connect("localhost", "benchmark");
+
+    char key_names[SEND_JSON_RECORDS][8U] = {};
+    StaticJsonDocument<JSON_OBJECT_SIZE(SEND_JSON_RECORDS)> source;
+    for (size_t record = 0U; record < SEND_JSON_RECORDS; record++) {
+        (void)snprintf(key_names[record], sizeof(key_names[record]), "key%u", static_cast<unsigned int>(record));
+        source[key_names[record]] = 22.02 + record;
+    }
+    size_t const json_size = Helper::Measure_Json(source);
+
+    int64_t const start = timestamp_microseconds();
+    for (size_t iteration = 0U; iteration < SEND_JSON_ITERATIONS; iteration++) {
+        (void)tb.sendTelemetryJson(source, json_size);
+    }
+    int64_t const total_us = timestamp_microseconds() - start;
+
+    printf("BENCH,send_json,records=%u,payload_bytes=%u,iterations=%u,total_us=%" PRId64 ",us_per_message=%.3f\n",
+      static_cast<unsigned int>(SEND_JSON_RECORDS), static_cast<unsigned int>(json_size), static_cast<unsigned int>(SEND_JSON_ITERATIONS),
+      total_us, static_cast<double>(total_us) / SEND_JSON_ITERATIONS);
+}
+
+// Amount of times the benchmarked RPC method has actually been dispatched, ensures the dispatch is not optimized away
+static size_t dispatched_rpc_calls = 0U;
+
+/// @brief Processes the benchmarked RPC method, only counts the call because the measured cost is the receive path in front of it
+/// @param data Data containing the rpc data that was called and its current value
+/// @param response Data containing the response value that should be sent to the cloud
+static void process_benchmark_rpc(JsonVariantConst const & data, JsonDocument & response) {
+    dispatched_rpc_calls++;
+    response.set(1);
+}
+
+/// @brief Measures how fast a received RPC request message passes through the complete receive hot path
+/// (topic matching, delimiter size scanning, deserialization and dispatching to the matching one of multiple subscribed methods)
+static void Benchmark_Receive_Dispatch() {
+    Loopback_MQTT_Client client;
+    Server_Side_RPC<RPC_SUBSCRIPTIONS, 5U> rpc;
+    std::array<IAPI_Implementation*, 1U> const apis = { &rpc };
+    ThingsBoard tb(client, 1024U, 1024U, Default_Max_Stack_Size, apis);
+    (void)tb.connect("localhost", "benchmark");
+
+    char method_names[RPC_SUBSCRIPTIONS][12U] = {};
+    std::array<RPC_Callback, RPC_SUBSCRIPTIONS> callbacks = {};
+    for (size_t subscription = 0U; subscription < RPC_SUBSCRIPTIONS; subscription++) {
+        (void)snprintf(method_names[subscription], sizeof(method_names[subscription]), "bench_%u", static_cast<unsigned int>(subscription));
+        callbacks[subscription] = RPC_Callback(method_names[subscription], process_benchmark_rpc);
+    }
+    (void)rpc.RPC_Subscribe(callbacks.begin(), callbacks.end());
+
+    // The receive path may modify both buffers in place (zero-copy deserialization), they are restored before every injection
+    char const topic_template[] = "v1/devices/me/rpc/request/1";
+    char const payload_template[] = "{\"method\":\"bench_15\",\"params\":{\"value\":42}}";
+    char topic[sizeof(topic_template)] = {};
+    uint8_t payload[sizeof(payload_template)] = {};
+
+    int64_t const start = timestamp_microseconds();
+    for (size_t iteration = 0U; iteration < DISPATCH_ITERATIONS; iteration++) {
+        memcpy(topic, topic_template, sizeof(topic_template));
+        memcpy(payload, payload_template, sizeof(payload_template));
+        client.simulate_incoming(topic, payload, sizeof(payload_template) - 1U);
+    }
+    int64_t const total_us = timestamp_microseconds() - start;
+
+    printf("BENCH,receive_dispatch,subscriptions=%u,dispatched=%u,iterations=%u,total_us=%" PRId64 ",us_per_message=%.3f\n",
+      static_cast<unsigned int>(RPC_SUBSCRIPTIONS), static_cast<unsigned int>(dispatched_rpc_calls), static_cast<unsigned int>(DISPATCH_ITERATIONS),
+      total_us, static_cast<double>(total_us) / DISPATCH_ITERATIONS);
+}
+
+/// @brief Measures the throughput of the word-at-a-time symbol scan that sizes the json document for every received message
+static void Benchmark_Get_Occurences() {
+    static uint8_t payload[OCCURENCES_PAYLOAD_LENGTH] = {};
+    // Pseudo json content with regularly occuring delimiters, the scan cost only depends on the length not the content
+    for (size_t index = 0U; index < OCCURENCES_PAYLOAD_LENGTH; index++) {
+        payload[index] = (index % 32U == 0U) ? ',' : ('a' + (index % 26U));
+    }
+
+    size_t occurences = 0U;
+    int64_t const start = timestamp_microseconds();
+    for (size_t iteration = 0U; iteration < OCCURENCES_ITERATIONS; iteration++) {
+        occurences += Helper::getOccurences(payload, ',', OCCURENCES_PAYLOAD_LENGTH);
+    }
+    int64_t const total_us = timestamp_microseconds() - start;
+
+    double const mb_per_s = (static_cast<double>(OCCURENCES_PAYLOAD_LENGTH) * OCCURENCES_ITERATIONS) / static_cast<double>(total_us);
+    printf("BENCH,get_occurences,payload_bytes=%u,occurences=%u,iterations=%u,total_us=%" PRId64 ",mb_per_s=%.2f\n",
+      static_cast<unsigned int>(OCCURENCES_PAYLOAD_LENGTH), static_cast<unsigned int>(occurences / OCCURENCES_ITERATIONS),
+      static_cast<unsigned int>(OCCURENCES_ITERATIONS), total_us, mb_per_s);
+}
+
+/// @brief Bridges the OTA_Handler callbacks into the benchmark, collects the requested chunks so the benchmark loop can serve them
+/// and records whether the update finished, the same role the OTA_Firmware_Update API implementation plays on the device
+struct OTA_Bench_Bridge {
+    /// @brief Single outstanding chunk request of the handler
+    struct Chunk_Request {
+        size_t chunk;      // Index of the requested chunk
+        size_t chunk_size; // Size in bytes the chunk was requested with
+    };
+
+    std::vector<Chunk_Request> requested_chunks = {}; // Chunks the handler has requested and the benchmark loop has not served yet
+    bool finished = false;                            // Whether the finish callback has been called
+    char const *last_state = "";                      // Last firmware state the handler reported
+
+    bool publish_chunk_request(size_t const & request_id, size_t const & chunk, size_t const & chunk_size) {
+        requested_chunks.push_back(Chunk_Request{chunk, chunk_size});
+        return true;
+    }
+
+    bool send_fw_state(char const * const current_fw_state, char const * const fw_error) {
+        last_state = current_fw_state;
+        return true;
+    }
+
+    bool finish() {
+        finished = true;
+        return true;
+    }
+};
+
+/// @brief Called once the firmware update has either finished successfully or failed definitely
+/// @param success Whether the complete firmware was received and passed the checksum verification or not
+static void ota_update_finished(bool const & success) {
+    // Result is checked over the bridge state instead
+}
+
+/// @brief Measures the throughput of processing received firmware chunks through the complete OTA_Handler pipeline
+/// (chunk bookkeeping, hashing, writing into the updater, final checksum verification) with an in-memory updater,
+/// isolating the cpu cost the library adds per chunk from the flash write and the network
+static void Benchmark_Ota_Chunk_Processing() {
+    static uint8_t firmware[OTA_FIRMWARE_SIZE] = {};
+    for (size_t index = 0U; index < OTA_FIRMWARE_SIZE; index++) {
+        firmware[index] = static_cast<uint8_t>(index * 31U);
+    }
+
+    // The checksum the handler verifies the received data against is calculated up front over the same synthetic firmware
+    char checksum[FIRMWARE_HASH_SIZE] = {};
+    HashGenerator hash;
+    if (!hash.start(MBEDTLS_MD_SHA256) || !hash.update(firmware, OTA_FIRMWARE_SIZE) || !hash.finish(checksum)) {
+        printf("BENCH,ota_chunk_processing,error=checksum_failed\n");
+        return;
+    }
+
+    OTA_Bench_Bridge bridge;
+    Memory_Updater updater;
+    OTA_Handler<DefaultLogger> handler(
+      Delegate<bool, size_t const &, size_t const &, size_t const &>::Create<OTA_Bench_Bridge, &OTA_Bench_Bridge::publish_chunk_request>(&bridge),
+      Delegate<bool, char const * const, char const * const>::Create<OTA_Bench_Bridge, &OTA_Bench_Bridge::send_fw_state>(&bridge),
+      Delegate<bool>::Create<OTA_Bench_Bridge, &OTA_Bench_Bridge::finish>(&bridge));
+
+    OTA_Update_Callback const fw_callback("benchmark_firmware", "1.0.0", &updater, ota_update_finished, nullptr, nullptr, 0U, OTA_CHUNK_SIZE);
+
+    int64_t const start = timestamp_microseconds();
+    handler.Start_Firmware_Update(fw_callback, OTA_FIRMWARE_SIZE, checksum, MBEDTLS_MD_SHA256);
+    // Serve every requested chunk with the corresponding slice of the synthetic firmware,
+    // the offset arithmetic (chunk index multiplied with the requested chunk size) mirrors what the server does
+    while (!bridge.requested_chunks.empty() && !bridge.finished) {
+        OTA_Bench_Bridge::Chunk_Request const request = bridge.requested_chunks.front();
+        bridge.requested_chunks.erase(bridge.requested_chunks.begin());
+        size_t const offset = request.chunk * request.chunk_size;
+        if (offset >= OTA_FIRMWARE_SIZE) {
+            continue;
+        }
+        size_t const remaining = OTA_FIRMWARE_SIZE - offset;
+        size_t const chunk_bytes = (remaining < request.chunk_size) ? remaining : request.chunk_size;
+        handler.Process_Firmware_Packet(request.chunk, firmware + offset, chunk_bytes);
+    }
+    int64_t const total_us = timestamp_microseconds() - start;
+
+    double const mb_per_s = static_cast<double>(OTA_FIRMWARE_SIZE) / static_cast<double>(total_us);
+    printf("BENCH,ota_chunk_processing,firmware_bytes=%u,chunk_bytes=%u,finished=%d,state=%s,total_us=%" PRId64 ",mb_per_s=%.2f\n",
+      static_cast<unsigned int>(OTA_FIRMWARE_SIZE), static_cast<unsigned int>(OTA_CHUNK_SIZE), bridge.finished, bridge.last_state, total_us, mb_per_s);
+}
+
+int main() {
+    printf("BENCH,config,dynamic=%d,msgpack=%d,stl=%d\n", THINGSBOARD_ENABLE_DYNAMIC, THINGSBOARD_ENABLE_MSGPACK, THINGSBOARD_ENABLE_STL);
+    Benchmark_Send_Json();
+    Benchmark_Receive_Dispatch();
+    Benchmark_Get_Occurences();
+    Benchmark_Ota_Chunk_Processing();
+    return 0;
+}
@@ -0,0 +1,28 @@
+#ifndef Arduino_h
+#define Arduino_h
+
+// Library include.
+#include <chrono>
+
+
+// Minimal host stand-in for the Arduino core header, only declares the time functions the library itself uses (millis() and micros()).
+// Exists so the library sources that fall back to the Arduino time functions when no ESP Timer is available (Helper.cpp, Callback_Watchdog.h)
+// compile unchanged on a desktop machine, allowing the hot paths to be profiled with desktop tooling like perf and callgrind
+
+/// @brief Gets the amount of milliseconds that have passed since the program was started,
+/// implemented with the monotonic steady clock so the values never jump backwards
+/// @return Amount of milliseconds since program start
+inline unsigned long millis() {
+    static auto const start = std::chrono::steady_clock::now();
+    return static_cast<unsigned long>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+/// @brief Gets the amount of microseconds that have passed since the program was started,
+/// implemented with the monotonic steady clock so the values never jump backwards
+/// @return Amount of microseconds since program start
+inline unsigned long micros() {
+    static auto const start = std::chrono::steady_clock::now();
+    return static_cast<unsigned long>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+#endif // Arduino_h
@@ -0,0 +1,62 @@
+#ifndef arduino_timer_h
+#define arduino_timer_h
+
+// Local include.
+#include "Arduino.h"
+
+// Library includes.
+#include <stddef.h>
+#include <stdint.h>
+
+
+// Minimal host stand-in for the arduino-timer library (https://github.com/contrem/arduino-timer),
+// only implements the subset the Callback_Watchdog actually uses (one armed oneshot task with in(), cancel() and tick()).
+// Exists so the non ESP Timer fallback path of the library compiles unchanged on a desktop machine,
+// the benchmarks never let a watchdog expire so the timing accuracy of this stand-in is irrelevant
+
+/// @brief Software timer that calls the given handler once the configured delay has passed, requires active polling with tick()
+/// @tparam MAX_TASKS Maximum amount of simultaneously armed tasks, only one is supported by this stand-in which is all the library requires
+/// @tparam time_func Function that returns the current time, the armed delay is interpreted in the same unit this function returns
+template <size_t MAX_TASKS = 16U, unsigned long (*time_func)() = millis>
+class Timer {
+  public:
+    /// @brief Handler signature, the returned boolean decides whether the task should be rearmed (true) or not (false)
+    using handler_t = bool (*)(void * opaque);
+
+    /// @brief Arms the timer to call the given handler once the given delay has passed
+    /// @param delay Delay in the unit of time_func after which the handler should be called
+    /// @param handler Handler that should be called once the delay has passed
+    /// @param opaque Argument that is simply forwarded to the handler when it is called
+    /// @return Opaque task handle, always 1 because this stand-in only supports one armed task
+    uintptr_t in(unsigned long delay, handler_t handler, void * opaque = nullptr) {
+        m_deadline = time_func() + delay;
+        m_handler = handler;
+        m_opaque = opaque;
+        m_armed = true;
+        return 1U;
+    }
+
+    /// @brief Disarms the currently armed task if there is one
+    void cancel() {
+        m_armed = false;
+    }
+
+    /// @brief Checks whether the armed delay has passed and calls the handler if it has,
+    /// has to be called repeatedly because this is a polled software timer
+    /// @tparam R Return type expected by the caller, only void is used by the library
+    template <typename R>
+    void tick() {
+        if (m_armed && static_cast<long>(time_func() - m_deadline) >= 0) {
+            m_armed = false;
+            (void)m_handler(m_opaque);
+        }
+    }
+
+  private:
+    unsigned long m_deadline = {}; // Point in time in the unit of time_func at which the handler should be called
+    handler_t     m_handler = {};  // Handler that is called once the deadline has passed
+    void          *m_opaque = {};  // Argument that is forwarded to the handler
+    bool          m_armed = {};    // Whether a task is currently armed or not
+};
+
+#endif // arduino_timer_h
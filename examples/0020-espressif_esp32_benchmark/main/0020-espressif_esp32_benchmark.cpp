@@ -0,0 +1,372 @@
+#include <esp_netif.h>
+#include <esp_log.h>
+#include <esp_wifi.h>
+#include <nvs_flash.h>
+#include <esp_timer.h>
+#include <esp_random.h>
+#include <string.h>
+#include <inttypes.h>
+#include <algorithm>
+
+// Whether the given script is using encryption or not,
+// generally recommended as it increases security (communication with the server is not in clear text anymore),
+// it does come with an overhead tough as having an encrypted session requires a lot of memory,
+// which might not be avaialable on lower end devices.
+#define ENCRYPTED false
+
+// Enable the latency instrumentation of the hot send and receive paths, so the receive-dispatch benchmark
+// can report the per-stage durations of processing received RPC and shared attribute messages.
+// Has to be defined before the library is included, because the probes are compiled away otherwise
+#define THINGSBOARD_ENABLE_PROFILING 1
+
+
+#include <Espressif_MQTT_Client.h>
+#include <Server_Side_RPC.h>
+#include <Shared_Attribute_Update.h>
+#include <HashGenerator.h>
+#include <ThingsBoard.h>
+
+
+// See https://docs.espressif.com/projects/esp-idf/en/latest/esp32/api-guides/memory-types.html#drom-data-stored-in-flash
+// for more information about the aforementioned feature
+constexpr char WIFI_SSID[] = "YOUR_WIFI_SSID";
+constexpr char WIFI_PASSWORD[] = "YOUR_WIFI_PASSWORD";
+
+// See https://thingsboard.io/docs/getting-started-guides/helloworld/
+// to understand how to obtain an access token
+constexpr char TOKEN[] = "YOUR_DEVICE_ACCESS_TOKEN";
+
+// Thingsboard we want to establish a connection to,
+// for reproducible latency numbers a broker on the local network is strongly recommended,
+// because against a cloud instance the measured end-to-end latency is dominated by the internet round trip
+constexpr char THINGSBOARD_SERVER[] = "demo.thingsboard.io";
+
+// MQTT port used to communicate with the server, 1883 is the default unencrypted MQTT port,
+// whereas 8883 would be the default encrypted SSL MQTT port
+#if ENCRYPTED
+constexpr uint16_t THINGSBOARD_PORT = 8883U;
+#else
+constexpr uint16_t THINGSBOARD_PORT = 1883U;
+#endif
+
+// Maximum size packets will ever be sent or received by the underlying MQTT client,
+// if the size is to small messages might not be sent or received messages will be discarded
+constexpr uint16_t MAX_MESSAGE_SEND_SIZE = 1024U;
+constexpr uint16_t MAX_MESSAGE_RECEIVE_SIZE = 1024U;
+
+#if ENCRYPTED
+// See https://comodosslstore.com/resources/what-is-a-root-ca-certificate-and-how-do-i-download-it/
+// on how to get the root certificate of the server we want to communicate with,
+// this is needed to establish a secure connection and changes depending on the website.
+constexpr char ROOT_CERT[] = R"(-----BEGIN CERTIFICATE-----
+MIIFazCCA1OgAwIBAgIRAIIQz7DSQONZRGPgu2OCiwAwDQYJKoZIhvcNAQELBQAw
+TzELMAkGA1UEBhMCVVMxKTAnBgNVBAoTIEludGVybmV0IFNlY3VyaXR5IFJlc2Vh
+cmNoIEdyb3VwMRUwEwYDVQQDEwxJU1JHIFJvb3QgWDEwHhcNMTUwNjA0MTEwNDM4
+WhcNMzUwNjA0MTEwNDM4WjBPMQswCQYDVQQGEwJVUzEpMCcGA1UEChMgSW50ZXJu
+ZXQgU2VjdXJpdHkgUmVzZWFyY2ggR3JvdXAxFTATBgNVBAMTDElTUkcgUm9vdCBY
+MTCCAiIwDQYJKoZIhvcNAQEBBQADggIPADCCAgoCggIBAK3oJHP0FDfzm54rVygc
+h77ct984kIxuPOZXoHj3dcKi/vVqbvYATyjb3miGbESTtrFj/RQSa78f0uoxmyF+
+0TM8ukj13Xnfs7j/EvEhmkvBioZxaUpmZmyPfjxwv60pIgbz5MDmgK7iS4+3mX6U
+A5/TR5d8mUgjU+g4rk8Kb4Mu0UlXjIB0ttov0DiNewNwIRt18jA8+o+u3dpjq+sW
+T8KOEUt+zwvo/7V3LvSye0rgTBIlDHCNAymg4VMk7BPZ7hm/ELNKjD+Jo2FR3qyH
+B5T0Y3HsLuJvW5iB4YlcNHlsdu87kGJ55tukmi8mxdAQ4Q7e2RCOFvu396j3x+UC
+B5iPNgiV5+I3lg02dZ77DnKxHZu8A/lJBdiB3QW0KtZB6awBdpUKD9jf1b0SHzUv
+KBds0pjBqAlkd25HN7rOrFleaJ1/ctaJxQZBKT5ZPt0m9STJEadao0xAH0ahmbWn
+OlFuhjuefXKnEgV4We0+UXgVCwOPjdAvBbI+e0ocS3MFEvzG6uBQE3xDk3SzynTn
+jh8BCNAw1FtxNrQHusEwMFxIt4I7mKZ9YIqioymCzLq9gwQbooMDQaHWBfEbwrbw
+qHyGO0aoSCqI3Haadr8faqU9GY/rOPNk3sgrDQoo//fb4hVC1CLQJ13hef4Y53CI
+rU7m2Ys6xt0nUW7/vGT1M0NPAgMBAAGjQjBAMA4GA1UdDwEB/wQEAwIBBjAPBgNV
+HRMBAf8EBTADAQH/MB0GA1UdDgQWBBR5tFnme7bl5AFzgAiIyBpY9umbbjANBgkq
+hkiG9w0BAQsFAAOCAgEAVR9YqbyyqFDQDLHYGmkgJykIrGF1XIpu+ILlaS/V9lZL
+ubhzEFnTIZd+50xx+7LSYK05qAvqFyFWhfFQDlnrzuBZ6brJFe+GnY+EgPbk6ZGQ
+3BebYhtF8GaV0nxvwuo77x/Py9auJ/GpsMiu/X1+mvoiBOv/2X/qkSsisRcOj/KK
+NFtY2PwByVS5uCbMiogziUwthDyC3+6WVwW6LLv3xLfHTjuCvjHIInNzktHCgKQ5
+ORAzI4JMPJ+GslWYHb4phowim57iaztXOoJwTdwJx4nLCgdNbOhdjsnvzqvHu7Ur
+TkXWStAmzOVyyghqpZXjFaH3pO3JLF+l+/+sKAIuvtd7u+Nxe5AW0wdeRlN8NwdC
+jNPElpzVmbUq4JUagEiuTDkHzsxHpFKVK7q4+63SM1N95R1NbdWhscdCb+ZAJzVc
+oyi3B43njTOQ5yOf+1CceWxG1bQVs5ZufpsMljq4Ui0/1lvh+wjChP4kqKOJ2qxq
+4RgqsahDYVvTH9w7jXbyLeiNdd8XM2w9U/t7y0Ff/9yi0GE44Za4rF2LN9d11TPA
+mRGunUHBcnWEvgJBQl9nJEiU0Zsnvgc/ubhPgXRR4Xq37Z0j4r7g1SgEEzwxA57d
+emyPxgcYxn/eR44/KJ4EBs+lVDR3veyJm+kXQ99b21/+jh5Xos1AnX5iItreGCc=
+-----END CERTIFICATE-----
+)";
+#endif
+
+// RPC method the receive-dispatch benchmark subscribes, call it from the rule chain or the device page
+// in a loop to produce receive samples, the received data is simply echoed back as the response
+constexpr char RPC_ECHO_METHOD[] = "benchmark_echo";
+constexpr uint8_t MAX_RPC_SUBSCRIPTIONS = 1U;
+constexpr uint8_t MAX_RPC_RESPONSE = 5U;
+constexpr uint8_t MAX_ATTRIBUTES = 8U;
+
+// Amount of serialization iterations per record count, big enough that the per-iteration timer overhead vanishes
+constexpr uint32_t SERIALIZE_ITERATIONS = 1000U;
+// Record counts the serialization throughput is measured for
+constexpr size_t SERIALIZE_RECORD_COUNTS[] = {1U, 4U, 16U, 64U};
+// Biggest record count that is measured, sizes the reused document and the key name pool
+constexpr size_t SERIALIZE_MAX_RECORDS = 64U;
+// Chunk size and amount the OTA chunk processing benchmark hashes, 256 chunks of 4KB = 1MB of firmware data
+constexpr size_t OTA_CHUNK_SIZE = 4096U;
+constexpr size_t OTA_CHUNK_AMOUNT = 256U;
+// Amount of end-to-end send latency samples that are collected before the percentiles are printed
+constexpr size_t SEND_LATENCY_SAMPLES = 100U;
+// Amount of milliseconds between two send latency samples, keeps the broker from coalescing the publishes
+constexpr uint32_t SEND_LATENCY_INTERVAL_MS = 50U;
+// Amount of milliseconds between two reports of the accumulated receive-dispatch stage statistics
+constexpr uint32_t PROFILE_REPORT_INTERVAL_MS = 30000U;
+
+constexpr char BENCHMARK_KEY[] = "benchmark_value";
+
+// Printable names of the instrumented stages, has to match the order of the Profile_Stage enumeration
+constexpr char const * PROFILE_STAGE_NAMES[PROFILE_STAGE_COUNT] = {
+    "send_measure",
+    "send_serialize",
+    "send_publish",
+    "receive_topic_match",
+    "receive_size_scan",
+    "receive_deserialize",
+    "receive_dispatch"
+};
+
+
+// Initalize the Mqtt client instance
+Espressif_MQTT_Client<> mqttClient;
+// Initialize used apis
+Server_Side_RPC<MAX_RPC_SUBSCRIPTIONS, MAX_RPC_RESPONSE> rpc;
+Shared_Attribute_Update<1U, MAX_ATTRIBUTES> shared_update;
+const std::array<IAPI_Implementation*, 2U> apis = {
+    &rpc,
+    &shared_update
+};
+// Initialize ThingsBoard instance with the maximum needed buffer size
+ThingsBoard tb(mqttClient, MAX_MESSAGE_RECEIVE_SIZE, MAX_MESSAGE_SEND_SIZE, Default_Max_Stack_Size, apis);
+
+// Status for successfully connecting to the given WiFi
+bool wifi_connected = false;
+// Statuses for subscribing to rpc and shared attributes
+bool subscribed = false;
+// Status for having finished the one-shot send latency benchmark
+bool send_latency_measured = false;
+
+
+/// @brief Callback method that is called if we got an ip address from the connected WiFi meaning we successfully established a connection
+/// @param event_handler_arg User data registered to the event
+/// @param event_base Event base for the handler
+/// @param event_id The id for the received event
+/// @param event_data The data for the event, esp_event_handler_t
+void on_got_ip(void* event_handler_arg, esp_event_base_t event_base, int32_t event_id, void* event_data) {
+    wifi_connected = true;
+}
+
+/// @brief Initalizes WiFi connection,
+// will endlessly delay until a connection has been successfully established
+void InitWiFi() {
+    const wifi_init_config_t wifi_init_config = WIFI_INIT_CONFIG_DEFAULT();
+    ESP_ERROR_CHECK(esp_wifi_init(&wifi_init_config));
+
+    esp_netif_config_t netif_config = ESP_NETIF_DEFAULT_WIFI_STA();
+    esp_netif_t *netif = esp_netif_new(&netif_config);
+    assert(netif);
+
+    ESP_ERROR_CHECK(esp_netif_attach_wifi_station(netif));
+    ESP_ERROR_CHECK(esp_event_handler_register(IP_EVENT, ip_event_t::IP_EVENT_STA_GOT_IP, &on_got_ip, NULL));
+    ESP_ERROR_CHECK(esp_wifi_set_default_wifi_sta_handlers());
+    ESP_ERROR_CHECK(esp_wifi_set_storage(wifi_storage_t::WIFI_STORAGE_RAM));
+
+    wifi_config_t wifi_config;
+    memset(&wifi_config, 0, sizeof(wifi_config));
+    strncpy(reinterpret_cast<char*>(wifi_config.sta.ssid), WIFI_SSID, strlen(WIFI_SSID) + 1);
+    strncpy(reinterpret_cast<char*>(wifi_config.sta.password), WIFI_PASSWORD, strlen(WIFI_PASSWORD) + 1);
+
+    ESP_LOGI("MAIN", "Connecting to %s...", wifi_config.sta.ssid);
+    ESP_ERROR_CHECK(esp_wifi_set_mode(wifi_mode_t::WIFI_MODE_STA));
+    ESP_ERROR_CHECK(esp_wifi_set_config(wifi_interface_t::WIFI_IF_STA, &wifi_config));
+    ESP_ERROR_CHECK(esp_wifi_start());
+    ESP_ERROR_CHECK(esp_wifi_connect());
+}
+
+/// @brief Prints the enabled configuration options that influence the measured numbers as one machine-readable line,
+/// so result files can be compared between SDK versions and configurations (for example THINGSBOARD_ENABLE_DYNAMIC on and off)
+void PrintBenchmarkConfiguration() {
+    printf("BENCH,config,dynamic=%d,msgpack=%d,stl=%d,send_buffer=%u,receive_buffer=%u\n",
+      THINGSBOARD_ENABLE_DYNAMIC, THINGSBOARD_ENABLE_MSGPACK, THINGSBOARD_ENABLE_STL, MAX_MESSAGE_SEND_SIZE, MAX_MESSAGE_RECEIVE_SIZE);
+}
+
+/// @brief Measures how fast Telemetry records are serialized into the json payload that would be published,
+/// for multiple record counts, without involving the network at all.
+/// Does exactly what the internal telemetry send path does (copy the records into a json document, serialize the document),
+/// meaning the printed throughput isolates the cpu cost of the serialization stage
+void RunSerializationBenchmark() {
+    // Key name pool, the records only store the pointers so the names have to stay allocated over the whole measurement
+    static char key_names[SERIALIZE_MAX_RECORDS][8U] = {};
+    for (size_t record = 0U; record < SERIALIZE_MAX_RECORDS; record++) {
+        (void)snprintf(key_names[record], sizeof(key_names[record]), "key%u", static_cast<unsigned int>(record));
+    }
+
+    StaticJsonDocument<JSON_OBJECT_SIZE(SERIALIZE_MAX_RECORDS)> source_document;
+    static char payload[2048U] = {};
+
+    for (size_t const record_count : SERIALIZE_RECORD_COUNTS) {
+        size_t payload_bytes = 0U;
+        int64_t const start = esp_timer_get_time();
+        for (uint32_t iteration = 0U; iteration < SERIALIZE_ITERATIONS; iteration++) {
+            source_document.clear();
+            JsonVariant variant = source_document.to<JsonVariant>();
+            for (size_t record = 0U; record < record_count; record++) {
+                Telemetry const telemetry(key_names[record], 22.02f + record);
+                (void)telemetry.SerializeKeyValue(variant);
+            }
+            payload_bytes = serializeJson(source_document, payload, sizeof(payload));
+        }
+        int64_t const total_us = esp_timer_get_time() - start;
+        double const us_per_message = static_cast<double>(total_us) / SERIALIZE_ITERATIONS;
+        double const mb_per_s = (static_cast<double>(payload_bytes) * SERIALIZE_ITERATIONS) / static_cast<double>(total_us);
+        printf("BENCH,serialize,records=%u,payload_bytes=%u,iterations=%" PRIu32 ",total_us=%" PRId64 ",us_per_message=%.2f,mb_per_s=%.2f\n",
+          static_cast<unsigned int>(record_count), static_cast<unsigned int>(payload_bytes), SERIALIZE_ITERATIONS, total_us, us_per_message, mb_per_s);
+    }
+}
+
+/// @brief Measures how fast received firmware chunks can be hashed, which is the cpu cost the library itself adds
+/// to processing every received OTA chunk (the remaining time of an actual update is spent in the flash write and the network).
+/// Hashes the same amount of data a 1MB firmware binary would produce in 4KB chunks
+void RunOtaChunkBenchmark() {
+    static uint8_t chunk[OTA_CHUNK_SIZE] = {};
+    esp_fill_random(chunk, sizeof(chunk));
+
+    HashGenerator hash;
+    if (!hash.start(MBEDTLS_MD_SHA256)) {
+        printf("BENCH,ota_chunk_hash,error=start_failed\n");
+        return;
+    }
+    int64_t const start = esp_timer_get_time();
+    for (size_t processed_chunk = 0U; processed_chunk < OTA_CHUNK_AMOUNT; processed_chunk++) {
+        (void)hash.update(chunk, sizeof(chunk));
+    }
+    char hash_string[(MBEDTLS_MD_MAX_SIZE * 2U) + 1U] = {};
+    (void)hash.finish(hash_string);
+    int64_t const total_us = esp_timer_get_time() - start;
+
+    size_t const total_bytes = OTA_CHUNK_SIZE * OTA_CHUNK_AMOUNT;
+    double const mb_per_s = static_cast<double>(total_bytes) / static_cast<double>(total_us);
+    printf("BENCH,ota_chunk_hash,chunk_bytes=%u,chunks=%u,total_us=%" PRId64 ",mb_per_s=%.2f\n",
+      static_cast<unsigned int>(OTA_CHUNK_SIZE), static_cast<unsigned int>(OTA_CHUNK_AMOUNT), total_us, mb_per_s);
+}
+
+/// @brief Measures the end-to-end latency of single key-value telemetry sends against the connected broker
+/// and prints the percentiles over all collected samples.
+/// The measured duration contains the complete send path (measuring, serializing and handing the payload to the network stack),
+/// against a local broker this makes regressions of the send path visible that the offline serialization benchmark alone would miss
+void RunSendLatencyBenchmark() {
+    static uint32_t samples[SEND_LATENCY_SAMPLES] = {};
+
+    for (size_t sample = 0U; sample < SEND_LATENCY_SAMPLES; sample++) {
+        int64_t const start = esp_timer_get_time();
+        (void)tb.sendTelemetryData(BENCHMARK_KEY, esp_random());
+        samples[sample] = static_cast<uint32_t>(esp_timer_get_time() - start);
+        tb.loop();
+        vTaskDelay(SEND_LATENCY_INTERVAL_MS / portTICK_PERIOD_MS);
+    }
+
+    std::sort(samples, samples + SEND_LATENCY_SAMPLES);
+    printf("BENCH,send_latency,samples=%u,p50_us=%" PRIu32 ",p90_us=%" PRIu32 ",p99_us=%" PRIu32 ",max_us=%" PRIu32 "\n",
+      static_cast<unsigned int>(SEND_LATENCY_SAMPLES), samples[(SEND_LATENCY_SAMPLES * 50U) / 100U],
+      samples[(SEND_LATENCY_SAMPLES * 90U) / 100U], samples[(SEND_LATENCY_SAMPLES * 99U) / 100U], samples[SEND_LATENCY_SAMPLES - 1U]);
+}
+
+/// @brief Prints the accumulated per-stage statistics of the instrumented send and receive paths as machine-readable lines.
+/// The receive stages accumulate samples whenever the subscribed RPC method is called or a subscribed shared attribute is updated,
+/// meaning the per-message receive-dispatch cost can be produced by simply calling the benchmark_echo method from the server in a loop
+void PrintProfilingReport() {
+    for (uint8_t stage = 0U; stage < PROFILE_STAGE_COUNT; stage++) {
+        Profile_Stage_Stats const & stats = tb.profilingStats(static_cast<Profile_Stage>(stage));
+        if (stats.samples == 0U) {
+            continue;
+        }
+        printf("BENCH,stage,name=%s,samples=%" PRIu32 ",total_us=%" PRIu64 ",avg_us=%.2f,max_us=%" PRIu32 ",hist=",
+          PROFILE_STAGE_NAMES[stage], stats.samples, stats.total_microseconds,
+          static_cast<double>(stats.total_microseconds) / stats.samples, stats.maximum_microseconds);
+        for (size_t bucket = 0U; bucket < PROFILER_BUCKET_COUNT; bucket++) {
+            printf("%" PRIu32 "%s", stats.buckets[bucket], (bucket + 1U < PROFILER_BUCKET_COUNT) ? "|" : "\n");
+        }
+    }
+}
+
+/// @brief Processes function for RPC call "benchmark_echo", simply echoes the received data back as the response.
+/// Only exists to produce receive and send samples for the instrumented stages, the actual measurement happens inside the library
+/// @param data Data containing the rpc data that was called and its current value
+/// @param response Data containgin the response value, any number, string or json, that should be sent to the cloud. Useful for getMethods
+void processBenchmarkEcho(const JsonVariantConst &data, JsonDocument &response) {
+    response.set(data);
+}
+
+/// @brief Processes shared attribute updates, the actual measurement of the receive stages happens inside the library,
+/// this callback only exists so updates of any shared attribute produce receive-dispatch samples
+/// @param data Data containing the shared attributes that were changed and their current value
+void processSharedAttributeUpdate(const JsonObjectConst &data) {
+    ESP_LOGI("BENCH", "Received shared attribute update with %u attributes", static_cast<unsigned int>(data.size()));
+}
+
+extern "C" void app_main(void) {
+    ESP_LOGI("MAIN", "[APP] Startup..");
+    ESP_LOGI("MAIN", "[APP] Free memory: %" PRIu32 " bytes", esp_get_free_heap_size());
+    ESP_LOGI("MAIN", "[APP] IDF version: %s", esp_get_idf_version());
+
+    esp_log_level_set("*", ESP_LOG_INFO);
+
+    ESP_ERROR_CHECK(nvs_flash_init());
+    ESP_ERROR_CHECK(esp_netif_init());
+    ESP_ERROR_CHECK(esp_event_loop_create_default());
+
+    // The offline benchmarks do not require any connection and run once directly at startup
+    PrintBenchmarkConfiguration();
+    RunSerializationBenchmark();
+    RunOtaChunkBenchmark();
+
+    InitWiFi();
+
+#if ENCRYPTED
+    mqttClient.set_server_certificate(ROOT_CERT);
+#endif // ENCRYPTED
+
+    uint32_t last_profile_report = 0U;
+
+    for (;;) {
+        // Wait until we connected to WiFi
+        if (!wifi_connected) {
+            vTaskDelay(1000 / portTICK_PERIOD_MS);
+            continue;
+        }
+
+        if (!tb.connected()) {
+            tb.connect(THINGSBOARD_SERVER, TOKEN, THINGSBOARD_PORT);
+        }
+
+        if (!subscribed) {
+            const std::array<RPC_Callback, MAX_RPC_SUBSCRIPTIONS> callbacks = {
+              RPC_Callback{ RPC_ECHO_METHOD, processBenchmarkEcho }
+            };
+            const Shared_Attribute_Callback<MAX_ATTRIBUTES> attribute_callback(&processSharedAttributeUpdate);
+            subscribed = rpc.RPC_Subscribe(callbacks.begin(), callbacks.end()) && shared_update.Shared_Attributes_Subscribe(attribute_callback);
+        }
+
+        // The end-to-end latency benchmark runs once after the connection has been established,
+        // the profiling statistics it produced on the send stages are reset afterwards so the periodic reports
+        // only contain the receive samples produced by the subscribed RPC method and shared attributes
+        if (subscribed && !send_latency_measured) {
+            RunSendLatencyBenchmark();
+            send_latency_measured = true;
+            tb.resetProfilingStats();
+            last_profile_report = static_cast<uint32_t>(esp_timer_get_time() / 1000U);
+        }
+
+        tb.loop();
+
+        uint32_t const uptime_ms = static_cast<uint32_t>(esp_timer_get_time() / 1000U);
+        if (send_latency_measured && (uptime_ms - last_profile_report) >= PROFILE_REPORT_INTERVAL_MS) {
+            PrintProfilingReport();
+            last_profile_report = uptime_ms;
+        }
+
+        vTaskDelay(10 / portTICK_PERIOD_MS);
+    }
+}
@@ -0,0 +1,186 @@
+#ifndef API_Registry_h
+#define API_Registry_h
+
+// Local include.
+#include "IAPI_Implementation.h"
+
+// Library include.
+#if THINGSBOARD_ENABLE_STL
+#include <tuple>
+
+
+/// @brief Compile-time registry that owns a fixed set of concrete API implementations in a std::tuple.
+/// Is subscribed to the used ThingsBoard client as one single IAPI_Implementation, meaning every received message pays exactly one virtual call into this registry,
+/// after which topic matching and response processing are forwarded to the contained API implementations with qualified non-virtual calls that the compiler can inline.
+/// Because the contained types are known at compile time, API implementations that are not part of the registry cost no flash or RAM at all,
+/// unlike a container of IAPI_Implementation pointers where every entry is dispatched virtually.
+/// Meant for firmwares that always use the same fixed set of APIs (for example Server_Side_RPC, Shared_Attribute_Update and OTA_Firmware_Update),
+/// if the subscribed APIs have to change at runtime simply subscribe the individual API implementations to the ThingsBoard client directly instead.
+/// Requires the C++ STL to be supported, because the underlying std::tuple that holds the API implementations does not exist otherwise
+/// @tparam APIs Concrete API implementation types that should be owned and dispatched by this registry, all have to implement the IAPI_Implementation interface
+template<typename... APIs>
+class API_Registry : public IAPI_Implementation {
+  public:
+    /// @brief Constructs the registry including all contained API implementations with their default constructor
+    API_Registry() = default;
+
+    /// @brief Gets the contained API implementation of the given concrete type as a reference.
+    /// Allows to call API specific methods (RPC_Subscribe, Start_Firmware_Update, ...) on the contained instances
+    /// @tparam API Concrete type of the contained API implementation we want to access, has to be contained exactly once in the registry
+    /// @return Reference to the contained API implementation of the given type
+    template<typename API>
+    API & Get_API() {
+        return std::get<API>(m_apis);
+    }
+
+    API_Process_Type Get_Process_Type() const override {
+        // Reports the process type of the API implementations that matched the topic of the last Compare_Response_Topic() call,
+        // because the registry can contain API implementations that process raw bytes (OTA_Firmware_Update) next to ones that process json
+        return m_matched_raw ? API_Process_Type::RAW : API_Process_Type::JSON;
+    }
+
+    void Process_Response(char const * topic, uint8_t * payload, unsigned int length) override {
+        Process_Response_Unrolled<0U>(topic, payload, length);
+    }
+
+    void Process_Json_Response(char const * topic, JsonDocument const & data) override {
+        Process_Json_Response_Unrolled<0U>(topic, data);
+    }
+
+    bool Compare_Response_Topic(char const * topic) const override {
+        m_matched_raw = Compare_Topic_Unrolled<0U>(topic, API_Process_Type::RAW);
+        return m_matched_raw || Compare_Topic_Unrolled<0U>(topic, API_Process_Type::JSON);
+    }
+
+    bool Unsubscribe() override {
+        return Unsubscribe_Unrolled<0U>();
+    }
+
+    bool Resubscribe_Topic() override {
+        return Resubscribe_Unrolled<0U>();
+    }
+
+#if !THINGSBOARD_USE_ESP_TIMER
+    void loop() override {
+        Loop_Unrolled<0U>();
+    }
+#endif // !THINGSBOARD_USE_ESP_TIMER
+
+    void Initialize() override {
+        Initialize_Unrolled<0U>();
+    }
+
+    void Set_Client_Callbacks(Delegate<void, IAPI_Implementation &> subscribe_api_callback, Delegate<bool, char const * const, JsonDocument const &, size_t const &> send_json_callback, Delegate<bool, char const * const, char const * const> send_json_string_callback, Delegate<bool, char const * const> subscribe_topic_callback, Delegate<bool, char const * const> unsubscribe_topic_callback, Delegate<uint16_t> get_receive_size_callback, Delegate<uint16_t> get_send_size_callback, Delegate<bool, uint16_t, uint16_t> set_buffer_size_callback, Delegate<size_t *> get_request_id_callback) override {
+        Set_Client_Callbacks_Unrolled<0U>(subscribe_api_callback, send_json_callback, send_json_string_callback, subscribe_topic_callback, unsubscribe_topic_callback, get_receive_size_callback, get_send_size_callback, set_buffer_size_callback, get_request_id_callback);
+    }
+
+  private:
+    /// @brief Concrete type of the API implementation stored at the given tuple index,
+    /// used to call the interface methods with a qualified-id, which skips the virtual dispatch and allows the compiler to inline the call
+    template<size_t Index>
+    using API_At = typename std::tuple_element<Index, std::tuple<APIs...>>::type;
+
+    template<size_t Index>
+    typename std::enable_if<(Index < sizeof...(APIs)), bool>::type Compare_Topic_Unrolled(char const * topic, API_Process_Type const & type) const {
+        using API_Type = API_At<Index>;
+        auto const & api = std::get<Index>(m_apis);
+        if (api.API_Type::Get_Process_Type() == type && api.API_Type::Compare_Response_Topic(topic)) {
+            return true;
+        }
+        return Compare_Topic_Unrolled<Index + 1U>(topic, type);
+    }
+
+    template<size_t Index>
+    typename std::enable_if<(Index >= sizeof...(APIs)), bool>::type Compare_Topic_Unrolled(char const *, API_Process_Type const &) const {
+        return false;
+    }
+
+    template<size_t Index>
+    typename std::enable_if<(Index < sizeof...(APIs)), void>::type Process_Response_Unrolled(char const * topic, uint8_t * payload, unsigned int length) {
+        using API_Type = API_At<Index>;
+        auto & api = std::get<Index>(m_apis);
+        if (api.API_Type::Get_Process_Type() == API_Process_Type::RAW && api.API_Type::Compare_Response_Topic(topic)) {
+            api.API_Type::Process_Response(topic, payload, length);
+        }
+        Process_Response_Unrolled<Index + 1U>(topic, payload, length);
+    }
+
+    template<size_t Index>
+    typename std::enable_if<(Index >= sizeof...(APIs)), void>::type Process_Response_Unrolled(char const *, uint8_t *, unsigned int) {}
+
+    template<size_t Index>
+    typename std::enable_if<(Index < sizeof...(APIs)), void>::type Process_Json_Response_Unrolled(char const * topic, JsonDocument const & data) {
+        using API_Type = API_At<Index>;
+        auto & api = std::get<Index>(m_apis);
+        if (api.API_Type::Get_Process_Type() == API_Process_Type::JSON && api.API_Type::Compare_Response_Topic(topic)) {
+            api.API_Type::Process_Json_Response(topic, data);
+        }
+        Process_Json_Response_Unrolled<Index + 1U>(topic, data);
+    }
+
+    template<size_t Index>
+    typename std::enable_if<(Index >= sizeof...(APIs)), void>::type Process_Json_Response_Unrolled(char const *, JsonDocument const &) {}
+
+    template<size_t Index>
+    typename std::enable_if<(Index < sizeof...(APIs)), bool>::type Unsubscribe_Unrolled() {
+        using API_Type = API_At<Index>;
+        bool const result = std::get<Index>(m_apis).API_Type::Unsubscribe();
+        return Unsubscribe_Unrolled<Index + 1U>() && result;
+    }
+
+    template<size_t Index>
+    typename std::enable_if<(Index >= sizeof...(APIs)), bool>::type Unsubscribe_Unrolled() {
+        return true;
+    }
+
+    template<size_t Index>
+    typename std::enable_if<(Index < sizeof...(APIs)), bool>::type Resubscribe_Unrolled() {
+        using API_Type = API_At<Index>;
+        bool const result = std::get<Index>(m_apis).API_Type::Resubscribe_Topic();
+        return Resubscribe_Unrolled<Index + 1U>() && result;
+    }
+
+    template<size_t Index>
+    typename std::enable_if<(Index >= sizeof...(APIs)), bool>::type Resubscribe_Unrolled() {
+        return true;
+    }
+
+#if !THINGSBOARD_USE_ESP_TIMER
+    template<size_t Index>
+    typename std::enable_if<(Index < sizeof...(APIs)), void>::type Loop_Unrolled() {
+        using API_Type = API_At<Index>;
+        std::get<Index>(m_apis).API_Type::loop();
+        Loop_Unrolled<Index + 1U>();
+    }
+
+    template<size_t Index>
+    typename std::enable_if<(Index >= sizeof...(APIs)), void>::type Loop_Unrolled() {}
+#endif // !THINGSBOARD_USE_ESP_TIMER
+
+    template<size_t Index>
+    typename std::enable_if<(Index < sizeof...(APIs)), void>::type Initialize_Unrolled() {
+        using API_Type = API_At<Index>;
+        std::get<Index>(m_apis).API_Type::Initialize();
+        Initialize_Unrolled<Index + 1U>();
+    }
+
+    template<size_t Index>
+    typename std::enable_if<(Index >= sizeof...(APIs)), void>::type Initialize_Unrolled() {}
+
+    template<size_t Index>
+    typename std::enable_if<(Index < sizeof...(APIs)), void>::type Set_Client_Callbacks_Unrolled(Delegate<void, IAPI_Implementation &> const & subscribe_api_callback, Delegate<bool, char const * const, JsonDocument const &, size_t const &> const & send_json_callback, Delegate<bool, char const * const, char const * const> const & send_json_string_callback, Delegate<bool, char const * const> const & subscribe_topic_callback, Delegate<bool, char const * const> const & unsubscribe_topic_callback, Delegate<uint16_t> const & get_receive_size_callback, Delegate<uint16_t> const & get_send_size_callback, Delegate<bool, uint16_t, uint16_t> const & set_buffer_size_callback, Delegate<size_t *> const & get_request_id_callback) {
+        using API_Type = API_At<Index>;
+        std::get<Index>(m_apis).API_Type::Set_Client_Callbacks(subscribe_api_callback, send_json_callback, send_json_string_callback, subscribe_topic_callback, unsubscribe_topic_callback, get_receive_size_callback, get_send_size_callback, set_buffer_size_callback, get_request_id_callback);
+        Set_Client_Callbacks_Unrolled<Index + 1U>(subscribe_api_callback, send_json_callback, send_json_string_callback, subscribe_topic_callback, unsubscribe_topic_callback, get_receive_size_callback, get_send_size_callback, set_buffer_size_callback, get_request_id_callback);
+    }
+
+    template<size_t Index>
+    typename std::enable_if<(Index >= sizeof...(APIs)), void>::type Set_Client_Callbacks_Unrolled(Delegate<void, IAPI_Implementation &> const &, Delegate<bool, char const * const, JsonDocument const &, size_t const &> const &, Delegate<bool, char const * const, char const * const> const &, Delegate<bool, char const * const> const &, Delegate<bool, char const * const> const &, Delegate<uint16_t> const &, Delegate<uint16_t> const &, Delegate<bool, uint16_t, uint16_t> const &, Delegate<size_t *> const &) {}
+
+    std::tuple<APIs...> m_apis = {};         // Concrete API implementations owned by this registry, allocated in place without any pointer indirection
+    mutable bool        m_matched_raw = {};  // Whether an API implementation that processes raw bytes matched the topic of the last Compare_Response_Topic() call
+};
+
+#endif // THINGSBOARD_ENABLE_STL
+
+#endif // API_Registry_h
@@ -0,0 +1,20 @@
+#ifndef Aggregation_Type_h
+#define Aggregation_Type_h
+
+// Library include.
+#include <stdint.h>
+
+
+/// @brief Possible aggregates a per-key telemetry accumulator can be flushed as.
+/// The accumulator itself always tracks every statistic, because updating all of them costs only a few instructions per sample,
+/// the chosen aggregate only decides which single value is serialized and published on flush
+enum class Aggregation_Type : uint8_t {
+    MIN,   ///< Publishes the smallest value that was recorded in the flush interval
+    MAX,   ///< Publishes the biggest value that was recorded in the flush interval
+    MEAN,  ///< Publishes the arithmetic mean of all values that were recorded in the flush interval
+    SUM,   ///< Publishes the sum of all values that were recorded in the flush interval
+    COUNT, ///< Publishes the amount of values that were recorded in the flush interval
+    LAST   ///< Publishes the value that was recorded last in the flush interval
+};
+
+#endif // Aggregation_Type_h
@@ -27,6 +27,10 @@ int Arduino_HTTP_Client::post(char const * url_path, char const * content_type,
     return m_http_client.post(url_path, content_type, request_body);
 }
 
+int Arduino_HTTP_Client::post(char const * url_path, char const * content_type, uint8_t const * request_body, size_t const & request_body_size) {
+    return m_http_client.post(url_path, content_type, request_body_size, request_body);
+}
+
 int Arduino_HTTP_Client::get_response_status_code() {
     return m_http_client.responseStatusCode();
 }
@@ -44,4 +48,15 @@ String Arduino_HTTP_Client::get_response_body() {
 #endif // THINGSBOARD_ENABLE_STL
 }
 
+int Arduino_HTTP_Client::get_response_body_length() {
+    (void)m_http_client.skipResponseHeaders();
+    return m_http_client.contentLength();
+}
+
+size_t Arduino_HTTP_Client::read_response_body(uint8_t * buffer, size_t const & buffer_size) {
+    (void)m_http_client.skipResponseHeaders();
+    int const read_bytes = m_http_client.read(buffer, buffer_size);
+    return read_bytes < 0 ? 0U : static_cast<size_t>(read_bytes);
+}
+
 #endif // ARDUINO
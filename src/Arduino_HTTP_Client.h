@@ -32,6 +32,8 @@ class Arduino_HTTP_Client : public IHTTP_Client {
 
     int post(char const * url_path, char const * content_type, char const * request_body) override;
 
+    int post(char const * url_path, char const * content_type, uint8_t const * request_body, size_t const & request_body_size) override;
+
     int get_response_status_code() override;
 
     int get(char const * url_path) override;
@@ -42,6 +44,10 @@ class Arduino_HTTP_Client : public IHTTP_Client {
     String get_response_body() override;
 #endif // THINGSBOARD_ENABLE_STL
 
+    int get_response_body_length() override;
+
+    size_t read_response_body(uint8_t * buffer, size_t const & buffer_size) override;
+
   private:
     HttpClient m_http_client; // Underlying HTTP client instance used to send data
 };
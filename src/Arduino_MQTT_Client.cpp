@@ -68,7 +68,11 @@ bool Arduino_MQTT_Client::connected() {
     return m_mqtt_client.connected();
 }
 
-#if THINGSBOARD_ENABLE_STREAM_UTILS
+void Arduino_MQTT_Client::set_receive_stream(Stream & receive_stream) {
+    // The underlying client copies the payload of received publish messages into the given stream while it is being read off the socket,
+    // meaning messages bigger than the receive buffer are not discarded anymore, because they never have to be held in memory completly
+    (void)m_mqtt_client.setStream(receive_stream);
+}
 
 bool Arduino_MQTT_Client::begin_publish(char const * topic, size_t const & length) {
     return m_mqtt_client.beginPublish(topic, length, false);
@@ -86,6 +90,4 @@ size_t Arduino_MQTT_Client::write(uint8_t const * buffer, size_t const & size) {
     return m_mqtt_client.write(buffer, size);
 }
 
-#endif // THINGSBOARD_ENABLE_STREAM_UTILS
-
 #endif // ARDUINO
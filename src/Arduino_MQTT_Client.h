@@ -53,7 +53,15 @@ class Arduino_MQTT_Client : public IMQTT_Client {
 
     bool connected() override;
 
-#if THINGSBOARD_ENABLE_STREAM_UTILS
+    /// @brief Configures a stream that the payload of every inbound publish message is additionally written into, chunk by chunk as it is read off the socket.
+    /// Allows receiving messages that are bigger than the receive buffer configured with set_buffer_size(), which would otherwise be discarded silently,
+    /// without having to permanently dedicate a receive buffer of the maximum expected message size.
+    /// The data callback is still called once the message has been received completly, but for oversized messages its payload argument
+    /// only contains the part that fit into the receive buffer, the complete payload has to be consumed from the given stream instead.
+    /// Any object implementing the Arduino Stream interface can be passed, for example one that feeds the chunks into the stream based deserializeJson of ArduinoJson
+    /// (https://arduinojson.org/v6/api/json/deserializejson/) or one that writes them directly into flash for over the air updates
+    /// @param receive_stream Stream the payload chunks of received publish messages are written into, requires to stay allocated for as long as this client and can not be removed again once configured
+    void set_receive_stream(Stream & receive_stream);
 
     bool begin_publish(char const * topic, size_t const & length) override;
 
@@ -67,8 +75,6 @@ class Arduino_MQTT_Client : public IMQTT_Client {
 
     size_t write(uint8_t const * buffer, size_t const & size) override;
 
-#endif // THINGSBOARD_ENABLE_STREAM_UTILS
-
   private:
     Callback<void> m_connected_callback = {}; // Callback that will be called as soon as the mqtt client has connected
     PubSubClient   m_mqtt_client = {};        // Underlying MQTT client instance used to send data
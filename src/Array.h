@@ -47,6 +47,20 @@ class Array {
         insert(nullptr, container.begin(), container.end());
     }
 
+    /// @brief Constructor that copies all elements of the given fixed size c-array.
+    /// Because the amount of elements is known at compile time already, exceeding the Capacity fails the build
+    /// with a clear error message, instead of only being discovered through a runtime assert in the field
+    /// @tparam Amount Amount of elements in the given c-array, deduced automatically
+    /// @param elements Fixed size c-array whose elements we want to copy into our underlying data container
+    template<size_t Amount>
+    Array(T const (&elements)[Amount])
+      : m_elements()
+      , m_size(0U)
+    {
+        static_assert(Amount <= Capacity, "Amount of elements in the given c-array exceeds the Capacity of this Array");
+        insert(nullptr, elements, elements + Amount);
+    }
+
     /// @brief Method that allows compatibility with std::vector, simply forwards call to internal insert method and copies all data between the first and last iterator
     /// @tparam InputIterator Class that points to the begin and end iterator
     /// of the given data container, allows for using / passing either std::vector or std::array.
@@ -87,6 +101,16 @@ class Array {
         return Capacity;
     }
 
+    /// @brief Compile time check whether the given amount of elements fits into this Array.
+    /// Allows to validate fixed subscription sets with a static_assert at the call site,
+    /// so capacity overflows fail the build instead of only being discovered at runtime
+    /// @tparam Amount Amount of elements that should fit
+    /// @return Whether the given amount of elements fits into the Capacity of this Array or not
+    template<size_t Amount>
+    static bool constexpr canHold() {
+        return Amount <= Capacity;
+    }
+
     /// @brief Returns a iterator to the first element of the underlying data container
     /// @return Iterator pointing to the first element of the underlying data container
     T * begin() {
@@ -156,6 +180,25 @@ class Array {
         }
     }
 
+    /// @brief Inserts all elements between the two given pointers into the underlying data container.
+    /// Overload for contiguous input, which bulk copies trivially copyable element types with one single memcpy,
+    /// instead of assigning them element by element like the generic iterator overload has to
+    /// @param position Attribute is not used and can be left as nullptr, simply there to keep compatibility with std::vector insert method
+    /// @param first Pointer to the first element we want to copy into our underlying data container
+    /// @param last Pointer to one past the end of the elements we want to copy into our underlying data container
+    void insert(T const * position, T const * first, T const * last) {
+        size_t const amount = last - first;
+        assert(m_size + amount <= Capacity);
+        if (__is_trivially_copyable(T) && amount != 0U) {
+            memcpy(static_cast<void*>(m_elements + m_size), static_cast<void const*>(first), amount * sizeof(T));
+            m_size += amount;
+            return;
+        }
+        for (T const * it = first; it != last; ++it) {
+            push_back(*it);
+        }
+    }
+
     /// @brief Removes the element at the given position, has to move all element one to the left if the index is not at the end of the array
     /// @tparam InputIterator Class that points to the begin and end iterator
     /// of the given data container, allows for using / passing either std::vector or std::array.
@@ -0,0 +1,135 @@
+// Header include.
+#include "Async_Logger.h"
+
+#if THINGSBOARD_ENABLE_WORKER_TASK
+
+Async_Logger::Ring_Slot *Async_Logger::m_ring = nullptr;
+size_t Async_Logger::m_ring_mask = 0U;
+size_t Async_Logger::m_enqueue_position = 0U;
+size_t Async_Logger::m_dequeue_position = 0U;
+size_t Async_Logger::m_dropped_lines = 0U;
+bool Async_Logger::m_stop_requested = false;
+bool Async_Logger::m_task_running = false;
+TaskHandle_t Async_Logger::m_task = nullptr;
+
+bool Async_Logger::startLoggingTask(size_t const & ring_size, uint8_t priority, uint16_t stack_size, BaseType_t core) {
+    if (m_task != nullptr) {
+        return true;
+    }
+    if (ring_size < 2U || (ring_size & (ring_size - 1U)) != 0U) {
+        (void)DefaultLogger::printfln(ASYNC_LOGGER_RING_SIZE_INVALID, ring_size);
+        return false;
+    }
+    m_ring = new Ring_Slot[ring_size];
+    if (m_ring == nullptr) {
+        (void)DefaultLogger::printfln(ASYNC_LOGGER_TASK_CREATE_FAILED);
+        return false;
+    }
+    m_ring_mask = ring_size - 1U;
+    // Every slot initially carries its own position as the sequence, marking it as free for the producer that claims that position first
+    for (size_t slot = 0U; slot < ring_size; slot++) {
+        __atomic_store_n(&m_ring[slot].sequence, slot, __ATOMIC_RELAXED);
+    }
+    m_enqueue_position = 0U;
+    m_dequeue_position = 0U;
+    m_dropped_lines = 0U;
+    m_stop_requested = false;
+    m_task_running = true;
+    if (xTaskCreatePinnedToCore(&Async_Logger::static_logging_task, "tb_logger", stack_size, nullptr, priority, &m_task, core) != pdPASS) {
+        m_task_running = false;
+        delete[] m_ring;
+        m_ring = nullptr;
+        (void)DefaultLogger::printfln(ASYNC_LOGGER_TASK_CREATE_FAILED);
+        return false;
+    }
+    return true;
+}
+
+void Async_Logger::stopLoggingTask() {
+    if (m_task == nullptr) {
+        return;
+    }
+    __atomic_store_n(&m_stop_requested, true, __ATOMIC_RELEASE);
+    while (__atomic_load_n(&m_task_running, __ATOMIC_ACQUIRE)) {
+        vTaskDelay(1U);
+    }
+    m_task = nullptr;
+    delete[] m_ring;
+    m_ring = nullptr;
+}
+
+bool Async_Logger::enqueue(char const * literal, char const * text) {
+    if (m_ring == nullptr || !__atomic_load_n(&m_task_running, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+    size_t position = __atomic_load_n(&m_enqueue_position, __ATOMIC_RELAXED);
+    while (true) {
+        Ring_Slot & slot = m_ring[position & m_ring_mask];
+        size_t const sequence = __atomic_load_n(&slot.sequence, __ATOMIC_ACQUIRE);
+        intptr_t const difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+        if (difference == 0) {
+            // The slot at our position is free, attempt to claim it before any other producer does
+            if (__atomic_compare_exchange_n(&m_enqueue_position, &position, position + 1U, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                slot.literal = literal;
+                if (literal == nullptr) {
+                    (void)snprintf(slot.text, sizeof(slot.text), "%s", text);
+                }
+                __atomic_store_n(&slot.sequence, position + 1U, __ATOMIC_RELEASE);
+                return true;
+            }
+            // Another producer claimed the position first, the compare and swap updated our position to the current one and we simply retry
+        }
+        else if (difference < 0) {
+            // The slot still holds a line the logging task has not printed yet, meaning the ring is currently full.
+            // The line is dropped instead of blocking, because not distorting the latency of the calling task is the whole point of this class
+            __atomic_fetch_add(&m_dropped_lines, 1U, __ATOMIC_RELAXED);
+            return true;
+        }
+        else {
+            position = __atomic_load_n(&m_enqueue_position, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+bool Async_Logger::dequeue_and_print() {
+    Ring_Slot & slot = m_ring[m_dequeue_position & m_ring_mask];
+    size_t const sequence = __atomic_load_n(&slot.sequence, __ATOMIC_ACQUIRE);
+    if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(m_dequeue_position + 1U) < 0) {
+        return false;
+    }
+    // The slot is printed before it is marked as free, meaning the text in it can not be overwritten by a producer while it is still being written out
+    (void)printf(LOG_MESSAGE_FORMAT, slot.literal != nullptr ? slot.literal : slot.text);
+    // Mark the slot as free for the producer that claims the position one ring revolution later
+    __atomic_store_n(&slot.sequence, m_dequeue_position + m_ring_mask + 1U, __ATOMIC_RELEASE);
+    m_dequeue_position++;
+    return true;
+}
+
+void Async_Logger::logging_task() {
+    while (true) {
+        bool const stop_requested = __atomic_load_n(&m_stop_requested, __ATOMIC_ACQUIRE);
+        if (dequeue_and_print()) {
+            continue;
+        }
+        // Ring has drained, report lines that had to be dropped while it was full before anything else
+        size_t const dropped_lines = __atomic_exchange_n(&m_dropped_lines, 0U, __ATOMIC_RELAXED);
+        if (dropped_lines != 0U) {
+            (void)DefaultLogger::printfln(ASYNC_LOGGER_DROPPED, dropped_lines);
+            continue;
+        }
+        if (stop_requested) {
+            break;
+        }
+        // Ring is currently empty, yield to lower priority tasks until new lines have been enqueued
+        vTaskDelay(1U);
+    }
+    __atomic_store_n(&m_task_running, false, __ATOMIC_RELEASE);
+    vTaskDelete(nullptr);
+}
+
+void Async_Logger::static_logging_task(void * instance) {
+    (void)instance;
+    logging_task();
+}
+
+#endif // THINGSBOARD_ENABLE_WORKER_TASK
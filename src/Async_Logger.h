@@ -0,0 +1,128 @@
+#ifndef Async_Logger_h
+#define Async_Logger_h
+
+// Local includes.
+#include "DefaultLogger.h"
+
+#if THINGSBOARD_ENABLE_WORKER_TASK
+
+// Library includes.
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <string.h>
+
+
+// Logging task defaults.
+size_t constexpr DEFAULT_ASYNC_LOGGER_RING_SIZE = 32U;
+// The priority is intentionally the lowest possible above the idle task, because log output is the least time-critical work in the system
+uint8_t constexpr DEFAULT_ASYNC_LOGGER_TASK_PRIORITY = 1U;
+uint16_t constexpr DEFAULT_ASYNC_LOGGER_TASK_STACK_SIZE = 4096U;
+// Maximum length in bytes a formatted log line can occupy in its ring slot including the null termination character, longer lines are truncated
+size_t constexpr ASYNC_LOGGER_SLOT_SIZE = 160U;
+// Log messages.
+char constexpr ASYNC_LOGGER_RING_SIZE_INVALID[] = "Log ring size (%u) has to be a power of two and at least 2";
+char constexpr ASYNC_LOGGER_TASK_CREATE_FAILED[] = "Creating the logging task failed, ensure there is enough heap memory left for its stack";
+char constexpr ASYNC_LOGGER_DROPPED[] = "Dropped (%u) log lines, because the asynchronous log ring stayed full";
+
+
+/// @brief Asynchronous logger class that can be passed as the Logger template argument instead of the DefaultLogger,
+/// to move the console output off the calling task. The DefaultLogger formats and writes every line synchronously from whatever context logs it,
+/// including the receive path of the underlying MQTT client, and writing to a UART at 115200 baud blocks for multiple milliseconds per line,
+/// meaning enabling THINGSBOARD_ENABLE_DEBUG measurably distorts the receive latency.
+/// Instead this class only places the line into a lock-free ring on the hot path, which a dedicated low priority task drains and prints.
+/// Messages without arguments, which are the vast majority in this library, defer even the formatting by only storing the pointer to the message,
+/// which works because every log message in this library is a constant with static storage duration.
+/// Messages with arguments are formatted into the claimed ring slot instead, because the lifetime of the arguments is not guaranteed beyond the call.
+/// Until the logging task has been started with startLoggingTask(), or if it has been stopped again, every line is simply printed synchronously like the DefaultLogger would.
+/// If the ring is completly full a line is dropped instead of blocking, the amount of dropped lines is reported by the logging task once the ring has drained
+class Async_Logger {
+  public:
+    /// @brief Starts the logging task, which creates a dedicated FreeRTOS task that drains and prints the enqueued log lines.
+    /// Once started every printfln() call only claims a ring slot and copies the line into it, without ever blocking on the console output
+    /// @param ring_size Amount of log lines the lock-free ring can hold before further lines are dropped, has to be a power of two because ring positions are mapped to slots with a bitwise and, default = DEFAULT_ASYNC_LOGGER_RING_SIZE (32)
+    /// @param priority Task priority with which the logging task should run, should stay below every time-critical task because log output can always wait, default = DEFAULT_ASYNC_LOGGER_TASK_PRIORITY (1)
+    /// @param stack_size Task stack size in bytes the logging task can use before the device crashes with a StackOverflow, default = DEFAULT_ASYNC_LOGGER_TASK_STACK_SIZE (4096)
+    /// @param core Core the logging task is pinned to, simply pass tskNO_AFFINITY if the scheduler should pick the core itself instead, default = tskNO_AFFINITY
+    /// @return Whether starting the logging task was successful or not, if it is already running there is nothing to do and we return true
+    static bool startLoggingTask(size_t const & ring_size = DEFAULT_ASYNC_LOGGER_RING_SIZE, uint8_t priority = DEFAULT_ASYNC_LOGGER_TASK_PRIORITY, uint16_t stack_size = DEFAULT_ASYNC_LOGGER_TASK_STACK_SIZE, BaseType_t core = tskNO_AFFINITY);
+
+    /// @brief Stops the previously with startLoggingTask() started logging task, all already enqueued log lines are drained and printed beforehand so none are lost.
+    /// Blocks until the logging task has finished printing and deleted itself, once stopped every further line is printed synchronously again
+    static void stopLoggingTask();
+
+    /// @brief Prints the given format message containing format specifiers (subsequences beginning with %) as well as a new line character at the end of the message.
+    /// If the logging task is running the line is only enqueued and the actual console output happens asynchronously on the logging task,
+    /// if it is not running the line is printed synchronously exactly like the DefaultLogger would
+    /// @tparam ...Args Additional arguments formatted and inserted in the resulting string replacing their respective specifiers.
+    /// See https://cplusplus.com/reference/cstdio/printf/ for more information on the possible format specifiers and the corresponding argument type
+    /// @param format Formatting message that the given arguments will be inserted into
+    /// @param ...args Arguments that will be formatted and inserted into the resulting string, replacing their respective specifiers
+    /// @return Either the length of the enqueued or written message or an error indicator (being a negative number) if one occured
+    template<typename ...Args>
+    static int printfln(char const * format, Args const &... args) {
+        // Check if variadic template contains any actual additional arguments that should be inserted into format message.
+        // If it does, use constexpr if statement for C++20 supported devices to optimize away the branch instruction at compile time
+        // or alternatively runtime for devices that do not support C++20
+#if THINGSBOARD_ENABLE_CXX20
+        if constexpr (sizeof...(Args) == 0U) {
+#else
+        if (sizeof...(Args) == 0U) {
+#endif // THINGSBOARD_ENABLE_CXX20
+            // Constant message without arguments, defer even the formatting by only storing the pointer to the message
+            if (enqueue(format, nullptr)) {
+                return static_cast<int>(strlen(format));
+            }
+        }
+        else {
+            int const size = Helper::detectSize(format, args...);
+            char arguments[size] = {};
+            int const written_characters = snprintf(arguments, size, format, args...);
+            // Written characters is expected to be one less, because of the null termination character
+            bool const result = (written_characters == (size - 1));
+            if (enqueue(nullptr, result ? arguments : FAILED_MESSAGE)) {
+                return written_characters;
+            }
+        }
+        return DefaultLogger::printfln(format, args...);
+    }
+
+  private:
+    /// @brief Single slot of the lock-free ring the producer tasks enqueue log lines into.
+    /// The sequence carries the position the slot is currently valid for, producers claim a free slot by compare and swapping the enqueue position
+    /// and publish the copied line by bumping the sequence, which the single consuming logging task in turn bumps by the ring size once it printed the line
+    struct Ring_Slot {
+        size_t     sequence;                     // Position the slot is currently valid for, accessed atomically to synchronize producers and the logging task
+        char const *literal;                     // Pointer to the constant message if the line has no arguments and the formatting could be deferred completly, nullptr otherwise
+        char       text[ASYNC_LOGGER_SLOT_SIZE]; // Already formatted line if the message contained arguments, only valid if literal is nullptr
+    };
+
+    /// @brief Enqueues a single log line into the lock-free ring for the logging task to print, safe to call from multiple producer tasks simultaneously
+    /// @param literal Pointer to the constant message if the formatting could be deferred completly, nullptr if the already formatted text is passed instead
+    /// @param text Already formatted line that is copied into the claimed ring slot, truncated to the slot size, ignored if a literal is passed
+    /// @return Whether the line was consumed by the asynchronous mode, either enqueued or counted as dropped because the ring is full,
+    /// is false only if the logging task is not running and the line should be printed synchronously instead
+    static bool enqueue(char const * literal, char const * text);
+
+    /// @brief Prints the oldest enqueued log line from the lock-free ring, only ever called from the logging task
+    /// @return Whether a line was printed or the ring is currently empty
+    static bool dequeue_and_print();
+
+    /// @brief Main loop of the dedicated logging task, drains the enqueued log lines and prints them one by one.
+    /// Once a stop has been requested the remaining lines are drained and printed before the task deletes itself, so no enqueued lines are lost
+    static void logging_task();
+
+    static void static_logging_task(void * instance);
+
+    static Ring_Slot    *m_ring;             // Lazily allocated lock-free ring the log lines are enqueued into, nullptr while the logging task is not running
+    static size_t       m_ring_mask;         // Mask ring positions are mapped to slots with, works because the ring size is a power of two
+    static size_t       m_enqueue_position;  // Position the next enqueued line claims its slot at, advanced atomically by the producer tasks
+    static size_t       m_dequeue_position;  // Position the logging task prints the next line from, only ever accessed by the logging task
+    static size_t       m_dropped_lines;     // Amount of lines that were dropped because the ring was full, reported and reset by the logging task once the ring has drained
+    static bool         m_stop_requested;    // Whether the logging task has been requested to stop, accessed atomically because it is written by another task
+    static bool         m_task_running;      // Whether the logging task is currently running, accessed atomically because it is cleared by the logging task itself
+    static TaskHandle_t m_task;              // Handle of the dedicated logging task the enqueued lines are printed on, nullptr if it has not been started
+};
+
+#endif // THINGSBOARD_ENABLE_WORKER_TASK
+
+#endif // Async_Logger_h
@@ -4,10 +4,11 @@
 // Local includes.
 #include "Attribute_Request_Callback.h"
 #include "IAPI_Implementation.h"
+#include "Telemetry.h"
 
 
 // Attribute request API topics.
-char constexpr ATTRIBUTE_REQUEST_TOPIC[] = "v1/devices/me/attributes/request/%u";
+char constexpr ATTRIBUTE_REQUEST_TOPIC_PREFIX[] = "v1/devices/me/attributes/request/";
 char constexpr ATTRIBUTE_RESPONSE_SUBSCRIBE_TOPIC[] = "v1/devices/me/attributes/response/+";
 char constexpr ATTRIBUTE_RESPONSE_TOPIC[] = "v1/devices/me/attributes/response/";
 // Client side attribute request keys.
@@ -20,6 +21,7 @@ char constexpr SHARED_REQUEST_KEY[] = "sharedKeys";
 char constexpr NO_KEYS_TO_REQUEST[] = "No keys to request were given";
 char constexpr ATT_KEY_NOT_FOUND[] = "Attribute key in Attribute_Request_Callback is NULL";
 char constexpr ATT_KEY_IS_NULL[] = "Requested attribute key is NULL";
+char constexpr SERVED_FROM_ATTRIBUTE_CACHE[] = "Served attribute request from the local cache without a network round trip";
 #endif // THINGSBOARD_ENABLE_DEBUG
 #if !THINGSBOARD_ENABLE_DYNAMIC
 char constexpr CLIENT_SHARED_ATTRIBUTE_SUBSCRIPTIONS[] = "client or shared attribute request";
@@ -43,6 +45,14 @@ class Attribute_Request : public IAPI_Implementation {
     /// @brief Constructor
     Attribute_Request() = default;
 
+#if THINGSBOARD_ENABLE_DYNAMIC
+    /// @brief Destructor, deletes the heap allocated deserialization filter document
+    ~Attribute_Request() {
+        delete m_response_filter;
+        m_response_filter = nullptr;
+    }
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+
     /// @brief Requests one client-side attribute calllback,
     /// that will be called if the key-value pair from the server for the given client-side attributes is received.
     /// Because the client-side attribute request is a single event subscription, meaning we only ever receive a response to our request once,
@@ -73,6 +83,52 @@ class Attribute_Request : public IAPI_Implementation {
         return Attributes_Request(callback, SHARED_REQUEST_KEY, SHARED_RESPONSE_KEY);
     }
 
+    /// @brief Enables the local attribute cache, received responses then populate a local key-value store
+    /// and subsequent requests whose keys are all cached and unexpired call their callback synchronously,
+    /// skipping the network round trip completely. Hugely reduces the startup latency if multiple subsystems
+    /// independently request the same configuration keys after boot. Only numeric and boolean values are cached,
+    /// because string values point into the received payload and would dangle once it is deserialized again,
+    /// requests containing a string valued or uncached key simply perform the full network round trip instead.
+    /// The cached key strings are the ones of the original request and therefore have to stay allocated for as long as the cache is enabled.
+    /// To invalidate cached entries once the value changes on the cloud, connect Invalidate_Cached_Attributes()
+    /// to the used Shared_Attribute_Update instance with its Set_Attribute_Invalidation_Callback() method
+    /// @param ttl_ms Amount of milliseconds a cached value stays valid before a request for it performs a network round trip again,
+    /// pass 0 if cached values should only ever be invalidated explicitly, default = 0
+    void Enable_Attribute_Cache(uint64_t const & ttl_ms = 0U) {
+        m_cache_enabled = true;
+        m_cache_ttl = ttl_ms;
+    }
+
+    /// @brief Disables the previously with Enable_Attribute_Cache() enabled local attribute cache and clears all cached values
+    void Disable_Attribute_Cache() {
+        m_cache_enabled = false;
+        m_cached_attributes.clear();
+    }
+
+    /// @brief Removes the cached value for the given key, the next request for it performs a network round trip again
+    /// @param key Key whose cached value should be removed
+    void Invalidate_Cached_Attribute(char const * key) {
+        if (Helper::stringIsNullorEmpty(key)) {
+            return;
+        }
+        for (auto it = m_cached_attributes.begin(); it != m_cached_attributes.end(); ++it) {
+            if (strcmp(it->value.GetKey(), key) == 0) {
+                Helper::remove(m_cached_attributes, it);
+                return;
+            }
+        }
+    }
+
+    /// @brief Removes the cached values of all keys contained in the given key-value pairs.
+    /// Meant to be connected to the Set_Attribute_Invalidation_Callback() method of the used Shared_Attribute_Update instance,
+    /// so shared attribute updates received from the cloud invalidate their cached values automatically
+    /// @param data Key-value pairs whose keys should be removed from the cache
+    void Invalidate_Cached_Attributes(JsonObjectConst const & data) {
+        for (JsonPairConst kv : data) {
+            Invalidate_Cached_Attribute(kv.key().c_str());
+        }
+    }
+
     API_Process_Type Get_Process_Type() const override {
         return API_Process_Type::JSON;
     }
@@ -83,53 +139,43 @@ class Attribute_Request : public IAPI_Implementation {
 
     void Process_Json_Response(char const * topic, JsonDocument const & data) override {
         size_t const request_id = Helper::parseRequestId(ATTRIBUTE_RESPONSE_TOPIC, topic);
+        size_t const slot = Helper::decodeRequestSlot(request_id);
         JsonObjectConst object = data.template as<JsonObjectConst>();
 
-#if THINGSBOARD_ENABLE_STL
-#if THINGSBOARD_ENABLE_DYNAMIC
-        auto it = std::find_if(m_attribute_request_callbacks.begin(), m_attribute_request_callbacks.end(), [&request_id](Attribute_Request_Callback & attribute_request) {
-#else
-        auto it = std::find_if(m_attribute_request_callbacks.begin(), m_attribute_request_callbacks.end(), [&request_id](Attribute_Request_Callback<MaxAttributes> & attribute_request) {
-#endif // THINGSBOARD_ENABLE_DYNAMIC
-            return attribute_request.Get_Request_ID() == request_id;
-        });
-        if (it != m_attribute_request_callbacks.end()) {
-            auto & attribute_request = *it;
-#else
-        for (auto it = m_attribute_request_callbacks.begin(); it != m_attribute_request_callbacks.end(); ++it) {
-            auto & attribute_request = *it;
-
-            if (attribute_request.Get_Request_ID() != request_id) {
-                continue;
-            }
-#endif // THINGSBOARD_ENABLE_STL
-            char const * attribute_response_key = attribute_request.Get_Attribute_Key();
-            if (attribute_response_key == nullptr) {
+        // The slot the ongoing request is stored in is encoded in the received request id, making the lookup constant time.
+        // Comparing the complete request id afterwards rejects stale responses whose slot has already been freed and reused
+        if (request_id != 0U && slot < m_attribute_request_callbacks.size()) {
+            auto & attribute_request = m_attribute_request_callbacks[slot];
+            if (attribute_request.Get_Request_ID() == request_id) {
+                char const * attribute_response_key = attribute_request.Get_Attribute_Key();
+                if (attribute_response_key != nullptr) {
+                    if (object.containsKey(attribute_response_key)) {
+                        object = object[attribute_response_key];
+                    }
+
+                    if (m_cache_enabled) {
+                        Cache_Response(attribute_request, object);
+                    }
+                    attribute_request.Stop_Timeout_Timer();
+                    attribute_request.Call_Callback(object);
+                }
 #if THINGSBOARD_ENABLE_DEBUG
-                Logger::printfln(ATT_KEY_NOT_FOUND);
+                else {
+                    Logger::printfln(ATT_KEY_NOT_FOUND);
+                }
 #endif // THINGSBOARD_ENABLE_DEBUG
-                goto delete_callback;
-            }
 
-            if (object.containsKey(attribute_response_key)) {
-                object = object[attribute_response_key];
+                // Free the slot for reuse by the next request, instead of shifting the remaining ongoing requests
+                attribute_request.Set_Request_ID(0U);
+                m_active_requests--;
+                Rebuild_Response_Filter();
             }
-
-            attribute_request.Stop_Timeout_Timer();
-            attribute_request.Call_Callback(object);
-
-            delete_callback:
-            // Delete callback because the changes have been requested and the callback is no longer needed
-            Helper::remove(m_attribute_request_callbacks, it);
-#if !THINGSBOARD_ENABLE_STL
-            break;
-#endif // !THINGSBOARD_ENABLE_STL
         }
 
         // Unsubscribe from the shared attribute request topic,
         // if we are not waiting for any further responses with shared attributes from the server.
         // Will be resubscribed if another request is sent anyway
-        if (m_attribute_request_callbacks.empty()) {
+        if (m_active_requests == 0U) {
             (void)Attributes_Request_Unsubscribe();
         }
     }
@@ -138,6 +184,18 @@ class Attribute_Request : public IAPI_Implementation {
         return strncmp(ATTRIBUTE_RESPONSE_TOPIC, topic, strlen(ATTRIBUTE_RESPONSE_TOPIC)) == 0;
     }
 
+    char const * Get_Response_Topic_Prefix() const override {
+        return ATTRIBUTE_RESPONSE_TOPIC;
+    }
+
+    JsonDocument * Get_Response_Filter() override {
+#if THINGSBOARD_ENABLE_DYNAMIC
+        return m_response_filter;
+#else
+        return m_response_filter_enabled ? &m_response_filter : nullptr;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    }
+
     bool Unsubscribe() override {
         return Attributes_Request_Unsubscribe();
     }
@@ -149,16 +207,20 @@ class Attribute_Request : public IAPI_Implementation {
 #if !THINGSBOARD_USE_ESP_TIMER
     void loop() override {
         for (auto & attribute_request : m_attribute_request_callbacks) {
+            if (attribute_request.Get_Request_ID() == 0U) {
+                continue;
+            }
             attribute_request.Update_Timeout_Timer();
         }
     }
 #endif // !THINGSBOARD_USE_ESP_TIMER
 
     void Initialize() override {
-        // Nothing to do
+        // Copy the constant topic prefix into the persistent request topic buffer once, every request only appends its id behind it
+        memcpy(m_request_topic, ATTRIBUTE_REQUEST_TOPIC_PREFIX, sizeof(ATTRIBUTE_REQUEST_TOPIC_PREFIX));
     }
 
-    void Set_Client_Callbacks(Callback<void, IAPI_Implementation &>::function subscribe_api_callback, Callback<bool, char const * const, JsonDocument const &, size_t const &>::function send_json_callback, Callback<bool, char const * const, char const * const>::function send_json_string_callback, Callback<bool, char const * const>::function subscribe_topic_callback, Callback<bool, char const * const>::function unsubscribe_topic_callback, Callback<uint16_t>::function get_receive_size_callback, Callback<uint16_t>::function get_send_size_callback, Callback<bool, uint16_t, uint16_t>::function set_buffer_size_callback, Callback<size_t *>::function get_request_id_callback) override {
+    void Set_Client_Callbacks(Delegate<void, IAPI_Implementation &> subscribe_api_callback, Delegate<bool, char const * const, JsonDocument const &, size_t const &> send_json_callback, Delegate<bool, char const * const, char const * const> send_json_string_callback, Delegate<bool, char const * const> subscribe_topic_callback, Delegate<bool, char const * const> unsubscribe_topic_callback, Delegate<uint16_t> get_receive_size_callback, Delegate<uint16_t> get_send_size_callback, Delegate<bool, uint16_t, uint16_t> set_buffer_size_callback, Delegate<size_t *> get_request_id_callback) override {
         m_send_json_callback.Set_Callback(send_json_callback);
         m_subscribe_topic_callback.Set_Callback(subscribe_topic_callback);
         m_unsubscribe_topic_callback.Set_Callback(unsubscribe_topic_callback);
@@ -193,6 +255,15 @@ class Attribute_Request : public IAPI_Implementation {
             return false;
         }
 
+        // Attempt to answer the request from the local cache first, if every requested key is cached and unexpired
+        // the callback is called synchronously and the network round trip is skipped completely
+        if (m_cache_enabled && Serve_From_Cache(callback)) {
+#if THINGSBOARD_ENABLE_DEBUG
+            Logger::printfln(SERVED_FROM_ATTRIBUTE_CACHE);
+#endif // THINGSBOARD_ENABLE_DEBUG
+            return true;
+        }
+
 #if THINGSBOARD_ENABLE_DYNAMIC
         Attribute_Request_Callback * registered_callback = nullptr;
 #else
@@ -250,13 +321,17 @@ class Attribute_Request : public IAPI_Implementation {
         }
         auto & request_id = *p_request_id;
 
-        registered_callback->Set_Request_ID(++request_id);
+        // Encode the slot the request is stored in into the request id, the server echoes the id in its response topic,
+        // which allows matching the response back to its request in constant time without scanning all ongoing requests
+        size_t const slot = registered_callback - &m_attribute_request_callbacks[0U];
+        registered_callback->Set_Request_ID(Helper::encodeRequestId(++request_id, slot));
         registered_callback->Set_Attribute_Key(attribute_response_key);
         registered_callback->Start_Timeout_Timer();
+        Rebuild_Response_Filter();
 
-        char topic[Helper::detectSize(ATTRIBUTE_REQUEST_TOPIC, request_id)] = {};
-        (void)snprintf(topic, sizeof(topic), ATTRIBUTE_REQUEST_TOPIC, request_id);
-        return m_send_json_callback.Call_Callback(topic, request_buffer, Helper::Measure_Json(request_buffer));
+        // Request topic buffer already contains the constant topic prefix, only the decimal request id has to be appended behind it
+        (void)Helper::writeUnsignedInteger(&m_request_topic[sizeof(ATTRIBUTE_REQUEST_TOPIC_PREFIX) - 1U], registered_callback->Get_Request_ID());
+        return m_send_json_callback.Call_Callback(m_request_topic, request_buffer, Helper::Measure_Json(request_buffer));
     }
 
     /// @brief Subscribes to attribute response topic
@@ -268,18 +343,38 @@ class Attribute_Request : public IAPI_Implementation {
 #else
     bool Attributes_Request_Subscribe(Attribute_Request_Callback<MaxAttributes> const & callback, Attribute_Request_Callback<MaxAttributes> * & registered_callback) {
 #endif // THINGSBOARD_ENABLE_DYNAMIC
-#if !THINGSBOARD_ENABLE_DYNAMIC
-        if (m_attribute_request_callbacks.size() + 1 > m_attribute_request_callbacks.capacity()) {
-            Logger::printfln(MAX_SUBSCRIPTIONS_EXCEEDED, MAX_SUBSCRIPTIONS_TEMPLATE_NAME, CLIENT_SHARED_ATTRIBUTE_SUBSCRIPTIONS);
-            return false;
+        // Find the first free slot, request ids always contain a non zero generation, meaning a zero id marks a free slot
+        size_t slot = 0U;
+        for (; slot < m_attribute_request_callbacks.size(); slot++) {
+            if (m_attribute_request_callbacks[slot].Get_Request_ID() == 0U) {
+                break;
+            }
         }
+        if (slot >= m_attribute_request_callbacks.size()) {
+#if !THINGSBOARD_ENABLE_DYNAMIC
+            if (m_attribute_request_callbacks.size() + 1 > m_attribute_request_callbacks.capacity()) {
+                Logger::printfln(MAX_SUBSCRIPTIONS_EXCEEDED, MAX_SUBSCRIPTIONS_TEMPLATE_NAME, CLIENT_SHARED_ATTRIBUTE_SUBSCRIPTIONS);
+                return false;
+            }
+#else
+            if (slot >= Helper::Max_Request_Slots) {
+                Logger::printfln(MAX_INFLIGHT_REQUESTS_EXCEEDED, Helper::Max_Request_Slots);
+                return false;
+            }
 #endif // !THINGSBOARD_ENABLE_DYNAMIC
+        }
         if (!m_subscribe_topic_callback.Call_Callback(ATTRIBUTE_RESPONSE_SUBSCRIBE_TOPIC)) {
             Logger::printfln(SUBSCRIBE_TOPIC_FAILED, ATTRIBUTE_RESPONSE_SUBSCRIBE_TOPIC);
           return false;
         }
-        m_attribute_request_callbacks.push_back(callback);
-        registered_callback = &m_attribute_request_callbacks.back();
+        if (slot >= m_attribute_request_callbacks.size()) {
+            m_attribute_request_callbacks.push_back(callback);
+        }
+        else {
+            m_attribute_request_callbacks[slot] = callback;
+        }
+        registered_callback = &m_attribute_request_callbacks[slot];
+        m_active_requests++;
         return true;
     }
 
@@ -288,13 +383,169 @@ class Attribute_Request : public IAPI_Implementation {
     /// and from the  attribute response topic, was successful or not
     bool Attributes_Request_Unsubscribe() {
         m_attribute_request_callbacks.clear();
+        m_active_requests = 0U;
+        Rebuild_Response_Filter();
         return m_unsubscribe_topic_callback.Call_Callback(ATTRIBUTE_RESPONSE_SUBSCRIBE_TOPIC);
     }
 
-    Callback<bool, char const * const, JsonDocument const &, size_t const &> m_send_json_callback = {};          // Send json document callback
-    Callback<bool, char const * const>                                       m_subscribe_topic_callback = {};    // Subscribe mqtt topic client callback
-    Callback<bool, char const * const>                                       m_unsubscribe_topic_callback = {};  // Unubscribe mqtt topic client callback
-    Callback<size_t *>                                                       m_get_request_id_callback = {};     // Get internal request id callback
+    /// @brief One cached attribute value, reuses the Telemetry union representation so one entry
+    /// can hold the different value types a response can contain without requiring any heap allocations
+    struct Cached_Attribute {
+        Telemetry value;     // Cached key-value pair, the key points to the key string of the original request
+        uint64_t  cached_at; // Uptime in milliseconds the value was cached at, used to evaluate the configured time to live
+    };
+
+    /// @brief Finds the cached value for the given key
+    /// @param key Key the value was cached under
+    /// @return Cached value for the given key or nullptr if the key is not cached
+    Cached_Attribute * Find_Cached_Attribute(char const * key) {
+        for (auto & cached : m_cached_attributes) {
+            if (cached.value.GetKey() == key || strcmp(cached.value.GetKey(), key) == 0) {
+                return &cached;
+            }
+        }
+        return nullptr;
+    }
+
+    /// @brief Attempts to answer the given request from the local cache, only possible if every requested key is cached and unexpired
+    /// @param callback Callback that should be called synchronously with the cached values if the request can be answered
+    /// @return Whether the request was answered from the cache or requires a network round trip
+#if THINGSBOARD_ENABLE_DYNAMIC
+    bool Serve_From_Cache(Attribute_Request_Callback const & callback) {
+#else
+    bool Serve_From_Cache(Attribute_Request_Callback<MaxAttributes> const & callback) {
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+        uint64_t const now = Helper::getUptimeMilliseconds();
+        size_t attribute_amount = 0U;
+        for (auto const & att : callback.Get_Attributes()) {
+            if (Helper::stringIsNullorEmpty(att)) {
+                continue;
+            }
+            Cached_Attribute const * const cached = Find_Cached_Attribute(att);
+            if (cached == nullptr || (m_cache_ttl != 0U && (now - cached->cached_at) > m_cache_ttl)) {
+                return false;
+            }
+            attribute_amount++;
+        }
+        if (attribute_amount == 0U) {
+            return false;
+        }
+#if THINGSBOARD_ENABLE_DYNAMIC
+        // Cached values are numeric and therefore require no string storage, the size only depends on the amount of key value pairs.
+        // See https://arduinojson.org/v6/assistant/ for more information on the needed size for the JsonDocument
+        TBJsonDocument response_buffer(JSON_OBJECT_SIZE(attribute_amount));
+#else
+        StaticJsonDocument<JSON_OBJECT_SIZE(MaxAttributes)> response_buffer;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+        for (auto const & att : callback.Get_Attributes()) {
+            if (Helper::stringIsNullorEmpty(att)) {
+                continue;
+            }
+            if (!Find_Cached_Attribute(att)->value.SerializeKeyValue(response_buffer)) {
+                return false;
+            }
+        }
+        callback.Call_Callback(response_buffer.template as<JsonObjectConst>());
+        return true;
+    }
+
+    /// @brief Caches the values the given response contains for the keys of the given request.
+    /// Only numeric and boolean values are cached, because string values point into the received payload and would dangle
+    /// @param attribute_request Request the response belongs to, its attribute keys are the ones looked up and cached
+    /// @param object Key-value pairs the response contained
+#if THINGSBOARD_ENABLE_DYNAMIC
+    void Cache_Response(Attribute_Request_Callback const & attribute_request, JsonObjectConst const & object) {
+#else
+    void Cache_Response(Attribute_Request_Callback<MaxAttributes> const & attribute_request, JsonObjectConst const & object) {
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+        uint64_t const now = Helper::getUptimeMilliseconds();
+        for (auto const & att : attribute_request.Get_Attributes()) {
+            if (Helper::stringIsNullorEmpty(att) || !object.containsKey(att)) {
+                continue;
+            }
+            JsonVariantConst const value = object[att];
+            Telemetry cached_value;
+            if (value.template is<bool>()) {
+                cached_value = Telemetry(att, value.template as<bool>());
+            }
+            else if (value.template is<int64_t>()) {
+                cached_value = Telemetry(att, value.template as<int64_t>());
+            }
+            else if (value.template is<double>()) {
+                cached_value = Telemetry(att, value.template as<double>());
+            }
+            else {
+                continue;
+            }
+            Cached_Attribute * const existing = Find_Cached_Attribute(att);
+            if (existing != nullptr) {
+                existing->value = cached_value;
+                existing->cached_at = now;
+                continue;
+            }
+#if !THINGSBOARD_ENABLE_DYNAMIC
+            // Cache is full, the value is simply not cached and the next request for it performs a network round trip
+            if (m_cached_attributes.size() + 1 > m_cached_attributes.capacity()) {
+                continue;
+            }
+#endif // !THINGSBOARD_ENABLE_DYNAMIC
+            Cached_Attribute const entry = {cached_value, now};
+            m_cached_attributes.push_back(entry);
+        }
+    }
+
+    /// @brief Rebuilds the deserialization filter from the attribute keys of the currently ongoing requests.
+    /// Called whenever the ongoing requests change, so the filter does not have to be recalculated for every received response.
+    /// Requests always restrict the attribute keys they want to receive, meaning the filter is only ever disabled while no requests are ongoing
+    void Rebuild_Response_Filter() {
+#if THINGSBOARD_ENABLE_DYNAMIC
+        delete m_response_filter;
+        m_response_filter = nullptr;
+#else
+        m_response_filter.clear();
+        m_response_filter_enabled = false;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+        if (m_active_requests == 0U) {
+            return;
+        }
+        size_t attribute_amount = 0U;
+        for (auto const & attribute_request : m_attribute_request_callbacks) {
+            if (attribute_request.Get_Request_ID() == 0U) {
+                continue;
+            }
+            attribute_amount += attribute_request.Get_Attributes().size();
+        }
+#if THINGSBOARD_ENABLE_DYNAMIC
+        // Requested keys are flagged both at the top level and wrapped below the client or shared response key, requiring two objects with all requested keys and the two wrapper key-value pairs.
+        // See https://arduinojson.org/v6/assistant/ for more information on the needed size for the JsonDocument
+        m_response_filter = new TBJsonDocument((2U * JSON_OBJECT_SIZE(attribute_amount)) + JSON_OBJECT_SIZE(2U));
+        auto & filter = *m_response_filter;
+#else
+        auto & filter = m_response_filter;
+        m_response_filter_enabled = true;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+        // Responses can arrive both as a flat object and wrapped below the client or shared response key, therefore the requested keys are flagged in both locations
+        for (auto const & attribute_request : m_attribute_request_callbacks) {
+            if (attribute_request.Get_Request_ID() == 0U) {
+                continue;
+            }
+            char const * const attribute_response_key = attribute_request.Get_Attribute_Key();
+            for (auto const & att : attribute_request.Get_Attributes()) {
+                if (Helper::stringIsNullorEmpty(att)) {
+                    continue;
+                }
+                filter[att] = true;
+                if (attribute_response_key != nullptr) {
+                    filter[attribute_response_key][att] = true;
+                }
+            }
+        }
+    }
+
+    Delegate<bool, char const * const, JsonDocument const &, size_t const &> m_send_json_callback = {};          // Send json document callback
+    Delegate<bool, char const * const>                                       m_subscribe_topic_callback = {};    // Subscribe mqtt topic client callback
+    Delegate<bool, char const * const>                                       m_unsubscribe_topic_callback = {};  // Unubscribe mqtt topic client callback
+    Delegate<size_t *>                                                       m_get_request_id_callback = {};     // Get internal request id callback
 
     // Vectors or array (depends on wheter if THINGSBOARD_ENABLE_DYNAMIC is set to 1 or 0), hold copy of the actual passed data, this is to ensure they stay valid,
     // even if the user only temporarily created the object before the method was called.
@@ -305,10 +556,22 @@ class Attribute_Request : public IAPI_Implementation {
     // Therefore copy-by-value has been choosen as for this specific use case it is more advantageous,
     // especially because at most we copy internal vectors or array, that will only ever contain a few pointers
 #if THINGSBOARD_ENABLE_DYNAMIC
-    Vector<Attribute_Request_Callback>                                       m_attribute_request_callbacks = {}; // Client-side or shared attribute request callback vector
+    Vector<Attribute_Request_Callback>                                       m_attribute_request_callbacks = {}; // Slot table of ongoing client-side or shared attribute requests, slots are reused and never shifted
+    TBJsonDocument *                                                         m_response_filter = {};             // Deserialization filter built from the attribute keys of the ongoing requests, nullptr while no requests are ongoing
+#else
+    Array<Attribute_Request_Callback<MaxAttributes>, MaxSubscriptions>       m_attribute_request_callbacks = {}; // Slot table of ongoing client-side or shared attribute requests, slots are reused and never shifted
+    StaticJsonDocument<(2U * JSON_OBJECT_SIZE(MaxSubscriptions * MaxAttributes)) + JSON_OBJECT_SIZE(2U)> m_response_filter = {}; // Deserialization filter built from the attribute keys of the ongoing requests
+    bool                                                                     m_response_filter_enabled = {};     // Whether the deserialization filter is used, disabled while no requests are ongoing
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    size_t                                                                   m_active_requests = {};             // Amount of slots that currently contain an ongoing request
+    bool                                                                     m_cache_enabled = {};               // Whether received responses populate the local attribute cache and requests are answered from it or not
+    uint64_t                                                                 m_cache_ttl = {};                   // Amount of milliseconds a cached value stays valid, 0 meaning cached values only ever expire through explicit invalidation
+#if THINGSBOARD_ENABLE_DYNAMIC
+    Vector<Cached_Attribute>                                                 m_cached_attributes = {};           // Local cache of previously received attribute values with the uptime they were cached at
 #else
-    Array<Attribute_Request_Callback<MaxAttributes>, MaxSubscriptions>       m_attribute_request_callbacks = {}; // Client-side or shared attribute request callback array
+    Array<Cached_Attribute, MaxSubscriptions * MaxAttributes>                m_cached_attributes = {};           // Local cache of previously received attribute values with the uptime they were cached at
 #endif // THINGSBOARD_ENABLE_DYNAMIC
+    char                                                                     m_request_topic[sizeof(ATTRIBUTE_REQUEST_TOPIC_PREFIX) + Helper::Max_Unsigned_Integer_Digits] = {}; // Persistent request topic buffer, contains the constant topic prefix with the request id of the current request appended behind it
 };
 
 #endif // Attribute_Request_h
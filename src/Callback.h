@@ -24,6 +24,99 @@ using Vector = std::vector<T>;
 #endif // THINGSBOARD_ENABLE_STL && THINGSBOARD_ENABLE_DYNAMIC
 
 
+/// @brief Lightweight fixed-size delegate that binds either a free function or a member function with its class instance.
+/// Requires only the storage of two pointers and neither allocates on the heap nor requires RTTI, unlike std::function with std::bind,
+/// which can heap-allocate its bound state and adds indirect-call overhead on every dispatch.
+/// Is therefore used for the internal client callbacks that are dispatched on every received message,
+/// whereas the user facing subscription callbacks keep using the more flexible Callback wrapper below
+/// @tparam return_typ Type the bound method should return
+/// @tparam argument_types Types the bound method should receive
+template<typename return_typ, typename... argument_types>
+class Delegate {
+  public:
+    /// @brief Constructs empty delegate, will result in never being called. Internals are simply default constructed as nullptr
+    Delegate() = default;
+
+    /// @brief Constructs delegate from a free function pointer
+    /// @param function Free function that will be called on dispatch.
+    /// If nullptr is passed the delegate will never be called and return with a defaulted instance of the requested return variable
+    Delegate(return_typ (*function)(argument_types... arguments))
+      : m_storage()
+      , m_stub(function != nullptr ? &free_function_stub : nullptr)
+    {
+        m_storage.function = function;
+    }
+
+    /// @brief Creates a delegate bound to the given member function of the given class instance.
+    /// The member function pointer is baked into the created stub at compile time, meaning only the instance pointer has to be stored at runtime
+    /// @tparam T Class the member function belongs to
+    /// @tparam Method Member function that will be called on dispatch
+    /// @param instance Class instance the member function will be called on, requires to stay allocated for as long as the delegate can be dispatched
+    /// @return Delegate bound to the given member function and class instance
+    template<typename T, return_typ (T::*Method)(argument_types...)>
+    static Delegate Create(T * instance) {
+        Delegate delegate;
+        delegate.m_storage.instance = instance;
+        delegate.m_stub = &method_stub<T, Method>;
+        return delegate;
+    }
+
+    /// @brief Calls the method that was bound, when this class instance was initally created.
+    /// If the default constructor was used or a nullptr was passed instead of a valid function pointer,
+    /// this method will check beforehand and simply return with a defaulted instance of the requested return variable
+    /// @param ...arguments Optional additional arguments that are simply forwarded to the bound method if it exists
+    /// @return Argument returned by the previously bound method or if none is bound
+    /// we instead return a defaulted instance of the requested return variable
+    return_typ Call_Callback(argument_types const &... arguments) const {
+        if (m_stub == nullptr) {
+            return return_typ();
+        }
+        return m_stub(m_storage, arguments...);
+    }
+
+    /// @brief Calls the bound method, allows using the delegate as a general purpose callable,
+    /// simply forwards the call to Call_Callback() including its safety check for an empty delegate
+    /// @param ...arguments Optional additional arguments that are simply forwarded to the bound method if it exists
+    /// @return Argument returned by the previously bound method or if none is bound
+    /// we instead return a defaulted instance of the requested return variable
+    return_typ operator()(argument_types const &... arguments) const {
+        return Call_Callback(arguments...);
+    }
+
+    /// @brief Sets the delegate that will be dispatched instead of the previously bound one,
+    /// used to change the bound method initally passed or to set it if nothing was bound initally
+    /// @param callback Delegate that will be dispatched instead of the previously bound one
+    void Set_Callback(Delegate const & callback) {
+        m_storage = callback.m_storage;
+        m_stub = callback.m_stub;
+    }
+
+  private:
+    /// @brief Storage container, which contains either the class instance the bound member function is called on or the bound free function
+    union Storage {
+        void       *instance;
+        return_typ (*function)(argument_types... arguments);
+    };
+
+    /// @brief Dispatch signature that erases the difference between a bound free function and a bound member function
+    using stub_type = return_typ (*)(Storage const & storage, argument_types... arguments);
+
+    /// @brief Stub that forwards the dispatch to the bound free function
+    static return_typ free_function_stub(Storage const & storage, argument_types... arguments) {
+        return storage.function(arguments...);
+    }
+
+    /// @brief Stub that forwards the dispatch to the member function baked in at compile time, called on the stored class instance
+    template<typename T, return_typ (T::*Method)(argument_types...)>
+    static return_typ method_stub(Storage const & storage, argument_types... arguments) {
+        return (static_cast<T *>(storage.instance)->*Method)(arguments...);
+    }
+
+    Storage   m_storage = {}; // Bound class instance or free function to dispatch to
+    stub_type m_stub = {};    // Stub that knows how to dispatch to the content of the storage
+};
+
+
 /// @brief General purpose safe callback wrapper. Expects either c-style or c++ style function pointer,
 /// depending on if the C++ STL has been implemented on the given device or not.
 /// Simply wraps that function pointer and before calling it ensures it actually exists
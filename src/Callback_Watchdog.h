@@ -6,6 +6,7 @@
 
 // Library includes.
 #if THINGSBOARD_USE_ESP_TIMER
+#include "Timer_Wheel.h"
 #include <esp_timer.h>
 #else
 #include <arduino-timer.h>
@@ -20,6 +21,9 @@ constexpr char WATCHDOG_TIMER_NAME[] = "watchdog_timer";
 /// @brief Wrapper class which allows to start a timer and if it is not stopped in the given time then the callback that was passed will be called,
 /// which informs the user of the failure to stop the timer in time, meaning a timeout has occured.
 /// The class wraps around either the Arduino timer class from Arduino (https://github.com/contrem/arduino-timer) or the offical ESP Timer implementation from Espressif (https://github.com/espressif/esp-idf/tree/master/examples/system/esp_timer), the latter takes precendence if it exists.
+/// On the ESP Timer path the deadlines of all instances are multiplexed onto the single shared Timer_Wheel instead of every instance creating its own kernel timer object,
+/// meaning arming and disarming a watchdog is a constant time list operation and the amount of kernel timer objects stays one regardless of how many requests are in flight.
+/// A dedicated timer is only created for an instance as a fallback if the shared wheel is completly exhausted.
 /// This is done because it uses FreeRTOS to start the actual timer in the background, which removes the need for a Hardware Timer with Interrupts but still achieve the advantage of accurate timings and no need for active polling.
 /// For all other use cases where the esp timer does not exists we instead use the Arduino timer as a fallback, because is is a simple software timer with active polling that works on all Arduino based devices,
 /// because it simply uses the millis() method per default but can be configured over template arguments to use other methods that return the current time.
@@ -49,6 +53,9 @@ class Callback_Watchdog : public Callback<void> {
 #if THINGSBOARD_USE_ESP_TIMER
     /// @brief Destructor
     ~Callback_Watchdog() {
+        // Ensures a possibly still armed deadline on the shared wheel is cancelled, because it holds a pointer to this object
+        Timer_Wheel::instance().cancel(m_wheel_handle);
+        m_wheel_handle = 0U;
         // Timer only has to deleted at the end of the lifetime of this object, to ensure no memory leak occurs.
         // But besides that the same timer can simply be stopped and restarted without needing to delete and create the timer again everytime.
         (void)esp_timer_delete(m_oneshot_timer);
@@ -60,6 +67,13 @@ class Callback_Watchdog : public Callback<void> {
     /// @param timeout_microseconds Amount of microseconds until the detach() method is excpected to have been called or the initally given callback method will be called
     void once(uint64_t const & timeout_microseconds) {
 #if THINGSBOARD_USE_ESP_TIMER
+        // Cancelling first ensures restarting an already started watchdog does not leave two armed deadlines for the same instance
+        Timer_Wheel::instance().cancel(m_wheel_handle);
+        m_wheel_handle = Timer_Wheel::instance().arm(timeout_microseconds, &Callback_Watchdog::oneshot_timer_callback, this);
+        if (m_wheel_handle != 0U) {
+            return;
+        }
+        // The shared wheel is exhausted, fall back to a dedicated timer for this instance so the timeout is never silently lost
         create_timer();
         (void)esp_timer_start_once(m_oneshot_timer, timeout_microseconds);
 #else
@@ -70,7 +84,11 @@ class Callback_Watchdog : public Callback<void> {
     /// @brief Stops the currently ongoing watchdog timer and ensures the callback is not called. Timer can simply be restarted with calling once() again
     void detach() {
 #if THINGSBOARD_USE_ESP_TIMER
-        (void)esp_timer_stop(m_oneshot_timer);
+        Timer_Wheel::instance().cancel(m_wheel_handle);
+        m_wheel_handle = 0U;
+        if (m_oneshot_timer != nullptr) {
+            (void)esp_timer_stop(m_oneshot_timer);
+        }
 #else
         m_oneshot_timer.cancel();
 #endif // THINGSBOARD_USE_ESP_TIMER
@@ -128,6 +146,10 @@ class Callback_Watchdog : public Callback<void> {
         }
 
         auto instance = static_cast<Callback_Watchdog *>(arg);
+#if THINGSBOARD_USE_ESP_TIMER
+        // The deadline on the shared wheel has fired, meaning the stored handle is stale from now on
+        instance->m_wheel_handle = 0U;
+#endif // THINGSBOARD_USE_ESP_TIMER
         instance->Call_Callback();
 #if !THINGSBOARD_USE_ESP_TIMER
         return false;
@@ -135,7 +157,8 @@ class Callback_Watchdog : public Callback<void> {
     }
 
 #if THINGSBOARD_USE_ESP_TIMER
-    esp_timer_handle_t m_oneshot_timer = {}; // ESP Timer handle that is used to start and stop the oneshot timer
+    uint32_t           m_wheel_handle = {};  // Handle of the currently armed deadline on the shared timer wheel, 0 if no deadline is currently armed there
+    esp_timer_handle_t m_oneshot_timer = {}; // Dedicated ESP Timer handle that is only created and used if the shared timer wheel is exhausted
 #else
     Timer<1, micros>   m_oneshot_timer = {}; // Ticker instance that handles the timer under the hood, if possible we directly use esp timer instead because it is more efficient
 #endif // THINGSBOARD_USE_ESP_TIMER
@@ -9,7 +9,7 @@
 // Client side RPC topics.
 char constexpr RPC_RESPONSE_SUBSCRIBE_TOPIC[] = "v1/devices/me/rpc/response/+";
 char constexpr RPC_RESPONSE_TOPIC[] = "v1/devices/me/rpc/response/";
-char constexpr RPC_SEND_REQUEST_TOPIC[] = "v1/devices/me/rpc/request/%u";
+char constexpr RPC_SEND_REQUEST_TOPIC_PREFIX[] = "v1/devices/me/rpc/request/";
 // Log messages.
 char constexpr CLIENT_RPC_METHOD_NULL[] = "Client-side RPC method name is NULL";
 #if !THINGSBOARD_ENABLE_DYNAMIC
@@ -95,12 +95,15 @@ class Client_Side_RPC : public IAPI_Implementation {
         }
         auto & request_id = *p_request_id;
 
-        registered_callback->Set_Request_ID(++request_id);
+        // Encode the slot the request is stored in into the request id, the server echoes the id in its response topic,
+        // which allows matching the response back to its request in constant time without scanning all in-flight requests
+        size_t const slot = registered_callback - &m_rpc_request_callbacks[0U];
+        registered_callback->Set_Request_ID(Helper::encodeRequestId(++request_id, slot));
         registered_callback->Start_Timeout_Timer();
 
-        char topic[Helper::detectSize(RPC_SEND_REQUEST_TOPIC, request_id)] = {};
-        (void)snprintf(topic, sizeof(topic), RPC_SEND_REQUEST_TOPIC, request_id);
-        return m_send_json_callback.Call_Callback(topic, request_buffer, Helper::Measure_Json(request_buffer));
+        // Request topic buffer already contains the constant topic prefix, only the decimal request id has to be appended behind it
+        (void)Helper::writeUnsignedInteger(&m_request_topic[sizeof(RPC_SEND_REQUEST_TOPIC_PREFIX) - 1U], registered_callback->Get_Request_ID());
+        return m_send_json_callback.Call_Callback(m_request_topic, request_buffer, Helper::Measure_Json(request_buffer));
     }
 
     API_Process_Type Get_Process_Type() const override {
@@ -113,35 +116,26 @@ class Client_Side_RPC : public IAPI_Implementation {
 
     void Process_Json_Response(char const * topic, JsonDocument const & data) override {
         size_t const request_id = Helper::parseRequestId(RPC_RESPONSE_TOPIC, topic);
-
-#if THINGSBOARD_ENABLE_STL
-        auto it = std::find_if(m_rpc_request_callbacks.begin(), m_rpc_request_callbacks.end(), [&request_id](RPC_Request_Callback & rpc_request) {
-            return rpc_request.Get_Request_ID() == request_id;
-        });
-        if (it != m_rpc_request_callbacks.end()) {
-            auto & rpc_request = *it;
-#else
-        for (auto it = m_rpc_request_callbacks.begin(); it != m_rpc_request_callbacks.end(); ++it) {
-            auto & rpc_request = *it;
-
-            if (rpc_request.Get_Request_ID() != request_id) {
-                continue;
+        size_t const slot = Helper::decodeRequestSlot(request_id);
+
+        // The slot the in-flight request is stored in is encoded in the received request id, making the lookup constant time.
+        // Comparing the complete request id afterwards rejects stale responses whose slot has already been freed and reused
+        if (request_id != 0U && slot < m_rpc_request_callbacks.size()) {
+            auto & rpc_request = m_rpc_request_callbacks[slot];
+            if (rpc_request.Get_Request_ID() == request_id) {
+                rpc_request.Stop_Timeout_Timer();
+                rpc_request.Call_Callback(data);
+
+                // Free the slot for reuse by the next request, instead of shifting the remaining in-flight requests
+                rpc_request.Set_Request_ID(0U);
+                m_active_requests--;
             }
-#endif // THINGSBOARD_ENABLE_STL
-            rpc_request.Stop_Timeout_Timer();
-            rpc_request.Call_Callback(data);
-
-            // Delete callback because the changes have been requested and the callback is no longer needed
-            Helper::remove(m_rpc_request_callbacks, it);
-#if !THINGSBOARD_ENABLE_STL
-            break;
-#endif // !THINGSBOARD_ENABLE_STL
         }
 
-        // Attempt to unsubscribe from the shared attribute request topic,
-        // if we are not waiting for any further responses with shared attributes from the server.
+        // Attempt to unsubscribe from the client-side RPC response topic,
+        // if we are not waiting for any further responses from the server.
         // Will be resubscribed if another request is sent anyway
-        if (m_rpc_request_callbacks.empty()) {
+        if (m_active_requests == 0U) {
             (void)RPC_Request_Unsubscribe();
         }
     }
@@ -150,6 +144,10 @@ class Client_Side_RPC : public IAPI_Implementation {
         return strncmp(RPC_RESPONSE_TOPIC, topic, strlen(RPC_RESPONSE_TOPIC)) == 0;
     }
 
+    char const * Get_Response_Topic_Prefix() const override {
+        return RPC_RESPONSE_TOPIC;
+    }
+
     bool Unsubscribe() override {
         return RPC_Request_Unsubscribe();
     }
@@ -161,16 +159,20 @@ class Client_Side_RPC : public IAPI_Implementation {
 #if !THINGSBOARD_USE_ESP_TIMER
     void loop() override {
         for (auto & rpc_request : m_rpc_request_callbacks) {
+            if (rpc_request.Get_Request_ID() == 0U) {
+                continue;
+            }
             rpc_request.Update_Timeout_Timer();
         }
     }
 #endif // !THINGSBOARD_USE_ESP_TIMER
 
     void Initialize() override {
-        // Nothing to do
+        // Copy the constant topic prefix into the persistent request topic buffer once, every request only appends its id behind it
+        memcpy(m_request_topic, RPC_SEND_REQUEST_TOPIC_PREFIX, sizeof(RPC_SEND_REQUEST_TOPIC_PREFIX));
     }
 
-    void Set_Client_Callbacks(Callback<void, IAPI_Implementation &>::function subscribe_api_callback, Callback<bool, char const * const, JsonDocument const &, size_t const &>::function send_json_callback, Callback<bool, char const * const, char const * const>::function send_json_string_callback, Callback<bool, char const * const>::function subscribe_topic_callback, Callback<bool, char const * const>::function unsubscribe_topic_callback, Callback<uint16_t>::function get_receive_size_callback, Callback<uint16_t>::function get_send_size_callback, Callback<bool, uint16_t, uint16_t>::function set_buffer_size_callback, Callback<size_t *>::function get_request_id_callback) override {
+    void Set_Client_Callbacks(Delegate<void, IAPI_Implementation &> subscribe_api_callback, Delegate<bool, char const * const, JsonDocument const &, size_t const &> send_json_callback, Delegate<bool, char const * const, char const * const> send_json_string_callback, Delegate<bool, char const * const> subscribe_topic_callback, Delegate<bool, char const * const> unsubscribe_topic_callback, Delegate<uint16_t> get_receive_size_callback, Delegate<uint16_t> get_send_size_callback, Delegate<bool, uint16_t, uint16_t> set_buffer_size_callback, Delegate<size_t *> get_request_id_callback) override {
         m_send_json_callback.Set_Callback(send_json_callback);
         m_subscribe_topic_callback.Set_Callback(subscribe_topic_callback);
         m_unsubscribe_topic_callback.Set_Callback(unsubscribe_topic_callback);
@@ -185,18 +187,38 @@ class Client_Side_RPC : public IAPI_Implementation {
     /// @param registered_callback Editable pointer to a reference of the local version that was copied from the passed callback
     /// @return Whether requesting the given callback was successful or not
     bool RPC_Request_Subscribe(RPC_Request_Callback const & callback, RPC_Request_Callback * & registered_callback) {
-#if !THINGSBOARD_ENABLE_DYNAMIC
-        if (m_rpc_request_callbacks.size() + 1 > m_rpc_request_callbacks.capacity()) {
-            Logger::printfln(MAX_SUBSCRIPTIONS_EXCEEDED, MAX_SUBSCRIPTIONS_TEMPLATE_NAME, CLIENT_SIDE_RPC_SUBSCRIPTIONS);
-            return false;
+        // Find the first free slot, request ids always contain a non zero generation, meaning a zero id marks a free slot
+        size_t slot = 0U;
+        for (; slot < m_rpc_request_callbacks.size(); slot++) {
+            if (m_rpc_request_callbacks[slot].Get_Request_ID() == 0U) {
+                break;
+            }
         }
+        if (slot >= m_rpc_request_callbacks.size()) {
+#if !THINGSBOARD_ENABLE_DYNAMIC
+            if (m_rpc_request_callbacks.size() + 1 > m_rpc_request_callbacks.capacity()) {
+                Logger::printfln(MAX_SUBSCRIPTIONS_EXCEEDED, MAX_SUBSCRIPTIONS_TEMPLATE_NAME, CLIENT_SIDE_RPC_SUBSCRIPTIONS);
+                return false;
+            }
+#else
+            if (slot >= Helper::Max_Request_Slots) {
+                Logger::printfln(MAX_INFLIGHT_REQUESTS_EXCEEDED, Helper::Max_Request_Slots);
+                return false;
+            }
 #endif // !THINGSBOARD_ENABLE_DYNAMIC
+        }
         if (!m_subscribe_topic_callback.Call_Callback(RPC_RESPONSE_SUBSCRIBE_TOPIC)) {
             Logger::printfln(SUBSCRIBE_TOPIC_FAILED, RPC_RESPONSE_SUBSCRIBE_TOPIC);
             return false;
         }
-        m_rpc_request_callbacks.push_back(callback);
-        registered_callback = &m_rpc_request_callbacks.back();
+        if (slot >= m_rpc_request_callbacks.size()) {
+            m_rpc_request_callbacks.push_back(callback);
+        }
+        else {
+            m_rpc_request_callbacks[slot] = callback;
+        }
+        registered_callback = &m_rpc_request_callbacks[slot];
+        m_active_requests++;
         return true;
     }
 
@@ -205,13 +227,14 @@ class Client_Side_RPC : public IAPI_Implementation {
     /// and from the client-side RPC response topic, was successful or not
     bool RPC_Request_Unsubscribe() {
         m_rpc_request_callbacks.clear();
+        m_active_requests = 0U;
         return m_unsubscribe_topic_callback.Call_Callback(RPC_RESPONSE_SUBSCRIBE_TOPIC);
     }
 
-    Callback<bool, char const * const, JsonDocument const &, size_t const &> m_send_json_callback = {};          // Send json document callback
-    Callback<bool, char const * const>                                       m_subscribe_topic_callback = {};    // Subscribe mqtt topic client callback
-    Callback<bool, char const * const>                                       m_unsubscribe_topic_callback = {};  // Unubscribe mqtt topic client callback
-    Callback<size_t *>                                                       m_get_request_id_callback = {};     // Get internal request id callback
+    Delegate<bool, char const * const, JsonDocument const &, size_t const &> m_send_json_callback = {};          // Send json document callback
+    Delegate<bool, char const * const>                                       m_subscribe_topic_callback = {};    // Subscribe mqtt topic client callback
+    Delegate<bool, char const * const>                                       m_unsubscribe_topic_callback = {};  // Unubscribe mqtt topic client callback
+    Delegate<size_t *>                                                       m_get_request_id_callback = {};     // Get internal request id callback
 
     // Vectors or array (depends on wheter if THINGSBOARD_ENABLE_DYNAMIC is set to 1 or 0), hold copy of the actual passed data, this is to ensure they stay valid,
     // even if the user only temporarily created the object before the method was called.
@@ -222,10 +245,12 @@ class Client_Side_RPC : public IAPI_Implementation {
     // Therefore copy-by-value has been choosen as for this specific use case it is more advantageous,
     // especially because at most we copy internal vectors or array, that will only ever contain a few pointers
 #if THINGSBOARD_ENABLE_DYNAMIC
-    Vector<RPC_Request_Callback>                                             m_rpc_request_callbacks = {};       // Server side RPC callbacks vector
+    Vector<RPC_Request_Callback>                                             m_rpc_request_callbacks = {};       // Slot table of in-flight client side RPC requests, slots are reused and never shifted
 #else
-    Array<RPC_Request_Callback, MaxSubscriptions>                            m_rpc_request_callbacks = {};       // Server side RPC callbacks array
+    Array<RPC_Request_Callback, MaxSubscriptions>                            m_rpc_request_callbacks = {};       // Slot table of in-flight client side RPC requests, slots are reused and never shifted
 #endif // THINGSBOARD_ENABLE_DYNAMIC
+    size_t                                                                   m_active_requests = {};             // Amount of slots that currently contain an in-flight request
+    char                                                                     m_request_topic[sizeof(RPC_SEND_REQUEST_TOPIC_PREFIX) + Helper::Max_Unsigned_Integer_Digits] = {}; // Persistent request topic buffer, contains the constant topic prefix with the request id of the current request appended behind it
 };
 
 #endif // Client_Side_RPC_h
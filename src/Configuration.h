@@ -98,6 +98,37 @@
 #    endif
 #  endif
 
+// Use the miniz inflate implementation contained in the ROM of the ESP chips internally, as long as the header exists,
+// for decompressing gzip compressed firmware binaries while they are downloaded during an OTA update.
+// Because the implementation is contained in the ROM it costs no additional flash space, only the decompressor state
+// and the inflate dictionary window (~43 KB) are allocated on the heap and only for the duration of the update.
+// Allows transferring roughly half the bytes over the network for typical firmware binaries, which especially matters on metered connections
+#  ifndef THINGSBOARD_USE_ROM_MINIZ
+#    ifdef __has_include
+#      if __has_include(<rom/miniz.h>) || __has_include(<esp32/rom/miniz.h>)
+#        define THINGSBOARD_USE_ROM_MINIZ 1
+#      else
+#        define THINGSBOARD_USE_ROM_MINIZ 0
+#      endif
+#    else
+#      define THINGSBOARD_USE_ROM_MINIZ 0
+#    endif
+#  endif
+
+// Use the dedicated mbedtls sha headers internally for creating hashes of the SHA family, instead of the generic message digest layer.
+// Only enabled if mbedtls itself is used and the SHA hardware acceleration has been enabled in the menuconfig (CONFIG_MBEDTLS_HARDWARE_SHA),
+// because in that case the Espressif IDF replaces the mbedtls_sha256 and mbedtls_sha512 implementations with alt implementations,
+// that calculate the hash on the SHA peripheral instead of the CPU and automatically use the DMA engine for big enough payloads on chips that support it.
+// Using the dedicated contexts directly additionally removes the heap allocation and the indirect dispatch the generic message digest layer requires.
+// Cuts the CPU share of hashing the received firmware binary during an OTA update to near zero, freeing the CPU for the concurrent flash writes.
+#  ifndef THINGSBOARD_USE_ESP_HARDWARE_SHA
+#    if THINGSBOARD_USE_MBED_TLS && defined(CONFIG_MBEDTLS_HARDWARE_SHA)
+#      define THINGSBOARD_USE_ESP_HARDWARE_SHA 1
+#    else
+#      define THINGSBOARD_USE_ESP_HARDWARE_SHA 0
+#    endif
+#  endif
+
 // Use the esp_ota_ops header internally for handling the writing of ota update data, as long as the header exists,
 // to allow users that do have the needed component to use the Espressif_Updater instead of only the Arduino_ESP32_Updater.
 // Only exists following major version 1 minor version 0 on ESP32 (https://github.com/espressif/esp-idf/releases/v0.9) and major version 3 minor version 0 on ESP8266 (https://github.com/espressif/ESP8266_RTOS_SDK/releases/tag/v3.0-rc1).
@@ -123,6 +154,33 @@
 #    define THINGSBOARD_ENABLE_DYNAMIC CONFIG_THINGSBOARD_ENABLE_DYNAMIC
 #  endif
 
+// Use a dedicated FreeRTOS worker task for serializing and publishing telemetry, as long as the FreeRTOS headers exist.
+// Allows other tasks to hand telemetry records to the ThingsBoard instance through a lock-free ring with enqueueTelemetryData(),
+// instead of every task having to serialize and publish itself, which is not safe without additional locking because the internal state is not synchronized.
+// The worker task is only created once startWorkerTask() is called, meaning simply having the option enabled costs nothing.
+#  ifndef THINGSBOARD_ENABLE_WORKER_TASK
+#    ifdef __has_include
+#      if __has_include(<freertos/FreeRTOS.h>) && __has_include(<freertos/task.h>)
+#        define THINGSBOARD_ENABLE_WORKER_TASK 1
+#      else
+#        define THINGSBOARD_ENABLE_WORKER_TASK 0
+#      endif
+#    else
+#      define THINGSBOARD_ENABLE_WORKER_TASK 0
+#    endif
+#  endif
+
+// Enables serializing all outgoing messages with the binary MessagePack format instead of json text.
+// ArduinoJson ships the serializeMsgPack method alongside serializeJson, which produces 30-50% smaller payloads for numeric-heavy telemetry
+// and is cheaper to encode, because no float-to-decimal formatting has to be done. Requires the used ThingsBoard instance,
+// to connect to the MessagePack MQTT endpoint instead (https://thingsboard.io/docs/reference/mqtt-api/), because the cloud has to know how to interpret the binary payload.
+// Only applies to the MQTT based ThingsBoard client, the ThingsBoardHttp client always sends json text and is therefore not compatible with this option.
+// Can also optionally be configured via the ESP-IDF menuconfig, if that is the done the value is set to the value entered in the menuconfig,
+// if the value is manually overriden tough with a #define before including ThingsBoard then the hardcoded value takes precendence.
+#  ifndef THINGSBOARD_ENABLE_MSGPACK
+#    define THINGSBOARD_ENABLE_MSGPACK CONFIG_THINGSBOARD_ENABLE_MSGPACK
+#  endif
+
 // Enables the ThingsBoard class to print all received and sent messages and their topic, from and to the server,
 // additionally some more debug messages will be printed. Requires more flash memory, and more calls to the console requiring more performance.
 // Recommended to disable when building for release, should only be enabled to debug where a issue might stem from.
@@ -132,6 +190,16 @@
 #    define THINGSBOARD_ENABLE_DEBUG CONFIG_THINGSBOARD_ENABLE_DEBUG
 #  endif
 
+// Enables the latency instrumentation of the hot send and receive paths, timestamping the stages of sending a message
+// (measuring, serializing, publishing) and of processing a received message (topic matching, size scanning, deserializing, dispatching)
+// and accumulating the durations into per-stage histograms that can be retrieved with the profilingStats() method of the ThingsBoard class.
+// Useful to narrow down where the time goes when the publish or receive latency regresses in the field.
+// Disabled by default because every probe costs two timestamps and a handful of counter increments on the hot path,
+// with the option disabled all probes compile away completly and the release build pays nothing.
+#  ifndef THINGSBOARD_ENABLE_PROFILING
+#    define THINGSBOARD_ENABLE_PROFILING 0
+#  endif
+
 // Use the StreamUtils header internally for enabling the usage of an additonal library as a fallback, as long as the header exists,
 // to allwo to directly serialize a json message that is sent to the cloud, if the size of that message would be bigger than the internal buffer size of the client.
 // Allows sending much bigger messages than would otherwise be possible, and without the need to increase stack or heap requirements, but at the cost of increased send times.
@@ -0,0 +1,17 @@
+#ifndef Connection_State_h
+#define Connection_State_h
+
+// Library include.
+#include <stdint.h>
+
+
+/// @brief Possible states of the asynchronous connect state machine started with connectAsync().
+/// Polled with connectionState() and advanced from loop(), meaning loop() has to be called continuously for the state machine to make progress
+enum class Connection_State : uint8_t {
+    DISCONNECTED,  ///< No connection is established and no asynchronous connect has been started yet
+    CONNECTING,    ///< Connection attempts to the configured server are performed, with the configured retry interval between failed attempts
+    RESUBSCRIBING, ///< Connection is established and the previously subscribed topics are replayed incrementally, one subscription per loop() iteration
+    CONNECTED      ///< Connection is established and all previously subscribed topics have been resubscribed
+};
+
+#endif // Connection_State_h
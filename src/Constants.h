@@ -8,6 +8,8 @@
 #if THINGSBOARD_ENABLE_PSRAM || THINGSBOARD_ENABLE_DYNAMIC
 #include <ArduinoJson.h>
 #endif // THINGSBOARD_ENABLE_PSRAM || THINGSBOARD_ENABLE_DYNAMIC
+#include <stddef.h>
+#include <stdint.h>
 
 #define Default_Endpoints_Amount 7
 #define Default_Response_Amount 8
@@ -16,6 +18,10 @@
 #define Default_RPC_Amount 0
 #define Default_Request_RPC_Amount 2
 #define Default_Payload_Size 64
+#define Default_Queued_Telemetry_Amount 16
+#define Default_Devices_Amount 8
+#define Default_Deadband_Rules_Amount 8
+#define Default_Aggregated_Keys_Amount 8
 #define Default_Max_Stack_Size 1024
 #if THINGSBOARD_ENABLE_STREAM_UTILS
 #define Default_Buffering_Size 64
@@ -24,6 +30,13 @@
 #define Default_Max_Response_Size 0
 #endif // THINGSBOARD_ENABLE_DYNAMIC
 
+// Telemetry batching defaults, shared between the MQTT and the HTTP transport so both expose the same batching API.
+uint16_t constexpr DEFAULT_FLUSH_THRESHOLD_BYTES = 0U;
+uint64_t constexpr DEFAULT_FLUSH_INTERVAL_MS = 1000U;
+// Upper bound of the serialized size of a single value (int64_t, double or bool) including the surrounding json syntax (quotes, colon and comma),
+// strings are instead measured with their actual length. Used to conservatively estimate the payload size of the queued telemetry without having to serialize it
+size_t constexpr MAX_SERIALIZED_VALUE_SIZE = 24U;
+
 
 // Log messages.
 #if !THINGSBOARD_ENABLE_DYNAMIC
@@ -0,0 +1,148 @@
+// Header include.
+#include "Delta_Patcher.h"
+
+// Magic bytes and format version every patch starts with
+constexpr uint8_t PATCH_MAGIC[] = {'T', 'B', 'D', 'P'};
+constexpr uint8_t PATCH_VERSION = 1U;
+constexpr size_t PATCH_HEADER_SIZE = sizeof(PATCH_MAGIC) + 1U;
+// Opcodes of the operations a patch consists of
+constexpr uint8_t OPCODE_COPY = 0x00U;
+constexpr uint8_t OPCODE_ADD = 0x01U;
+constexpr uint8_t OPCODE_END = 0x02U;
+// Amount of argument bytes the operations carry
+constexpr size_t COPY_ARGUMENT_SIZE = 8U;
+constexpr size_t ADD_ARGUMENT_SIZE = 4U;
+// Size of the staging buffer the copied regions of the currently running firmware are read into,
+// bounds the memory cost of the patch application while keeping the amount of read calls per copied region low
+constexpr size_t STAGING_SIZE = 1024U;
+
+Delta_Patcher::~Delta_Patcher() {
+    reset();
+}
+
+bool Delta_Patcher::begin(Delegate<size_t, size_t const &, uint8_t *, size_t const &> source_read_callback, Delegate<bool, uint8_t *, size_t const &> output_callback) {
+    if (m_staging_buffer == nullptr) {
+        m_staging_buffer = new uint8_t[STAGING_SIZE];
+    }
+    if (m_staging_buffer == nullptr) {
+        return false;
+    }
+    m_source_read_callback = source_read_callback;
+    m_output_callback = output_callback;
+    m_patch_state = Patch_State::MAGIC;
+    m_argument_bytes = 0U;
+    m_add_remaining = 0U;
+    m_patch_finished = false;
+    return true;
+}
+
+bool Delta_Patcher::update(uint8_t * data, size_t const & length) {
+    if (m_staging_buffer == nullptr) {
+        return false;
+    }
+    uint8_t * input = data;
+    size_t remaining = length;
+    while (remaining > 0U) {
+        uint8_t const byte = *input;
+        switch (m_patch_state) {
+            case Patch_State::MAGIC:
+                if ((m_argument_bytes < sizeof(PATCH_MAGIC) && byte != PATCH_MAGIC[m_argument_bytes]) ||
+                    (m_argument_bytes == sizeof(PATCH_MAGIC) && byte != PATCH_VERSION)) {
+                    return false;
+                }
+                if (++m_argument_bytes >= PATCH_HEADER_SIZE) {
+                    m_patch_state = Patch_State::OPCODE;
+                    m_argument_bytes = 0U;
+                }
+                break;
+            case Patch_State::OPCODE:
+                if (byte == OPCODE_COPY) {
+                    m_patch_state = Patch_State::COPY_ARGUMENTS;
+                }
+                else if (byte == OPCODE_ADD) {
+                    m_patch_state = Patch_State::ADD_LENGTH;
+                }
+                else if (byte == OPCODE_END) {
+                    m_patch_state = Patch_State::DONE;
+                    m_patch_finished = true;
+                }
+                else {
+                    return false;
+                }
+                m_argument_bytes = 0U;
+                break;
+            case Patch_State::COPY_ARGUMENTS:
+                m_arguments[m_argument_bytes] = byte;
+                if (++m_argument_bytes >= COPY_ARGUMENT_SIZE) {
+                    if (!execute_copy(decode_argument(0U), decode_argument(sizeof(uint32_t)))) {
+                        return false;
+                    }
+                    m_patch_state = Patch_State::OPCODE;
+                }
+                break;
+            case Patch_State::ADD_LENGTH:
+                m_arguments[m_argument_bytes] = byte;
+                if (++m_argument_bytes >= ADD_ARGUMENT_SIZE) {
+                    m_add_remaining = decode_argument(0U);
+                    m_patch_state = (m_add_remaining != 0U) ? Patch_State::ADD_DATA : Patch_State::OPCODE;
+                }
+                break;
+            case Patch_State::ADD_DATA: {
+                // Raw bytes are forwarded to the output callback directly out of the fed data, without being copied anywhere first
+                size_t const forwarded_bytes = (remaining < m_add_remaining) ? remaining : m_add_remaining;
+                if (!m_output_callback.Call_Callback(input, forwarded_bytes)) {
+                    return false;
+                }
+                m_add_remaining -= forwarded_bytes;
+                if (m_add_remaining == 0U) {
+                    m_patch_state = Patch_State::OPCODE;
+                }
+                input += forwarded_bytes;
+                remaining -= forwarded_bytes;
+                continue;
+            }
+            case Patch_State::DONE:
+                // Bytes that follow the end marker are simply ignored
+                return true;
+            default:
+                return false;
+        }
+        input++;
+        remaining--;
+    }
+    return true;
+}
+
+bool Delta_Patcher::finish() const {
+    return m_patch_finished;
+}
+
+void Delta_Patcher::reset() {
+    delete[] m_staging_buffer;
+    m_staging_buffer = nullptr;
+    m_patch_finished = false;
+}
+
+bool Delta_Patcher::execute_copy(size_t const & source_offset, size_t const & length) {
+    size_t copied_bytes = 0U;
+    while (copied_bytes < length) {
+        size_t const remaining_bytes = length - copied_bytes;
+        size_t const requested_bytes = (remaining_bytes < STAGING_SIZE) ? remaining_bytes : STAGING_SIZE;
+        size_t const read_bytes = m_source_read_callback.Call_Callback(source_offset + copied_bytes, m_staging_buffer, requested_bytes);
+        if (read_bytes != requested_bytes) {
+            return false;
+        }
+        if (!m_output_callback.Call_Callback(m_staging_buffer, read_bytes)) {
+            return false;
+        }
+        copied_bytes += read_bytes;
+    }
+    return true;
+}
+
+uint32_t Delta_Patcher::decode_argument(size_t const & index) const {
+    return static_cast<uint32_t>(m_arguments[index]) |
+           (static_cast<uint32_t>(m_arguments[index + 1U]) << 8U) |
+           (static_cast<uint32_t>(m_arguments[index + 2U]) << 16U) |
+           (static_cast<uint32_t>(m_arguments[index + 3U]) << 24U);
+}
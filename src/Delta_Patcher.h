@@ -0,0 +1,95 @@
+#ifndef Delta_Patcher_h
+#define Delta_Patcher_h
+
+// Local includes.
+#include "Configuration.h"
+#include "Callback.h"
+
+// Library includes.
+#include <stdint.h>
+#include <stddef.h>
+
+
+/// @brief Streams a binary delta patch and reconstructs the complete target firmware from it,
+/// reading unchanged regions from the currently running firmware and taking changed regions from the patch itself.
+/// Because most firmware releases only change a small portion of the image, the patch artifact is typically an order of magnitude smaller
+/// than the complete binary, which shrinks the download accordingly without any change to the download protocol.
+/// The class instance is meant to be started with begin() which allocates the staging buffer the unchanged regions are read into,
+/// the patch is then fed in arbitrary sized pieces with update(), which forwards every reconstructed block to the given callback,
+/// and once the complete patch has been fed finish() reports whether the patch was terminated correctly.
+///
+/// The expected patch format is a simple stream of operations, with all multi byte values stored in little endian byte order:
+/// - 4 magic bytes "TBDP" followed by 1 format version byte (currently 1)
+/// - any amount of operations, each starting with 1 opcode byte:
+///   - 0x00 (copy): 4 byte source offset and 4 byte length, copies the given region of the currently running firmware into the target
+///   - 0x01 (add): 4 byte length followed by that many raw bytes, writes the contained bytes into the target
+///   - 0x02 (end): marks the end of the patch, all following bytes are ignored
+/// The integrity of the reconstructed firmware is expected to be verified by the caller (hash over the reconstructed stream),
+/// which also catches the source firmware on the device not being the version the patch was created against
+class Delta_Patcher {
+  public:
+    /// @brief Constructor
+    Delta_Patcher() = default;
+
+    /// @brief Destructor
+    ~Delta_Patcher();
+
+    /// @brief Starts the application of a new patch, allocates the staging buffer if it does not exist yet,
+    /// can be called again at any point to restart the patch application from the beginning, previously allocated memory is then simply reused
+    /// @param source_read_callback Callback that reads the given region of the currently running firmware into the given buffer,
+    /// returns the amount of bytes that were actually read, reading less than the requested amount fails the patch application
+    /// @param output_callback Callback that is called with every reconstructed block, the given data is only valid for the duration of the call.
+    /// If the callback returns false the patch application is considered failed and the update() call that produced the block fails as well
+    /// @return Whether allocating the internally needed memory was successful or not
+    bool begin(Delegate<size_t, size_t const &, uint8_t *, size_t const &> source_read_callback, Delegate<bool, uint8_t *, size_t const &> output_callback);
+
+    /// @brief Feeds the next piece of the patch into the patcher,
+    /// calls the callback given in begin() for every reconstructed block that could be produced from the data fed so far
+    /// @param data Next piece of the patch, directly following the previously fed piece
+    /// @param length Amount of bytes in the given piece
+    /// @return Whether applying the given piece was successful or not
+    bool update(uint8_t * data, size_t const & length);
+
+    /// @brief Returns whether the patch was terminated correctly with its end marker, called once the complete patch has been fed with update().
+    /// If the end marker was never reached the patch was truncated and the reconstructed firmware is incomplete
+    /// @return Whether the patch was terminated correctly or not
+    bool finish() const;
+
+    /// @brief Frees the staging buffer, begin() has to be called again before the instance can be reused,
+    /// called once the reconstructed firmware is not needed anymore to give the memory back as long as no patch application is running
+    void reset();
+
+  private:
+    /// @brief Possible states of parsing the patch stream, decides how the next fed byte is interpreted
+    enum class Patch_State : uint8_t {
+        MAGIC,          ///< Magic bytes and format version at the beginning of the patch
+        OPCODE,         ///< Opcode byte deciding which operation follows
+        COPY_ARGUMENTS, ///< Source offset and length of a copy operation
+        ADD_LENGTH,     ///< Length of the raw bytes of an add operation
+        ADD_DATA,       ///< Raw bytes of an add operation, forwarded to the output callback directly
+        DONE            ///< End marker has been reached, all following bytes are ignored
+    };
+
+    /// @brief Copies the given region of the currently running firmware into the target,
+    /// read through the staging buffer in pieces and forwarded to the output callback piece by piece
+    /// @param source_offset Offset of the region inside the currently running firmware
+    /// @param length Amount of bytes that should be copied
+    /// @return Whether reading and forwarding the complete region was successful or not
+    bool execute_copy(size_t const & source_offset, size_t const & length);
+
+    /// @brief Decodes a little endian 4 byte value from the internally accumulated argument bytes
+    /// @param index Index of the first of the 4 bytes inside the accumulated argument bytes
+    /// @return Decoded value
+    uint32_t decode_argument(size_t const & index) const;
+
+    Delegate<size_t, size_t const &, uint8_t *, size_t const &> m_source_read_callback = {}; // Callback that reads regions of the currently running firmware
+    Delegate<bool, uint8_t *, size_t const &>                   m_output_callback = {};      // Callback that every reconstructed block is forwarded to
+    uint8_t                                                     *m_staging_buffer = {};      // Staging buffer the copied regions of the currently running firmware are read into
+    Patch_State                                                 m_patch_state = {};          // Current state of parsing the patch stream
+    uint8_t                                                     m_arguments[8] = {};         // Accumulated argument bytes of the operation that is currently parsed
+    size_t                                                      m_argument_bytes = {};       // Amount of argument bytes that were already accumulated
+    size_t                                                      m_add_remaining = {};        // Amount of raw bytes of the current add operation that have not been forwarded yet
+    bool                                                        m_patch_finished = {};       // Whether the end marker of the patch has been reached
+};
+
+#endif // Delta_Patcher_h
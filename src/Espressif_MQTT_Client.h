@@ -12,12 +12,21 @@
 // Library includes.
 #include <mqtt_client.h>
 #include <esp_crt_bundle.h>
+#ifdef CONFIG_MQTT_PROTOCOL_5
+#include <mqtt5_client.h>
+#endif // CONFIG_MQTT_PROTOCOL_5
 
 // The error integer -1 means a general failure while handling the mqtt client,
 // where as -2 means that the outbox is filled and the message can therefore not be sent.
 // Therefore we have to check if the value is smaller or equal to the MQTT_FAILURE_MESSAGE_ID,
 // to ensure other errors are indentified as well
 constexpr int MQTT_FAILURE_MESSAGE_ID = -1;
+#ifdef CONFIG_MQTT_PROTOCOL_5
+// Maximum amount of topics that can be registered to be published with an MQTT 5 topic alias.
+// Intentionally small, because only the few constant topics that are published at a high rate benefit from an alias
+// and the broker is allowed to reject connections that announce more aliases than its topic alias maximum
+constexpr uint8_t MAX_TOPIC_ALIAS_AMOUNT = 8U;
+#endif // CONFIG_MQTT_PROTOCOL_5
 constexpr char MQTT_DATA_EXCEEDS_BUFFER[] = "Received amount of data (%u) is bigger than current buffer size (%u), increase accordingly";
 #if THINGSBOARD_ENABLE_DEBUG
 constexpr char RECEIVED_MQTT_EVENT[] = "Handling received mqtt event: (%s)";
@@ -37,11 +46,29 @@ class Espressif_MQTT_Client : public IMQTT_Client {
     /// @brief Constructs a IMQTT_Client implementation which creates and empty esp_mqtt_client_config_t, which then has to be configured with the other methods in the class
     Espressif_MQTT_Client()
       : m_received_data_callback()
+      , m_fragment_data_callback()
+      , m_publish_completed_callback()
       , m_connected_callback()
       , m_connected(false)
       , m_enqueue_messages(false)
       , m_mqtt_configuration()
       , m_mqtt_client(nullptr)
+      , m_borrow_buffer(nullptr)
+      , m_borrow_capacity(0U)
+      , m_streamed_topic(nullptr)
+      , m_streamed_length(0U)
+      , m_streamed_written(0U)
+      , m_fragment_topic(nullptr)
+      , m_fragment_topic_capacity(0U)
+      , m_fragment_callback_set(false)
+      , m_fragment_in_progress(false)
+      , m_fragment_next_offset(0U)
+#ifdef CONFIG_MQTT_PROTOCOL_5
+      , m_mqtt5_enabled(false)
+      , m_topic_aliases()
+      , m_topic_alias_announced()
+      , m_topic_alias_amount(0U)
+#endif // CONFIG_MQTT_PROTOCOL_5
     {
         // Nothing to do
     }
@@ -49,6 +76,8 @@ class Espressif_MQTT_Client : public IMQTT_Client {
     /// @brief Destructor
     ~Espressif_MQTT_Client() {
         (void)esp_mqtt_client_destroy(m_mqtt_client);
+        delete[] m_borrow_buffer;
+        delete[] m_fragment_topic;
     }
 
     /// @brief Configures the server certificate, which allows to connect to the MQTT broker over a secure TLS / SSL conenction instead of the default unencrypted channel.
@@ -113,6 +142,94 @@ class Espressif_MQTT_Client : public IMQTT_Client {
         return update_configuration();
     }
 
+    /// @brief Whether to disable or enable the clean session flag of the MQTT connection, the default value is false meaning every connection starts with a clean session.
+    /// Disabling the clean session makes the broker keep the session state (subscriptions and undelivered messages with a QoS bigger than 0) across reconnects,
+    /// which meaningfully reduces the reconnect-to-first-publish latency for devices that reconnect often (wake-publish-sleep cycles),
+    /// because the subscribe requests for all previously subscribed topics do not have to be sent and confirmed again before the device is fully operational.
+    /// Requires connecting with the same client id for the broker to be able to associate the connection with the kept session.
+    /// Has to be called before initally calling connect() on the client, because the flag is part of the connect control packet.
+    /// The TLS handshake latency of a reconnect can additionally be reduced with the compile time options of the used Espressif IDF components,
+    /// CONFIG_ESP_TLS_CLIENT_SESSION_TICKETS enables TLS session tickets, which replace the full TLS handshake with an abbreviated one on reconnects,
+    /// and CONFIG_MBEDTLS_SSL_IN_CONTENT_LEN as well as CONFIG_MBEDTLS_SSL_OUT_CONTENT_LEN configure the TLS fragment length, smaller fragments reduce both the handshake duration and the memory usage.
+    /// Both are configured with menuconfig, because the underlying esp mqtt component does not expose them over its runtime configuration
+    /// @param disable_clean_session Whether the broker should keep the session state across reconnects or start every connection with a clean session
+    /// @return Whether changing the internal clean session flag was successful or not
+    bool set_disable_clean_session(bool disable_clean_session) {
+#if ESP_IDF_VERSION_MAJOR < 5
+        m_mqtt_configuration.disable_clean_session = disable_clean_session;
+#else
+        m_mqtt_configuration.session.disable_clean_session = disable_clean_session;
+#endif // ESP_IDF_VERSION_MAJOR < 5
+        return update_configuration();
+    }
+
+    /// @brief Sets the timeout in milliseconds for every network operation of the underlying mqtt client (establishing the connection, writing to and reading from the socket),
+    /// if the value is 0 then the default of 10 seconds is used instead. Reducing the timeout makes the client detect a broken connection faster,
+    /// which reduces the worst case duration until a reconnect is attempted, but a too small value makes the client abort operations that would have succeeded on slow links
+    /// @param network_timeout_milliseconds Timeout until a network operation that has not completed is considered to have failed
+    /// @return Whether changing the internal network timeout was successful or not
+    bool set_network_timeout(uint32_t network_timeout_milliseconds) {
+#if ESP_IDF_VERSION_MAJOR < 5
+        m_mqtt_configuration.network_timeout_ms = network_timeout_milliseconds;
+#else
+        m_mqtt_configuration.network.timeout_ms = network_timeout_milliseconds;
+#endif // ESP_IDF_VERSION_MAJOR < 5
+        return update_configuration();
+    }
+
+    /// @brief Sets the time in milliseconds the underlying mqtt client waits after a lost connection before it automatically attempts to reconnect,
+    /// if the value is 0 then the default of 10 seconds is used instead. Reducing the wait time reduces the duration until the device is operational again after a lost connection,
+    /// but a too small value can overwhelm slow links, because every failed attempt pays the complete TLS handshake again
+    /// @param reconnect_timeout_milliseconds Time the client waits after a lost connection before attempting to reconnect
+    /// @return Whether changing the internal reconnect timeout was successful or not
+    bool set_reconnect_timeout(uint32_t reconnect_timeout_milliseconds) {
+#if ESP_IDF_VERSION_MAJOR < 5
+        m_mqtt_configuration.reconnect_timeout_ms = reconnect_timeout_milliseconds;
+#else
+        m_mqtt_configuration.network.reconnect_timeout_ms = reconnect_timeout_milliseconds;
+#endif // ESP_IDF_VERSION_MAJOR < 5
+        return update_configuration();
+    }
+
+#ifdef CONFIG_MQTT_PROTOCOL_5
+    /// @brief Enables the MQTT 5 protocol for the connection with the broker instead of the default MQTT 3.1.1.
+    /// Required for topics registered with register_topic_alias() to actually be published with their 2 byte alias instead of the complete topic string.
+    /// Has to be called before initally calling connect() on the client, because the protocol version is negotiated when the connection is established.
+    /// Additionally requires the MQTT 5 protocol support of the esp mqtt component (CONFIG_MQTT_PROTOCOL_5) to be enabled with menuconfig,
+    /// if it is not this method and register_topic_alias() simply do not exist and the client keeps using MQTT 3.1.1
+    /// @return Whether enabling the MQTT 5 protocol was successful or not
+    bool enable_mqtt_version_5() {
+#if ESP_IDF_VERSION_MAJOR < 5
+        m_mqtt_configuration.protocol_ver = esp_mqtt_protocol_ver_t::MQTT_PROTOCOL_V_5;
+#else
+        m_mqtt_configuration.session.protocol_ver = esp_mqtt_protocol_ver_t::MQTT_PROTOCOL_V_5;
+#endif // ESP_IDF_VERSION_MAJOR < 5
+        m_mqtt5_enabled = true;
+        return update_configuration();
+    }
+
+    bool register_topic_alias(char const * topic) override {
+        if (!m_mqtt5_enabled || topic == nullptr) {
+            return false;
+        }
+        // Already registered topics simply keep their previously assigned alias, occurs because the ThingsBoard client registers
+        // its constant topics on every established connection, because topic aliases only survive for a single MQTT session
+        for (uint8_t alias_index = 0U; alias_index < m_topic_alias_amount; ++alias_index) {
+            if (m_topic_aliases[alias_index] == topic || strcmp(m_topic_aliases[alias_index], topic) == 0) {
+                m_topic_alias_announced[alias_index] = false;
+                return true;
+            }
+        }
+        if (m_topic_alias_amount >= MAX_TOPIC_ALIAS_AMOUNT) {
+            return false;
+        }
+        m_topic_aliases[m_topic_alias_amount] = topic;
+        m_topic_alias_announced[m_topic_alias_amount] = false;
+        m_topic_alias_amount++;
+        return true;
+    }
+#endif // CONFIG_MQTT_PROTOCOL_5
+
     /// @brief Sets the keep alive timeout in seconds, if the value is 0 then the default of 120 seconds is used instead to disable the keep alive mechanism use set_disable_keep_alive() instead.
     /// The default timeout value ThingsBoard expectes to receive any message including a keep alive to not show the device as inactive can be found here https://thingsboard.io/fig/#mqtt-server-parameters
     /// under the transport.sessions.inactivity_timeout section and is 300 seconds. Meaning a value bigger than 300 seconds with the default config defeats the purpose of the keep alive alltogetherdocs/user-guide/install/con
@@ -218,6 +335,15 @@ class Espressif_MQTT_Client : public IMQTT_Client {
         m_connected_callback.Set_Callback(callback);
     }
 
+    void set_fragment_data_callback(Callback<void, char *, uint8_t *, unsigned int, size_t const &, size_t const &>::function callback) override {
+        m_fragment_data_callback.Set_Callback(callback);
+        m_fragment_callback_set = callback != nullptr;
+    }
+
+    void set_publish_completion_callback(Callback<void, int>::function callback) override {
+        m_publish_completed_callback.Set_Callback(callback);
+    }
+
     bool set_buffer_size(uint16_t receive_buffer_size, uint16_t send_buffer_size) override {
 #if ESP_IDF_VERSION_MAJOR < 5
         m_mqtt_configuration.buffer_size = receive_buffer_size;
@@ -319,21 +445,67 @@ class Espressif_MQTT_Client : public IMQTT_Client {
     }
 
     bool publish(char const * topic, uint8_t const * payload, size_t const & length) override {
-        int message_id = MQTT_FAILURE_MESSAGE_ID;
+        int message_id = 0;
+        return publish(topic, payload, length, 0U, message_id);
+    }
+
+    bool publish(char const * topic, uint8_t const * payload, size_t const & length, uint8_t const & quality_of_service, int & message_id) override {
+        message_id = MQTT_FAILURE_MESSAGE_ID;
+#ifdef CONFIG_MQTT_PROTOCOL_5
+        // Steady state publishes to a registered topic only carry their 2 byte alias instead of the complete topic string,
+        // the first publish after an established connection announces the alias to the broker by carrying both the topic string and the alias property.
+        // The publish property has to be set for topics without an alias as well, because the previously set alias property would be reused for them otherwise
+        uint8_t topic_alias = 0U;
+        if (m_mqtt5_enabled) {
+            esp_mqtt5_publish_property_config_t publish_property = {};
+            topic_alias = find_topic_alias(topic);
+            if (topic_alias != 0U) {
+                publish_property.topic_alias = topic_alias;
+                if (m_topic_alias_announced[topic_alias - 1U]) {
+                    topic = "";
+                }
+            }
+            (void)esp_mqtt5_client_set_publish_property(m_mqtt_client, &publish_property);
+        }
+#endif // CONFIG_MQTT_PROTOCOL_5
 
         if (m_enqueue_messages) {
-            message_id = esp_mqtt_client_enqueue(m_mqtt_client, topic, reinterpret_cast<const char*>(payload), length, 0U, 0U, true);
-            return message_id > MQTT_FAILURE_MESSAGE_ID;
+            message_id = esp_mqtt_client_enqueue(m_mqtt_client, topic, reinterpret_cast<const char*>(payload), length, quality_of_service, 0U, true);
         }
+        else {
+            // The blocking version esp_mqtt_client_publish() it is sent directly from the users task context.
+            // This way is used to send messages to the cloud, because like that no internal buffer has to be used to store the message until it should be sent,
+            // because messages are sent with QoS level 0 per default. Messages published with a QoS level bigger than 0 are additionally saved in the outbox,
+            // which retransmits them automatically until the broker has confirmed their delivery, reported over the callback configured with set_publish_completion_callback().
+            // Allows to use the publish method without having to worry about any CPU overhead, so it can even be used in callbacks or high priority tasks, without starving other tasks,
+            // but compared to the other method esp_mqtt_client_enqueue() requires to save the message in the outbox, which increases the memory requirements for the internal buffer size
+            message_id = esp_mqtt_client_publish(m_mqtt_client, topic, reinterpret_cast<const char*>(payload), length, quality_of_service, 0U);
+        }
+        bool const result = message_id > MQTT_FAILURE_MESSAGE_ID;
+        // Messages published with quality of service 0 are never confirmed by the broker, meaning their message id is reported as 0
+        if (quality_of_service == 0U) {
+            message_id = 0;
+        }
+#ifdef CONFIG_MQTT_PROTOCOL_5
+        // The alias is only marked as announced if the publish carrying the topic string and the alias property was actually handed to the client,
+        // because following publishes with an empty topic would be unroutable for the broker otherwise
+        if (result && topic_alias != 0U) {
+            m_topic_alias_announced[topic_alias - 1U] = true;
+        }
+#endif // CONFIG_MQTT_PROTOCOL_5
+        return result;
+    }
 
-        // The blocking version esp_mqtt_client_publish() it is sent directly from the users task context.
-        // This way is used to send messages to the cloud, because like that no internal buffer has to be used to store the message until it should be sent,
-        // because all messages are sent with QoS level 0. If this is not wanted esp_mqtt_client_enqueue() could be used with store = true,
-        // to ensure the sending is done in the mqtt event context instead of the users task context.
-        // Allows to use the publish method without having to worry about any CPU overhead, so it can even be used in callbacks or high priority tasks, without starving other tasks,
-        // but compared to the other method esp_mqtt_client_enqueue() requires to save the message in the outbox, which increases the memory requirements for the internal buffer size
-        message_id = esp_mqtt_client_publish(m_mqtt_client, topic, reinterpret_cast<const char*>(payload), length, 0U, 0U);
-        return message_id > MQTT_FAILURE_MESSAGE_ID;
+    uint8_t * borrow_publish_buffer(size_t const & length) override {
+        // The esp mqtt client only accepts contiguous payloads and always copies them into its outbox before sending,
+        // meaning true zero-copy publishing is not possible with its public API. Lending a reusable buffer that callers serialize into directly
+        // still removes their own per-message allocation and assembly copy, leaving the single unavoidable copy into the outbox
+        if (length > m_borrow_capacity) {
+            delete[] m_borrow_buffer;
+            m_borrow_buffer = new uint8_t[length];
+            m_borrow_capacity = length;
+        }
+        return m_borrow_buffer;
     }
 
     bool subscribe(char const * topic) override {
@@ -360,6 +532,43 @@ class Espressif_MQTT_Client : public IMQTT_Client {
         return m_connected;
     }
 
+    bool begin_publish(char const * topic, size_t const & length) override {
+        // The esp mqtt client has no incremental publish API, the written chunks are therefore accumulated
+        // into the reusable borrow buffer and handed over in one piece on end_publish().
+        // Because esp_mqtt_client_publish() splits payloads that are bigger than the internal buffer over multiple TCP writes itself,
+        // this still allows publishing messages of arbitrary size, at the cost of one payload sized accumulation buffer
+        uint8_t * const buffer = borrow_publish_buffer(length);
+        if (buffer == nullptr) {
+            return false;
+        }
+        m_streamed_topic = topic;
+        m_streamed_length = length;
+        m_streamed_written = 0U;
+        return true;
+    }
+
+    bool end_publish() override {
+        if (m_streamed_topic == nullptr) {
+            return false;
+        }
+        bool const result = m_streamed_written == m_streamed_length && publish(m_streamed_topic, m_borrow_buffer, m_streamed_length);
+        m_streamed_topic = nullptr;
+        return result;
+    }
+
+    size_t write(uint8_t payload_byte) override {
+        return write(&payload_byte, 1U);
+    }
+
+    size_t write(uint8_t const * buffer, size_t const & size) override {
+        if (m_streamed_topic == nullptr || m_streamed_written + size > m_streamed_length) {
+            return 0U;
+        }
+        memcpy(m_borrow_buffer + m_streamed_written, buffer, size);
+        m_streamed_written += size;
+        return size;
+    }
+
 private:
     /// @brief Is internally used to allow changes to the underlying configuration of the esp_mqtt_client_handle_t after it has connected,
     /// to for example increase the buffer size or increase the timeouts or stack size, allows to change the underlying client configuration,
@@ -408,6 +617,61 @@ private:
     }
 #endif // THINGSBOARD_ENABLE_DEBUG
 
+#ifdef CONFIG_MQTT_PROTOCOL_5
+    /// @brief Searches the given topic in the previously registered topic aliases
+    /// @param topic Topic the alias should be searched for
+    /// @return Alias number the topic was registered with (index + 1) or 0 if the topic has not been registered
+    uint8_t find_topic_alias(char const * topic) const {
+        for (uint8_t alias_index = 0U; alias_index < m_topic_alias_amount; ++alias_index) {
+            // Pointer comparison suffices nearly always, because the constant topics are registered and published with the same string literal,
+            // the string comparison only exists as a fallback for topics that were registered from a different buffer
+            if (m_topic_aliases[alias_index] == topic || strcmp(m_topic_aliases[alias_index], topic) == 0) {
+                return alias_index + 1U;
+            }
+        }
+        return 0U;
+    }
+#endif // CONFIG_MQTT_PROTOCOL_5
+
+    /// @brief Forwards one received fragment of a message that did not fit into the receive buffer at once to the configured fragment callback.
+    /// Because only the event containing the first fragment of a message includes the topic, it is copied into a retained buffer,
+    /// which is then passed to the fragment callback for all following fragments of the same message as well.
+    /// The retained buffer is grown on demand and reused for every received oversized message, the same way the borrow buffer is for sent ones
+    /// @param event Received data event containing the current fragment, its offset inside the complete message and the total message length
+    /// @return Whether the fragment could be forwarded to a previously configured fragment callback or not
+    bool process_message_fragment(esp_mqtt_event_handle_t const & event) {
+        if (!m_fragment_callback_set) {
+            return false;
+        }
+        // Only the event containing the first fragment includes the topic, meaning it has to be retained for the following fragments
+        if (event->current_data_offset == 0) {
+            size_t const required_capacity = event->topic_len + 1U;
+            if (required_capacity > m_fragment_topic_capacity) {
+                delete[] m_fragment_topic;
+                m_fragment_topic = new char[required_capacity];
+                m_fragment_topic_capacity = required_capacity;
+            }
+            (void)strncpy(m_fragment_topic, event->topic, event->topic_len);
+            m_fragment_topic[event->topic_len] = '\0';
+            m_fragment_in_progress = true;
+            m_fragment_next_offset = 0U;
+        }
+        // Fragments that do not continue the current message exactly where the previous fragment ended can not be routed,
+        // either their first fragment was never received (client connected mid-message), meaning the retained topic still belongs to a previous message,
+        // or a fragment in between was lost, making the partial message unusable. The remaining fragments of the message are discarded as well
+        if (!m_fragment_in_progress || static_cast<size_t>(event->current_data_offset) != m_fragment_next_offset) {
+            m_fragment_in_progress = false;
+            return false;
+        }
+        m_fragment_next_offset += event->data_len;
+        // Once the last fragment has arrived the message is finished, ensuring the retained topic is not reused for a later message whose first fragment was missed
+        if (m_fragment_next_offset >= static_cast<size_t>(event->total_data_len)) {
+            m_fragment_in_progress = false;
+        }
+        m_fragment_data_callback.Call_Callback(m_fragment_topic, reinterpret_cast<uint8_t*>(event->data), event->data_len, static_cast<size_t>(event->current_data_offset), static_cast<size_t>(event->total_data_len));
+        return true;
+    }
+
     /// @brief Event handler registered to receive MQTT events. Is called by the MQTT client event loop, whenever a new event occurs
     /// @param base Event base for the handler
     /// @param event_id The id for the received event
@@ -421,16 +685,31 @@ private:
         switch (event_id) {
             case esp_mqtt_event_id_t::MQTT_EVENT_CONNECTED:
                 m_connected = true;
+#ifdef CONFIG_MQTT_PROTOCOL_5
+                // Topic aliases only survive for the duration of a single MQTT session,
+                // meaning every registered topic has to carry its complete topic string again on its first publish after a reconnect
+                for (uint8_t alias_index = 0U; alias_index < m_topic_alias_amount; ++alias_index) {
+                    m_topic_alias_announced[alias_index] = false;
+                }
+#endif // CONFIG_MQTT_PROTOCOL_5
                 m_connected_callback.Call_Callback();
                 break;
             case esp_mqtt_event_id_t::MQTT_EVENT_DISCONNECTED:
                 m_connected = false;
+                // A message received in fragments can not continue over a reconnect, ensures the retained topic is not applied to fragments of a later message
+                m_fragment_in_progress = false;
+                break;
+            case esp_mqtt_event_id_t::MQTT_EVENT_PUBLISHED:
+                m_publish_completed_callback.Call_Callback(event->msg_id);
                 break;
             case esp_mqtt_event_id_t::MQTT_EVENT_DATA: {
-                // Check wheter the given message has not bee received completly, but instead would be received in multiple chunks,
-                // if it were we discard the message because receiving a message over multiple chunks is currently not supported
+                // Messages that do not fit into the receive buffer at once are delivered as multiple events, each containing one fragment of the payload.
+                // If a fragment callback has been configured the fragments are forwarded with their offset as they arrive,
+                // if it has not been the message is discarded instead, because assembling it would require a buffer as big as the complete message
                 if (event->data_len != event->total_data_len) {
-                    Logger::printfln(MQTT_DATA_EXCEEDS_BUFFER, event->total_data_len, get_receive_buffer_size());
+                    if (!process_message_fragment(event)) {
+                        Logger::printfln(MQTT_DATA_EXCEEDS_BUFFER, event->total_data_len, get_receive_buffer_size());
+                    }
                     break;
                 }
                 // Topic is not null terminated, to fix this issue we copy the topic string.
@@ -454,12 +733,30 @@ private:
         instance->mqtt_event_handler(base, static_cast<esp_mqtt_event_id_t>(event_id), event_data);
     }
 
-    Callback<void, char *, uint8_t *, unsigned int> m_received_data_callback = {}; // Callback that will be called as soon as the mqtt client receives any data
-    Callback<void>                                  m_connected_callback = {};     // Callback that will be called as soon as the mqtt client has connected
-    bool                                            m_connected = {};              // Whether the client has received the connected or disconnected event
-    bool                                            m_enqueue_messages = {};       // Whether we enqueue messages making nearly all ThingsBoard calls non blocking or wheter we publish instead
-    esp_mqtt_client_config_t                        m_mqtt_configuration = {};     // Configuration of the underlying mqtt client, saved as a private variable to allow changes after inital configuration with the same options for all non changed settings
-    esp_mqtt_client_handle_t                        m_mqtt_client = {};            // Handle to the underlying mqtt client, used to establish the communication
+    Callback<void, char *, uint8_t *, unsigned int>                                 m_received_data_callback = {};  // Callback that will be called as soon as the mqtt client receives any data
+    Callback<void, char *, uint8_t *, unsigned int, size_t const &, size_t const &> m_fragment_data_callback = {};  // Callback that will be called for every received fragment of a message that did not fit into the receive buffer at once
+    Callback<void, int>                                                             m_publish_completed_callback = {}; // Callback that will be called once the broker has confirmed the delivery of a message published with a quality of service bigger than 0
+    Callback<void>                                                                  m_connected_callback = {};      // Callback that will be called as soon as the mqtt client has connected
+    bool                                                                            m_connected = {};               // Whether the client has received the connected or disconnected event
+    bool                                                                            m_enqueue_messages = {};        // Whether we enqueue messages making nearly all ThingsBoard calls non blocking or wheter we publish instead
+    esp_mqtt_client_config_t                                                        m_mqtt_configuration = {};      // Configuration of the underlying mqtt client, saved as a private variable to allow changes after inital configuration with the same options for all non changed settings
+    esp_mqtt_client_handle_t                                                        m_mqtt_client = {};             // Handle to the underlying mqtt client, used to establish the communication
+    uint8_t *                                                                       m_borrow_buffer = {};           // Reusable buffer lent to callers with borrow_publish_buffer(), so payloads can be serialized without their own per-message allocation
+    size_t                                                                          m_borrow_capacity = {};         // Currently allocated size of the reusable borrow buffer in bytes
+    char const *                                                                    m_streamed_topic = {};          // Topic of the publish message currently being streamed with begin_publish(), nullptr if none is in progress
+    size_t                                                                          m_streamed_length = {};         // Total expected length of the publish message currently being streamed
+    size_t                                                                          m_streamed_written = {};        // Amount of bytes of the streamed publish message that have been written so far
+    char *                                                                          m_fragment_topic = {};          // Retained copy of the topic of the oversized message currently received in fragments, because only the first fragment includes the topic
+    size_t                                                                          m_fragment_topic_capacity = {}; // Currently allocated size of the retained fragment topic buffer in bytes
+    bool                                                                            m_fragment_callback_set = {};   // Whether a fragment callback has been configured, oversized messages are discarded if it has not been
+    bool                                                                            m_fragment_in_progress = {};    // Whether the fragments received so far form a contiguous message the retained topic belongs to
+    size_t                                                                          m_fragment_next_offset = {};    // Offset inside the complete message the next fragment of the current oversized message is expected to start at
+#ifdef CONFIG_MQTT_PROTOCOL_5
+    bool                                                                            m_mqtt5_enabled = {};           // Whether the MQTT 5 protocol has been enabled with enable_mqtt_version_5() instead of the default MQTT 3.1.1
+    char const *                                                                    m_topic_aliases[MAX_TOPIC_ALIAS_AMOUNT] = {};          // Topics registered to be published with a topic alias, the alias number is the index + 1
+    bool                                                                            m_topic_alias_announced[MAX_TOPIC_ALIAS_AMOUNT] = {};  // Whether the alias has been announced to the broker with a publish carrying the complete topic string in the current session
+    uint8_t                                                                         m_topic_alias_amount = {};      // Amount of topics that have been registered to be published with a topic alias
+#endif // CONFIG_MQTT_PROTOCOL_5
 };
 
 #endif // THINGSBOARD_USE_ESP_MQTT
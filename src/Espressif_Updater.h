@@ -11,20 +11,32 @@
 
 // Library include.
 #include <esp_ota_ops.h>
+#include <string.h>
 
 constexpr char INVALID_OTA_PARTIION[] = "The running partition and the parition we wanted to boot into were not the same meaning the previous update failed and choose the fallback partition instead";
 constexpr char MISSING_OTA_APP[] = "Missing second ota app or app was invalid";
 constexpr char BEGIN_UPDATE_FAILED[] = "Beginning update failed with error reason (%s)";
+// Size of the internal staging buffer that coalesces received firmware packets into bursts, before they are written into flash.
+// Matches the flash sector size, because that is the granularity the flash is erased and written with,
+// meaning every esp_ota_write call issued covers complete sectors instead of the arbitrary network chunk size
+constexpr size_t STAGING_BUFFER_SIZE = 4096U;
 
 
 /// @brief IUpdater implementation that uses the Over the Air Update API from Espressif (https://docs.espressif.com/projects/esp-idf/en/latest/esp32/api-reference/system/ota.html)
-/// under the hood to write the given binary firmware data into flash memory so we can restart with newly received firmware
+/// under the hood to write the given binary firmware data into flash memory so we can restart with newly received firmware.
+/// Received firmware packets are coalesced into flash sector sized bursts with an internal staging buffer before they are written,
+/// which decouples the network chunk size that is tuned for the link, from the flash write granularity that is tuned for the hardware,
+/// requires the remaining staged data to be written with flush() once all packets have been received
 /// @tparam Logger Implementation that should be used to print error messages generated by internal processes and additional debugging messages if THINGSBOARD_ENABLE_DEBUG is set, default = DefaultLogger
 template <typename Logger = DefaultLogger>
 class Espressif_Updater : public IUpdater {
   public:
     Espressif_Updater() = default;
 
+    ~Espressif_Updater() {
+        delete[] m_staging_buffer;
+    }
+
     bool begin(size_t const & firmware_size) override {
         esp_partition_t const * running = esp_ota_get_running_partition();
         esp_partition_t const * configured = esp_ota_get_boot_partition();
@@ -45,7 +57,9 @@ class Espressif_Updater : public IUpdater {
         // allowing us to only include the esp_ota_ops header in the defintion (.cpp) file,
         // instead of also needing to declare it in the declaration (.h) header file
         esp_ota_handle_t ota_handle;
-        esp_err_t const error = esp_ota_begin(update_partition, firmware_size, &ota_handle);
+        // A firmware size of 0 means the final size is not known upfront, because the received data is transformed before it is written,
+        // the complete partition is erased in that case instead of only the region the firmware will occupy
+        esp_err_t const error = esp_ota_begin(update_partition, firmware_size == 0U ? OTA_SIZE_UNKNOWN : firmware_size, &ota_handle);
 
         if (error != ESP_OK) {
             Logger::printfln(BEGIN_UPDATE_FAILED, esp_err_to_name(error));
@@ -54,16 +68,60 @@ class Espressif_Updater : public IUpdater {
 
         m_ota_handle = ota_handle;
         m_update_partition = update_partition;
+        // Staging buffer is only allocated once and reused for every following update,
+        // if the allocation fails the received packets are simply written directly instead
+        if (m_staging_buffer == nullptr) {
+            m_staging_buffer = new uint8_t[STAGING_BUFFER_SIZE];
+        }
+        m_staged_bytes = 0U;
         return true;
     }
 
     size_t write(uint8_t * payload, size_t const & total_bytes) override {
-        esp_err_t const error = esp_ota_write(m_ota_handle, payload, total_bytes);
-        size_t const written_bytes = (error == ESP_OK) ? total_bytes : 0U;
-        return written_bytes;
+        if (m_staging_buffer == nullptr) {
+            esp_err_t const error = esp_ota_write(m_ota_handle, payload, total_bytes);
+            size_t const written_bytes = (error == ESP_OK) ? total_bytes : 0U;
+            return written_bytes;
+        }
+        size_t consumed_bytes = 0U;
+        while (consumed_bytes < total_bytes) {
+            size_t const staging_capacity = STAGING_BUFFER_SIZE - m_staged_bytes;
+            size_t const remaining_bytes = total_bytes - consumed_bytes;
+            size_t const copied_bytes = (remaining_bytes < staging_capacity) ? remaining_bytes : staging_capacity;
+            (void)memcpy(m_staging_buffer + m_staged_bytes, payload + consumed_bytes, copied_bytes);
+            m_staged_bytes += copied_bytes;
+            consumed_bytes += copied_bytes;
+            // Only ever written once a complete flash sector has been staged, the remainder that does not fill a sector anymore,
+            // stays staged until either the following packets fill the sector or the remainder is written with flush().
+            // On failure only the bytes flushed with previously completed sectors count as written, the bytes copied into the failed sector do not,
+            // the sector can additionally contain bytes staged by earlier calls that have already been reported as written back then
+            if (m_staged_bytes == STAGING_BUFFER_SIZE && !flush()) {
+                return consumed_bytes - copied_bytes;
+            }
+        }
+        return consumed_bytes;
+    }
+
+    size_t read_current(size_t const & offset, uint8_t * payload, size_t const & length) override {
+        esp_partition_t const * running = esp_ota_get_running_partition();
+        if (running == nullptr || offset + length > running->size) {
+            return 0U;
+        }
+        esp_err_t const error = esp_partition_read(running, offset, payload, length);
+        return (error == ESP_OK) ? length : 0U;
+    }
+
+    bool flush() override {
+        if (m_staged_bytes == 0U) {
+            return true;
+        }
+        esp_err_t const error = esp_ota_write(m_ota_handle, m_staging_buffer, m_staged_bytes);
+        m_staged_bytes = 0U;
+        return error == ESP_OK;
     }
 
     void reset() override {
+        m_staged_bytes = 0U;
 #if defined(ESP8266) || (ESP_IDF_VERSION_MAJOR == 4 && ESP_IDF_VERSION_MINOR < 3) || ESP_IDF_VERSION_MAJOR < 4
         (void)end();
 #else
@@ -84,6 +142,8 @@ class Espressif_Updater : public IUpdater {
   private:
     uint32_t               m_ota_handle = {};       // ESP OTA hanle that is used to to access the underlying updater
     esp_partition_t const *m_update_partition = {}; // Non active OTA partition that we write our data into
+    uint8_t                *m_staging_buffer = {};   // Staging buffer that coalesces received firmware packets into flash sector sized bursts
+    size_t                 m_staged_bytes = {};     // Amount of bytes in the staging buffer that have not been written into flash yet
 };
 
 #endif // THINGSBOARD_USE_ESP_PARTITION
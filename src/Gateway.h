@@ -0,0 +1,347 @@
+#ifndef Gateway_h
+#define Gateway_h
+
+// Local includes.
+#include "Telemetry.h"
+#include "IAPI_Implementation.h"
+
+
+// Gateway topics.
+char constexpr GATEWAY_CONNECT_TOPIC[] = "v1/gateway/connect";
+char constexpr GATEWAY_DISCONNECT_TOPIC[] = "v1/gateway/disconnect";
+char constexpr GATEWAY_TELEMETRY_TOPIC[] = "v1/gateway/telemetry";
+char constexpr GATEWAY_ATTRIBUTE_TOPIC[] = "v1/gateway/attributes";
+// Gateway data keys.
+char constexpr GATEWAY_DEVICE_KEY[] = "device";
+char constexpr GATEWAY_DATA_KEY[] = "data";
+// Log messages.
+#if !THINGSBOARD_ENABLE_DYNAMIC
+char constexpr GATEWAY_MAX_DEVICES_EXCEEDED[] = "Too many connected devices, increase MaxDevicesAmount (%u) or disconnect another device";
+#endif // !THINGSBOARD_ENABLE_DYNAMIC
+char constexpr GATEWAY_DEVICE_NOT_CONNECTED[] = "Device (%s) is not connected to the gateway, call Connect_Device first";
+#if THINGSBOARD_ENABLE_DEBUG
+char constexpr GATEWAY_DEVICE_NAME_NULL[] = "Received gateway message does not contain a device name";
+#endif // THINGSBOARD_ENABLE_DEBUG
+
+
+/// @brief Handles the internal implementation of the ThingsBoard Gateway API, which allows representing multiple named devices over the single established MQTT connection.
+/// Meant for edge devices that poll data from attached sensors (Modbus, BLE, ...) and forward it to the cloud as individual ThingsBoard devices,
+/// without having to pay the RAM and connection overhead of one complete client instance and MQTT connection per represented device.
+/// Devices are announced with Connect_Device() and their data is then sent with the named send and queue methods,
+/// queued telemetry of all devices is coalesced into one combined publish message on the next flush, so a gateway with many attached sensors
+/// still only produces a single message per flush. See https://thingsboard.io/docs/reference/gateway-mqtt-api/ for more information
+/// @tparam Logger Implementation that should be used to print error messages generated by internal processes and additional debugging messages if THINGSBOARD_ENABLE_DEBUG is set, default = DefaultLogger
+#if THINGSBOARD_ENABLE_DYNAMIC
+template <typename Logger = DefaultLogger>
+#else
+/// @tparam MaxDevicesAmount Maximum amount of devices that can be connected to the gateway simultaneously.
+/// Once the maximum amount has been reached it is not possible to increase the size, this is done because it allows to allcoate the memory on the stack instead of the heap, default = Default_Devices_Amount (8)
+/// @tparam MaxQueuedTelemetryAmount Maximum amount of telemetry key value pairs that can be queued per device with Queue_Telemetry_Data() before the queue is flushed automatically, default = Default_Queued_Telemetry_Amount (16)
+template<size_t MaxDevicesAmount = Default_Devices_Amount, size_t MaxQueuedTelemetryAmount = Default_Queued_Telemetry_Amount, typename Logger = DefaultLogger>
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+class Gateway : public IAPI_Implementation {
+  public:
+    /// @brief Callback signature the subscribed gateway attribute update callback is called with,
+    /// receives the name of the device the update is meant for and the updated shared attribute key value pairs
+    using Gateway_Attribute_Update_Callback = Callback<void, char const * const, JsonObjectConst const &>;
+
+    /// @brief Constructor
+    Gateway() = default;
+
+    /// @brief Connects the device with the given name to the gateway, announcing it to the cloud so a matching device is created or found there.
+    /// Has to be called before any data can be sent or queued for the given device. Can be called even if we are currently not connected to the cloud,
+    /// because all connected devices are automatically re-announced once the gateway itself has established a connection to the cloud
+    /// @param device_name Name of the device we want to connect, requires to stay allocated until the device has been disconnected with Disconnect_Device()
+    /// @return Whether connecting the given device was successful or not
+    bool Connect_Device(char const * device_name) {
+        if (Helper::stringIsNullorEmpty(device_name)) {
+            return false;
+        }
+        if (Find_Device(device_name) != nullptr) {
+            return true;
+        }
+#if !THINGSBOARD_ENABLE_DYNAMIC
+        if (m_devices.size() + 1 > m_devices.capacity()) {
+            Logger::printfln(GATEWAY_MAX_DEVICES_EXCEEDED, MaxDevicesAmount);
+            return false;
+        }
+#endif // !THINGSBOARD_ENABLE_DYNAMIC
+        Device_Entry entry = {};
+        entry.name = device_name;
+        m_devices.push_back(entry);
+        return Send_Device_Message(GATEWAY_CONNECT_TOPIC, device_name);
+    }
+
+    /// @brief Disconnects the device with the given name from the gateway, announcing the disconnect to the cloud.
+    /// Any still queued telemetry of the given device is flushed beforehand so no queued data points are lost
+    /// @param device_name Name of the device we want to disconnect
+    /// @return Whether disconnecting the given device was successful or not
+    bool Disconnect_Device(char const * device_name) {
+        Device_Entry * const device = Find_Device(device_name);
+        if (device == nullptr) {
+            return false;
+        }
+        if (!device->telemetry_queue.empty()) {
+            (void)Flush_Telemetry();
+        }
+        bool const result = Send_Device_Message(GATEWAY_DISCONNECT_TOPIC, device_name);
+        for (auto it = m_devices.begin(); it != m_devices.end(); ++it) {
+            if (strcmp(it->name, device_name) == 0) {
+                m_devices.erase(it);
+                break;
+            }
+        }
+        return result;
+    }
+
+    /// @brief Attempts to immediately send telemetry data with the given key and value of the given type for the device with the given name.
+    /// See https://thingsboard.io/docs/reference/gateway-mqtt-api/#telemetry-api for more information
+    /// @tparam T Type of the passed value
+    /// @param device_name Name of the previously connected device the data belongs to
+    /// @param key Key of the key value pair we want to send
+    /// @param value Value of the key value pair we want to send
+    /// @return Whether sending the data was successful or not
+    template<typename T>
+    bool Send_Telemetry_Data(char const * device_name, char const * key, T const & value) {
+        if (Find_Device(device_name) == nullptr) {
+            Logger::printfln(GATEWAY_DEVICE_NOT_CONNECTED, device_name);
+            return false;
+        }
+        StaticJsonDocument<JSON_OBJECT_SIZE(1) + JSON_ARRAY_SIZE(1) + JSON_OBJECT_SIZE(1)> json_buffer;
+        JsonVariant device_values = json_buffer.createNestedArray(device_name).add();
+        Telemetry const t(key, value);
+        if (t.IsEmpty() || !t.SerializeKeyValue(device_values)) {
+            Logger::printfln(UNABLE_TO_SERIALIZE);
+            return false;
+        }
+        return m_send_json_callback.Call_Callback(GATEWAY_TELEMETRY_TOPIC, json_buffer, Helper::Measure_Json(json_buffer));
+    }
+
+    /// @brief Attempts to immediately send attribute data with the given key and value of the given type for the device with the given name.
+    /// See https://thingsboard.io/docs/reference/gateway-mqtt-api/#attributes-api for more information
+    /// @tparam T Type of the passed value
+    /// @param device_name Name of the previously connected device the data belongs to
+    /// @param key Key of the key value pair we want to send
+    /// @param value Value of the key value pair we want to send
+    /// @return Whether sending the data was successful or not
+    template<typename T>
+    bool Send_Attribute_Data(char const * device_name, char const * key, T const & value) {
+        if (Find_Device(device_name) == nullptr) {
+            Logger::printfln(GATEWAY_DEVICE_NOT_CONNECTED, device_name);
+            return false;
+        }
+        StaticJsonDocument<2 * JSON_OBJECT_SIZE(1)> json_buffer;
+        // Serializing into the member proxy automatically creates the nested json object the key value pair of the given device is placed into
+        auto device_values = json_buffer[device_name];
+        Telemetry const t(key, value);
+        if (t.IsEmpty() || !t.SerializeKeyValue(device_values)) {
+            Logger::printfln(UNABLE_TO_SERIALIZE);
+            return false;
+        }
+        return m_send_json_callback.Call_Callback(GATEWAY_ATTRIBUTE_TOPIC, json_buffer, Helper::Measure_Json(json_buffer));
+    }
+
+    /// @brief Queues telemetry data with the given key and value of the given type for the device with the given name,
+    /// to be sent as one combined message with the queued data points of all other connected devices on the next flush.
+    /// Hugely reduces the amount of sent messages for gateways with many attached devices, because one publish message per flush
+    /// carries the data of every device instead of every single data point paying the complete topic, MQTT header and json envelope overhead.
+    /// Be aware that queueing the same key twice for the same device before a flush occured, results in the previously queued value being overwritten on the cloud side,
+    /// because both values are serialized into the same json object. If multiple values of the same key should arrive ensure to call Flush_Telemetry() in between
+    /// @tparam T Type of the passed value
+    /// @param device_name Name of the previously connected device the data belongs to
+    /// @param key Key of the key value pair we want to queue, requires to stay allocated until the queue has been flushed
+    /// @param value Value of the key value pair we want to queue
+    /// @return Whether queueing (or if a flush was caused, sending) the data was successful or not
+    template<typename T>
+    bool Queue_Telemetry_Data(char const * device_name, char const * key, T const & value) {
+        Device_Entry * device = Find_Device(device_name);
+        if (device == nullptr) {
+            Logger::printfln(GATEWAY_DEVICE_NOT_CONNECTED, device_name);
+            return false;
+        }
+        Telemetry const t(key, value);
+        if (t.IsEmpty()) {
+            return false;
+        }
+#if !THINGSBOARD_ENABLE_DYNAMIC
+        // Queue of the given device is full, flush the already queued data points of all devices to make space for the new one instead of discarding it
+        if (device->telemetry_queue.size() + 1 > device->telemetry_queue.capacity()) {
+            (void)Flush_Telemetry();
+            // Flushing rebuilds nothing but the queues themselves, the device entry stays valid because the device list is not changed by a flush
+        }
+#endif // !THINGSBOARD_ENABLE_DYNAMIC
+        device->telemetry_queue.push_back(t);
+        return true;
+    }
+
+    /// @brief Immediately sends the currently queued telemetry data points of all connected devices as one combined publish message and clears the queues.
+    /// Is called automatically once the per-device queue of any connected device is full
+    /// @return Whether sending the queued telemetry data was successful or not, if all queues were empty there is nothing to do and we return true
+    bool Flush_Telemetry() {
+        size_t devices_with_data = 0U;
+        size_t queued_data_points = 0U;
+        for (auto const & device : m_devices) {
+            if (device.telemetry_queue.empty()) {
+                continue;
+            }
+            devices_with_data++;
+            queued_data_points += device.telemetry_queue.size();
+        }
+        if (devices_with_data == 0U) {
+            return true;
+        }
+#if THINGSBOARD_ENABLE_DYNAMIC
+        TBJsonDocument json_buffer(JSON_OBJECT_SIZE(devices_with_data) + (devices_with_data * JSON_ARRAY_SIZE(1)) + JSON_OBJECT_SIZE(queued_data_points));
+#else
+        StaticJsonDocument<JSON_OBJECT_SIZE(MaxDevicesAmount) + (MaxDevicesAmount * (JSON_ARRAY_SIZE(1) + JSON_OBJECT_SIZE(MaxQueuedTelemetryAmount)))> json_buffer;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+        for (auto & device : m_devices) {
+            if (device.telemetry_queue.empty()) {
+                continue;
+            }
+            JsonVariant device_values = json_buffer.createNestedArray(device.name).add();
+            for (auto const & data : device.telemetry_queue) {
+                if (!data.SerializeKeyValue(device_values)) {
+                    Logger::printfln(UNABLE_TO_SERIALIZE);
+                }
+            }
+            device.telemetry_queue.clear();
+        }
+        return m_send_json_callback.Call_Callback(GATEWAY_TELEMETRY_TOPIC, json_buffer, Helper::Measure_Json(json_buffer));
+    }
+
+    /// @brief Subscribes the given callback, that will be called if a shared attribute update for any of the connected devices is received.
+    /// Can be called even if we are currently not connected to the cloud,
+    /// this is the case because the only interaction that requires an active connection is the subscription of the topic that we receive the update on
+    /// and that subscription is also done automatically by the library once the gateway has established a connection to the cloud.
+    /// See https://thingsboard.io/docs/reference/gateway-mqtt-api/#attributes-api for more information
+    /// @param callback Callback method that will be called with the name of the device the update is meant for and the updated key value pairs
+    /// @return Whether subscribing the given callback was successful or not
+    bool Gateway_Attributes_Subscribe(Gateway_Attribute_Update_Callback const & callback) {
+        m_attribute_update_callback = callback;
+        m_attributes_subscribed = true;
+        return m_subscribe_topic_callback.Call_Callback(GATEWAY_ATTRIBUTE_TOPIC);
+    }
+
+    /// @brief Unsubcribes the previously subscribed gateway attribute update callback.
+    /// See https://thingsboard.io/docs/reference/gateway-mqtt-api/#attributes-api for more information
+    /// @return Whether unsubcribing the previously subscribed callback
+    /// and from the gateway attribute topic, was successful or not
+    bool Gateway_Attributes_Unsubscribe() {
+        m_attribute_update_callback = Gateway_Attribute_Update_Callback();
+        m_attributes_subscribed = false;
+        return m_unsubscribe_topic_callback.Call_Callback(GATEWAY_ATTRIBUTE_TOPIC);
+    }
+
+    API_Process_Type Get_Process_Type() const override {
+        return API_Process_Type::JSON;
+    }
+
+    void Process_Response(char const * topic, uint8_t * payload, unsigned int length) override {
+        // Nothing to do
+    }
+
+    void Process_Json_Response(char const * topic, JsonDocument const & data) override {
+        char const * device_name = data[GATEWAY_DEVICE_KEY];
+        if (Helper::stringIsNullorEmpty(device_name)) {
+#if THINGSBOARD_ENABLE_DEBUG
+            Logger::printfln(GATEWAY_DEVICE_NAME_NULL);
+#endif // THINGSBOARD_ENABLE_DEBUG
+            return;
+        }
+        m_attribute_update_callback.Call_Callback(device_name, data[GATEWAY_DATA_KEY].template as<JsonObjectConst>());
+    }
+
+    bool Compare_Response_Topic(char const * topic) const override {
+        return strncmp(GATEWAY_ATTRIBUTE_TOPIC, topic, strlen(GATEWAY_ATTRIBUTE_TOPIC)) == 0;
+    }
+
+    char const * Get_Response_Topic_Prefix() const override {
+        return GATEWAY_ATTRIBUTE_TOPIC;
+    }
+
+    bool Unsubscribe() override {
+        m_devices.clear();
+        return Gateway_Attributes_Unsubscribe();
+    }
+
+    bool Resubscribe_Topic() override {
+        // Re-announce all connected devices, required because the cloud forgets which devices a gateway represents once the connection is lost
+        for (auto const & device : m_devices) {
+            (void)Send_Device_Message(GATEWAY_CONNECT_TOPIC, device.name);
+        }
+        if (m_attributes_subscribed && !m_subscribe_topic_callback.Call_Callback(GATEWAY_ATTRIBUTE_TOPIC)) {
+            Logger::printfln(SUBSCRIBE_TOPIC_FAILED, GATEWAY_ATTRIBUTE_TOPIC);
+            return false;
+        }
+        return true;
+    }
+
+#if !THINGSBOARD_USE_ESP_TIMER
+    void loop() override {
+        // Nothing to do
+    }
+#endif // !THINGSBOARD_USE_ESP_TIMER
+
+    void Initialize() override {
+        // Nothing to do
+    }
+
+    void Set_Client_Callbacks(Delegate<void, IAPI_Implementation &> subscribe_api_callback, Delegate<bool, char const * const, JsonDocument const &, size_t const &> send_json_callback, Delegate<bool, char const * const, char const * const> send_json_string_callback, Delegate<bool, char const * const> subscribe_topic_callback, Delegate<bool, char const * const> unsubscribe_topic_callback, Delegate<uint16_t> get_receive_size_callback, Delegate<uint16_t> get_send_size_callback, Delegate<bool, uint16_t, uint16_t> set_buffer_size_callback, Delegate<size_t *> get_request_id_callback) override {
+        m_send_json_callback.Set_Callback(send_json_callback);
+        m_subscribe_topic_callback.Set_Callback(subscribe_topic_callback);
+        m_unsubscribe_topic_callback.Set_Callback(unsubscribe_topic_callback);
+    }
+
+  private:
+    /// @brief One device connected to the gateway, connecting its name with the telemetry data points
+    /// that have been queued for it and not been flushed yet
+    struct Device_Entry {
+        char const * name = {};                                  // Name of the connected device, points to the string the device was connected with
+#if THINGSBOARD_ENABLE_DYNAMIC
+        Vector<Telemetry> telemetry_queue = {};                  // Queued telemetry data points of this device that will be coalesced into the next combined publish message
+#else
+        Array<Telemetry, MaxQueuedTelemetryAmount> telemetry_queue = {}; // Queued telemetry data points of this device that will be coalesced into the next combined publish message
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    };
+
+    /// @brief Finds the device entry of the device with the given name in the currently connected devices
+    /// @param device_name Name of the device we want to find
+    /// @return Device entry of the device with the given name or nullptr if no device with that name is connected
+    Device_Entry * Find_Device(char const * device_name) {
+        if (Helper::stringIsNullorEmpty(device_name)) {
+            return nullptr;
+        }
+        for (auto & device : m_devices) {
+            if (strcmp(device.name, device_name) == 0) {
+                return &device;
+            }
+        }
+        return nullptr;
+    }
+
+    /// @brief Sends a message containing only the name of the given device over the given topic,
+    /// used to announce connected devices to the cloud and to announce their disconnect again
+    /// @param topic Topic we want to send the device name over
+    /// @param device_name Name of the device the message is about
+    /// @return Whether sending the message was successful or not
+    bool Send_Device_Message(char const * topic, char const * device_name) {
+        StaticJsonDocument<JSON_OBJECT_SIZE(1)> json_buffer;
+        json_buffer[GATEWAY_DEVICE_KEY] = device_name;
+        return m_send_json_callback.Call_Callback(topic, json_buffer, Helper::Measure_Json(json_buffer));
+    }
+
+    Delegate<bool, char const * const, JsonDocument const &, size_t const &> m_send_json_callback = {};         // Send json document callback
+    Delegate<bool, char const * const>                                       m_subscribe_topic_callback = {};   // Subscribe mqtt topic client callback
+    Delegate<bool, char const * const>                                       m_unsubscribe_topic_callback = {}; // Unubscribe mqtt topic client callback
+
+    Gateway_Attribute_Update_Callback                                        m_attribute_update_callback = {};  // Callback called with received shared attribute updates for connected devices
+    bool                                                                     m_attributes_subscribed = {};      // Whether the gateway attribute topic should be subscribed on the cloud, kept to resubscribe it on reconnect
+#if THINGSBOARD_ENABLE_DYNAMIC
+    Vector<Device_Entry>                                                     m_devices = {};                    // Devices currently connected to the gateway with their queued telemetry
+#else
+    Array<Device_Entry, MaxDevicesAmount>                                    m_devices = {};                    // Devices currently connected to the gateway with their queued telemetry
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+};
+
+#endif // Gateway_h
@@ -0,0 +1,165 @@
+// Header include.
+#include "Gzip_Decompressor.h"
+
+#if THINGSBOARD_USE_ROM_MINIZ
+
+// Magic bytes and compression method every gzip header starts with, see https://datatracker.ietf.org/doc/html/rfc1952 for the complete header layout
+constexpr size_t FIXED_HEADER_SIZE = 10U;
+constexpr uint8_t GZIP_MAGIC_FIRST = 0x1FU;
+constexpr uint8_t GZIP_MAGIC_SECOND = 0x8BU;
+constexpr uint8_t GZIP_METHOD_DEFLATE = 8U;
+// Positions of the bytes in the fixed portion of the header that have to be validated or remembered
+constexpr size_t HEADER_MAGIC_FIRST_INDEX = 0U;
+constexpr size_t HEADER_MAGIC_SECOND_INDEX = 1U;
+constexpr size_t HEADER_METHOD_INDEX = 2U;
+constexpr size_t HEADER_FLAGS_INDEX = 3U;
+// Bits of the flag byte that decide which optional header fields follow the fixed portion
+constexpr uint8_t FLAG_HEADER_CRC = 0x02U;
+constexpr uint8_t FLAG_EXTRA = 0x04U;
+constexpr uint8_t FLAG_NAME = 0x08U;
+constexpr uint8_t FLAG_COMMENT = 0x10U;
+
+Gzip_Decompressor::~Gzip_Decompressor() {
+    reset();
+}
+
+bool Gzip_Decompressor::begin(Delegate<bool, uint8_t *, size_t const &> output_callback) {
+    if (m_decompressor == nullptr) {
+        m_decompressor = new tinfl_decompressor;
+    }
+    if (m_dictionary == nullptr) {
+        m_dictionary = new uint8_t[TINFL_LZ_DICT_SIZE];
+    }
+    if (m_decompressor == nullptr || m_dictionary == nullptr) {
+        reset();
+        return false;
+    }
+    tinfl_init(m_decompressor);
+    m_output_callback = output_callback;
+    m_dictionary_offset = 0U;
+    m_header_state = Header_State::FIXED;
+    m_header_bytes = 0U;
+    m_header_flags = 0U;
+    m_extra_length = 0U;
+    m_stream_finished = false;
+    return true;
+}
+
+bool Gzip_Decompressor::update(uint8_t const * data, size_t const & length) {
+    if (m_decompressor == nullptr || m_dictionary == nullptr) {
+        return false;
+    }
+    uint8_t const * input = data;
+    size_t remaining = length;
+    if (m_header_state != Header_State::DONE && !consume_header(input, remaining)) {
+        return false;
+    }
+    while (remaining > 0U) {
+        // Bytes that follow the terminated deflate stream are the gzip footer (crc and size of the decompressed data),
+        // which is simply ignored, because the integrity of the decompressed data is verified by the caller instead
+        if (m_stream_finished) {
+            return true;
+        }
+        size_t input_bytes = remaining;
+        size_t output_bytes = TINFL_LZ_DICT_SIZE - m_dictionary_offset;
+        tinfl_status const status = tinfl_decompress(m_decompressor, input, &input_bytes, m_dictionary, m_dictionary + m_dictionary_offset, &output_bytes, TINFL_FLAG_HAS_MORE_INPUT);
+        input += input_bytes;
+        remaining -= input_bytes;
+        if (output_bytes != 0U) {
+            if (!m_output_callback.Call_Callback(m_dictionary + m_dictionary_offset, output_bytes)) {
+                return false;
+            }
+            // Dictionary window is circular, once it has been filled completly the decompressor continues at its beginning again,
+            // the previously produced data stays in the window so back references into it can still be resolved
+            m_dictionary_offset = (m_dictionary_offset + output_bytes) & (TINFL_LZ_DICT_SIZE - 1U);
+        }
+        if (status == TINFL_STATUS_DONE) {
+            m_stream_finished = true;
+        }
+        else if (status < TINFL_STATUS_DONE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Gzip_Decompressor::finish() const {
+    return m_stream_finished;
+}
+
+void Gzip_Decompressor::reset() {
+    delete m_decompressor;
+    m_decompressor = nullptr;
+    delete[] m_dictionary;
+    m_dictionary = nullptr;
+    m_stream_finished = false;
+}
+
+bool Gzip_Decompressor::consume_header(uint8_t const * & data, size_t & remaining) {
+    while (remaining > 0U && m_header_state != Header_State::DONE) {
+        uint8_t const byte = *data;
+        switch (m_header_state) {
+            case Header_State::FIXED:
+                if ((m_header_bytes == HEADER_MAGIC_FIRST_INDEX && byte != GZIP_MAGIC_FIRST) ||
+                    (m_header_bytes == HEADER_MAGIC_SECOND_INDEX && byte != GZIP_MAGIC_SECOND) ||
+                    (m_header_bytes == HEADER_METHOD_INDEX && byte != GZIP_METHOD_DEFLATE)) {
+                    return false;
+                }
+                if (m_header_bytes == HEADER_FLAGS_INDEX) {
+                    m_header_flags = byte;
+                }
+                if (++m_header_bytes >= FIXED_HEADER_SIZE) {
+                    m_header_state = (m_header_flags & FLAG_EXTRA) ? Header_State::EXTRA_LENGTH : Header_State::NAME;
+                    m_header_bytes = 0U;
+                }
+                break;
+            case Header_State::EXTRA_LENGTH:
+                // Length of the extra field is stored in little endian byte order
+                m_extra_length |= static_cast<uint16_t>(byte) << (m_header_bytes * 8U);
+                if (++m_header_bytes >= sizeof(uint16_t)) {
+                    m_header_state = (m_extra_length != 0U) ? Header_State::EXTRA : Header_State::NAME;
+                    m_header_bytes = 0U;
+                }
+                break;
+            case Header_State::EXTRA:
+                if (++m_header_bytes >= m_extra_length) {
+                    m_header_state = Header_State::NAME;
+                    m_header_bytes = 0U;
+                }
+                break;
+            case Header_State::NAME:
+                if (!(m_header_flags & FLAG_NAME) || byte == '\0') {
+                    m_header_state = Header_State::COMMENT;
+                }
+                // Field is not included at all, the current byte already belongs to the following field and must not be consumed
+                if (!(m_header_flags & FLAG_NAME)) {
+                    continue;
+                }
+                break;
+            case Header_State::COMMENT:
+                if (!(m_header_flags & FLAG_COMMENT) || byte == '\0') {
+                    m_header_state = Header_State::HEADER_CRC;
+                }
+                if (!(m_header_flags & FLAG_COMMENT)) {
+                    continue;
+                }
+                break;
+            case Header_State::HEADER_CRC:
+                if (!(m_header_flags & FLAG_HEADER_CRC)) {
+                    m_header_state = Header_State::DONE;
+                    continue;
+                }
+                if (++m_header_bytes >= sizeof(uint16_t)) {
+                    m_header_state = Header_State::DONE;
+                }
+                break;
+            default:
+                return false;
+        }
+        data++;
+        remaining--;
+    }
+    return true;
+}
+
+#endif // THINGSBOARD_USE_ROM_MINIZ
@@ -0,0 +1,92 @@
+#ifndef Gzip_Decompressor_h
+#define Gzip_Decompressor_h
+
+// Local include.
+#include "Configuration.h"
+
+#if THINGSBOARD_USE_ROM_MINIZ
+
+// Local include.
+#include "Callback.h"
+
+// Library includes.
+#if __has_include(<rom/miniz.h>)
+#include <rom/miniz.h>
+#else
+#include <esp32/rom/miniz.h>
+#endif // __has_include(<rom/miniz.h>)
+#include <stdint.h>
+#include <stddef.h>
+
+
+/// @brief Streams a gzip compressed byte payload through the miniz inflate implementation contained in the ROM of the ESP chips,
+/// producing the decompressed data block by block without ever holding the complete compressed or decompressed payload in memory.
+/// The class instance is meant to be started with begin() which allocates the decompressor state and the inflate dictionary window (~43 KB),
+/// the compressed payload is then fed in arbitrary sized pieces with update(), which forwards every produced decompressed block to the given callback,
+/// and once the complete payload has been fed finish() reports whether the compressed stream was terminated correctly.
+/// The gzip header is parsed and skipped internally and the gzip footer is ignored,
+/// because the integrity of the decompressed data is expected to be verified by the caller instead (hash over the decompressed stream)
+class Gzip_Decompressor {
+  public:
+    /// @brief Constructor
+    Gzip_Decompressor() = default;
+
+    /// @brief Destructor
+    ~Gzip_Decompressor();
+
+    /// @brief Starts the decompression of a new gzip compressed payload, allocates the decompressor state and the dictionary window if they do not exist yet,
+    /// can be called again at any point to restart the decompression from the beginning, previously allocated memory is then simply reused
+    /// @param output_callback Callback that is called with every produced decompressed block, the given data is only valid for the duration of the call.
+    /// If the callback returns false the decompression is considered failed and the update() call that produced the block fails as well
+    /// @return Whether allocating the internally needed memory was successful or not
+    bool begin(Delegate<bool, uint8_t *, size_t const &> output_callback);
+
+    /// @brief Feeds the next piece of the gzip compressed payload into the decompressor,
+    /// calls the callback given in begin() for every decompressed block that could be produced from the data fed so far
+    /// @param data Next piece of the gzip compressed payload, directly following the previously fed piece
+    /// @param length Amount of bytes in the given piece
+    /// @return Whether decompressing the given piece was successful or not
+    bool update(uint8_t const * data, size_t const & length);
+
+    /// @brief Returns whether the compressed stream was terminated correctly, called once the complete compressed payload has been fed with update().
+    /// If the stream was not terminated the compressed payload was truncated and the produced decompressed data is incomplete
+    /// @return Whether the compressed stream was terminated correctly or not
+    bool finish() const;
+
+    /// @brief Frees the decompressor state and the dictionary window, begin() has to be called again before the instance can be reused,
+    /// called once the decompressed data is not needed anymore to give the memory back as long as no decompression is running
+    void reset();
+
+  private:
+    /// @brief Possible states of parsing the gzip header, which has to be skipped before the contained deflate stream starts.
+    /// The optional fields are included depending on the flag byte of the fixed portion of the header
+    enum class Header_State : uint8_t {
+        FIXED,        ///< Fixed 10 byte portion of the header containing the magic bytes, the compression method and the flag byte
+        EXTRA_LENGTH, ///< Optional 2 byte length of the extra field
+        EXTRA,        ///< Optional extra field, skipped according to its previously parsed length
+        NAME,         ///< Optional null terminated original file name
+        COMMENT,      ///< Optional null terminated comment
+        HEADER_CRC,   ///< Optional 2 byte crc of the header
+        DONE          ///< Header has been skipped completly, all following bytes belong to the deflate stream
+    };
+
+    /// @brief Parses and skips the gzip header at the beginning of the fed payload, handles the header being split over multiple update() calls
+    /// @param data Data pointer that is advanced behind the consumed header bytes
+    /// @param remaining Amount of bytes that is decreased by the consumed header bytes
+    /// @return Whether the consumed bytes were a valid gzip header or not
+    bool consume_header(uint8_t const * & data, size_t & remaining);
+
+    Delegate<bool, uint8_t *, size_t const &> m_output_callback = {};     // Callback that every produced decompressed block is forwarded to
+    tinfl_decompressor                        *m_decompressor = {};       // Decompressor state of the miniz inflate implementation contained in the ROM
+    uint8_t                                   *m_dictionary = {};         // Dictionary window the decompressed data is produced into, required to resolve back references in the deflate stream
+    size_t                                    m_dictionary_offset = {};   // Current write offset into the dictionary window, wraps around once the window is full
+    Header_State                              m_header_state = {};        // Current state of parsing the gzip header
+    size_t                                    m_header_bytes = {};        // Amount of bytes that were already consumed in the current header state
+    uint8_t                                   m_header_flags = {};        // Flag byte of the fixed portion of the header, decides which optional fields follow
+    uint16_t                                  m_extra_length = {};        // Length of the optional extra field that has to be skipped
+    bool                                      m_stream_finished = {};     // Whether the deflate stream contained in the payload was terminated correctly
+};
+
+#endif // THINGSBOARD_USE_ROM_MINIZ
+
+#endif // Gzip_Decompressor_h
@@ -4,6 +4,16 @@
 // Library include.
 #include <stdio.h>
 
+#if THINGSBOARD_USE_ESP_HARDWARE_SHA && MBEDTLS_VERSION_MAJOR < 3
+// MBEDTLS Version 2 still suffixes the fallible sha functions with _ret, Version 3 removed the suffix together with the previously deprecated void returning versions
+#define mbedtls_sha256_starts(ctx, is224)        mbedtls_sha256_starts_ret(ctx, is224)
+#define mbedtls_sha256_update(ctx, data, length) mbedtls_sha256_update_ret(ctx, data, length)
+#define mbedtls_sha256_finish(ctx, output)       mbedtls_sha256_finish_ret(ctx, output)
+#define mbedtls_sha512_starts(ctx, is384)        mbedtls_sha512_starts_ret(ctx, is384)
+#define mbedtls_sha512_update(ctx, data, length) mbedtls_sha512_update_ret(ctx, data, length)
+#define mbedtls_sha512_finish(ctx, output)       mbedtls_sha512_finish_ret(ctx, output)
+#endif // THINGSBOARD_USE_ESP_HARDWARE_SHA && MBEDTLS_VERSION_MAJOR < 3
+
 HashGenerator::~HashGenerator(void) {
     free();
 }
@@ -12,6 +22,18 @@ bool HashGenerator::start(mbedtls_md_type_t const & type) {
     // Clear the internal structure of any previous attempt, because if we do not the init function will not work correctly
     free();
     m_size = mbedtls_type_to_size(type);
+#if THINGSBOARD_USE_ESP_HARDWARE_SHA
+    m_uses_hardware_sha = type_uses_hardware_sha(type);
+    if (m_uses_hardware_sha) {
+        m_uses_sha512_context = (type == mbedtls_md_type_t::MBEDTLS_MD_SHA384) || (type == mbedtls_md_type_t::MBEDTLS_MD_SHA512);
+        if (m_uses_sha512_context) {
+            mbedtls_sha512_init(&m_sha512_ctx);
+            return mbedtls_sha512_starts(&m_sha512_ctx, type == mbedtls_md_type_t::MBEDTLS_MD_SHA384) == 0;
+        }
+        mbedtls_sha256_init(&m_sha256_ctx);
+        return mbedtls_sha256_starts(&m_sha256_ctx, type == mbedtls_md_type_t::MBEDTLS_MD_SHA224) == 0;
+    }
+#endif // THINGSBOARD_USE_ESP_HARDWARE_SHA
     // Initialize the context
     mbedtls_md_init(&m_ctx);
     // Choose the hash function
@@ -22,12 +44,20 @@ bool HashGenerator::start(mbedtls_md_type_t const & type) {
 }
 
 bool HashGenerator::update(uint8_t const * data, size_t const & length) {
+#if THINGSBOARD_USE_ESP_HARDWARE_SHA
+    if (m_uses_hardware_sha) {
+        if (m_uses_sha512_context) {
+            return mbedtls_sha512_update(&m_sha512_ctx, data, length) == 0;
+        }
+        return mbedtls_sha256_update(&m_sha256_ctx, data, length) == 0;
+    }
+#endif // THINGSBOARD_USE_ESP_HARDWARE_SHA
     return mbedtls_md_update(&m_ctx, data, length) == 0;
 }
 
 bool HashGenerator::finish(char * hash_string) {
     unsigned char byte_hash[m_size] = {};
-    bool const success = mbedtls_md_finish(&m_ctx, byte_hash) == 0;
+    bool const success = finish_byte_hash(byte_hash);
     if (!success) {
         return success;
     }
@@ -38,7 +68,45 @@ bool HashGenerator::finish(char * hash_string) {
     return success;
 }
 
+bool HashGenerator::finish_byte_hash(unsigned char * byte_hash) {
+#if THINGSBOARD_USE_ESP_HARDWARE_SHA
+    if (m_uses_hardware_sha) {
+        if (m_uses_sha512_context) {
+            return mbedtls_sha512_finish(&m_sha512_ctx, byte_hash) == 0;
+        }
+        return mbedtls_sha256_finish(&m_sha256_ctx, byte_hash) == 0;
+    }
+#endif // THINGSBOARD_USE_ESP_HARDWARE_SHA
+    return mbedtls_md_finish(&m_ctx, byte_hash) == 0;
+}
+
+#if THINGSBOARD_USE_ESP_HARDWARE_SHA
+bool HashGenerator::type_uses_hardware_sha(mbedtls_md_type_t const & type) {
+    switch (type) {
+        case mbedtls_md_type_t::MBEDTLS_MD_SHA224: // Fallthrough same behaviour
+        case mbedtls_md_type_t::MBEDTLS_MD_SHA256:
+        case mbedtls_md_type_t::MBEDTLS_MD_SHA384:
+        case mbedtls_md_type_t::MBEDTLS_MD_SHA512:
+            return true;
+        default:
+            return false;
+    }
+}
+#endif // THINGSBOARD_USE_ESP_HARDWARE_SHA
+
 void HashGenerator::free() {
+#if THINGSBOARD_USE_ESP_HARDWARE_SHA
+    if (m_uses_hardware_sha) {
+        if (m_uses_sha512_context) {
+            mbedtls_sha512_free(&m_sha512_ctx);
+        }
+        else {
+            mbedtls_sha256_free(&m_sha256_ctx);
+        }
+        m_uses_hardware_sha = false;
+        return;
+    }
+#endif // THINGSBOARD_USE_ESP_HARDWARE_SHA
     // MBEDTLS Version 3 is a major breaking changes were accessing the internal structures requires the MBEDTLS_PRIVATE macro
 #if MBEDTLS_VERSION_MAJOR < 3
     if (m_ctx.hmac_ctx != nullptr && m_ctx.md_ctx != nullptr && m_ctx.md_info != nullptr) {
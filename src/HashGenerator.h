@@ -10,6 +10,10 @@
 #else
 #include <Seeed_mbedtls.h>
 #endif // THINGSBOARD_USE_MBED_TLS
+#if THINGSBOARD_USE_ESP_HARDWARE_SHA
+#include <mbedtls/sha256.h>
+#include <mbedtls/sha512.h>
+#endif // THINGSBOARD_USE_ESP_HARDWARE_SHA
 #include <stdint.h>
 #include <stddef.h>
 
@@ -19,6 +23,8 @@
 /// This is done because it removes the need to include another library, because the component already exists on the system and we can therefore simply utilize that one.
 /// The ESP Mbed TLS implementationt works with both Espressif IDF v4.X and v5.X, meaning it is version idependent, this is the case
 /// because depending on the used version the implementation automatically adjusts to still initalize correctly.
+/// If THINGSBOARD_USE_ESP_HARDWARE_SHA is enabled the hashes of the SHA family are calculated with the dedicated sha contexts instead of the generic message digest layer,
+/// because those are replaced with alt implementations that use the SHA peripheral of the device, leaving the CPU free for the concurrent flash writes during an OTA update.
 /// The class instance is meant to be started with start() which will then create the configuration for a hash of the given type
 /// and we then expect the complete binary payload to be called in multiple calls to update() and the final result to be read with get_hash_string()
 /// Documentation about the specific use and caviates of the ESP Mbedt TLS implementation can be found here https://docs.espressif.com/projects/esp-idf/en/latest/esp32/api-reference/protocols/mbedtls.html
@@ -55,6 +61,19 @@ class HashGenerator {
     /// before freeing, because freeing without having started a hash calculation causes a crash.
     void free();
 
+    /// @brief Calculates the final hash bytes with whichever context the hash calculation was started with
+    /// @param byte_hash Output buffer that the final hash bytes will be written into, needs to be big enough to hold the amount of bytes the started hash type produces
+    /// @return Whether calculating the final hash bytes was successful or not
+    bool finish_byte_hash(unsigned char * byte_hash);
+
+#if THINGSBOARD_USE_ESP_HARDWARE_SHA
+    /// @brief Returns whether the given hash type can be calculated with one of the dedicated sha contexts on the SHA peripheral,
+    /// every other type falls back to the generic message digest layer instead
+    /// @param type Supported type of hash that should be generated from this class
+    /// @return Whether the given hash type is calculated with a dedicated sha context or not
+    static bool type_uses_hardware_sha(mbedtls_md_type_t const & type);
+#endif // THINGSBOARD_USE_ESP_HARDWARE_SHA
+
     /// @brief Calculates the amount of bytes needed for the hash output.
     /// Is used because we if we don't calculate the exact amount needed the final hash string representation, will always be filled up with hex 00 to the maximum size of the hash string representation being 129 bytes.
     /// Which results in hash string representation with a lot of additional 00 at the end, which might make the further processing of those strings fail
@@ -64,6 +83,12 @@ class HashGenerator {
 
     size_t               m_size = {}; // Actual size in bytes, depend on the mbedtls_md_type_t given in the start method
     mbedtls_md_context_t m_ctx = {};  // Context used to access the already written bytes and update them latter
+#if THINGSBOARD_USE_ESP_HARDWARE_SHA
+    bool                   m_uses_hardware_sha = {};   // Whether the started hash is calculated with a dedicated sha context on the SHA peripheral instead of the generic message digest layer
+    bool                   m_uses_sha512_context = {}; // Whether the started hash uses the sha512 context (SHA384 and SHA512) or the sha256 context (SHA224 and SHA256)
+    mbedtls_sha256_context m_sha256_ctx = {};          // Context used to calculate SHA224 and SHA256 hashes on the SHA peripheral
+    mbedtls_sha512_context m_sha512_ctx = {};          // Context used to calculate SHA384 and SHA512 hashes on the SHA peripheral
+#endif // THINGSBOARD_USE_ESP_HARDWARE_SHA
 };
 
 #endif // Hash_Generator_h
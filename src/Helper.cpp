@@ -6,20 +6,117 @@
 
 // Library includes.
 #include <string.h>
+#include <stdint.h>
+#if THINGSBOARD_USE_ESP_TIMER
+#include <esp_timer.h>
+#else
+#include <Arduino.h>
+#endif // THINGSBOARD_USE_ESP_TIMER
 
-size_t Helper::getOccurences(uint8_t const * bytes, char symbol, unsigned int length) {
+/// @brief Repeats the given symbol into every byte of a word, allowing the word-at-a-time comparisons below
+/// @param symbol Symbol that should be broadcasted into every byte of the word
+/// @return Word containing the given symbol in every byte
+static uint32_t broadcastSymbol(uint8_t symbol) {
+    return static_cast<uint32_t>(symbol) * 0x01010101UL;
+}
+
+/// @brief Returns a word with the highest bit of every byte set that matched the broadcasted symbol.
+/// Uses the exact SWAR zero-byte detection from Hacker's Delight, which can not produce false positives from borrows between bytes,
+/// required because the set bits are counted afterwards and a false positive would overestimate the amount of occurences
+/// @param word Word containing the next chunk of the scanned payload
+/// @param broadcasted_symbol Word containing the searched symbol in every byte
+/// @return Word with the highest bit of every matching byte set and every other bit cleared
+static uint32_t matchSymbol(uint32_t word, uint32_t broadcasted_symbol) {
+    uint32_t const difference = word ^ broadcasted_symbol;
+    uint32_t const overflow = (difference & 0x7F7F7F7FUL) + 0x7F7F7F7FUL;
+    return ~(overflow | difference | 0x7F7F7F7FUL);
+}
+
+/// @brief Counts how often any of the three given symbols occurs in the given byte payload in one single pass.
+/// Scans word-at-a-time once the payload pointer is aligned, comparing all bytes of a word against all three symbols simultaneously,
+/// which processes four bytes per iteration instead of one on the 32-bit targets this library runs on
+/// @param bytes Byte payload that we want to check the symbols for
+/// @param length Length of the byte payload
+/// @param first_symbol First symbol we want to search for
+/// @param second_symbol Second symbol we want to search for, can be the same as the first to search for fewer distinct symbols
+/// @param third_symbol Third symbol we want to search for, can be the same as the first to search for fewer distinct symbols
+/// @return Amount of bytes that matched any of the given symbols
+static size_t countSymbolOccurences(uint8_t const * bytes, unsigned int length, uint8_t first_symbol, uint8_t second_symbol, uint8_t third_symbol) {
     size_t count = 0;
-    if (bytes == nullptr) {
-        return count;
+    uint8_t const * current = bytes;
+    unsigned int remaining = length;
+    // Process the unaligned head of the payload byte by byte, so the word sized loads below are always aligned
+    while (remaining > 0U && (reinterpret_cast<uintptr_t>(current) & (sizeof(uint32_t) - 1U)) != 0U) {
+        count += (*current == first_symbol) || (*current == second_symbol) || (*current == third_symbol);
+        current++;
+        remaining--;
+    }
+    uint32_t const first_broadcast = broadcastSymbol(first_symbol);
+    uint32_t const second_broadcast = broadcastSymbol(second_symbol);
+    uint32_t const third_broadcast = broadcastSymbol(third_symbol);
+    while (remaining >= sizeof(uint32_t)) {
+        uint32_t word = 0;
+        memcpy(&word, current, sizeof(word));
+        // Matches of the distinct symbols can never share a byte, meaning the match words can be combined and counted together
+        uint32_t const matches = matchSymbol(word, first_broadcast) | matchSymbol(word, second_broadcast) | matchSymbol(word, third_broadcast);
+        count += __builtin_popcount(matches);
+        current += sizeof(uint32_t);
+        remaining -= sizeof(uint32_t);
     }
-    for (size_t i = 0; i < length; ++i) {
-        if (bytes[i] == symbol) {
-            count++;
-        }
+    // Process the remaining tail of the payload that did not fill a complete word anymore
+    while (remaining > 0U) {
+        count += (*current == first_symbol) || (*current == second_symbol) || (*current == third_symbol);
+        current++;
+        remaining--;
     }
     return count;
 }
 
+size_t Helper::getOccurences(uint8_t const * bytes, char symbol, unsigned int length) {
+    if (bytes == nullptr) {
+        return 0U;
+    }
+    uint8_t const symbol_byte = static_cast<uint8_t>(symbol);
+    return countSymbolOccurences(bytes, length, symbol_byte, symbol_byte, symbol_byte);
+}
+
+size_t Helper::getJsonDelimiterOccurences(uint8_t const * bytes, unsigned int length) {
+    if (bytes == nullptr) {
+        return 0U;
+    }
+    return countSymbolOccurences(bytes, length, static_cast<uint8_t>(','), static_cast<uint8_t>('{'), static_cast<uint8_t>('['));
+}
+
+size_t Helper::writeUnsignedInteger(char * buffer, size_t value) {
+    size_t digits = 1U;
+    for (size_t remainder = value; remainder >= 10U; remainder /= 10U) {
+        digits++;
+    }
+    buffer[digits] = '\0';
+    for (size_t index = digits; index-- > 0U;) {
+        buffer[index] = '0' + (value % 10U);
+        value /= 10U;
+    }
+    return digits;
+}
+
+uint64_t Helper::getUptimeMilliseconds() {
+#if THINGSBOARD_USE_ESP_TIMER
+    return static_cast<uint64_t>(esp_timer_get_time() / 1000);
+#else
+    return millis();
+#endif // THINGSBOARD_USE_ESP_TIMER
+}
+
+uint32_t Helper::hashString(char const * str) {
+    uint32_t hash = 2166136261UL;
+    for (; *str != '\0'; str++) {
+        hash ^= static_cast<uint8_t>(*str);
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
 bool Helper::stringIsNullorEmpty(char const * str) {
     return str == nullptr || str[0] == '\0';
 }
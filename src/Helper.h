@@ -3,6 +3,7 @@
 
 // Local includes.
 #include "Configuration.h"
+#include "Profiler.h"
 
 // Library include.
 #include <ArduinoJson.h>
@@ -40,6 +41,66 @@ class Helper {
     /// @return Amount of occurences of the given symbol
     static size_t getOccurences(uint8_t const * bytes, char symbol, unsigned int length);
 
+    /// @brief Counts how often any of the json delimiter symbols (',', '{' and '[') occurs in the given byte payload in one single pass.
+    /// Used to estimate the amount of key-value pairs a received json payload contains before it is deserialized,
+    /// scans the payload word-at-a-time instead of byte by byte and only traverses it once instead of once per symbol
+    /// @param bytes Byte payload that we want to check the symbols for
+    /// @param length Length of the byte payload, meaning if we reach the given length and have not found any occurence of the symbols we return 0.
+    /// Ensure to never pass a length that is longer than the actualy payload, because this will cause this method to read outside of the bounds of the buffer
+    /// @return Amount of occurences of the json delimiter symbols
+    static size_t getJsonDelimiterOccurences(uint8_t const * bytes, unsigned int length);
+
+    /// @brief Maximum amount of characters the decimal representation of an unsigned integer can require,
+    /// used to size topic buffers that have the request id appended behind their constant prefix
+    static size_t constexpr Max_Unsigned_Integer_Digits = 20U;
+
+    /// @brief Writes the decimal representation of the given unsigned value into the given buffer including the null terminator.
+    /// Replaces snprintf on the request hot path, because formatting a single unsigned integer does not require the whole printf machinery
+    /// @param buffer Buffer the decimal representation is written into,
+    /// requires enough space for all digits and the null terminator (Max_Unsigned_Integer_Digits + 1 bytes at most)
+    /// @param value Unsigned value whose decimal representation should be written
+    /// @return Amount of characters that were written, not including the null terminator
+    static size_t writeUnsignedInteger(char * buffer, size_t value);
+
+    /// @brief Gets the amount of milliseconds that have passed since the device was started.
+    /// Used to evaluate configured time based rules (telemetry suppression intervals, attribute cache time to live),
+    /// uses the ESP Timer if it exists and the Arduino millis() method as a fallback, the same way the timeout timers do
+    /// @return Amount of milliseconds since boot
+    static uint64_t getUptimeMilliseconds();
+
+    /// @brief Calculates the 32-bit FNV-1a hash of the given null terminated string.
+    /// Used to presort dispatch tables by key, which allows finding an entry with a binary search over the hashes
+    /// and a single final string comparison, instead of string comparing every entry.
+    /// See http://www.isthe.com/chongo/tech/comp/fnv/ for more information on the algorithm
+    /// @param str String the hash should be calculated for, requires a null terminated string
+    /// @return Hash of the given string
+    static uint32_t hashString(char const * str);
+
+    /// @brief Amount of bits of an encoded request id that hold the slot index of the in-flight request,
+    /// the remaining upper bits hold the generation counter that makes every request id unique.
+    /// Bounds the amount of simultaneously in-flight requests per API to Max_Request_Slots
+    static size_t constexpr Request_Slot_Bits = 8U;
+
+    /// @brief Maximum amount of simultaneously in-flight requests per API that the request id encoding can address
+    static size_t constexpr Max_Request_Slots = static_cast<size_t>(1U) << Request_Slot_Bits;
+
+    /// @brief Encodes the slot index of an in-flight request into the request id sent to the server.
+    /// Because the server echoes the request id in its response topic, the slot the request is stored in
+    /// can be recovered from the response directly, making response matching O(1) instead of scanning all in-flight requests
+    /// @param generation Monotonically increasing counter that makes every request id unique, even once a slot is reused
+    /// @param slot Index of the slot the in-flight request is stored in
+    /// @return Request id containing both the generation and the slot index
+    static size_t constexpr encodeRequestId(size_t const & generation, size_t const & slot) {
+        return (generation << Request_Slot_Bits) | slot;
+    }
+
+    /// @brief Decodes the slot index of the in-flight request a response belongs to from the received request id
+    /// @param request_id Request id that was parsed from the received response topic
+    /// @return Index of the slot the in-flight request is stored in
+    static size_t constexpr decodeRequestSlot(size_t const & request_id) {
+        return request_id & (Max_Request_Slots - 1U);
+    }
+
     /// @brief Returns wheter the given string is either a nullptr or is an empty string,
     /// meaning it only contains a null terminator and no other characters
     /// @param str String that we want to check for emptiness
@@ -57,13 +118,23 @@ class Helper {
     /// @brief Calculates the total size of the string the serializeJson method would produce including the null end terminator.
     /// Be aware that null terminator will later not be serialied in the serializeJson() call,
     /// meaning the returned written amount of bytes is the return value of this method - 1.
+    /// If THINGSBOARD_ENABLE_MSGPACK is enabled the size of the binary payload the serializeMsgPack method would produce is returned instead,
+    /// which does not include any null terminator, because MessagePack is a binary format that is not null terminated.
     /// See https://arduinojson.org/v6/api/json/measurejson/ for more information on the underlying method used
     /// @tparam TSource Source class that should be used to serialize the json that is sent to the server
     /// @param source Data source containing our json key value pairs we want to measure
-    /// @return Total size required for the string that would be produced by serializeJson + 1 byte for the string null terminator
+    /// @return Total size required for the string that would be produced by serializeJson + 1 byte for the string null terminator,
+    /// or the exact binary size produced by serializeMsgPack if THINGSBOARD_ENABLE_MSGPACK is enabled
     template <typename TSource>
     static size_t Measure_Json(TSource const & source) {
+#if THINGSBOARD_ENABLE_PROFILING
+        Profile_Probe const probe(Profile_Stage::SEND_MEASURE);
+#endif // THINGSBOARD_ENABLE_PROFILING
+#if THINGSBOARD_ENABLE_MSGPACK
+        return measureMsgPack(source);
+#else
         return measureJson(source) + 1;
+#endif // THINGSBOARD_ENABLE_MSGPACK
     }
 
     /// @brief Removes the element with the given index, which allows to use data containers that do not have a random-access iterator.
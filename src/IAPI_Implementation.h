@@ -20,6 +20,9 @@
 char constexpr MAX_SUBSCRIPTIONS_EXCEEDED[] = "Too many (%s) subscriptions, increase (%s) or unsubscribe";
 #endif // !THINGSBOARD_ENABLE_DYNAMIC
 char constexpr MAX_SUBSCRIPTIONS_TEMPLATE_NAME[] = "MaxSubscriptions";
+#if THINGSBOARD_ENABLE_DYNAMIC
+char constexpr MAX_INFLIGHT_REQUESTS_EXCEEDED[] = "Too many (%u) simultaneous in-flight requests, wait for responses before requesting more";
+#endif // THINGSBOARD_ENABLE_DYNAMIC
 char constexpr SUBSCRIBE_TOPIC_FAILED[] = "Subscribing the given topic (%s) failed";
 char constexpr REQUEST_ID_NULL[] = "Internal request id is NULL";
 // RPC data keys.
@@ -49,6 +52,19 @@ class IAPI_Implementation {
     /// @param length Total length of the received payload
     virtual void Process_Response(char const * topic, uint8_t * payload, unsigned int length) = 0;
 
+    /// @brief Process callback that will be called for every received fragment of a response, that did not fit into the receive buffer of the underlying client at once.
+    /// Only ever called for api implementations that process their response as raw binary data, because json responses can only be deserialized once the complete payload has been received.
+    /// Does nothing per default, api implementations whose responses can be consumed incrementally (OTA Firmware Update) override this method,
+    /// which allows the receive buffer of the underlying client to be multiple times smaller than the biggest expected response
+    /// @param topic Previously subscribed topic, we got the response over
+    /// @param payload Fragment of the payload that was sent over the cloud and received over the given topic
+    /// @param length Amount of bytes in the received fragment
+    /// @param current_offset Offset of the fragment inside the complete payload
+    /// @param total_length Total length of the complete payload the fragment belongs to
+    virtual void Process_Response_Fragment(char const * topic, uint8_t * payload, unsigned int length, size_t const & current_offset, size_t const & total_length) {
+        // Nothing to do
+    }
+
     /// @brief Process callback that will be called upon response arrival
     /// and is responsible for handling the alredy serialized payload and calling the appropriate previously subscribed callbacks
     /// @param topic Previously subscribed topic, we got the response over
@@ -63,6 +79,29 @@ class IAPI_Implementation {
     /// @return Whether the received response topic matches the topic this api implementation handles responses on
     virtual bool Compare_Response_Topic(char const * topic) const = 0;
 
+    /// @brief Returns the constant topic prefix this api implementation handles responses on,
+    /// used by the client to build a sorted dispatch table once at subscribe time, which allows routing received messages
+    /// with a binary search over the table instead of comparing the topic against every subscribed api implementation.
+    /// The returned pointer has to stay constant and allocated for the whole lifetime of this api implementation,
+    /// a matching entry found in the dispatch table is always confirmed with Compare_Response_Topic() before it is processed,
+    /// meaning the prefix may be shorter than the actually compared topic (OTA Firmware Update includes the current request id in the comparison)
+    /// @return Topic prefix used to presort received messages or nullptr if the topic prefix is not constant,
+    /// which causes the client to fall back to comparing the received topic with Compare_Response_Topic() directly
+    virtual char const * Get_Response_Topic_Prefix() const {
+        return nullptr;
+    }
+
+    /// @brief Returns the deserialization filter the received payload should be filtered with, before this api implementation processes the response.
+    /// Filtering causes only the members that are actually subscribed to be materialized into the JsonDocument that is deserialized from the received payload,
+    /// all other members are skipped over, which drastically reduces the amount of memory the document requires for payloads that contain a lot of unsubscribed members.
+    /// See https://arduinojson.org/v6/api/json/deserializejson/ for more information on the deserialization filter.
+    /// Only applied if this api implementation is the only one that matched the received topic, because the filters of multiple endpoints can not be combined safely
+    /// @return Filter document containing the subscribed members flagged with true or nullptr if the payload should be deserialized unfiltered,
+    /// which has to be the case if at least one subscription does not restrict the members it wants to receive
+    virtual JsonDocument * Get_Response_Filter() {
+        return nullptr;
+    }
+
     /// @brief Unsubcribes all callbacks, to clear up any ongoing subscriptions and stop receiving information over the previously subscribed topic
     /// @return Whether unsubcribing all the previously subscribed callbacks
     /// and from the previously subscribed topic, was successful or not
@@ -98,7 +137,7 @@ class IAPI_Implementation {
     /// @param get_send_size_callback Method which allows to get the current underlying send size of the buffer, points to m_client.get_send_buffer_size per default
     /// @param set_buffer_size_callback Method which allows to set the current underlying size of the buffer, points to m_client.set_buffer_size per default
     /// @param get_request_id_callback Method which allows to get the current request id as a mutable reference, points to getRequestID per default
-    virtual void Set_Client_Callbacks(Callback<void, IAPI_Implementation &>::function subscribe_api_callback, Callback<bool, char const * const, JsonDocument const &, size_t const &>::function send_json_callback, Callback<bool, char const * const, char const * const>::function send_json_string_callback, Callback<bool, char const * const>::function subscribe_topic_callback, Callback<bool, char const * const>::function unsubscribe_topic_callback, Callback<uint16_t>::function get_receive_size_callback, Callback<uint16_t>::function get_send_size_callback, Callback<bool, uint16_t, uint16_t>::function set_buffer_size_callback, Callback<size_t *>::function get_request_id_callback) = 0;
+    virtual void Set_Client_Callbacks(Delegate<void, IAPI_Implementation &> subscribe_api_callback, Delegate<bool, char const * const, JsonDocument const &, size_t const &> send_json_callback, Delegate<bool, char const * const, char const * const> send_json_string_callback, Delegate<bool, char const * const> subscribe_topic_callback, Delegate<bool, char const * const> unsubscribe_topic_callback, Delegate<uint16_t> get_receive_size_callback, Delegate<uint16_t> get_send_size_callback, Delegate<bool, uint16_t, uint16_t> set_buffer_size_callback, Delegate<size_t *> get_request_id_callback) = 0;
 };
 
 #endif // IAPI_Implementation_h
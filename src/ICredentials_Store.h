@@ -0,0 +1,45 @@
+#ifndef ICredentials_Store_h
+#define ICredentials_Store_h
+
+// Library include.
+#include <stddef.h>
+
+
+// Maximum size of one credential field including the null terminator,
+// big enough to hold the credentials the ThingsBoard server issues with room to spare (issued access tokens are 20 characters)
+size_t constexpr CREDENTIALS_FIELD_SIZE = 64U;
+
+
+/// @brief Credentials issued by the provision API, layed out as fixed size character arrays,
+/// so the complete structure can be persisted and restored as one binary blob by the credentials store implementation.
+/// Fields that are not part of the issued credentials (client id and password for access token credentials) simply stay empty
+struct Provisioned_Credentials {
+    char access_token[CREDENTIALS_FIELD_SIZE]; // Issued access token, or the username if basic MQTT credentials were issued
+    char client_id[CREDENTIALS_FIELD_SIZE];    // Issued client id, only set if basic MQTT credentials were issued
+    char password[CREDENTIALS_FIELD_SIZE];     // Issued password, only set if basic MQTT credentials were issued
+};
+
+
+/// @brief Credentials store interface that contains the methods that a class that can be used to persist provisioned device credentials should implement.
+/// Is used as an optional cache stage for the provision API, credentials issued by a successful provision response are persisted through this interface
+/// and consumed directly by the connect() method of the ThingsBoard client on subsequent boots, skipping the complete provision exchange
+/// and therefore significantly reducing the wake-to-first-telemetry time of devices that sleep between transmissions.
+/// Where the credentials are persisted (flash, NVS or an SD card) is up to the specific implementation, similar to how the IUpdater interface abstracts where firmware data is written
+class ICredentials_Store {
+  public:
+    /// @brief Persists the given provisioned credentials, overwriting any previously persisted ones
+    /// @param credentials Credentials that should be persisted
+    /// @return Whether persisting the given credentials was successful or not
+    virtual bool store(Provisioned_Credentials const & credentials) = 0;
+
+    /// @brief Copies the previously persisted credentials into the given structure
+    /// @param credentials Output parameter the persisted credentials are copied into, stays untouched if no credentials are persisted
+    /// @return Whether previously persisted credentials existed and have been copied into the given structure or not
+    virtual bool retrieve(Provisioned_Credentials & credentials) = 0;
+
+    /// @brief Removes the currently persisted credentials, meaning the next boot has to perform the full provision exchange again.
+    /// Should be called if connecting with the persisted credentials fails, because the device might have been deleted on the cloud in the meantime
+    virtual void clear() = 0;
+};
+
+#endif // ICredentials_Store_h
@@ -10,6 +10,8 @@
 #else
 #include <WString.h>
 #endif // THINGSBOARD_ENABLE_STL
+#include <stddef.h>
+#include <stdint.h>
 
 
 /// @brief HTTP Client interface that contains the method that a class that can be used to send and receive data over an HTTP conection should implement.
@@ -45,6 +47,16 @@ class IHTTP_Client {
     /// @return Whether the request was successful or not, returns 0 if successful or if not the internal error code
     virtual int post(char const * url_path, char const * content_type, char const * request_body) = 0;
 
+    /// @brief Connects to the server and sends a POST request with a body of the given size and content type.
+    /// Overload of post() that receives the body with an explicit size instead of as a null terminated string,
+    /// allowing already measured payloads to be sent without the underlying client having to measure them again and without requiring a null terminator
+    /// @param url_path URL the POST request should be sent too
+    /// @param content_type Type of the content that is sent will be JSON data most of the time
+    /// @param request_body Request body containing data of the given content type
+    /// @param request_body_size Size of the request body in bytes
+    /// @return Whether the request was successful or not, returns 0 if successful or if not the internal error code
+    virtual int post(char const * url_path, char const * content_type, uint8_t const * request_body, size_t const & request_body_size) = 0;
+
     /// @brief Gets the HTTP status code contained in the server response.
     /// Should follow the HTTP standard, meaning 200 for a successful request or 404 for file not found,
     /// see https://developer.mozilla.org/en-US/docs/Web/HTTP/Status for more information on all standard status codes
@@ -65,6 +77,22 @@ class IHTTP_Client {
 #else
     virtual String get_response_body() = 0;
 #endif // THINGSBOARD_ENABLE_STL
+
+    /// @brief Returns the size of the response body of a previously sent message in bytes,
+    /// skips any response headers if they have not been read already,
+    /// should be called after calling get_response_status_code() and ensuring the request was successful
+    /// @return Size of the response body in bytes, or a negative value if the server did not report it
+    virtual int get_response_body_length() = 0;
+
+    /// @brief Reads a chunk of the response body of a previously sent message directly into the given caller allocated buffer,
+    /// skips any response headers if they have not been read already.
+    /// Alternative to get_response_body() that requires neither a heap allocation nor a copy of the complete response,
+    /// can be called repeatedly until it returns 0 to consume the complete response body,
+    /// should be called after calling get_response_status_code() and ensuring the request was successful
+    /// @param buffer Caller allocated buffer the read bytes are written into
+    /// @param buffer_size Maximum amount of bytes that can be written into the given buffer
+    /// @return Amount of bytes that were actually written into the given buffer, 0 once the complete response body has been read
+    virtual size_t read_response_body(uint8_t * buffer, size_t const & buffer_size) = 0;
 };
 
 #endif // IHTTP_Client_h
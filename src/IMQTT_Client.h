@@ -9,6 +9,16 @@
 #if THINGSBOARD_ENABLE_STREAM_UTILS
 #include <Print.h>
 #endif // THINGSBOARD_ENABLE_STREAM_UTILS
+#include <string.h>
+
+
+/// @brief Single contiguous segment of a payload that is published with publish_segments().
+/// Allows handing a message that exists in multiple non-adjacent buffers (for example a constant prefix, a serialized body and a constant suffix)
+/// to the client in one call, without the caller having to assemble it into one contiguous buffer first
+struct MQTT_Payload_Segment {
+    uint8_t const * payload; // Start of the contiguous payload segment
+    size_t          length;  // Length of the payload segment in bytes
+};
 
 
 /// @brief MQTT Client interface that contains the method that a class that can be used to send and receive data over an MQTT connection should implement.
@@ -41,12 +51,36 @@ class IMQTT_Client {
     /// @param callback Method that should be called on established MQTT connection
     virtual void set_connect_callback(Callback<void>::function callback) = 0;
 
+    /// @brief Sets the callback that is called for every received fragment of a message that did not fit into the receive buffer of the MQTT client at once,
+    /// including the topic string that the message was received over, the fragment data and its size, the offset of the fragment inside the complete message and the total message length.
+    /// Does nothing per default, because not every implementation can deliver oversized messages fragment by fragment,
+    /// implementations that can not simply keep discarding messages that exceed their receive buffer instead.
+    /// Directly set by the used ThingsBoard client to its internal methods, therefore calling again and overriding as a user ist not recommended, unless you know what you are doing
+    /// @param callback Method that should be called for every received fragment of an oversized MQTT message
+    virtual void set_fragment_data_callback(Callback<void, char *, uint8_t *, unsigned int, size_t const &, size_t const &>::function callback) {
+        // Nothing to do
+    }
+
+    /// @brief Registers the given topic to be published with an MQTT 5 topic alias,
+    /// meaning steady state publishes to the topic carry a 2 byte alias instead of the complete topic string,
+    /// which meaningfully reduces the per-publish overhead for devices that publish on the same constant topics at a high rate over slow links.
+    /// Does nothing per default, because topic aliases require the MQTT 5 protocol, which not every implementation supports.
+    /// Publishes to topics that could not be registered simply keep carrying the complete topic string instead,
+    /// meaning the result can safely be ignored if the reduced overhead is merely an optimization and not a requirement
+    /// @param topic Topic that should be registered, requires to stay allocated for the complete lifetime of this client, because only the pointer is stored
+    /// @return Whether the topic was registered or not, fails if the MQTT 5 protocol is not supported or has not been enabled
+    virtual bool register_topic_alias(char const * topic) {
+        return false;
+    }
+
     /// @brief Changes the size of the buffer for sent and received MQTT messages,
     /// using a bigger value than uint16_t for passing the buffer size does not make any sense because the maximum message size received
     /// or sent by MQTT can never be bigger than 64K, because it relies on TCP and the TCP size limit also uses a uint16_t internally for the size parameter
     /// @param receive_buffer_size Maximum amount of data that can be received via MQTT at once,
     /// expected behaviour is that, if bigger packets are received they are discarded and a warning is printed to the console.
     /// Should be big enough to hold the biggest response that is expected to be ever received by the device at once.
+    /// Alternatively the Arduino_MQTT_Client allows receiving bigger packets in chunks with a stream configured with set_receive_stream(),
+    /// decoupling the required buffer size from the maximum expected message size
     /// @param send_buffer_size Maximum amount of data that can be sent via MQTT at once,
     /// expected behaviour is that, if we attempt to send data that is bigger, it will simply not be sent and a message is printed to the console instead.
     /// Should be big enough to hold the biggest request that is expected to be ever sent by the device at once.
@@ -97,6 +131,79 @@ class IMQTT_Client {
     /// @return Whether publishing the payload on the given topic was successful or not
     virtual bool publish(char const * topic, uint8_t const * payload, size_t const & length) = 0;
 
+    /// @brief Sends the given payload over the previously established connection with connect, with the given quality of service.
+    /// Per default the payload is simply published with quality of service 0 and the given quality of service is ignored,
+    /// because not every implementation supports publishing with a quality of service bigger than 0,
+    /// implementations that do override this method and additionally return the message id of the sent message,
+    /// whose delivery confirmation is then reported over the callback configured with set_publish_completion_callback()
+    /// @param topic Topic that the message is sent over, where different MQTT topics expect a different kind of payload
+    /// @param payload Payload containg the json data that should be sent
+    /// @param length Length of the payload in bytes
+    /// @param quality_of_service Quality of service the payload should be published with (0 or 1)
+    /// @param message_id Variable the message id of the sent message is copied into,
+    /// is 0 if the message does not expect a delivery confirmation (quality of service 0 or not supported by the implementation)
+    /// @return Whether publishing the payload on the given topic was successful or not
+    virtual bool publish(char const * topic, uint8_t const * payload, size_t const & length, uint8_t const & quality_of_service, int & message_id) {
+        message_id = 0;
+        return publish(topic, payload, length);
+    }
+
+    /// @brief Sets the callback that is called once the broker has confirmed the delivery of a message that was published with a quality of service bigger than 0,
+    /// including the message id that the publish() call with a quality of service returned for the message.
+    /// Does nothing per default, because not every implementation supports publishing with a quality of service bigger than 0.
+    /// Directly set by the used ThingsBoard client to its internal methods, therefore calling again and overriding as a user ist not recommended, unless you know what you are doing
+    /// @param callback Method that should be called on confirmed delivery of a published message
+    virtual void set_publish_completion_callback(Callback<void, int>::function callback) {
+        // Nothing to do
+    }
+
+    /// @brief Borrows a buffer owned by the transport that the payload of the next publish() call can be serialized into directly,
+    /// skipping the callers own intermediate buffer and its assembly copy. The buffer stays owned by the client and remains valid until the next call
+    /// to borrow_publish_buffer() or until the client is destructed, meaning it must not be freed by the caller and not be used after the message has been published.
+    /// The default implementation returns nullptr, meaning the transport does not own borrowable memory and the caller has to serialize into its own buffer instead
+    /// @param length Amount of bytes the borrowed buffer has to be able to hold
+    /// @return Pointer to the transport-owned buffer or nullptr if the transport can not lend one
+    virtual uint8_t * borrow_publish_buffer(size_t const & length) {
+        return nullptr;
+    }
+
+    /// @brief Publishes the given payload segments as one single message over the previously established connection with connect.
+    /// Allows sending a message that exists in multiple non-adjacent buffers without the caller having to assemble it into one contiguous buffer first.
+    /// Implementations whose transport supports scattered payloads can forward the segments directly, the default implementation assembles them once,
+    /// preferably into a transport-owned buffer borrowed with borrow_publish_buffer() and only as a last resort into a temporary heap allocation
+    /// @param topic Topic that the message is sent over, where different MQTT topics expect a different kind of payload
+    /// @param segments Start of the array of payload segments that together form the complete message
+    /// @param segments_amount Amount of payload segments in the given array
+    /// @return Whether publishing the assembled payload on the given topic was successful or not
+    virtual bool publish_segments(char const * topic, MQTT_Payload_Segment const * segments, size_t const & segments_amount) {
+        if (segments == nullptr || segments_amount == 0U) {
+            return false;
+        }
+        // A single segment is already contiguous and can simply be handed to the client directly without any assembly
+        if (segments_amount == 1U) {
+            return publish(topic, segments[0U].payload, segments[0U].length);
+        }
+        size_t total_length = 0U;
+        for (size_t segment = 0U; segment < segments_amount; segment++) {
+            total_length += segments[segment].length;
+        }
+        uint8_t * assembled = borrow_publish_buffer(total_length);
+        bool const heap_allocated = assembled == nullptr;
+        if (heap_allocated) {
+            assembled = new uint8_t[total_length];
+        }
+        size_t offset = 0U;
+        for (size_t segment = 0U; segment < segments_amount; segment++) {
+            memcpy(assembled + offset, segments[segment].payload, segments[segment].length);
+            offset += segments[segment].length;
+        }
+        bool const result = publish(topic, assembled, total_length);
+        if (heap_allocated) {
+            delete[] assembled;
+        }
+        return result;
+    }
+
     /// @brief Subscribes to MQTT message on the given topic, which will cause an internal callback to be called for each message received on that topic from the server,
     /// it should then, call the previously configured callback with set_data_callback() with the received data
     /// @param topic Topic we want to receive a notification about if messages are sent by the server
@@ -115,8 +222,6 @@ class IMQTT_Client {
     /// @return Whether the client is currently connected or not
     virtual bool connected() = 0;
 
-#if THINGSBOARD_ENABLE_STREAM_UTILS
-
     /// @brief Start to publish a message over a given topic, without being restricted to the internal buffer size.
     /// Meaning it allows for arbitrarily large payloads to be sent without them having to be copied into a new buffer and held in memory.
     /// To use this feature first call begin_publish(), followed by multiple calls to write() and then ending with a call to end_publish()
@@ -147,8 +252,6 @@ class IMQTT_Client {
     /// @param size Amount of bytes contained in the buffer that should be sent
     /// @return The amount of bytes successfully written
     virtual size_t write(uint8_t const * buffer, size_t const & size) = 0;
-
-#endif // THINGSBOARD_ENABLE_STREAM_UTILS
 };
 
 #endif // IMQTT_Client_h
@@ -0,0 +1,40 @@
+#ifndef ITelemetry_Store_h
+#define ITelemetry_Store_h
+
+// Library include.
+#include <stddef.h>
+#include <stdint.h>
+
+
+/// @brief Telemetry store interface that contains the methods that a class that can be used to persist serialized telemetry records should implement.
+/// Is used as an optional backing store for the store-and-forward subsystem of the ThingsBoard client, records that do not fit into the RAM ring buffer anymore,
+/// are handed to this interface instead of being dropped and are read back in their original order once the connection to the cloud has been established again.
+/// Where the records are persisted (flash, NVS or an SD card) is up to the specific implementation, similar to how the IUpdater interface abstracts where firmware data is written
+class ITelemetry_Store {
+  public:
+    /// @brief Persists the given serialized telemetry record, is expected to keep the insertion order of the given records,
+    /// because they are read back oldest first to ensure the data arrives on the cloud in the order it was sampled
+    /// @param record Serialized telemetry record that should be persisted
+    /// @param length Length of the serialized telemetry record in bytes
+    /// @return Whether persisting the given record was successful or not
+    virtual bool store(uint8_t const * record, uint16_t length) = 0;
+
+    /// @brief Gets the length of the oldest currently persisted telemetry record
+    /// @return Length of the oldest persisted record in bytes or 0 if no record is persisted
+    virtual uint16_t oldest_record_length() = 0;
+
+    /// @brief Copies the oldest persisted telemetry record into the given buffer and removes it from the store.
+    /// The given buffer is expected to be big enough to hold atleast the amount of bytes returned by oldest_record_length()
+    /// @param buffer Buffer the oldest persisted record should be copied into, if nullptr is passed the record is simply discarded instead
+    /// @return Whether retrieving (or discarding) the oldest persisted record was successful or not
+    virtual bool retrieve_oldest_record(uint8_t * buffer) = 0;
+
+    /// @brief Gets the amount of currently persisted telemetry records
+    /// @return Amount of persisted records
+    virtual size_t amount() = 0;
+
+    /// @brief Removes all currently persisted telemetry records
+    virtual void clear() = 0;
+};
+
+#endif // ITelemetry_Store_h
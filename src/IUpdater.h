@@ -14,7 +14,9 @@
 class IUpdater {
   public:
     /// @brief Initalizes the writing of the given data
-    /// @param firmware_size Total size of the data that should be written, is done in multiple packets
+    /// @param firmware_size Total size of the data that should be written, is done in multiple packets.
+    /// Passing 0 means the final size is not known upfront (received data is decompressed or applied as a patch before it is written),
+    /// implementations that can not prepare for an unknown size are expected to fail in that case
     /// @return Whether initalizing the update was successful or not
     virtual bool begin(size_t const & firmware_size) = 0;
   
@@ -23,6 +25,22 @@ class IUpdater {
     /// @param total_bytes Amount of bytes in the current firmware packet data
     /// @return Total amount of bytes that were successfully written
     virtual size_t write(uint8_t * payload, size_t const & total_bytes) = 0;
+
+    /// @brief Writes any internally staged data that has not been written onto the device yet.
+    /// Called once all data has been received, before the update is ended with end().
+    /// Implementing this method is optional, because it is only needed by implementations that coalesce the given packet data internally,
+    /// implementations that write every packet immediately can simply keep the default implementation
+    /// @return Whether writing the staged data was successful or not
+    virtual bool flush() { return true; }
+
+    /// @brief Reads the given region of the currently running firmware, used as the source for reconstructing a new firmware from a binary delta patch.
+    /// Implementing this method is optional, because it is only needed to support delta updates,
+    /// implementations that keep the default implementation simply fail the patch application
+    /// @param offset Offset of the region inside the currently running firmware
+    /// @param payload Buffer the read region will be written into
+    /// @param length Amount of bytes that should be read
+    /// @return Amount of bytes that were actually read
+    virtual size_t read_current(size_t const & offset, uint8_t * payload, size_t const & length) { return 0U; }
   
     /// @brief Resets the writing of the given data so it can be restarted with begin
     virtual void reset() = 0;
@@ -0,0 +1,91 @@
+// Header include.
+#include "Key_Intern_Pool.h"
+
+// Local includes.
+#include "Helper.h"
+#include "Memory_Metrics.h"
+
+// Library include.
+#include <string.h>
+
+Key_Intern_Pool::Key_Intern_Pool(size_t const & block_size)
+  : m_block_size(block_size)
+{
+    // Nothing to do
+}
+
+Key_Intern_Pool::~Key_Intern_Pool() {
+    clear();
+}
+
+char const * Key_Intern_Pool::intern(char const * key) {
+    if (Helper::stringIsNullorEmpty(key)) {
+        return nullptr;
+    }
+    // Compare the precomputed hashes first, so almost every non-matching entry is skipped without a string comparison,
+    // entries that share the hash are confirmed with a single string comparison each because different keys can collide on the same hash value
+    uint32_t const key_hash = Helper::hashString(key);
+    for (auto const & entry : m_entries) {
+        if (entry.hash == key_hash && strcmp(entry.key, key) == 0) {
+            return entry.key;
+        }
+    }
+
+    size_t const required_size = strlen(key) + 1U;
+    char * destination = nullptr;
+    if (required_size > m_block_size) {
+        // Keys bigger than one arena block receive a dedicated allocation of their exact size,
+        // the current block stays in place so its remaining space is still used for following keys
+        destination = allocate_block(required_size);
+    }
+    else {
+        if (m_current_block == nullptr || m_current_block_used + required_size > m_block_size) {
+            m_current_block = allocate_block(m_block_size);
+            m_current_block_used = 0U;
+        }
+        if (m_current_block != nullptr) {
+            destination = &m_current_block[m_current_block_used];
+            m_current_block_used += required_size;
+        }
+    }
+    if (destination == nullptr) {
+        return nullptr;
+    }
+
+    memcpy(destination, key, required_size);
+    Intern_Entry const entry = {key_hash, destination};
+    m_entries.push_back(entry);
+    return destination;
+}
+
+size_t Key_Intern_Pool::interned_amount() const {
+    return m_entries.size();
+}
+
+size_t Key_Intern_Pool::used_bytes() const {
+    return m_used_bytes;
+}
+
+void Key_Intern_Pool::clear() {
+    for (auto & block : m_blocks) {
+        delete[] block;
+        block = nullptr;
+    }
+    m_blocks.clear();
+    m_entries.clear();
+    Memory_Metrics::record_deallocation(Memory_Subsystem::INTERN_POOL, m_used_bytes);
+    m_current_block = nullptr;
+    m_current_block_used = 0U;
+    m_used_bytes = 0U;
+}
+
+char * Key_Intern_Pool::allocate_block(size_t const & size) {
+    char * const block = new char[size]();
+    if (block == nullptr) {
+        return nullptr;
+    }
+    m_blocks.push_back(block);
+    m_used_bytes += size;
+    Memory_Metrics::record_allocation(Memory_Subsystem::INTERN_POOL, size);
+    return block;
+}
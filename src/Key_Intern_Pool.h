@@ -0,0 +1,79 @@
+#ifndef Key_Intern_Pool_h
+#define Key_Intern_Pool_h
+
+// Local includes.
+#include "Vector.h"
+
+// Library includes.
+#include <stddef.h>
+#include <stdint.h>
+
+
+// Default size in bytes of one arena block newly interned keys are copied into,
+// big enough to hold the key set of a typical device in a single block
+size_t constexpr DEFAULT_INTERN_BLOCK_SIZE = 256U;
+
+
+/// @brief Compact arena that interns telemetry keys, meaning every distinct key is stored exactly once
+/// and interning the same key again returns the identical stable pointer instead of storing another copy.
+/// Meant for applications that build their keys dynamically (generated channel names, keys read from a configuration),
+/// which otherwise have to keep their own long-lived buffer per key, because the Telemetry record only stores a pointer to the key.
+/// The returned pointers stay valid until clear() is called or the pool is destructed and can therefore be passed
+/// directly as the key of Telemetry records, queued telemetry and deadband rules, no matter how the original string was allocated.
+/// Keys are packed back to back into arena blocks, so thousands of queued records referencing a few dozen distinct keys
+/// share one densely packed allocation instead of each pointing into scattered caller buffers
+class Key_Intern_Pool {
+  public:
+    /// @brief Constructor
+    /// @param block_size Size in bytes of one arena block newly interned keys are copied into,
+    /// keys bigger than one block receive a dedicated allocation of their exact size, default = DEFAULT_INTERN_BLOCK_SIZE (256)
+    explicit Key_Intern_Pool(size_t const & block_size = DEFAULT_INTERN_BLOCK_SIZE);
+
+    /// @brief Destructor
+    ~Key_Intern_Pool();
+
+    // Copying the pool is forbidden, because the interned pointers point into the arena blocks
+    // and a copy would either share or invalidate them once one of the two instances is destructed
+    Key_Intern_Pool(Key_Intern_Pool const &) = delete;
+    Key_Intern_Pool & operator=(Key_Intern_Pool const &) = delete;
+
+    /// @brief Interns the given key, copying it into the arena if it has not been interned before
+    /// @param key Key that should be interned, does not need to stay allocated after this method returns
+    /// @return Stable pointer to the interned copy of the given key, stays valid until clear() is called or the pool is destructed.
+    /// Interning the same key again returns the identical pointer, nullptr is returned if the given key is null or empty or allocating a new arena block failed
+    char const * intern(char const * key);
+
+    /// @brief Gets the amount of distinct keys that are currently interned
+    /// @return Amount of interned keys
+    size_t interned_amount() const;
+
+    /// @brief Gets the total amount of arena bytes that are currently allocated, including unused block remainders
+    /// @return Amount of allocated arena bytes
+    size_t used_bytes() const;
+
+    /// @brief Removes all interned keys and frees the arena blocks.
+    /// Invalidates every pointer previously returned by intern(), ensure no Telemetry record or rule referencing them is still in use
+    void clear();
+
+  private:
+    /// @brief One interned key, connecting the precomputed hash of the key with the stable pointer to its arena copy,
+    /// the hash allows skipping the string comparison for almost every non-matching entry during the dedup lookup
+    struct Intern_Entry {
+        uint32_t     hash; // Precomputed hash of the interned key
+        char const * key;  // Stable pointer to the arena copy of the interned key
+    };
+
+    /// @brief Allocates a new arena block of the given size and records the allocation
+    /// @param size Size of the arena block in bytes
+    /// @return Pointer to the allocated block or nullptr if the allocation failed
+    char * allocate_block(size_t const & size);
+
+    Vector<char *>       m_blocks = {};             // Allocated arena blocks the interned keys are packed into
+    Vector<Intern_Entry> m_entries = {};            // Interned keys with their precomputed hashes, used for the dedup lookup
+    size_t               m_block_size = {};         // Size in bytes one arena block is allocated with
+    char *               m_current_block = {};      // Arena block newly interned keys are currently packed into
+    size_t               m_current_block_used = {}; // Amount of bytes already used in the current arena block
+    size_t               m_used_bytes = {};         // Total amount of currently allocated arena bytes over all blocks
+};
+
+#endif // Key_Intern_Pool_h
@@ -0,0 +1,53 @@
+// Header include.
+#include "Memory_Metrics.h"
+
+// Accumulated statistics of every subsystem, zero initialized with static storage duration
+static Memory_Subsystem_Stats memory_stats[MEMORY_SUBSYSTEM_COUNT] = {};
+
+void Memory_Metrics::record_allocation(Memory_Subsystem subsystem, size_t const & bytes) {
+    Memory_Subsystem_Stats & stats = memory_stats[static_cast<uint8_t>(subsystem)];
+    size_t const live_bytes = __atomic_add_fetch(&stats.live_bytes, bytes, __ATOMIC_RELAXED);
+    (void)__atomic_fetch_add(&stats.allocation_count, 1U, __ATOMIC_RELAXED);
+    // The peak is raised with a compare and swap loop, because another task might have raised it further in the meantime
+    size_t peak_bytes = __atomic_load_n(&stats.peak_bytes, __ATOMIC_RELAXED);
+    while (live_bytes > peak_bytes && !__atomic_compare_exchange_n(&stats.peak_bytes, &peak_bytes, live_bytes, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {}
+}
+
+void Memory_Metrics::record_deallocation(Memory_Subsystem subsystem, size_t const & bytes) {
+    Memory_Subsystem_Stats & stats = memory_stats[static_cast<uint8_t>(subsystem)];
+    // The live amount is never decremented below 0, guards against deallocations of memory that was allocated before the accounting saw it,
+    // for example the initial default buffers of the underlying MQTT client
+    size_t live_bytes = __atomic_load_n(&stats.live_bytes, __ATOMIC_RELAXED);
+    while (true) {
+        size_t const decremented_bytes = (live_bytes > bytes) ? (live_bytes - bytes) : 0U;
+        if (__atomic_compare_exchange_n(&stats.live_bytes, &live_bytes, decremented_bytes, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            return;
+        }
+    }
+}
+
+void Memory_Metrics::record_resize(Memory_Subsystem subsystem, size_t const & previous_bytes, size_t const & new_bytes) {
+    if (new_bytes > previous_bytes) {
+        record_allocation(subsystem, new_bytes - previous_bytes);
+    }
+    else {
+        record_deallocation(subsystem, previous_bytes - new_bytes);
+    }
+}
+
+Memory_Subsystem_Stats Memory_Metrics::stats(Memory_Subsystem subsystem) {
+    Memory_Subsystem_Stats const & stats = memory_stats[static_cast<uint8_t>(subsystem)];
+    Memory_Subsystem_Stats snapshot = {};
+    snapshot.live_bytes = __atomic_load_n(&stats.live_bytes, __ATOMIC_RELAXED);
+    snapshot.peak_bytes = __atomic_load_n(&stats.peak_bytes, __ATOMIC_RELAXED);
+    snapshot.allocation_count = __atomic_load_n(&stats.allocation_count, __ATOMIC_RELAXED);
+    return snapshot;
+}
+
+size_t Memory_Metrics::total_live_bytes() {
+    size_t total_bytes = 0U;
+    for (uint8_t subsystem = 0U; subsystem < MEMORY_SUBSYSTEM_COUNT; subsystem++) {
+        total_bytes += __atomic_load_n(&memory_stats[subsystem].live_bytes, __ATOMIC_RELAXED);
+    }
+    return total_bytes;
+}
@@ -0,0 +1,68 @@
+#ifndef Memory_Metrics_h
+#define Memory_Metrics_h
+
+// Local include.
+#include "Configuration.h"
+
+// Library includes.
+#include <stdint.h>
+#include <stddef.h>
+
+
+/// @brief Subsystems the library attributes its own heap allocations to, used as the index into the accumulated per-subsystem statistics
+enum class Memory_Subsystem : uint8_t {
+    VECTOR,           ///< Growth of the fallback Vector container used when the C++ STL is not supported
+    SCRATCH_BUFFER,   ///< Reusable serialization scratch buffer payloads too big for the stack are serialized into
+    RECEIVE_DOCUMENT, ///< Reusable receive document received messages are deserialized into, only used if THINGSBOARD_ENABLE_DYNAMIC is enabled
+    CLIENT_BUFFER,    ///< Send and receive buffers of the underlying MQTT client, accounted with the requested buffer sizes
+    WORKER_RING,      ///< Lock-free ring of the optional telemetry worker task
+    INTERN_POOL       ///< Arena blocks of the optional key intern pool
+};
+uint8_t constexpr MEMORY_SUBSYSTEM_COUNT = 6U;
+
+
+/// @brief Accumulated heap usage statistics of one subsystem
+struct Memory_Subsystem_Stats {
+    size_t   live_bytes;       // Amount of bytes the subsystem has currently allocated
+    size_t   peak_bytes;       // Biggest amount of bytes the subsystem had allocated at any one time
+    uint32_t allocation_count; // Total amount of allocations the subsystem has performed, a high count with low live bytes indicates churn that fragments the heap
+};
+
+
+/// @brief Accounts every heap allocation the library performs itself, attributed to the subsystem that caused it.
+/// Long uptime devices chase heap fragmentation blind, because the allocations happen inside the library (container growth,
+/// serialization spill buffers, the dynamic receive document, client buffer resizes) and are not attributable from the outside.
+/// The per-subsystem live bytes, peak bytes and allocation count can be retrieved with the memoryStats() method of the ThingsBoard class
+/// and published as telemetry, which allows right-sizing the template arguments and buffer parameters of a complete fleet from reported data.
+/// The counters are updated with atomic builtins, because allocations can happen from multiple tasks,
+/// the accounting itself never allocates and costs a handful of instructions per allocation site
+class Memory_Metrics {
+  public:
+    /// @brief Records that the given subsystem allocated the given amount of bytes
+    /// @param subsystem Subsystem the allocation is attributed to
+    /// @param bytes Size of the allocation in bytes
+    static void record_allocation(Memory_Subsystem subsystem, size_t const & bytes);
+
+    /// @brief Records that the given subsystem freed the given amount of previously allocated bytes
+    /// @param subsystem Subsystem the deallocation is attributed to
+    /// @param bytes Size of the freed allocation in bytes
+    static void record_deallocation(Memory_Subsystem subsystem, size_t const & bytes);
+
+    /// @brief Records that an allocation of the given subsystem changed its size, used for buffers that are resized as a whole.
+    /// Only counts as an actual allocation if the new size is bigger than the previous one
+    /// @param subsystem Subsystem the resized allocation is attributed to
+    /// @param previous_bytes Size of the allocation in bytes before the resize
+    /// @param new_bytes Size of the allocation in bytes after the resize
+    static void record_resize(Memory_Subsystem subsystem, size_t const & previous_bytes, size_t const & new_bytes);
+
+    /// @brief Gets a snapshot of the accumulated statistics of the given subsystem
+    /// @param subsystem Subsystem the statistics should be returned for
+    /// @return Copied snapshot of the accumulated statistics, copied because the counters keep changing while they are read
+    static Memory_Subsystem_Stats stats(Memory_Subsystem subsystem);
+
+    /// @brief Gets the total amount of bytes the library currently has allocated over all subsystems
+    /// @return Sum of the live bytes of every subsystem
+    static size_t total_live_bytes();
+};
+
+#endif // Memory_Metrics_h
@@ -7,6 +7,13 @@
 #include "OTA_Handler.h"
 #include "IAPI_Implementation.h"
 
+// Library includes.
+#if THINGSBOARD_ENABLE_WORKER_TASK
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#endif // THINGSBOARD_ENABLE_WORKER_TASK
+
 
 uint8_t constexpr MAX_FW_TOPIC_SIZE = 33U;
 uint8_t constexpr OTA_ATTRIBUTE_KEYS_AMOUNT = 5U;
@@ -14,6 +21,7 @@ char constexpr NO_FW_REQUEST_RESPONSE[] = "Did not receive requested shared attr
 // Firmware topics.
 char constexpr FIRMWARE_RESPONSE_TOPIC[] = "v2/fw/response/%u/chunk/";
 char constexpr FIRMWARE_RESPONSE_SUBSCRIBE_TOPIC[] = "v2/fw/response/+";
+char constexpr FIRMWARE_RESPONSE_TOPIC_PREFIX[] = "v2/fw/response/";
 char constexpr FIRMWARE_REQUEST_TOPIC[] = "v2/fw/request/%u/chunk/%u";
 // Firmware data keys.
 char constexpr CURR_FW_TITLE_KEY[] = "current_fw_title";
@@ -29,6 +37,17 @@ char constexpr CHECKSUM_AGORITM_MD5[] = "MD5";
 char constexpr CHECKSUM_AGORITM_SHA256[] = "SHA256";
 char constexpr CHECKSUM_AGORITM_SHA384[] = "SHA384";
 char constexpr CHECKSUM_AGORITM_SHA512[] = "SHA512";
+#if THINGSBOARD_ENABLE_WORKER_TASK
+// Processing task defaults.
+// The priority is intentionally below the default priority of the internal MQTT event task,
+// so hashing and flashing the received chunks can not starve the reception and dispatching of other server-side messages
+uint8_t constexpr DEFAULT_OTA_TASK_PRIORITY = 2U;
+uint16_t constexpr DEFAULT_OTA_TASK_STACK_SIZE = 8192U;
+uint8_t constexpr DEFAULT_OTA_TASK_QUEUE_LENGTH = 4U;
+// Maximum time in milliseconds the receiving task waits for a free queue slot before the received chunk is dropped,
+// waiting applies backpressure onto the chunk intake while the processing task catches up with already received chunks
+uint16_t constexpr OTA_TASK_ENQUEUE_TIMEOUT_MS = 1000U;
+#endif // THINGSBOARD_ENABLE_WORKER_TASK
 // Log messages.
 char constexpr NUMBER_PRINTF[] = "%u";
 char constexpr NO_FW[] = "Missing shared attribute firmware keys. Ensure you assigned an OTA update with binary";
@@ -37,6 +56,10 @@ char constexpr FW_NOT_FOR_US[] = "Received firmware title (%s) is different and
 char constexpr FW_CHKS_ALGO_NOT_SUPPORTED[] = "Received checksum algorithm (%s) is not supported";
 char constexpr NOT_ENOUGH_RAM[] = "Temporary allocating more internal client buffer failed, decrease OTA chunk size or decrease overall heap usage";
 char constexpr RESETTING_FAILED[] = "Preparing for OTA firmware updates failed, attributes might be NULL";
+#if THINGSBOARD_ENABLE_WORKER_TASK
+char constexpr OTA_TASK_CREATE_FAILED[] = "Creating the OTA processing task failed, ensure there is enough heap memory left for its stack";
+char constexpr OTA_CHUNK_DROPPED[] = "Handing received chunk (%u) to the OTA processing task failed, it is requested again once the chunk request times out";
+#endif // THINGSBOARD_ENABLE_WORKER_TASK
 #if THINGSBOARD_ENABLE_DEBUG
 char constexpr PAGE_BREAK[] = "=================================";
 char constexpr NEW_FW[] = "A new Firmware is available:";
@@ -65,11 +88,7 @@ class OTA_Firmware_Update : public IAPI_Implementation {
       , m_fw_callback()
       , m_previous_buffer_size(0U)
       , m_changed_buffer_size(false)
-#if THINGSBOARD_ENABLE_STL
-      , m_ota(std::bind(&OTA_Firmware_Update::Publish_Chunk_Request, this, std::placeholders::_1, std::placeholders::_2), std::bind(&OTA_Firmware_Update::Firmware_Send_State, this, std::placeholders::_1, std::placeholders::_2), std::bind(&OTA_Firmware_Update::Firmware_OTA_Unsubscribe, this))
-#else
-      , m_ota(OTA_Firmware_Update::staticPublishChunk, OTA_Firmware_Update::staticFirmwareSend, OTA_Firmware_Update::staticUnsubscribe)
-#endif // THINGSBOARD_ENABLE_STL
+      , m_ota(Delegate<bool, size_t const &, size_t const &, size_t const &>::Create<OTA_Firmware_Update, &OTA_Firmware_Update::Publish_Chunk_Request>(this), Delegate<bool, char const * const, char const * const>::Create<OTA_Firmware_Update, &OTA_Firmware_Update::Firmware_Send_State>(this), Delegate<bool>::Create<OTA_Firmware_Update, &OTA_Firmware_Update::Firmware_OTA_Unsubscribe>(this))
       , m_response_topic()
       , m_fw_attribute_update()
       , m_fw_attribute_request()
@@ -120,6 +139,62 @@ class OTA_Firmware_Update : public IAPI_Implementation {
         m_ota.Stop_Firmware_Update();
     }
 
+#if THINGSBOARD_ENABLE_WORKER_TASK
+    /// @brief Starts the optional processing task mode, which creates a dedicated FreeRTOS task that received firmware chunks are handed to through a queue,
+    /// instead of hashing and flashing them directly in the receive context of the underlying MQTT client.
+    /// Writing a chunk to flash can block for multiple hundred milliseconds (flash sector erases), which stalls every other server-side callback
+    /// dispatched from the same receive context (for example time-critical server-side RPC) for that duration.
+    /// With the processing task started the receive context only copies the chunk into the queue and returns immediately,
+    /// while the lower priority processing task performs the hashing and flashing and requests the next chunk once it is done,
+    /// meaning the chunk intake automatically slows down to the processing speed instead of piling up received chunks.
+    /// If the queue is full regardless, the receiving task waits up to OTA_TASK_ENQUEUE_TIMEOUT_MS for a free slot and drops the chunk after,
+    /// which the normal chunk request timeout recovers from by simply requesting the dropped chunk again.
+    /// The task can be started once before any update and simply kept running, because while no update is ongoing it only blocks on the empty queue
+    /// @param queue_length Amount of received chunks the queue can hold before the receiving task has to wait,
+    /// should be at least as big as the configured chunk request window so a full window never has to wait, default = DEFAULT_OTA_TASK_QUEUE_LENGTH (4)
+    /// @param priority Task priority with which the processing task should run,
+    /// should stay below the priority of the task that drives the underlying MQTT client so message reception takes precedence over flashing, default = DEFAULT_OTA_TASK_PRIORITY (2)
+    /// @param stack_size Task stack size in bytes the processing task can use before the device crashes with a StackOverflow, default = DEFAULT_OTA_TASK_STACK_SIZE (8192)
+    /// @param core Core the processing task is pinned to, simply pass tskNO_AFFINITY if the scheduler should pick the core itself instead, default = tskNO_AFFINITY
+    /// @return Whether starting the processing task was successful or not, if it is already running there is nothing to do and we return true
+    bool Start_Processing_Task(uint8_t queue_length = DEFAULT_OTA_TASK_QUEUE_LENGTH, uint8_t priority = DEFAULT_OTA_TASK_PRIORITY, uint16_t stack_size = DEFAULT_OTA_TASK_STACK_SIZE, BaseType_t core = tskNO_AFFINITY) {
+        if (m_processing_task != nullptr) {
+            return true;
+        }
+        m_processing_queue = xQueueCreate(queue_length, sizeof(Chunk_Message));
+        if (m_processing_queue == nullptr) {
+            Logger::printfln(OTA_TASK_CREATE_FAILED);
+            return false;
+        }
+        m_processing_stop_requested = false;
+        m_processing_task_running = true;
+        if (xTaskCreatePinnedToCore(&OTA_Firmware_Update::Static_Processing_Task, "tb_ota", stack_size, this, priority, &m_processing_task, core) != pdPASS) {
+            m_processing_task_running = false;
+            vQueueDelete(m_processing_queue);
+            m_processing_queue = nullptr;
+            Logger::printfln(OTA_TASK_CREATE_FAILED);
+            return false;
+        }
+        return true;
+    }
+
+    /// @brief Stops the previously with Start_Processing_Task() started processing task, chunks that are still queued are discarded without being processed.
+    /// Blocks until the processing task has freed the queued chunk copies and deleted itself,
+    /// should only be called while no update is ongoing, because discarding queued chunks of an ongoing update forces it to be retried
+    void Stop_Processing_Task() {
+        if (m_processing_task == nullptr) {
+            return;
+        }
+        __atomic_store_n(&m_processing_stop_requested, true, __ATOMIC_RELEASE);
+        while (__atomic_load_n(&m_processing_task_running, __ATOMIC_ACQUIRE)) {
+            vTaskDelay(1U);
+        }
+        m_processing_task = nullptr;
+        vQueueDelete(m_processing_queue);
+        m_processing_queue = nullptr;
+    }
+#endif // THINGSBOARD_ENABLE_WORKER_TASK
+
     /// @brief Subscribes to any changes of the assigned firmware information on the connected device,
     /// meaning once we subscribed if we register any changes we will start the update if the given firmware is not already installed.
     /// Unlike Start_Firmware_Update this method only registers changes to the firmware information,
@@ -186,9 +261,27 @@ class OTA_Firmware_Update : public IAPI_Implementation {
         char response_topic[Helper::detectSize(FIRMWARE_RESPONSE_TOPIC, request_id)] = {};
         (void)snprintf(response_topic, sizeof(response_topic), FIRMWARE_RESPONSE_TOPIC, request_id);
         size_t const chunk = Helper::parseRequestId(response_topic, topic);
+#if THINGSBOARD_ENABLE_WORKER_TASK
+        if (Enqueue_Firmware_Packet(chunk, payload, length, 0U, 0U, false)) {
+            return;
+        }
+#endif // THINGSBOARD_ENABLE_WORKER_TASK
         m_ota.Process_Firmware_Packet(chunk, payload, length);
     }
 
+    void Process_Response_Fragment(char const * topic, uint8_t * payload, unsigned int length, size_t const & current_offset, size_t const & total_length) override {
+        size_t const & request_id = m_fw_callback.Get_Request_ID();
+        char response_topic[Helper::detectSize(FIRMWARE_RESPONSE_TOPIC, request_id)] = {};
+        (void)snprintf(response_topic, sizeof(response_topic), FIRMWARE_RESPONSE_TOPIC, request_id);
+        size_t const chunk = Helper::parseRequestId(response_topic, topic);
+#if THINGSBOARD_ENABLE_WORKER_TASK
+        if (Enqueue_Firmware_Packet(chunk, payload, length, current_offset, total_length, true)) {
+            return;
+        }
+#endif // THINGSBOARD_ENABLE_WORKER_TASK
+        m_ota.Process_Firmware_Packet_Fragment(chunk, payload, length, current_offset, total_length);
+    }
+
     void Process_Json_Response(char const * topic, JsonDocument const & data) override {
         // Nothing to do
     }
@@ -197,6 +290,10 @@ class OTA_Firmware_Update : public IAPI_Implementation {
         return strncmp(m_response_topic, topic, strlen(m_response_topic)) == 0;
     }
 
+    char const * Get_Response_Topic_Prefix() const override {
+        return FIRMWARE_RESPONSE_TOPIC_PREFIX;
+    }
+
     bool Unsubscribe() override {
         Stop_Firmware_Update();
         return true;
@@ -217,7 +314,7 @@ class OTA_Firmware_Update : public IAPI_Implementation {
         m_subscribe_api_callback.Call_Callback(m_fw_attribute_request);
     }
 
-    void Set_Client_Callbacks(Callback<void, IAPI_Implementation &>::function subscribe_api_callback, Callback<bool, char const * const, JsonDocument const &, size_t const &>::function send_json_callback, Callback<bool, char const * const, char const * const>::function send_json_string_callback, Callback<bool, char const * const>::function subscribe_topic_callback, Callback<bool, char const * const>::function unsubscribe_topic_callback, Callback<uint16_t>::function get_receive_size_callback, Callback<uint16_t>::function get_send_size_callback, Callback<bool, uint16_t, uint16_t>::function set_buffer_size_callback, Callback<size_t *>::function get_request_id_callback) override {
+    void Set_Client_Callbacks(Delegate<void, IAPI_Implementation &> subscribe_api_callback, Delegate<bool, char const * const, JsonDocument const &, size_t const &> send_json_callback, Delegate<bool, char const * const, char const * const> send_json_string_callback, Delegate<bool, char const * const> subscribe_topic_callback, Delegate<bool, char const * const> unsubscribe_topic_callback, Delegate<uint16_t> get_receive_size_callback, Delegate<uint16_t> get_send_size_callback, Delegate<bool, uint16_t, uint16_t> set_buffer_size_callback, Delegate<size_t *> get_request_id_callback) override {
         m_subscribe_api_callback.Set_Callback(subscribe_api_callback);
         m_send_json_callback.Set_Callback(send_json_callback);
         m_send_json_string_callback.Set_Callback(send_json_string_callback);
@@ -290,12 +387,9 @@ class OTA_Firmware_Update : public IAPI_Implementation {
     /// @brief Publishes a request for the given firmware chunk
     /// @param request_id Request ID corresponding to the extact OTA update package we want to request chunks from
     /// @param request_chunck Chunk index that should be requested from the server
+    /// @param chunk_size Chunk size in bytes the chunk should be requested with, the server maps the chunk index to the byte offset chunk * size with it
     /// @return Whether publishing the message was successful or not
-    bool Publish_Chunk_Request(size_t const & request_id, size_t const & request_chunck) {
-        // Calculate the number of chuncks we need to request,
-        // in order to download the complete firmware binary
-        uint16_t const & chunk_size = m_fw_callback.Get_Chunk_Size();
-
+    bool Publish_Chunk_Request(size_t const & request_id, size_t const & request_chunck, size_t const & chunk_size) {
         // Convert the interger size into a readable string
         char size[Helper::detectSize(NUMBER_PRINTF, chunk_size)] = {};
         (void)snprintf(size, sizeof(size), NUMBER_PRINTF, chunk_size);
@@ -305,6 +399,85 @@ class OTA_Firmware_Update : public IAPI_Implementation {
         return m_send_json_string_callback.Call_Callback(topic, size);
     }
 
+#if THINGSBOARD_ENABLE_WORKER_TASK
+    /// @brief Single received firmware chunk handed from the receive context of the underlying MQTT client to the processing task.
+    /// Carries a heap copy of the chunk data, because the received payload points into the receive buffer of the MQTT client
+    /// and is only valid for the duration of the receive callback itself
+    struct Chunk_Message {
+        size_t  chunk;          // Chunk index the data belongs to, parsed from the response topic
+        uint8_t *payload;       // Heap copy of the received chunk data, owned by the message and freed by the processing task once it has been processed
+        size_t  length;         // Length in bytes of the copied chunk data
+        size_t  current_offset; // Byte offset of the fragment inside the complete chunk, only valid if fragment is set
+        size_t  total_length;   // Total length in bytes of the complete chunk the fragment belongs to, only valid if fragment is set
+        bool    fragment;       // Whether the message carries a fragment of a chunk instead of a complete chunk
+    };
+
+    /// @brief Copies the received chunk data into a message owned heap buffer and hands it to the processing task.
+    /// If the queue is full the receiving task waits up to OTA_TASK_ENQUEUE_TIMEOUT_MS for a free slot, applying backpressure onto the chunk intake,
+    /// and drops the chunk after, which the normal chunk request timeout recovers from by simply requesting the chunk again.
+    /// The same recovery applies if copying the chunk data fails, because processing the chunk inline instead
+    /// would race with the processing task possibly processing another chunk at the same time
+    /// @param chunk Chunk index the received data belongs to
+    /// @param payload Received chunk data, only valid for the duration of the receive callback
+    /// @param length Length in bytes of the received chunk data
+    /// @param current_offset Byte offset of the fragment inside the complete chunk, only used if fragment is set
+    /// @param total_length Total length in bytes of the complete chunk the fragment belongs to, only used if fragment is set
+    /// @param fragment Whether the received data is a fragment of a chunk instead of a complete chunk
+    /// @return Whether the chunk was consumed by the processing task mode, is false only if the processing task is not running
+    /// and the chunk should be processed inline instead
+    bool Enqueue_Firmware_Packet(size_t const & chunk, uint8_t * payload, unsigned int length, size_t const & current_offset, size_t const & total_length, bool fragment) {
+        if (m_processing_queue == nullptr || !__atomic_load_n(&m_processing_task_running, __ATOMIC_ACQUIRE)) {
+            return false;
+        }
+        uint8_t * copied_payload = new uint8_t[length];
+        if (copied_payload == nullptr) {
+            Logger::printfln(OTA_CHUNK_DROPPED, chunk);
+            return true;
+        }
+        memcpy(copied_payload, payload, length);
+        Chunk_Message const message = {chunk, copied_payload, length, current_offset, total_length, fragment};
+        if (xQueueSend(m_processing_queue, &message, pdMS_TO_TICKS(OTA_TASK_ENQUEUE_TIMEOUT_MS)) != pdTRUE) {
+            delete[] copied_payload;
+            Logger::printfln(OTA_CHUNK_DROPPED, chunk);
+        }
+        return true;
+    }
+
+    /// @brief Main loop of the dedicated processing task, dequeues the received chunks one by one and performs the hashing and flashing for each.
+    /// Requesting the next chunk happens at the end of processing a chunk, meaning the chunk intake automatically follows the processing speed.
+    /// Once a stop has been requested the remaining queued chunk copies are freed without being processed, before the task deletes itself
+    void Processing_Task() {
+        Chunk_Message message = {};
+        while (true) {
+            bool const stop_requested = __atomic_load_n(&m_processing_stop_requested, __ATOMIC_ACQUIRE);
+            if (xQueueReceive(m_processing_queue, &message, 1U) == pdTRUE) {
+                if (!stop_requested) {
+                    if (message.fragment) {
+                        m_ota.Process_Firmware_Packet_Fragment(message.chunk, message.payload, message.length, message.current_offset, message.total_length);
+                    }
+                    else {
+                        m_ota.Process_Firmware_Packet(message.chunk, message.payload, message.length);
+                    }
+                }
+                delete[] message.payload;
+            }
+            else if (stop_requested) {
+                break;
+            }
+        }
+        __atomic_store_n(&m_processing_task_running, false, __ATOMIC_RELEASE);
+        vTaskDelete(nullptr);
+    }
+
+    static void Static_Processing_Task(void * instance) {
+        if (instance == nullptr) {
+            vTaskDelete(nullptr);
+            return;
+        }
+        static_cast<OTA_Firmware_Update *>(instance)->Processing_Task();
+    }
+#endif // THINGSBOARD_ENABLE_WORKER_TASK
+
     /// @brief Handler if the firmware shared attribute request times out without getting a response.
     /// Is used to signal that the update could not be started, because the current firmware information could not be fetched
     void Request_Timeout() {
@@ -425,47 +598,32 @@ class OTA_Firmware_Update : public IAPI_Implementation {
         m_subscribedInstance->Request_Timeout();
     }
 
-    static bool staticPublishChunk(size_t const & request_id, size_t const & request_chunck) {
-        if (m_subscribedInstance == nullptr) {
-            return false;
-        }
-        return m_subscribedInstance->Publish_Chunk_Request(request_id, request_chunck);
-    }
-
-    static bool staticFirmwareSend(char const * current_fw_state, char const * fw_error = nullptr) {
-        if (m_subscribedInstance == nullptr) {
-            return false;
-        }
-        return m_subscribedInstance->Firmware_Send_State(current_fw_state, fw_error);
-    }
-
-    static bool staticUnsubscribe() {
-        if (m_subscribedInstance == nullptr) {
-            return false;
-        }
-        return m_subscribedInstance->Firmware_OTA_Unsubscribe();
-    }
-
     // Used API Implementation cannot call a instanced method when message arrives on subscribed topic.
     // Only free-standing function is allowed.
     // To be able to forward event to an instance, rather than to a function, this pointer exists.
     static OTA_Firmware_Update                                               *m_subscribedInstance;
 #endif // !THINGSBOARD_ENABLE_STL
 
-    Callback<void, IAPI_Implementation &>                                    m_subscribe_api_callback = {};            // Subscribe additional api callback
-    Callback<bool, char const * const, JsonDocument const &, size_t const &> m_send_json_callback = {};                // Send json document callback
-    Callback<bool, char const * const, char const * const>                   m_send_json_string_callback = {};         // Send json string callback
-    Callback<bool, char const * const>                                       m_subscribe_topic_callback = {};          // Subscribe mqtt topic client callback
-    Callback<bool, char const * const>                                       m_unsubscribe_topic_callback = {};        // Unubscribe mqtt topic client callback
-    Callback<uint16_t>                                                       m_get_receive_size_callback = {};         // Get client receive buffer size callback
-    Callback<uint16_t>                                                       m_get_send_size_callback = {};            // Get client send buffer size callback
-    Callback<bool, uint16_t, uint16_t>                                       m_set_buffer_size_callback = {};          // Set client buffer size callback
-    Callback<size_t *>                                                       m_get_request_id_callback = {};           // Get internal request id callback
+    Delegate<void, IAPI_Implementation &>                                    m_subscribe_api_callback = {};            // Subscribe additional api callback
+    Delegate<bool, char const * const, JsonDocument const &, size_t const &> m_send_json_callback = {};                // Send json document callback
+    Delegate<bool, char const * const, char const * const>                   m_send_json_string_callback = {};         // Send json string callback
+    Delegate<bool, char const * const>                                       m_subscribe_topic_callback = {};          // Subscribe mqtt topic client callback
+    Delegate<bool, char const * const>                                       m_unsubscribe_topic_callback = {};        // Unubscribe mqtt topic client callback
+    Delegate<uint16_t>                                                       m_get_receive_size_callback = {};         // Get client receive buffer size callback
+    Delegate<uint16_t>                                                       m_get_send_size_callback = {};            // Get client send buffer size callback
+    Delegate<bool, uint16_t, uint16_t>                                       m_set_buffer_size_callback = {};          // Set client buffer size callback
+    Delegate<size_t *>                                                       m_get_request_id_callback = {};           // Get internal request id callback
 
     OTA_Update_Callback                                                      m_fw_callback = {};                       // OTA update response callback
     uint16_t                                                                 m_previous_buffer_size = {};              // Previous buffer size of the underlying client, used to revert to the previously configured buffer size if it was temporarily increased by the OTA update
     bool                                                                     m_changed_buffer_size = {};               // Whether the buffer size had to be changed, because the previous internal buffer size was to small to hold the firmware chunks
     OTA_Handler<Logger>                                                      m_ota = {};                               // Class instance that handles the flashing and creating a hash from the given received binary firmware data
+#if THINGSBOARD_ENABLE_WORKER_TASK
+    TaskHandle_t                                                             m_processing_task = {};                   // Handle of the dedicated processing task the received chunks are hashed and flashed on, nullptr if it has not been started
+    QueueHandle_t                                                            m_processing_queue = {};                  // Queue the received chunks are handed to the processing task through, each entry owns a heap copy of the chunk data
+    bool                                                                     m_processing_stop_requested = {};         // Whether the processing task has been requested to stop, accessed atomically because it is written by another task
+    bool                                                                     m_processing_task_running = {};           // Whether the processing task is currently running, accessed atomically because it is cleared by the processing task itself
+#endif // THINGSBOARD_ENABLE_WORKER_TASK
     char                                                                     m_response_topic[MAX_FW_TOPIC_SIZE] = {}; // Firmware response topic that contains the specific request ID of the firmware we actually want to download
 #if !THINGSBOARD_ENABLE_DYNAMIC
     Shared_Attribute_Update<1U, OTA_ATTRIBUTE_KEYS_AMOUNT, Logger>           m_fw_attribute_update = {};               // API implementation to be informed if needed fw attributes have been updated
@@ -9,6 +9,8 @@
 #include "HashGenerator.h"
 #include "OTA_Update_Callback.h"
 #include "OTA_Failure_Response.h"
+#include "Gzip_Decompressor.h"
+#include "Delta_Patcher.h"
 #include "Helper.h"
 
 // Library includes.
@@ -30,11 +32,26 @@ char constexpr RECEIVED_UNEXPECTED_CHUNK_SIZE[] = "Received chunk size (%u), not
 char constexpr ERROR_UPDATE_BEGIN[] = "Failed to initalize flash updater, ensure that the partition scheme has two app sections";
 char constexpr ERROR_UPDATE_WRITE[] = "Only wrote (%u) bytes of binary data instead of expected (%u)";
 char constexpr ERROR_UPDATE_END[] = "Error during flash updater not all bytes written";
+char constexpr ERROR_UPDATE_FLUSH[] = "Failed to write remaining staged firmware binary data";
+char constexpr ERROR_UPDATE_WRITE_DATA[] = "Failed to write received firmware binary data";
+char constexpr ERROR_DECOMPRESSION_BEGIN[] = "Failed to start decompression of compressed firmware binary";
+char constexpr ERROR_DECOMPRESSION[] = "Failed to decompress received firmware binary data, ensure the binary is actually gzip compressed";
+char constexpr ERROR_DECOMPRESSION_INCOMPLETE[] = "Compressed firmware binary stream ended unexpectedly, the decompressed firmware is incomplete";
+char constexpr COMPRESSION_NOT_SUPPORTED[] = "Compressed firmware binary requested, but no decompressor is available on this platform";
+char constexpr ERROR_PATCH_BEGIN[] = "Failed to start applying the firmware binary delta patch";
+char constexpr ERROR_PATCH[] = "Failed to apply received firmware binary delta patch data, ensure the patch was created against the running firmware version";
+char constexpr ERROR_PATCH_INCOMPLETE[] = "Firmware binary delta patch ended unexpectedly, the reconstructed firmware is incomplete";
+char constexpr CHUNK_SIZE_CHANGED[] = "Adapted requested chunk size to (%u) bytes";
+// Amount of chunks that have to arrive in a row without a timeout, before the requested chunk size is grown to the next bound
+uint8_t constexpr CHUNKS_BEFORE_GROWTH = 4U;
 char constexpr CHECKSUM_VERIFICATION_FAILED[] = "Calculated checksum (%s), not the same as expected checksum (%s)";
 char constexpr FW_UPDATE_ABORTED[] = "Firmware update aborted";
 char constexpr CHUNK_REQUEST_TIMED_OUT[] = "Failed to receive requested chunk (%u) in (%llu) us. Internet connection might have been lost";
+char constexpr RECEIVED_UNEXPECTED_FRAGMENT[] = "Received fragment at offset (%u), not the same as the expected offset (%u)";
+char constexpr RECEIVED_RESTARTED_CHUNK[] = "Received restarted transmission of partially written chunk (%u), restarting the complete update";
 #if THINGSBOARD_ENABLE_DEBUG
 char constexpr FW_CHUNK[] = "Receive chunk (%u), with size (%u) bytes";
+char constexpr FW_CHUNK_FRAGMENT[] = "Receive fragment of chunk (%u), at offset (%u) with size (%u) bytes";
 char constexpr HASH_EXPECTED[] = "Expected checksum: (%s)";
 char constexpr CHECKSUM_VERIFICATION_SUCCESS[] = "Checksum is the same as expected";
 char constexpr FW_UPDATE_SUCCESS[] = "Update success";
@@ -50,10 +67,10 @@ template <typename Logger>
 class OTA_Handler {
   public:
     /// @brief Constructor
-    /// @param publish_callback Callback that is used to request the firmware chunk of the firmware binary with the given chunk number
+    /// @param publish_callback Callback that is used to request the firmware chunk of the firmware binary with the given chunk number and chunk size
     /// @param send_fw_state_callback Callback that is used to send information about the current state of the over the air update
     /// @param finish_callback Callback that is called once the update has been finished and the user should be informed of the failure or success of the over the air update
-    OTA_Handler(Callback<bool, size_t const &, size_t const &>::function publish_callback, Callback<bool, char const * const, char const * const>::function send_fw_state_callback, Callback<bool>::function finish_callback)
+    OTA_Handler(Delegate<bool, size_t const &, size_t const &, size_t const &> publish_callback, Delegate<bool, char const * const, char const * const> send_fw_state_callback, Delegate<bool> finish_callback)
       : m_fw_callback(nullptr)
       , m_publish_callback(publish_callback)
       , m_send_fw_state_callback(send_fw_state_callback)
@@ -64,6 +81,12 @@ class OTA_Handler {
       , m_hash()
       , m_total_chunks(0U)
       , m_requested_chunks(0U)
+      , m_chunk_received_bytes(0U)
+      , m_outstanding_requests(0U)
+      , m_current_chunk_size(0U)
+      , m_received_firmware_bytes(0U)
+      , m_pending_chunk_size(0U)
+      , m_successful_chunks(0U)
       , m_retries(0U)
       , m_watchdog(std::bind(&OTA_Handler::Handle_Request_Timeout, this))
     {
@@ -78,7 +101,8 @@ class OTA_Handler {
     void Start_Firmware_Update(OTA_Update_Callback const & fw_callback, size_t const & fw_size, char const * fw_checksum, mbedtls_md_type_t const & fw_checksum_algorithm) {
         m_fw_callback = &fw_callback;
         m_fw_size = fw_size;
-        m_total_chunks = (m_fw_size / m_fw_callback->Get_Chunk_Size()) + 1U;
+        m_current_chunk_size = Clamped_Chunk_Size(m_fw_callback->Get_Chunk_Size());
+        m_total_chunks = (m_fw_size / m_current_chunk_size) + 1U;
         (void)strncpy(m_fw_checksum, fw_checksum, sizeof(m_fw_checksum));
         m_fw_checksum_algorithm = fw_checksum_algorithm;
         m_fw_updater = m_fw_callback->Get_Updater();
@@ -92,6 +116,10 @@ class OTA_Handler {
     void Stop_Firmware_Update()  {
         m_watchdog.detach();
         m_fw_updater->reset();
+#if THINGSBOARD_USE_ROM_MINIZ
+        m_decompressor.reset();
+#endif // THINGSBOARD_USE_ROM_MINIZ
+        m_patcher.reset();
         Logger::printfln(FW_UPDATE_ABORTED);
         Handle_Failure(OTA_Failure_Response::RETRY_NOTHING, FW_UPDATE_ABORTED);
         m_fw_callback = nullptr;
@@ -120,30 +148,139 @@ class OTA_Handler {
 
         if (current_chunk == 0U) {
             // Initialize Flash
-            if (!m_fw_updater->begin(m_fw_size)) {
+            if (!m_fw_updater->begin(Get_Firmware_Write_Size())) {
                 Logger::printfln(ERROR_UPDATE_BEGIN);
                 return Handle_Failure(OTA_Failure_Response::RETRY_UPDATE, ERROR_UPDATE_BEGIN);
             }
+            if (!Begin_Decompression()) {
+                return Handle_Failure(OTA_Failure_Response::RETRY_NOTHING, ERROR_DECOMPRESSION_BEGIN);
+            }
+            if (!Begin_Patch_Apply()) {
+                return Handle_Failure(OTA_Failure_Response::RETRY_NOTHING, ERROR_PATCH_BEGIN);
+            }
         }
 
-        // Write received binary data to flash partition
-        size_t const written_bytes = m_fw_updater->write(payload, total_bytes);
-        if (written_bytes != total_bytes) {
-            char message[Helper::detectSize(ERROR_UPDATE_WRITE, written_bytes, total_bytes)] = {};
-            (void)snprintf(message, sizeof(message), ERROR_UPDATE_WRITE, written_bytes, total_bytes);
-            Logger::printfln(message);
-            return Handle_Failure(OTA_Failure_Response::RETRY_UPDATE, message);
+        // The next chunk is requested before the current one is written into flash, which overlaps the network round trip of the request
+        // with the flash write, instead of letting the radio idle during every write and the flash idle during every round trip.
+        // The response can not overtake the write, because received messages are only processed once this callback has returned
+        if (m_outstanding_requests != 0U) {
+            m_outstanding_requests--;
+        }
+        Record_Chunk_Success(total_bytes);
+        m_requested_chunks = current_chunk + 1;
+        if (m_requested_chunks < m_total_chunks) {
+            Request_Next_Firmware_Packet();
         }
 
-        // Update value only if writing to flash was a success, result is ignored,
-        // because it can only fail if the input parameters are invalid
-        (void)m_hash.update(payload, total_bytes);
+        // Write received binary data to flash partition, or stream it through the decompression stage first if the firmware binary is compressed
+        if (!Write_Received_Firmware_Data(payload, total_bytes)) {
+            return Handle_Failure(OTA_Failure_Response::RETRY_UPDATE, ERROR_UPDATE_WRITE_DATA);
+        }
+
+        m_fw_callback->Call_Progress_Callback(m_requested_chunks, m_total_chunks);
+
+        // Ensure to check if the update was cancelled during the progress callback,
+        // if it was the callback variable was reset and the response for the already requested next chunk is simply ignored
+        if (m_fw_callback == nullptr) {
+            Logger::printfln(OTA_CB_IS_NULL);
+            return Handle_Failure(OTA_Failure_Response::RETRY_NOTHING, OTA_CB_IS_NULL);
+        }
+
+        // Reset retries as the current chunk has been downloaded and handled successfully
+        m_retries = m_fw_callback->Get_Chunk_Retries();
+        if (m_requested_chunks >= m_total_chunks) {
+            Finish_Firmware_Update();
+        }
+    }
+
+    /// @brief Uses one received fragment of the firmware packet for the given chunk and processes it immediately.
+    /// Used instead of Process_Firmware_Packet() if the receive buffer of the underlying MQTT client is smaller than the configured chunk size,
+    /// because every fragment is written into flash memory and the hash as it arrives, the complete chunk never has to be held in memory at once
+    /// @param current_chunk Index of the chunk we recieved the binary data fragment for
+    /// @param payload Firmware packet data of the current fragment
+    /// @param length Amount of bytes in the current fragment
+    /// @param current_offset Offset of the fragment inside the complete firmware packet
+    /// @param total_bytes Total amount of bytes of the complete firmware packet the fragment belongs to
+    void Process_Firmware_Packet_Fragment(size_t const & current_chunk, uint8_t * payload, size_t const & length, size_t const & current_offset, size_t const & total_bytes) {
+        if (current_chunk != m_requested_chunks) {
+            Logger::printfln(RECEIVED_UNEXPECTED_CHUNK, current_chunk, m_requested_chunks);
+            return;
+        }
+
+        if (current_offset == 0U) {
+            size_t expected_chunk_size = 0U;
+            if (!Received_Valid_Chunk_Size(total_bytes, expected_chunk_size)) {
+                Logger::printfln(RECEIVED_UNEXPECTED_CHUNK_SIZE, expected_chunk_size, total_bytes);
+                return;
+            }
+
+            // A restarted transmission of a chunk that has already been partially written can not simply be processed again,
+            // because the already written partial data is in flash memory and in the hash and would be duplicated.
+            // Therefore the complete update is restarted instead, the same way a failed flash write is handled
+            if (m_chunk_received_bytes != 0U) {
+                m_chunk_received_bytes = 0U;
+                char message[Helper::detectSize(RECEIVED_RESTARTED_CHUNK, current_chunk)] = {};
+                (void)snprintf(message, sizeof(message), RECEIVED_RESTARTED_CHUNK, current_chunk);
+                Logger::printfln(message);
+                return Handle_Failure(OTA_Failure_Response::RETRY_UPDATE, message);
+            }
+
+            if (current_chunk == 0U) {
+                // Initialize Flash
+                if (!m_fw_updater->begin(Get_Firmware_Write_Size())) {
+                    Logger::printfln(ERROR_UPDATE_BEGIN);
+                    return Handle_Failure(OTA_Failure_Response::RETRY_UPDATE, ERROR_UPDATE_BEGIN);
+                }
+                if (!Begin_Decompression()) {
+                    return Handle_Failure(OTA_Failure_Response::RETRY_NOTHING, ERROR_DECOMPRESSION_BEGIN);
+                }
+                if (!Begin_Patch_Apply()) {
+                    return Handle_Failure(OTA_Failure_Response::RETRY_NOTHING, ERROR_PATCH_BEGIN);
+                }
+            }
+        }
+
+        // Fragments that do not continue exactly where the previously received one ended are dropped.
+        // The underlying transport (MQTT over TCP) guarantees in order delivery, meaning a gap can only be caused by an earlier dropped fragment,
+        // the chunk is then simply rerequested completly once the chunk watchdog times out
+        if (current_offset != m_chunk_received_bytes) {
+            Logger::printfln(RECEIVED_UNEXPECTED_FRAGMENT, current_offset, m_chunk_received_bytes);
+            return;
+        }
 
+    #if THINGSBOARD_ENABLE_DEBUG
+        Logger::printfln(FW_CHUNK_FRAGMENT, current_chunk, current_offset, length);
+    #endif // THINGSBOARD_ENABLE_DEBUG
+
+        // Write received binary data fragment to flash partition, or stream it through the decompression stage first if the firmware binary is compressed
+        if (!Write_Received_Firmware_Data(payload, length)) {
+            m_chunk_received_bytes = 0U;
+            return Handle_Failure(OTA_Failure_Response::RETRY_UPDATE, ERROR_UPDATE_WRITE_DATA);
+        }
+        m_chunk_received_bytes += length;
+
+        // The chunk is only completed once all its fragments have been received and written, the watchdog stays armed while the fragments arrive,
+        // meaning a transmission that stalls in the middle of a chunk is handled by the same timeout as a chunk that was never answered at all
+        if (m_chunk_received_bytes < total_bytes) {
+            return;
+        }
+        m_chunk_received_bytes = 0U;
+
+        m_watchdog.detach();
+        // The next chunk is requested before the progress callback runs, the same way the complete chunk path overlaps
+        // the network round trip of the request with the flash write of the received data
+        if (m_outstanding_requests != 0U) {
+            m_outstanding_requests--;
+        }
+        Record_Chunk_Success(total_bytes);
         m_requested_chunks = current_chunk + 1;
+        if (m_requested_chunks < m_total_chunks) {
+            Request_Next_Firmware_Packet();
+        }
         m_fw_callback->Call_Progress_Callback(m_requested_chunks, m_total_chunks);
 
         // Ensure to check if the update was cancelled during the progress callback,
-        // if it was the callback variable was reset and there is no need to request the next firmware packet
+        // if it was the callback variable was reset and the response for the already requested next chunk is simply ignored
         if (m_fw_callback == nullptr) {
             Logger::printfln(OTA_CB_IS_NULL);
             return Handle_Failure(OTA_Failure_Response::RETRY_NOTHING, OTA_CB_IS_NULL);
@@ -151,7 +288,9 @@ class OTA_Handler {
 
         // Reset retries as the current chunk has been downloaded and handled successfully
         m_retries = m_fw_callback->Get_Chunk_Retries();
-        Request_Next_Firmware_Packet();
+        if (m_requested_chunks >= m_total_chunks) {
+            Finish_Firmware_Update();
+        }
     }
 
 #if !THINGSBOARD_USE_ESP_TIMER
@@ -163,7 +302,7 @@ class OTA_Handler {
 #endif // !THINGSBOARD_USE_ESP_TIMER
 
   private:
-    /// @brief Checks whether the received chunk size matches the expected chunk size, should be the configured chunk size of the OTA_Update_Callback, CHUNK_SIZE (4096) per default
+    /// @brief Checks whether the received chunk size matches the expected chunk size, should be the chunk size the chunk was requested with
     /// and it should be the remaining bytes to fill the total firmware size with the last received chunk. If that is not the case then something went wrong with the request and we have to rerequest that specific chunk,
     /// because if we do not do that we would write missing or only partial binary data to flash and into the hash, meaning the complete OTA update will be invalidated at the end and has to be restarted
     /// @param received_chunk_size Size in bytes of the received chunk
@@ -172,17 +311,24 @@ class OTA_Handler {
     bool Received_Valid_Chunk_Size(size_t const & received_chunk_size, size_t & expected_chunk_size) {
         bool const is_last_chunk = m_requested_chunks + 1 >= m_total_chunks;
         if (is_last_chunk) {
-            size_t const last_chunk_expected_size = m_fw_size % m_fw_callback->Get_Chunk_Size();
+            size_t const last_chunk_expected_size = m_fw_size % m_current_chunk_size;
             expected_chunk_size = last_chunk_expected_size;
             return received_chunk_size == last_chunk_expected_size;
         }
-        expected_chunk_size = m_fw_callback->Get_Chunk_Size();
-        return received_chunk_size == m_fw_callback->Get_Chunk_Size();
+        expected_chunk_size = m_current_chunk_size;
+        return received_chunk_size == m_current_chunk_size;
     }
 
     /// @brief Restarts or starts the firmware update and its needed components and then requests the first firmware chunk
     void Request_First_Firmware_Packet()  {
         m_requested_chunks = 0U;
+        m_chunk_received_bytes = 0U;
+        m_outstanding_requests = 0U;
+        m_received_firmware_bytes = 0U;
+        m_pending_chunk_size = 0U;
+        m_successful_chunks = 0U;
+        m_current_chunk_size = Clamped_Chunk_Size(m_fw_callback->Get_Chunk_Size());
+        m_total_chunks = (m_fw_size / m_current_chunk_size) + 1U;
         m_retries = m_fw_callback->Get_Chunk_Retries();
         // Hash start result is ignored, because it can only fail if the input parameters are invalid
         (void)m_hash.start(m_fw_checksum_algorithm);
@@ -191,8 +337,12 @@ class OTA_Handler {
         Request_Next_Firmware_Packet();
     }
 
-    /// @brief Requests the next firmware chunk of the OTA firmware if there are any left
-    /// and starts the timer that ensures we request the same chunk again if we have not received a response yet
+    /// @brief Requests the next firmware chunks of the OTA firmware if there are any left
+    /// and starts the timer that ensures the outstanding chunks are requested again if we have not received a response yet.
+    /// Keeps up to the configured window of chunk requests outstanding simultaneously, so the following chunks are already in transit
+    /// while the current one is processed, instead of the download throughput being bound by one network round trip per chunk.
+    /// Because MQTT responses are delivered over TCP in the order the requests were received by the broker,
+    /// the outstanding responses arrive in chunk order and can be written into flash and the hash directly as they arrive
     void Request_Next_Firmware_Packet()  {
         // Check if we have already requested and handled the last remaining chunk
         if (m_requested_chunks >= m_total_chunks) {
@@ -200,8 +350,23 @@ class OTA_Handler {
             return;
         }
 
-        if (!m_publish_callback.Call_Callback(m_fw_callback->Get_Request_ID(), m_requested_chunks)) {
-            Logger::printfln(UNABLE_TO_REQUEST_CHUNCKS);
+        // A grown chunk size can only be applied once no requests are outstanding anymore, because all outstanding requests share one size,
+        // and only once the amount of received bytes is divisible by the new size, because the server maps a chunk index
+        // to the byte offset chunk * size with the size sent in the request, meaning the new indexes have to align with the received bytes
+        if (m_pending_chunk_size != 0U && m_outstanding_requests == 0U && (m_received_firmware_bytes % m_pending_chunk_size) == 0U) {
+            Apply_Chunk_Size(m_pending_chunk_size);
+            m_pending_chunk_size = 0U;
+        }
+
+        // While a chunk size change is pending the window is limited to a single outstanding request,
+        // so the outstanding requests drain quickly and the received bytes align with the new size after at most one more chunk
+        size_t const window = (m_pending_chunk_size != 0U) ? 1U : ((m_fw_callback->Get_Chunk_Window() > 1U) ? m_fw_callback->Get_Chunk_Window() : 1U);
+        while (m_outstanding_requests < window && m_requested_chunks + m_outstanding_requests < m_total_chunks) {
+            if (!m_publish_callback.Call_Callback(m_fw_callback->Get_Request_ID(), m_requested_chunks + m_outstanding_requests, m_current_chunk_size)) {
+                Logger::printfln(UNABLE_TO_REQUEST_CHUNCKS);
+                break;
+            }
+            m_outstanding_requests++;
         }
 
         // Watchdog gets started no matter if publishing request was successful or not in hopes,
@@ -217,6 +382,28 @@ class OTA_Handler {
     void Finish_Firmware_Update()  {
         (void)m_send_fw_state_callback.Call_Callback(FW_STATE_DOWNLOADED, "");
 
+#if THINGSBOARD_USE_ROM_MINIZ
+        if (m_fw_callback->Get_Firmware_Compressed()) {
+            // Ensure the compressed stream was terminated correctly, otherwise the decompressed data that was written into flash is incomplete
+            if (!m_decompressor.finish()) {
+                Logger::printfln(ERROR_DECOMPRESSION_INCOMPLETE);
+                return Handle_Failure(OTA_Failure_Response::RETRY_UPDATE, ERROR_DECOMPRESSION_INCOMPLETE);
+            }
+            // Dictionary window and decompressor state are given back already, because all data has been decompressed and the memory is not needed anymore
+            m_decompressor.reset();
+        }
+#endif // THINGSBOARD_USE_ROM_MINIZ
+
+        if (m_fw_callback->Get_Firmware_Delta()) {
+            // Ensure the patch was terminated correctly, otherwise the reconstructed firmware that was written into flash is incomplete
+            if (!m_patcher.finish()) {
+                Logger::printfln(ERROR_PATCH_INCOMPLETE);
+                return Handle_Failure(OTA_Failure_Response::RETRY_UPDATE, ERROR_PATCH_INCOMPLETE);
+            }
+            // Staging buffer is given back already, because the complete patch has been applied and the memory is not needed anymore
+            m_patcher.reset();
+        }
+
         char calculated_checksum[FIRMWARE_HASH_SIZE] = {};
         // Result of calculating final hash result is ignored,
         // because it can only fail if the input parameters are invalid and we check it afterwards anyway
@@ -233,6 +420,12 @@ class OTA_Handler {
         Logger::printfln(CHECKSUM_VERIFICATION_SUCCESS);
     #endif // THINGSBOARD_ENABLE_DEBUG
 
+        // Ensure the remainder of the binary that is still staged in the updater, because it did not fill a complete write burst anymore, is written as well
+        if (!m_fw_updater->flush()) {
+            Logger::printfln(ERROR_UPDATE_FLUSH);
+            return Handle_Failure(OTA_Failure_Response::RETRY_UPDATE, ERROR_UPDATE_FLUSH);
+        }
+
         if (!m_fw_updater->end()) {
             Logger::printfln(ERROR_UPDATE_END);
             return Handle_Failure(OTA_Failure_Response::RETRY_UPDATE, ERROR_UPDATE_END);
@@ -285,19 +478,185 @@ class OTA_Handler {
         }
     }
 
+    /// @brief Records one completly received and handled chunk for the adaptive chunk sizing,
+    /// once enough chunks arrived in a row without a timeout the requested chunk size is grown to the next bound
+    /// @param received_bytes Amount of bytes the received chunk contained
+    void Record_Chunk_Success(size_t const & received_bytes) {
+        m_received_firmware_bytes += received_bytes;
+        size_t const maximum = m_fw_callback->Get_Chunk_Size_Maximum();
+        if (maximum == 0U) {
+            return;
+        }
+        if (++m_successful_chunks < CHUNKS_BEFORE_GROWTH) {
+            return;
+        }
+        m_successful_chunks = 0U;
+        size_t const grown_chunk_size = m_current_chunk_size * 2U;
+        if (grown_chunk_size <= maximum) {
+            m_pending_chunk_size = grown_chunk_size;
+        }
+    }
+
+    /// @brief Applies the given chunk size for all following chunk requests,
+    /// remaps the chunk index and total chunk amount so the next requested index points at the first byte that has not been received yet
+    /// @param chunk_size Chunk size the following chunks are requested with
+    void Apply_Chunk_Size(size_t const & chunk_size) {
+        m_current_chunk_size = chunk_size;
+        m_requested_chunks = m_received_firmware_bytes / chunk_size;
+        m_total_chunks = (m_fw_size / chunk_size) + 1U;
+        Logger::printfln(CHUNK_SIZE_CHANGED, chunk_size);
+    }
+
+    /// @brief Clamps the given chunk size into the bounds configured for the adaptive chunk sizing,
+    /// returns the size unchanged if the adaptive chunk sizing is not enabled at all
+    /// @param chunk_size Chunk size that should be clamped
+    /// @return Chunk size within the configured bounds
+    size_t Clamped_Chunk_Size(size_t const & chunk_size) const {
+        size_t const minimum = m_fw_callback->Get_Chunk_Size_Minimum();
+        size_t const maximum = m_fw_callback->Get_Chunk_Size_Maximum();
+        if (maximum == 0U) {
+            return chunk_size;
+        }
+        if (chunk_size < minimum) {
+            return minimum;
+        }
+        if (chunk_size > maximum) {
+            return maximum;
+        }
+        return chunk_size;
+    }
+
+    /// @brief Starts the decompression stage if the received firmware binary is compressed, called once the first chunk of the firmware binary arrives.
+    /// Fails if the platform does not contain a decompressor or if allocating the internally needed memory failed
+    /// @return Whether the decompression stage is ready to receive data or whether no decompression is needed at all
+    bool Begin_Decompression() {
+        if (!m_fw_callback->Get_Firmware_Compressed()) {
+            return true;
+        }
+#if THINGSBOARD_USE_ROM_MINIZ
+        if (m_decompressor.begin(Delegate<bool, uint8_t *, size_t const &>::Create<OTA_Handler, &OTA_Handler::Process_Decompressed_Data>(this))) {
+            return true;
+        }
+        Logger::printfln(ERROR_DECOMPRESSION_BEGIN);
+#else
+        Logger::printfln(COMPRESSION_NOT_SUPPORTED);
+#endif // THINGSBOARD_USE_ROM_MINIZ
+        return false;
+    }
+
+    /// @brief Writes the given received firmware binary data into the flash updater and the hash.
+    /// If the firmware binary is compressed the received data is streamed through the decompression stage instead,
+    /// which then forwards every decompressed block to Process_Decompressed_Data(),
+    /// meaning the hash is calculated over the decompressed data and verifies what was actually written into flash
+    /// @param payload Received firmware binary data
+    /// @param received_bytes Amount of bytes in the received firmware binary data
+    /// @return Whether writing the received data was successful or not
+    bool Write_Received_Firmware_Data(uint8_t * payload, size_t const & received_bytes) {
+#if THINGSBOARD_USE_ROM_MINIZ
+        if (m_fw_callback->Get_Firmware_Compressed()) {
+            if (!m_decompressor.update(payload, received_bytes)) {
+                Logger::printfln(ERROR_DECOMPRESSION);
+                return false;
+            }
+            return true;
+        }
+#endif // THINGSBOARD_USE_ROM_MINIZ
+        return Process_Decompressed_Data(payload, received_bytes);
+    }
+
+    /// @brief Forwards the given firmware binary data to the next stage of the receive pipeline.
+    /// Receives the data directly if the firmware binary is not compressed, or every decompressed block produced by the decompression stage if it is.
+    /// If the artifact is a binary delta patch the data is streamed through the patch application stage,
+    /// which then forwards every reconstructed block to Write_Firmware_Data(), otherwise the data is written directly
+    /// @param payload Firmware binary data that should be forwarded
+    /// @param length Amount of bytes in the given data
+    /// @return Whether processing the data was successful or not
+    bool Process_Decompressed_Data(uint8_t * payload, size_t const & length) {
+        if (m_fw_callback->Get_Firmware_Delta()) {
+            if (!m_patcher.update(payload, length)) {
+                Logger::printfln(ERROR_PATCH);
+                return false;
+            }
+            return true;
+        }
+        return Write_Firmware_Data(payload, length);
+    }
+
+    /// @brief Writes the given firmware binary data into the flash updater and updates the hash with it,
+    /// last stage of the receive pipeline, only ever receives the final data that actually ends up in flash,
+    /// meaning the hash always verifies exactly what was written
+    /// @param payload Firmware binary data that should be written
+    /// @param length Amount of bytes in the given data
+    /// @return Whether writing the data was successful or not
+    bool Write_Firmware_Data(uint8_t * payload, size_t const & length) {
+        size_t const written_bytes = m_fw_updater->write(payload, length);
+        if (written_bytes != length) {
+            Logger::printfln(ERROR_UPDATE_WRITE, written_bytes, length);
+            return false;
+        }
+        // Update value only if writing to flash was a success, result is ignored,
+        // because it can only fail if the input parameters are invalid
+        (void)m_hash.update(payload, length);
+        return true;
+    }
+
+    /// @brief Reads the given region of the currently running firmware with the flash updater,
+    /// used by the patch application stage as the source for reconstructing the new firmware
+    /// @param offset Offset of the region inside the currently running firmware
+    /// @param payload Buffer the read region will be written into
+    /// @param length Amount of bytes that should be read
+    /// @return Amount of bytes that were actually read
+    size_t Read_Current_Firmware(size_t const & offset, uint8_t * payload, size_t const & length) {
+        return m_fw_updater->read_current(offset, payload, length);
+    }
+
+    /// @brief Starts the patch application stage if the received artifact is a binary delta patch, called once the first chunk of the artifact arrives
+    /// @return Whether the patch application stage is ready to receive data or whether no patch application is needed at all
+    bool Begin_Patch_Apply() {
+        if (!m_fw_callback->Get_Firmware_Delta()) {
+            return true;
+        }
+        if (m_patcher.begin(Delegate<size_t, size_t const &, uint8_t *, size_t const &>::Create<OTA_Handler, &OTA_Handler::Read_Current_Firmware>(this), Delegate<bool, uint8_t *, size_t const &>::Create<OTA_Handler, &OTA_Handler::Write_Firmware_Data>(this))) {
+            return true;
+        }
+        Logger::printfln(ERROR_PATCH_BEGIN);
+        return false;
+    }
+
+    /// @brief Returns the firmware size the flash updater is started with.
+    /// The size received from the server describes the downloaded artifact, which only matches the written firmware if the artifact is written unmodified,
+    /// if it is decompressed or applied as a patch first the final size is not known upfront and 0 is passed instead,
+    /// meaning the updater has to prepare for an unknown size
+    /// @return Firmware size the flash updater is started with
+    size_t Get_Firmware_Write_Size() const {
+        return (m_fw_callback->Get_Firmware_Compressed() || m_fw_callback->Get_Firmware_Delta()) ? 0U : m_fw_size;
+    }
+
     /// @brief Callback that will be called if we did not receive the firmware chunk response in the given timeout time
     void Handle_Request_Timeout()  {
         uint64_t const & timeout = m_fw_callback->Get_Timeout();
         char message[Helper::detectSize(CHUNK_REQUEST_TIMED_OUT, m_requested_chunks, timeout)] = {};
         (void)snprintf(message, sizeof(message), CHUNK_REQUEST_TIMED_OUT, m_requested_chunks, timeout);
         Logger::printfln(message);
+        // All outstanding requests are considered lost once the timeout expired and the complete window is requested again,
+        // responses to the original requests that still arrive afterwards are simply dropped by the expected chunk check
+        m_outstanding_requests = 0U;
+        // A timed out chunk indicates the current chunk size is too big for the link,
+        // the following requests back off to half the size within the configured bounds.
+        // Halving is always applicable immediately, because the received bytes stay divisible by half the size
+        size_t const halved_chunk_size = m_current_chunk_size / 2U;
+        if (m_fw_callback->Get_Chunk_Size_Maximum() != 0U && halved_chunk_size != 0U && halved_chunk_size >= m_fw_callback->Get_Chunk_Size_Minimum()) {
+            m_successful_chunks = 0U;
+            m_pending_chunk_size = 0U;
+            Apply_Chunk_Size(halved_chunk_size);
+        }
         Handle_Failure(OTA_Failure_Response::RETRY_CHUNK, message);
     }
 
     const OTA_Update_Callback                              *m_fw_callback = {};                    // Callback method that contains configuration information, about the over the air update
-    Callback<bool, size_t const &, size_t const &>         m_publish_callback = {};                // Callback that is used to request the firmware chunk of the firmware binary with the given chunk number
-    Callback<bool, char const * const, char const * const> m_send_fw_state_callback = {};          // Callback that is used to send information about the current state of the over the air update
-    Callback<bool>                                         m_finish_callback = {};                 // Callback that is called once the update has been finished and the user should be informed of the failure or success of the over the air update
+    Delegate<bool, size_t const &, size_t const &, size_t const &> m_publish_callback = {};        // Callback that is used to request the firmware chunk of the firmware binary with the given chunk number and chunk size
+    Delegate<bool, char const * const, char const * const> m_send_fw_state_callback = {};          // Callback that is used to send information about the current state of the over the air update
+    Delegate<bool>                                         m_finish_callback = {};                 // Callback that is called once the update has been finished and the user should be informed of the failure or success of the over the air update
     size_t                                                 m_fw_size = {};                         // Total size of the firmware binary we will receive. Allows for a binary size of up to theoretically 4 GB
     char                                                   m_fw_checksum[FIRMWARE_HASH_SIZE] = {}; // Checksum of the complete firmware binary, should be the same as the actually written data in the end
     mbedtls_md_type_t                                      m_fw_checksum_algorithm = {};           // Algorithm type used to hash the firmware binary
@@ -305,8 +664,18 @@ class OTA_Handler {
     HashGenerator                                          m_hash = {};                            // Class instance that allows to generate a hash from received firmware binary data
     size_t                                                 m_total_chunks = {};                    // Total amount of chunks that need to be received to get the complete firmware binary
     size_t                                                 m_requested_chunks = {};                // Amount of successfully requested and received firmware binary chunks
+    size_t                                                 m_chunk_received_bytes = {};            // Amount of bytes of the currently requested chunk that have already been received as fragments and written
+    size_t                                                 m_outstanding_requests = {};            // Amount of chunk requests that are currently in transit simultaneously, bounded by the window configured in the callback
+    size_t                                                 m_current_chunk_size = {};              // Chunk size the chunks are currently requested with, fixed to the configured chunk size unless adaptive chunk sizing is enabled
+    size_t                                                 m_received_firmware_bytes = {};         // Amount of bytes of the firmware binary that have been received and handled completly, basis for remapping chunk indexes once the chunk size changes
+    size_t                                                 m_pending_chunk_size = {};              // Chunk size the following requests should grow to, only applied once no requests are outstanding and the received bytes align with the new size
+    uint8_t                                                m_successful_chunks = {};               // Amount of chunks that arrived in a row without a timeout, once enough arrived the requested chunk size is grown
     uint8_t                                                m_retries = {};                         // Amount of request retries we attempt for each chunk, increasing makes the connection more stable
     Callback_Watchdog                                      m_watchdog = {};                        // Class instances that allows to timeout if we do not receive a response for a requested chunk in the given time
+#if THINGSBOARD_USE_ROM_MINIZ
+    Gzip_Decompressor                                      m_decompressor = {};                    // Decompression stage that compressed firmware binary data is streamed through before it is written into flash and the hash
+#endif // THINGSBOARD_USE_ROM_MINIZ
+    Delta_Patcher                                          m_patcher = {};                         // Patch application stage that reconstructs the new firmware from a binary delta patch and the currently running firmware
 };
 
 #endif // OTA_Handler_h
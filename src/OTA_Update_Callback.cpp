@@ -1,7 +1,7 @@
 // Header include.
 #include "OTA_Update_Callback.h"
 
-OTA_Update_Callback::OTA_Update_Callback(char const * current_fw_title, char const * current_fw_version, IUpdater * updater, function finished_callback, Callback<void, size_t const &, size_t const &>::function progress_callback, Callback<void>::function update_starting_callback, uint8_t chunk_retries, uint16_t chunk_size, uint64_t const & timeout_microseconds)
+OTA_Update_Callback::OTA_Update_Callback(char const * current_fw_title, char const * current_fw_version, IUpdater * updater, function finished_callback, Callback<void, size_t const &, size_t const &>::function progress_callback, Callback<void>::function update_starting_callback, uint8_t chunk_retries, uint16_t chunk_size, uint64_t const & timeout_microseconds, uint8_t chunk_window, bool firmware_compressed, bool firmware_delta)
   : Callback(finished_callback)
   , m_current_fw_title(current_fw_title)
   , m_current_fw_version(current_fw_version)
@@ -11,6 +11,9 @@ OTA_Update_Callback::OTA_Update_Callback(char const * current_fw_title, char con
   , m_chunk_retries(chunk_retries)
   , m_chunk_size(chunk_size)
   , m_timeout_microseconds(timeout_microseconds)
+  , m_chunk_window(chunk_window)
+  , m_firmware_compressed(firmware_compressed)
+  , m_firmware_delta(firmware_delta)
 {
     // Nothing to do
 }
@@ -86,3 +89,40 @@ uint64_t const & OTA_Update_Callback::Get_Timeout() const {
 void OTA_Update_Callback::Set_Timeout(const uint64_t & timeout_microseconds) {
     m_timeout_microseconds = timeout_microseconds;
 }
+
+uint8_t OTA_Update_Callback::Get_Chunk_Window() const {
+    return m_chunk_window;
+}
+
+void OTA_Update_Callback::Set_Chunk_Window(uint8_t chunk_window) {
+    m_chunk_window = chunk_window;
+}
+
+bool OTA_Update_Callback::Get_Firmware_Compressed() const {
+    return m_firmware_compressed;
+}
+
+void OTA_Update_Callback::Set_Firmware_Compressed(bool firmware_compressed) {
+    m_firmware_compressed = firmware_compressed;
+}
+
+bool OTA_Update_Callback::Get_Firmware_Delta() const {
+    return m_firmware_delta;
+}
+
+void OTA_Update_Callback::Set_Firmware_Delta(bool firmware_delta) {
+    m_firmware_delta = firmware_delta;
+}
+
+uint16_t OTA_Update_Callback::Get_Chunk_Size_Minimum() const {
+    return m_chunk_size_minimum;
+}
+
+uint16_t OTA_Update_Callback::Get_Chunk_Size_Maximum() const {
+    return m_chunk_size_maximum;
+}
+
+void OTA_Update_Callback::Set_Adaptive_Chunk_Size(uint16_t chunk_size_minimum, uint16_t chunk_size_maximum) {
+    m_chunk_size_minimum = chunk_size_minimum;
+    m_chunk_size_maximum = chunk_size_maximum;
+}
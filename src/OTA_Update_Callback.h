@@ -10,6 +10,9 @@
 
 // OTA default values.
 uint8_t constexpr CHUNK_RETRIES = 12U;
+uint8_t constexpr CHUNK_WINDOW = 1U;
+bool constexpr FIRMWARE_COMPRESSED = false;
+bool constexpr FIRMWARE_DELTA = false;
 uint16_t constexpr CHUNK_SIZE = (4U * 1024U);
 uint64_t constexpr REQUEST_TIMEOUT = (5U * 1000U * 1000U);
 
@@ -45,7 +48,17 @@ class OTA_Update_Callback : public Callback<void, bool const &> {
     // because the whole chunk is saved into the heap before it can be processed and is then erased again after it has been used, default = CHUNK_SIZE
     /// @param timeout Maximum amount of time in microseconds for the OTA firmware update for each seperate chunk,
     /// until that chunk counts as a timeout, retries is then subtraced by one and the download is retried, default = REQUEST_TIMEOUT
-    OTA_Update_Callback(char const * current_fw_title, char const * current_fw_version, IUpdater * updater, function finished_callback, Callback<void, size_t const &, size_t const &>::function progress_callback = nullptr, Callback<void>::function update_starting_callback = nullptr, uint8_t chunk_retries = CHUNK_RETRIES, uint16_t chunk_size = CHUNK_SIZE, uint64_t const & timeout_microseconds = REQUEST_TIMEOUT);
+    /// @param chunk_window Amount of chunk requests that are kept outstanding simultaneously,
+    /// increasing the window pipelines the requests so the download throughput is not bound by one network round trip per chunk,
+    /// which especially speeds up the complete update on high latency connections (cellular), default = CHUNK_WINDOW
+    /// @param firmware_compressed Whether the firmware binary on the server is gzip compressed and has to be decompressed while it is downloaded,
+    /// requires the expected checksum to be the checksum of the decompressed firmware binary, because the hash is calculated over the decompressed data.
+    /// Roughly halves the amount of transferred bytes for typical firmware binaries, only supported on platforms where the miniz rom decompressor exists, default = FIRMWARE_COMPRESSED
+    /// @param firmware_delta Whether the artifact on the server is a binary delta patch instead of a complete firmware binary,
+    /// the new firmware is then reconstructed by applying the patch against the currently running firmware while the patch is downloaded.
+    /// Requires an updater that implements read_current(), the expected checksum to be the checksum of the reconstructed firmware binary
+    /// and a patch in the format described in Delta_Patcher.h, created against the exact firmware version the device is running, default = FIRMWARE_DELTA
+    OTA_Update_Callback(char const * current_fw_title, char const * current_fw_version, IUpdater * updater, function finished_callback, Callback<void, size_t const &, size_t const &>::function progress_callback = nullptr, Callback<void>::function update_starting_callback = nullptr, uint8_t chunk_retries = CHUNK_RETRIES, uint16_t chunk_size = CHUNK_SIZE, uint64_t const & timeout_microseconds = REQUEST_TIMEOUT, uint8_t chunk_window = CHUNK_WINDOW, bool firmware_compressed = FIRMWARE_COMPRESSED, bool firmware_delta = FIRMWARE_DELTA);
 
     /// @brief Gets the current firmware title, used to decide if an OTA firmware update is already installed and therefore should not be downladed,
     /// this is only done if the title of the update and the current firmware title are the same because if they are not then this firmware is meant for another device type
@@ -143,6 +156,54 @@ class OTA_Update_Callback : public Callback<void, bool const &> {
     /// @param timeout_microseconds Timeout time until we expect a response from the server
     void Set_Timeout(uint64_t const & timeout_microseconds);
 
+    /// @brief Gets the amount of chunk requests that are kept outstanding simultaneously,
+    /// increasing the window pipelines the requests so the download throughput is not bound by one network round trip per chunk
+    /// @return Amount of simultaneously outstanding chunk requests
+    uint8_t Get_Chunk_Window() const;
+
+    /// @brief Sets the amount of chunk requests that are kept outstanding simultaneously,
+    /// increasing the window pipelines the requests so the download throughput is not bound by one network round trip per chunk
+    /// @param chunk_window Amount of simultaneously outstanding chunk requests
+    void Set_Chunk_Window(uint8_t chunk_window);
+
+    /// @brief Gets whether the firmware binary on the server is gzip compressed and has to be decompressed while it is downloaded
+    /// @return Whether the firmware binary is gzip compressed or not
+    bool Get_Firmware_Compressed() const;
+
+    /// @brief Sets whether the firmware binary on the server is gzip compressed and has to be decompressed while it is downloaded.
+    /// Requires the expected checksum to be the checksum of the decompressed firmware binary, because the hash is calculated over the decompressed data.
+    /// Roughly halves the amount of transferred bytes for typical firmware binaries, only supported on platforms where the miniz rom decompressor exists
+    /// @param firmware_compressed Whether the firmware binary is gzip compressed or not
+    void Set_Firmware_Compressed(bool firmware_compressed);
+
+    /// @brief Gets whether the artifact on the server is a binary delta patch that is applied against the currently running firmware
+    /// @return Whether the artifact is a binary delta patch or not
+    bool Get_Firmware_Delta() const;
+
+    /// @brief Sets whether the artifact on the server is a binary delta patch instead of a complete firmware binary,
+    /// the new firmware is then reconstructed by applying the patch against the currently running firmware while the patch is downloaded.
+    /// Requires an updater that implements read_current(), the expected checksum to be the checksum of the reconstructed firmware binary
+    /// and a patch in the format described in Delta_Patcher.h, created against the exact firmware version the device is running
+    /// @param firmware_delta Whether the artifact is a binary delta patch or not
+    void Set_Firmware_Delta(bool firmware_delta);
+
+    /// @brief Gets the lower bound the requested chunk size can be decreased to while adapting to the measured link quality
+    /// @return Lower chunk size bound in bytes, 0 if the chunk size is not adapted at all
+    uint16_t Get_Chunk_Size_Minimum() const;
+
+    /// @brief Gets the upper bound the requested chunk size can be increased to while adapting to the measured link quality
+    /// @return Upper chunk size bound in bytes, 0 if the chunk size is not adapted at all
+    uint16_t Get_Chunk_Size_Maximum() const;
+
+    /// @brief Enables adapting the requested chunk size to the measured link quality during the transfer, within the given bounds.
+    /// The transfer starts with the configured chunk size, grows it once multiple chunks in a row arrived without a timeout
+    /// and backs off to half the size once a chunk request timed out, meaning the same firmware build gets a fitting chunk size on good and bad links alike.
+    /// The given bounds and the configured chunk size are expected to be powers of two, because the size is always doubled or halved,
+    /// chunk sizes that grow beyond the receive buffer of the underlying MQTT client additionally require a client that supports receiving messages fragment by fragment
+    /// @param chunk_size_minimum Lower chunk size bound in bytes the size can be decreased to
+    /// @param chunk_size_maximum Upper chunk size bound in bytes the size can be increased to
+    void Set_Adaptive_Chunk_Size(uint16_t chunk_size_minimum, uint16_t chunk_size_maximum);
+
   private:
     char const                                     *m_current_fw_title = {};        // Current firmware title of device
     char const                                     *m_current_fw_version = {};      // Current firmware version of device
@@ -153,6 +214,11 @@ class OTA_Update_Callback : public Callback<void, bool const &> {
     uint8_t                                        m_chunk_retries = {};            // Maximum amount of retries for a single chunk to be downloaded and flashed successfully
     uint16_t                                       m_chunk_size = {};               // Size of chunks the firmware data will be split into
     uint64_t                                       m_timeout_microseconds = {};     // How long we wait for each chunck to arrive before declaring it as failed
+    uint8_t                                        m_chunk_window = {};             // Amount of chunk requests that are kept outstanding simultaneously
+    bool                                           m_firmware_compressed = {};      // Whether the firmware binary is gzip compressed and has to be decompressed while it is downloaded
+    bool                                           m_firmware_delta = {};           // Whether the artifact is a binary delta patch that is applied against the currently running firmware
+    uint16_t                                       m_chunk_size_minimum = {};       // Lower bound the requested chunk size can be decreased to, 0 if the chunk size is not adapted at all
+    uint16_t                                       m_chunk_size_maximum = {};       // Upper bound the requested chunk size can be increased to, 0 if the chunk size is not adapted at all
 };
 
 #endif // OTA_Update_Callback_h
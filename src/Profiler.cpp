@@ -0,0 +1,55 @@
+// Header include.
+#include "Profiler.h"
+
+#if THINGSBOARD_ENABLE_PROFILING
+
+// Library includes.
+#if THINGSBOARD_USE_ESP_TIMER
+#include <esp_timer.h>
+#else
+#include <Arduino.h>
+#endif // THINGSBOARD_USE_ESP_TIMER
+
+// Accumulated statistics of every instrumented stage, zero initialized with static storage duration
+static Profile_Stage_Stats profile_stats[PROFILE_STAGE_COUNT] = {};
+
+uint64_t Profiler::timestamp() {
+#if THINGSBOARD_USE_ESP_TIMER
+    return static_cast<uint64_t>(esp_timer_get_time());
+#else
+    return micros();
+#endif // THINGSBOARD_USE_ESP_TIMER
+}
+
+void Profiler::record(Profile_Stage stage, uint64_t const & start_timestamp) {
+    uint64_t const duration_microseconds = timestamp() - start_timestamp;
+    Profile_Stage_Stats & stats = profile_stats[static_cast<uint8_t>(stage)];
+
+    stats.total_microseconds += duration_microseconds;
+    stats.samples++;
+    if (duration_microseconds > stats.maximum_microseconds) {
+        stats.maximum_microseconds = static_cast<uint32_t>(duration_microseconds);
+    }
+    // The bucket is the position of the highest set bit of the microsecond value, durations below one microsecond fall into bucket 0
+    // and everything too long for the covered range is collected in the last bucket
+    uint8_t bucket = 0U;
+    if (duration_microseconds != 0U) {
+        bucket = 63U - static_cast<uint8_t>(__builtin_clzll(duration_microseconds));
+        if (bucket >= PROFILER_BUCKET_COUNT) {
+            bucket = PROFILER_BUCKET_COUNT - 1U;
+        }
+    }
+    stats.buckets[bucket]++;
+}
+
+Profile_Stage_Stats const & Profiler::stats(Profile_Stage stage) {
+    return profile_stats[static_cast<uint8_t>(stage)];
+}
+
+void Profiler::reset() {
+    for (uint8_t stage = 0U; stage < PROFILE_STAGE_COUNT; stage++) {
+        profile_stats[stage] = Profile_Stage_Stats{};
+    }
+}
+
+#endif // THINGSBOARD_ENABLE_PROFILING
@@ -0,0 +1,94 @@
+#ifndef Profiler_h
+#define Profiler_h
+
+// Local include.
+#include "Configuration.h"
+
+#if THINGSBOARD_ENABLE_PROFILING
+
+// Library include.
+#include <stdint.h>
+
+
+// Amount of power of two histogram buckets each stage records its durations into,
+// bucket i counts the durations whose microsecond value has its highest set bit at position i,
+// meaning the buckets cover 1us up to about 32ms with the last bucket collecting everything above
+uint8_t constexpr PROFILER_BUCKET_COUNT = 16U;
+
+
+/// @brief Instrumented stages of the hot send and receive paths, used as the index into the accumulated per-stage statistics
+enum class Profile_Stage : uint8_t {
+    SEND_MEASURE,        ///< Measuring the serialized size of the outgoing payload
+    SEND_SERIALIZE,      ///< Serializing the outgoing payload into the prepared buffer
+    SEND_PUBLISH,        ///< Handing the serialized payload to the underlying MQTT client
+    RECEIVE_TOPIC_MATCH, ///< Matching the received topic against the subscribed api implementations
+    RECEIVE_SIZE_SCAN,   ///< Scanning the received payload for json delimiters to estimate the needed document size
+    RECEIVE_DESERIALIZE, ///< Deserializing the received payload into the json document
+    RECEIVE_DISPATCH     ///< Dispatching the received message to the matched api implementations
+};
+uint8_t constexpr PROFILE_STAGE_COUNT = 7U;
+
+
+/// @brief Accumulated duration statistics of one instrumented stage
+struct Profile_Stage_Stats {
+    uint64_t total_microseconds;               // Sum of all recorded durations in microseconds, divided by samples this gives the average duration
+    uint32_t samples;                          // Amount of durations that were recorded for the stage
+    uint32_t maximum_microseconds;             // Longest single duration in microseconds that was recorded for the stage
+    uint32_t buckets[PROFILER_BUCKET_COUNT];   // Histogram of the recorded durations, bucket i counts the durations whose microsecond value has its highest set bit at position i
+};
+
+
+/// @brief Accumulates the duration of the instrumented stages of the hot send and receive paths into per-stage histograms.
+/// Every probe only takes two timestamps and increments a handful of counters, meaning the instrumentation itself does not distort what it measures,
+/// and with THINGSBOARD_ENABLE_PROFILING disabled every probe compiles away completly so the release build pays nothing.
+/// The counters are deliberately updated without atomic operations, because a stage is always recorded from the one task it runs on
+/// and the retrieval of the statistics is best-effort by nature, a torn read simply shows up as a slightly inconsistent snapshot
+class Profiler {
+  public:
+    /// @brief Gets the current timestamp the duration of a stage is measured with,
+    /// uses the ESP Timer if it exists and the Arduino micros() method as a fallback, the same way the timeout timers do
+    /// @return Amount of microseconds since boot
+    static uint64_t timestamp();
+
+    /// @brief Records the duration of one completed stage into its accumulated statistics
+    /// @param stage Stage the duration is recorded for
+    /// @param start_timestamp Timestamp that was taken with timestamp() when the stage started
+    static void record(Profile_Stage stage, uint64_t const & start_timestamp);
+
+    /// @brief Gets the accumulated statistics of the given stage
+    /// @param stage Stage the statistics should be returned for
+    /// @return Reference to the accumulated statistics, stays valid for the complete lifetime of the program
+    static Profile_Stage_Stats const & stats(Profile_Stage stage);
+
+    /// @brief Resets the accumulated statistics of every stage back to zero,
+    /// useful to measure a specific phase of the program in isolation
+    static void reset();
+};
+
+
+/// @brief Scoped probe that records the duration from its construction until the end of the enclosing scope for the given stage.
+/// Used for stages that span a complete function, stages that only cover a part of one are measured with explicit timestamp() and record() calls instead
+class Profile_Probe {
+  public:
+    /// @brief Constructs the probe and takes the start timestamp of the measured stage
+    /// @param stage Stage the duration is recorded for once the enclosing scope ends
+    explicit Profile_Probe(Profile_Stage stage)
+      : m_stage(stage)
+      , m_start_timestamp(Profiler::timestamp())
+    {
+        // Nothing to do
+    }
+
+    /// @brief Destructor, records the duration since construction for the given stage
+    ~Profile_Probe() {
+        Profiler::record(m_stage, m_start_timestamp);
+    }
+
+  private:
+    Profile_Stage m_stage;           // Stage the measured duration is recorded for
+    uint64_t      m_start_timestamp; // Timestamp that was taken when the probe was constructed
+};
+
+#endif // THINGSBOARD_ENABLE_PROFILING
+
+#endif // Profiler_h
@@ -4,6 +4,7 @@
 // Local includes.
 #include "Provision_Callback.h"
 #include "IAPI_Implementation.h"
+#include "ICredentials_Store.h"
 
 
 // Provision topics.
@@ -19,6 +20,15 @@ char constexpr PROV_CRED_USERNAME[] = "username";
 char constexpr PROV_CRED_PASSWORD[] = "password";
 char constexpr PROV_CRED_CLIENT_ID[] = "clientId";
 char constexpr PROV_CRED_HASH[] = "hash";
+// Provision response keys and values, used to extract the issued credentials for the optional credentials store.
+char constexpr PROV_STATUS_KEY[] = "status";
+char constexpr PROV_STATUS_SUCCESS[] = "SUCCESS";
+char constexpr PROV_CRED_VALUE_KEY[] = "credentialsValue";
+char constexpr PROV_CRED_RESPONSE_USERNAME[] = "userName";
+char constexpr PROV_CRED_TYPE_ACCESS_TOKEN[] = "ACCESS_TOKEN";
+char constexpr PROV_CRED_TYPE_MQTT_BASIC[] = "MQTT_BASIC";
+// Log messages.
+char constexpr PROV_CREDENTIALS_STORE_FAILED[] = "Persisting the provisioned credentials in the credentials store failed";
 
 
 /// @brief Handles the internal implementation of the ThingsBoard provision API.
@@ -91,6 +101,17 @@ class Provision : public IAPI_Implementation {
         return m_send_json_callback.Call_Callback(PROV_REQUEST_TOPIC, request_buffer, Helper::Measure_Json(request_buffer));
     }
 
+    /// @brief Sets the credentials store the credentials issued by a successful provision response are automatically persisted into.
+    /// Lets subsequent boots skip the complete provision exchange, because the persisted credentials can be consumed
+    /// directly by the connect() method of the ThingsBoard client, which significantly reduces the wake-to-first-telemetry time
+    /// of devices that sleep between transmissions. Only access token and basic MQTT credentials can be persisted,
+    /// X.509 certificate credentials are not received from the cloud and therefore do not require persisting
+    /// @param credentials_store Credentials store implementation the issued credentials are persisted into,
+    /// or nullptr if issued credentials should not be persisted anymore
+    void Set_Credentials_Store(ICredentials_Store * credentials_store) {
+        m_credentials_store = credentials_store;
+    }
+
     API_Process_Type Get_Process_Type() const override {
         return API_Process_Type::JSON;
     }
@@ -101,6 +122,9 @@ class Provision : public IAPI_Implementation {
 
     void Process_Json_Response(char const * topic, JsonDocument const & data) override {
         m_provision_callback.Stop_Timeout_Timer();
+        if (m_credentials_store != nullptr) {
+            Cache_Credentials(data);
+        }
         m_provision_callback.Call_Callback(data);
         // Unsubscribe from the provision response topic,
         // Will be resubscribed if another request is sent anyway
@@ -111,6 +135,10 @@ class Provision : public IAPI_Implementation {
         return strncmp(PROV_RESPONSE_TOPIC, topic, strlen(PROV_RESPONSE_TOPIC) + 1) == 0;
     }
 
+    char const * Get_Response_Topic_Prefix() const override {
+        return PROV_RESPONSE_TOPIC;
+    }
+
     bool Unsubscribe() override {
         return Provision_Unsubscribe();
     }
@@ -133,7 +161,7 @@ class Provision : public IAPI_Implementation {
         // Nothing to do
     }
 
-    void Set_Client_Callbacks(Callback<void, IAPI_Implementation &>::function subscribe_api_callback, Callback<bool, char const * const, JsonDocument const &, size_t const &>::function send_json_callback, Callback<bool, char const * const, char const * const>::function send_json_string_callback, Callback<bool, char const * const>::function subscribe_topic_callback, Callback<bool, char const * const>::function unsubscribe_topic_callback, Callback<uint16_t>::function get_receive_size_callback, Callback<uint16_t>::function get_send_size_callback, Callback<bool, uint16_t, uint16_t>::function set_buffer_size_callback, Callback<size_t *>::function get_request_id_callback) override {
+    void Set_Client_Callbacks(Delegate<void, IAPI_Implementation &> subscribe_api_callback, Delegate<bool, char const * const, JsonDocument const &, size_t const &> send_json_callback, Delegate<bool, char const * const, char const * const> send_json_string_callback, Delegate<bool, char const * const> subscribe_topic_callback, Delegate<bool, char const * const> unsubscribe_topic_callback, Delegate<uint16_t> get_receive_size_callback, Delegate<uint16_t> get_send_size_callback, Delegate<bool, uint16_t, uint16_t> set_buffer_size_callback, Delegate<size_t *> get_request_id_callback) override {
         m_send_json_callback.Set_Callback(send_json_callback);
         m_subscribe_topic_callback.Set_Callback(subscribe_topic_callback);
         m_unsubscribe_topic_callback.Set_Callback(unsubscribe_topic_callback);
@@ -153,6 +181,51 @@ private:
         return true;
     }
 
+    /// @brief Extracts the credentials issued by the given provision response and persists them in the configured credentials store.
+    /// Only called if a credentials store has been configured with Set_Credentials_Store(), responses that do not report a successful provision
+    /// or contain a credentials type that can not be persisted (X.509 certificate) are simply skipped
+    /// @param data Received provision response containing the issued credentials
+    void Cache_Credentials(JsonDocument const & data) {
+        char const * status = data[PROV_STATUS_KEY];
+        if (status == nullptr || strcmp(status, PROV_STATUS_SUCCESS) != 0) {
+            return;
+        }
+        char const * credentials_type = data[PROV_CRED_TYPE_KEY];
+        if (credentials_type == nullptr) {
+            return;
+        }
+        Provisioned_Credentials credentials = {};
+        if (strcmp(credentials_type, PROV_CRED_TYPE_ACCESS_TOKEN) == 0) {
+            char const * access_token = data[PROV_CRED_VALUE_KEY];
+            if (Helper::stringIsNullorEmpty(access_token)) {
+                return;
+            }
+            (void)snprintf(credentials.access_token, sizeof(credentials.access_token), "%s", access_token);
+        }
+        else if (strcmp(credentials_type, PROV_CRED_TYPE_MQTT_BASIC) == 0) {
+            JsonObjectConst const credentials_value = data[PROV_CRED_VALUE_KEY].template as<JsonObjectConst>();
+            char const * username = credentials_value[PROV_CRED_RESPONSE_USERNAME];
+            char const * client_id = credentials_value[PROV_CRED_CLIENT_ID];
+            char const * password = credentials_value[PROV_CRED_PASSWORD];
+            if (Helper::stringIsNullorEmpty(username)) {
+                return;
+            }
+            (void)snprintf(credentials.access_token, sizeof(credentials.access_token), "%s", username);
+            if (!Helper::stringIsNullorEmpty(client_id)) {
+                (void)snprintf(credentials.client_id, sizeof(credentials.client_id), "%s", client_id);
+            }
+            if (!Helper::stringIsNullorEmpty(password)) {
+                (void)snprintf(credentials.password, sizeof(credentials.password), "%s", password);
+            }
+        }
+        else {
+            return;
+        }
+        if (!m_credentials_store->store(credentials)) {
+            Logger::printfln(PROV_CREDENTIALS_STORE_FAILED);
+        }
+    }
+
     /// @brief Unsubcribes the provision callback
     /// @return Whether unsubcribing the previously subscribed callback
     /// and from the provision response topic, was successful or not
@@ -161,11 +234,12 @@ private:
         return m_unsubscribe_topic_callback.Call_Callback(PROV_RESPONSE_TOPIC);
     }
 
-    Callback<bool, char const * const, JsonDocument const &, size_t const &> m_send_json_callback = {};         // Send json document callback
-    Callback<bool, char const * const>                                       m_subscribe_topic_callback = {};   // Subscribe mqtt topic client callback
-    Callback<bool, char const * const>                                       m_unsubscribe_topic_callback = {}; // Unubscribe mqtt topic client callback
+    Delegate<bool, char const * const, JsonDocument const &, size_t const &> m_send_json_callback = {};         // Send json document callback
+    Delegate<bool, char const * const>                                       m_subscribe_topic_callback = {};   // Subscribe mqtt topic client callback
+    Delegate<bool, char const * const>                                       m_unsubscribe_topic_callback = {}; // Unubscribe mqtt topic client callback
 
     Provision_Callback                                                       m_provision_callback = {};         // Provision response callback
+    ICredentials_Store *                                                     m_credentials_store = {};          // Optional credentials store the issued credentials are persisted into, nullptr meaning they are not persisted
 };
 
 #endif // Provision_h
@@ -0,0 +1,188 @@
+#ifndef Raw_Subscription_h
+#define Raw_Subscription_h
+
+// Local include.
+#include "IAPI_Implementation.h"
+
+
+// Log messages.
+#if !THINGSBOARD_ENABLE_DYNAMIC
+char constexpr RAW_SUBSCRIPTIONS[] = "raw topic";
+#endif // !THINGSBOARD_ENABLE_DYNAMIC
+#if THINGSBOARD_ENABLE_DEBUG
+char constexpr CALLING_RAW_CB[] = "Calling subscribed callback for raw topic (%s)";
+#endif // THINGSBOARD_ENABLE_DEBUG
+
+
+/// @brief Handles subscriptions to arbitrary topics whose payloads are delivered to the subscribed callbacks as raw bytes,
+/// straight from the underlying client without any JsonDocument allocation, deserialization or additional copy.
+/// Meant for application payloads that are not json in the first place (compressed configuration blobs, binary sensor data),
+/// which would otherwise have to be wrapped in json and base64 encoded just to fit through the json processing stage,
+/// paying both the roughly one third base64 size overhead on the wire and the full deserialization of the inflated payload on arrival.
+/// The topic a callback is subscribed to may contain the MQTT wildcards + (one topic level) and # (all remaining topic levels).
+/// Be aware that the payload pointer handed to the callback points directly into the receive buffer of the underlying client
+/// and is only valid for the duration of the callback, if the data is needed for longer it has to be copied out
+/// @tparam Logger Implementation that should be used to print error messages generated by internal processes and additional debugging messages if THINGSBOARD_ENABLE_DEBUG is set, default = DefaultLogger
+#if THINGSBOARD_ENABLE_DYNAMIC
+template <typename Logger = DefaultLogger>
+#else
+/// @tparam MaxSubscriptions Maximum amount of simultaneous raw topic subscriptions.
+/// Once the maximum amount has been reached it is not possible to increase the size, this is done because it allows to allcoate the memory on the stack instead of the heap, default = Default_Subscriptions_Amount (1)
+template<size_t MaxSubscriptions = Default_Subscriptions_Amount, typename Logger = DefaultLogger>
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+class Raw_Subscription : public IAPI_Implementation {
+  public:
+    /// @brief Callback signature the subscribed raw data callbacks are called with,
+    /// receives the topic the payload arrived on, a pointer to the raw payload bytes and the payload length
+    using Raw_Data_Callback = Callback<void, char const * const, uint8_t *, unsigned int>;
+
+    /// @brief Constructor
+    Raw_Subscription() = default;
+
+    /// @brief Subscribes one raw data callback, that will be called with the raw payload bytes of every message received over the given topic.
+    /// Can be called even if we are currently not connected to the cloud,
+    /// this is the case because the only interaction that requires an active connection is the subscription of the topic that we receive the payloads on
+    /// and that subscription is also done automatically by the library once the device has established a connection to the cloud
+    /// @param topic Topic we want to receive raw payloads over, may contain the MQTT wildcards + and #,
+    /// requires to stay allocated until the callback has been unsubscribed with Raw_Unsubscribe()
+    /// @param callback Callback method that will be called with the received raw payload bytes
+    /// @return Whether subscribing the given callback was successful or not
+    bool Raw_Subscribe(char const * topic, Raw_Data_Callback const & callback) {
+        if (Helper::stringIsNullorEmpty(topic)) {
+            return false;
+        }
+#if !THINGSBOARD_ENABLE_DYNAMIC
+        if (m_subscriptions.size() + 1 > m_subscriptions.capacity()) {
+            Logger::printfln(MAX_SUBSCRIPTIONS_EXCEEDED, MAX_SUBSCRIPTIONS_TEMPLATE_NAME, RAW_SUBSCRIPTIONS);
+            return false;
+        }
+#endif // !THINGSBOARD_ENABLE_DYNAMIC
+        (void)m_subscribe_topic_callback.Call_Callback(topic);
+        Raw_Subscription_Entry const entry = {topic, callback};
+        m_subscriptions.push_back(entry);
+        return true;
+    }
+
+    /// @brief Unsubcribes the raw data callback previously subscribed to the given topic
+    /// @param topic Topic the callback we want to unsubscribe was subscribed with
+    /// @return Whether unsubcribing the previously subscribed callback
+    /// and from the given topic, was successful or not
+    bool Raw_Unsubscribe(char const * topic) {
+        for (auto it = m_subscriptions.begin(); it != m_subscriptions.end(); ++it) {
+            if (strcmp(it->topic, topic) == 0) {
+                m_subscriptions.erase(it);
+                return m_unsubscribe_topic_callback.Call_Callback(topic);
+            }
+        }
+        return false;
+    }
+
+    API_Process_Type Get_Process_Type() const override {
+        return API_Process_Type::RAW;
+    }
+
+    void Process_Response(char const * topic, uint8_t * payload, unsigned int length) override {
+        for (auto const & subscription : m_subscriptions) {
+            if (!Topic_Matches_Subscription(subscription.topic, topic)) {
+                continue;
+            }
+#if THINGSBOARD_ENABLE_DEBUG
+            Logger::printfln(CALLING_RAW_CB, topic);
+#endif // THINGSBOARD_ENABLE_DEBUG
+            subscription.callback.Call_Callback(topic, payload, length);
+        }
+    }
+
+    void Process_Json_Response(char const * topic, JsonDocument const & data) override {
+        // Nothing to do
+    }
+
+    bool Compare_Response_Topic(char const * topic) const override {
+        for (auto const & subscription : m_subscriptions) {
+            if (Topic_Matches_Subscription(subscription.topic, topic)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool Unsubscribe() override {
+        bool result = true;
+        for (auto const & subscription : m_subscriptions) {
+            result = m_unsubscribe_topic_callback.Call_Callback(subscription.topic) && result;
+        }
+        m_subscriptions.clear();
+        return result;
+    }
+
+    bool Resubscribe_Topic() override {
+        for (auto const & subscription : m_subscriptions) {
+            if (!m_subscribe_topic_callback.Call_Callback(subscription.topic)) {
+                Logger::printfln(SUBSCRIBE_TOPIC_FAILED, subscription.topic);
+                return false;
+            }
+        }
+        return true;
+    }
+
+#if !THINGSBOARD_USE_ESP_TIMER
+    void loop() override {
+        // Nothing to do
+    }
+#endif // !THINGSBOARD_USE_ESP_TIMER
+
+    void Initialize() override {
+        // Nothing to do
+    }
+
+    void Set_Client_Callbacks(Delegate<void, IAPI_Implementation &> subscribe_api_callback, Delegate<bool, char const * const, JsonDocument const &, size_t const &> send_json_callback, Delegate<bool, char const * const, char const * const> send_json_string_callback, Delegate<bool, char const * const> subscribe_topic_callback, Delegate<bool, char const * const> unsubscribe_topic_callback, Delegate<uint16_t> get_receive_size_callback, Delegate<uint16_t> get_send_size_callback, Delegate<bool, uint16_t, uint16_t> set_buffer_size_callback, Delegate<size_t *> get_request_id_callback) override {
+        m_subscribe_topic_callback.Set_Callback(subscribe_topic_callback);
+        m_unsubscribe_topic_callback.Set_Callback(unsubscribe_topic_callback);
+    }
+
+  private:
+    /// @brief One raw topic subscription, connecting the subscribed topic with the callback
+    /// that is called with the raw payload bytes of every message received over it
+    struct Raw_Subscription_Entry {
+        char const *      topic;    // Topic the callback was subscribed with, may contain MQTT wildcards
+        Raw_Data_Callback callback; // Callback called with the raw payload bytes of received messages
+    };
+
+    /// @brief Compares a received topic against a subscribed topic, honoring the MQTT wildcards
+    /// + (matches exactly one topic level) and # (matches all remaining topic levels)
+    /// @param subscription Subscribed topic that may contain wildcards
+    /// @param topic Received topic that is compared against the subscribed one
+    /// @return Whether the received topic matches the subscribed one or not
+    static bool Topic_Matches_Subscription(char const * subscription, char const * topic) {
+        while (*subscription != '\0') {
+            if (*subscription == '#') {
+                return true;
+            }
+            if (*subscription == '+') {
+                // Skip exactly one topic level of the received topic
+                while (*topic != '\0' && *topic != '/') {
+                    topic++;
+                }
+                subscription++;
+                continue;
+            }
+            if (*subscription != *topic) {
+                return false;
+            }
+            subscription++;
+            topic++;
+        }
+        return *topic == '\0';
+    }
+
+    Delegate<bool, char const * const>        m_subscribe_topic_callback = {};   // Subscribe mqtt topic client callback
+    Delegate<bool, char const * const>        m_unsubscribe_topic_callback = {}; // Unubscribe mqtt topic client callback
+
+#if THINGSBOARD_ENABLE_DYNAMIC
+    Vector<Raw_Subscription_Entry>            m_subscriptions = {};              // Raw topic subscriptions vector
+#else
+    Array<Raw_Subscription_Entry, MaxSubscriptions> m_subscriptions = {};        // Raw topic subscriptions array
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+};
+
+#endif // Raw_Subscription_h
@@ -7,52 +7,107 @@
 // Local include.
 #include <IUpdater.h>
 
+// Library include.
+#include <stdio.h>
+
 constexpr char OPEN_FILE_FAILED[] = "Failed to open file (%s), ensure path is correct and SD card exist and is initalized";
+// Default size of the write-behind buffer the received firmware data is collected in, before it is written onto the SD card in one piece.
+// Writing buffer sized pieces instead of every received chunk directly, pays the FAT filesystem and SPI transaction overhead
+// once per buffer instead of once per chunk, which speeds up the writes severalfold on typical SD cards
+constexpr size_t SD_WRITE_BUFFER_SIZE = 16U * 1024U;
 
 
 /// @brief IUpdater implementation that uses the c fopen function (https://cplusplus.com/reference/cstdio/fopen/),
-/// under the hood to write the given binary firmware data into a file. Can be used to write the binary into an intermediate SD card instead of directly updating to flash memory
+/// under the hood to write the given binary firmware data into a file. Can be used to write the binary into an intermediate SD card instead of directly updating to flash memory.
+/// The file is kept open for the complete update and the received data is collected in a write-behind buffer,
+/// so the FAT filesystem and SPI transaction overhead is paid once per buffer instead of once per received chunk,
+/// additionally the file is preallocated to the known firmware size upfront, so it does not have to grow cluster by cluster while the data arrives
 /// @tparam Logger Implementation that should be used to print error messages generated by internal processes and additional debugging messages if THINGSBOARD_ENABLE_DEBUG is set, default = DefaultLogger
 template <typename Logger = DefaultLogger>
 class SDCard_Updater : public IUpdater {
   public:
-    SDCard_Updater(char const * file_path)
+    /// @brief Constructor
+    /// @param file_path Path to the file the binary data is written into
+    /// @param buffer_size Size in bytes of the write-behind buffer the received data is collected in before it is written,
+    /// bigger buffers pay the per-write overhead less often at the cost of more allocated heap memory during the update, default = SD_WRITE_BUFFER_SIZE
+    SDCard_Updater(char const * file_path, size_t buffer_size = SD_WRITE_BUFFER_SIZE)
       : m_path(file_path)
+      , m_buffer_size(buffer_size)
     {
         // Nothing to do
     }
 
+    /// @brief Destructor
+    ~SDCard_Updater() {
+        close_file();
+        delete[] m_write_buffer;
+    }
+
     bool begin(size_t const & firmware_size) override {
-        FILE* file = fopen(m_path, "w");
-        if (file == nullptr) {
+        close_file();
+        m_file = fopen(m_path, "w");
+        if (m_file == nullptr) {
             Logger::printfln(OPEN_FILE_FAILED, m_path);
             return false;
         }
-        fclose(file);
+        // Write-behind buffer is only allocated once and reused for every following update,
+        // if the allocation fails the received data is simply written with the default buffering of the c library instead
+        if (m_write_buffer == nullptr) {
+            m_write_buffer = new uint8_t[m_buffer_size];
+        }
+        if (m_write_buffer != nullptr) {
+            (void)setvbuf(m_file, reinterpret_cast<char *>(m_write_buffer), _IOFBF, m_buffer_size);
+        }
+        // Preallocate the file to the known firmware size, so the cluster chain is allocated once upfront,
+        // instead of the file having to grow cluster by cluster while the data arrives.
+        // A firmware size of 0 means the final size is not known upfront and the file simply grows while it is written
+        if (firmware_size != 0U) {
+            if (fseek(m_file, firmware_size - 1U, SEEK_SET) != 0 || fputc(0, m_file) == EOF || fseek(m_file, 0, SEEK_SET) != 0) {
+                close_file();
+                Logger::printfln(OPEN_FILE_FAILED, m_path);
+                return false;
+            }
+        }
         return true;
     }
-  
+
     size_t write(uint8_t * payload, size_t const & total_bytes) override {
-        FILE* file = fopen(m_path, "a");
-        if (file == nullptr) {
+        if (m_file == nullptr) {
             Logger::printfln(OPEN_FILE_FAILED, m_path);
             return 0;
         }
-        size_t const bytes_written = fwrite(payload, 1, total_bytes, file);
-        fclose(file);
-        return bytes_written;
+        return fwrite(payload, 1, total_bytes, m_file);
+    }
+
+    bool flush() override {
+        if (m_file == nullptr) {
+            return false;
+        }
+        return fflush(m_file) == 0;
     }
 
     void reset() override {
         end();
     }
-  
+
     bool end() override {
+        close_file();
         return remove(m_path) == 0;
     }
 
   private:
-    char const * m_path = {}; // Path to the file the binary data is written into
+    /// @brief Closes the file if it is currently open, ensures the write-behind buffer is written onto the SD card completly before the file is closed
+    void close_file() {
+        if (m_file != nullptr) {
+            (void)fclose(m_file);
+            m_file = nullptr;
+        }
+    }
+
+    char const * m_path = {};         // Path to the file the binary data is written into
+    size_t       m_buffer_size = {};  // Size in bytes of the write-behind buffer the received data is collected in before it is written
+    FILE         *m_file = {};        // File the binary data is written into, kept open for the complete update
+    uint8_t      *m_write_buffer = {}; // Write-behind buffer the received data is collected in, installed as the stream buffer of the open file
 };
 
 #endif // SDCard_Updater_h
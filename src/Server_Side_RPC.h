@@ -9,7 +9,7 @@
 // Server side RPC topics.
 char constexpr RPC_SUBSCRIBE_TOPIC[] = "v1/devices/me/rpc/request/+";
 char constexpr RPC_REQUEST_TOPIC[] = "v1/devices/me/rpc/request/";
-char constexpr RPC_SEND_RESPONSE_TOPIC[] = "v1/devices/me/rpc/response/%u";
+char constexpr RPC_SEND_RESPONSE_TOPIC_PREFIX[] = "v1/devices/me/rpc/response/";
 // Log messages.
 char constexpr RPC_RESPONSE_OVERFLOWED[] = "Server-side RPC response overflowed, increase MaxRPC (%u)";
 #if !THINGSBOARD_ENABLE_DYNAMIC
@@ -67,6 +67,7 @@ class Server_Side_RPC : public IAPI_Implementation {
         (void)m_subscribe_topic_callback.Call_Callback(RPC_SUBSCRIBE_TOPIC);
         // Push back complete vector into our local m_rpc_callbacks vector.
         m_rpc_callbacks.insert(m_rpc_callbacks.end(), first, last);
+        Build_Method_Dispatch_Table();
         return true;
     }
 
@@ -89,6 +90,7 @@ class Server_Side_RPC : public IAPI_Implementation {
 #endif // !THINGSBOARD_ENABLE_DYNAMIC
         (void)m_subscribe_topic_callback.Call_Callback(RPC_SUBSCRIBE_TOPIC);
         m_rpc_callbacks.push_back(callback);
+        Build_Method_Dispatch_Table();
         return true;
     }
 
@@ -98,6 +100,7 @@ class Server_Side_RPC : public IAPI_Implementation {
     /// and from the rpc topic, was successful or not
     bool RPC_Unsubscribe() {
         m_rpc_callbacks.clear();
+        m_dispatch_table.clear();
         return m_unsubscribe_topic_callback.Call_Callback(RPC_SUBSCRIBE_TOPIC);
     }
 
@@ -118,20 +121,28 @@ class Server_Side_RPC : public IAPI_Implementation {
         }
         char const * method_name = data[RPC_METHOD_KEY];
 
-#if THINGSBOARD_ENABLE_STL
-        auto it = std::find_if(m_rpc_callbacks.begin(), m_rpc_callbacks.end(), [&method_name](RPC_Callback const & rpc) {
-            char const * subscribedMethodName = rpc.Get_Name();
-            return (!Helper::stringIsNullorEmpty(subscribedMethodName) && strncmp(subscribedMethodName, method_name, strlen(subscribedMethodName)) == 0);
-        });
-        if (it != m_rpc_callbacks.end()) {
-            auto & rpc = *it;
-#else
-        for (auto const & rpc : m_rpc_callbacks) {
-            char const * subscribedMethodName = rpc.Get_Name();
-            if (Helper::stringIsNullorEmpty(subscribedMethodName) || strncmp(subscribedMethodName, method_name, strlen(subscribedMethodName)) != 0) {
-              continue;
+        // Find the first dispatch table entry whose hash is not smaller than the hash of the received method name with a binary search,
+        // the table is sorted by hash once at subscribe time, meaning the lookup stays logarithmic as the amount of subscribed methods grows
+        uint32_t const method_hash = Helper::hashString(method_name);
+        size_t lower_bound = 0U;
+        size_t upper_bound = m_dispatch_table.size();
+        while (lower_bound < upper_bound) {
+            size_t const middle = lower_bound + ((upper_bound - lower_bound) / 2U);
+            if (m_dispatch_table[middle].hash < method_hash) {
+                lower_bound = middle + 1U;
+            }
+            else {
+                upper_bound = middle;
+            }
+        }
+
+        // Walk all entries that share the found hash and confirm the actual match with a single string comparison each,
+        // required because different method names can collide on the same hash value
+        for (size_t index = lower_bound; index < m_dispatch_table.size() && m_dispatch_table[index].hash == method_hash; index++) {
+            auto & rpc = m_rpc_callbacks[m_dispatch_table[index].index];
+            if (strcmp(rpc.Get_Name(), method_name) != 0) {
+                continue;
             }
-#endif // THINGSBOARD_ENABLE_STL
 #if THINGSBOARD_ENABLE_DEBUG
             if (!data.containsKey(RPC_PARAMS_KEY)) {
                 Logger::printfln(NO_RPC_PARAMS_PASSED);
@@ -164,9 +175,9 @@ class Server_Side_RPC : public IAPI_Implementation {
             }
 
             size_t const request_id = Helper::parseRequestId(RPC_REQUEST_TOPIC, topic);
-            char responseTopic[Helper::detectSize(RPC_SEND_RESPONSE_TOPIC, request_id)] = {};
-            (void)snprintf(responseTopic, sizeof(responseTopic), RPC_SEND_RESPONSE_TOPIC, request_id);
-            (void)m_send_json_callback.Call_Callback(responseTopic, json_buffer, Helper::Measure_Json(json_buffer));
+            // Response topic buffer already contains the constant topic prefix, only the decimal request id has to be appended behind it
+            (void)Helper::writeUnsignedInteger(&m_response_topic[sizeof(RPC_SEND_RESPONSE_TOPIC_PREFIX) - 1U], request_id);
+            (void)m_send_json_callback.Call_Callback(m_response_topic, json_buffer, Helper::Measure_Json(json_buffer));
             return;
         }
     }
@@ -175,6 +186,10 @@ class Server_Side_RPC : public IAPI_Implementation {
         return strncmp(RPC_REQUEST_TOPIC, topic, strlen(RPC_REQUEST_TOPIC)) == 0;
     }
 
+    char const * Get_Response_Topic_Prefix() const override {
+        return RPC_REQUEST_TOPIC;
+    }
+
     bool Unsubscribe() override {
         return RPC_Unsubscribe();
     }
@@ -194,19 +209,52 @@ class Server_Side_RPC : public IAPI_Implementation {
 #endif // !THINGSBOARD_USE_ESP_TIMER
 
     void Initialize() override {
-        // Nothing to do
+        // Copy the constant topic prefix into the persistent response topic buffer once, every response only appends its request id behind it
+        memcpy(m_response_topic, RPC_SEND_RESPONSE_TOPIC_PREFIX, sizeof(RPC_SEND_RESPONSE_TOPIC_PREFIX));
     }
 
-    void Set_Client_Callbacks(Callback<void, IAPI_Implementation &>::function subscribe_api_callback, Callback<bool, char const * const, JsonDocument const &, size_t const &>::function send_json_callback, Callback<bool, char const * const, char const * const>::function send_json_string_callback, Callback<bool, char const * const>::function subscribe_topic_callback, Callback<bool, char const * const>::function unsubscribe_topic_callback, Callback<uint16_t>::function get_receive_size_callback, Callback<uint16_t>::function get_send_size_callback, Callback<bool, uint16_t, uint16_t>::function set_buffer_size_callback, Callback<size_t *>::function get_request_id_callback) override {
+    void Set_Client_Callbacks(Delegate<void, IAPI_Implementation &> subscribe_api_callback, Delegate<bool, char const * const, JsonDocument const &, size_t const &> send_json_callback, Delegate<bool, char const * const, char const * const> send_json_string_callback, Delegate<bool, char const * const> subscribe_topic_callback, Delegate<bool, char const * const> unsubscribe_topic_callback, Delegate<uint16_t> get_receive_size_callback, Delegate<uint16_t> get_send_size_callback, Delegate<bool, uint16_t, uint16_t> set_buffer_size_callback, Delegate<size_t *> get_request_id_callback) override {
         m_send_json_callback.Set_Callback(send_json_callback);
         m_subscribe_topic_callback.Set_Callback(subscribe_topic_callback);
         m_unsubscribe_topic_callback.Set_Callback(unsubscribe_topic_callback);
     }
 
   private:
-    Callback<bool, char const * const, JsonDocument const &, size_t const &> m_send_json_callback = {};         // Send json document callback
-    Callback<bool, char const * const>                                       m_subscribe_topic_callback = {};   // Subscribe mqtt topic client callback
-    Callback<bool, char const * const>                                       m_unsubscribe_topic_callback = {}; // Unubscribe mqtt topic client callback
+    /// @brief One entry of the method dispatch table, connecting the precomputed hash of a subscribed method name
+    /// with the index of its callback in the subscribed callbacks, the index is stored instead of a pointer,
+    /// because subscribing additional callbacks can reallocate the underlying container and invalidate pointers into it
+    struct Method_Dispatch_Entry {
+        uint32_t hash;  // Precomputed hash of the subscribed method name
+        size_t   index; // Index of the connected callback in m_rpc_callbacks
+    };
+
+    /// @brief Rebuilds the method dispatch table from the currently subscribed callbacks and sorts it by the precomputed method name hashes.
+    /// Called whenever the subscribed callbacks change, so received requests can find their callback
+    /// with a binary search over the hashes and a single final string comparison, instead of string comparing every subscribed callback
+    void Build_Method_Dispatch_Table() {
+        m_dispatch_table.clear();
+        for (size_t index = 0U; index < m_rpc_callbacks.size(); index++) {
+            char const * const method_name = m_rpc_callbacks[index].Get_Name();
+            if (Helper::stringIsNullorEmpty(method_name)) {
+                continue;
+            }
+            Method_Dispatch_Entry const entry = {Helper::hashString(method_name), index};
+            m_dispatch_table.push_back(entry);
+        }
+        // Insertion sort by hash, efficient for the small and mostly presorted table and does not require any additional allocations
+        for (size_t index = 1U; index < m_dispatch_table.size(); index++) {
+            Method_Dispatch_Entry const entry = m_dispatch_table[index];
+            size_t previous = index;
+            for (; previous > 0U && m_dispatch_table[previous - 1U].hash > entry.hash; previous--) {
+                m_dispatch_table[previous] = m_dispatch_table[previous - 1U];
+            }
+            m_dispatch_table[previous] = entry;
+        }
+    }
+
+    Delegate<bool, char const * const, JsonDocument const &, size_t const &> m_send_json_callback = {};         // Send json document callback
+    Delegate<bool, char const * const>                                       m_subscribe_topic_callback = {};   // Subscribe mqtt topic client callback
+    Delegate<bool, char const * const>                                       m_unsubscribe_topic_callback = {}; // Unubscribe mqtt topic client callback
 
     // Vectors or array (depends on wheter if THINGSBOARD_ENABLE_DYNAMIC is set to 1 or 0), hold copy of the actual passed data, this is to ensure they stay valid,
     // even if the user only temporarily created the object before the method was called.
@@ -218,9 +266,12 @@ class Server_Side_RPC : public IAPI_Implementation {
     // especially because at most we copy internal vectors or array, that will only ever contain a few pointers
 #if THINGSBOARD_ENABLE_DYNAMIC
     Vector<RPC_Callback>                                                     m_rpc_callbacks = {};              // Server side RPC callbacks vector
+    Vector<Method_Dispatch_Entry>                                            m_dispatch_table = {};             // Method dispatch table sorted by the precomputed method name hashes
 #else
     Array<RPC_Callback, MaxSubscriptions>                                    m_rpc_callbacks = {};              // Server side RPC callbacks array
+    Array<Method_Dispatch_Entry, MaxSubscriptions>                           m_dispatch_table = {};             // Method dispatch table sorted by the precomputed method name hashes
 #endif // THINGSBOARD_ENABLE_DYNAMIC
+    char                                                                     m_response_topic[sizeof(RPC_SEND_RESPONSE_TOPIC_PREFIX) + Helper::Max_Unsigned_Integer_Digits] = {}; // Persistent response topic buffer, contains the constant topic prefix with the request id of the current response appended behind it
 };
 
 #endif // Server_Side_RPC_h
@@ -28,6 +28,14 @@ class Shared_Attribute_Update : public IAPI_Implementation {
     /// @brief Constructor
     Shared_Attribute_Update() = default;
 
+#if THINGSBOARD_ENABLE_DYNAMIC
+    /// @brief Destructor, deletes the heap allocated deserialization filter document
+    ~Shared_Attribute_Update() {
+        delete m_response_filter;
+        m_response_filter = nullptr;
+    }
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+
     /// @brief Subscribes multiple shared attribute callbacks,
     /// that will be called if the key-value pair from the server for the given shared attributes is received.
     /// Can be called even if we are currently not connected to the cloud,
@@ -54,6 +62,8 @@ class Shared_Attribute_Update : public IAPI_Implementation {
         (void)m_subscribe_topic_callback.Call_Callback(ATTRIBUTE_TOPIC);
         // Push back complete vector into our local m_shared_attribute_update_callbacks vector.
         m_shared_attribute_update_callbacks.insert(m_shared_attribute_update_callbacks.end(), first, last);
+        Rebuild_Response_Filter();
+        Build_Key_Dispatch_Table();
         return true;
     }
 
@@ -80,6 +90,8 @@ class Shared_Attribute_Update : public IAPI_Implementation {
 #endif // !THINGSBOARD_ENABLE_DYNAMIC
         (void)m_subscribe_topic_callback.Call_Callback(ATTRIBUTE_TOPIC);
         m_shared_attribute_update_callbacks.push_back(callback);
+        Rebuild_Response_Filter();
+        Build_Key_Dispatch_Table();
         return true;
     }
 
@@ -89,9 +101,19 @@ class Shared_Attribute_Update : public IAPI_Implementation {
     /// and from the attribute topic, was successful or not
     bool Shared_Attributes_Unsubscribe() {
         m_shared_attribute_update_callbacks.clear();
+        Rebuild_Response_Filter();
+        Build_Key_Dispatch_Table();
         return m_unsubscribe_topic_callback.Call_Callback(ATTRIBUTE_TOPIC);
     }
 
+    /// @brief Sets the callback that is informed about the key-value pairs of every received shared attribute update,
+    /// before the subscribed callbacks are called. Meant to connect the Invalidate_Cached_Attributes() method
+    /// of the used Attribute_Request instance, so updated values are removed from its local attribute cache automatically
+    /// @param invalidate_attributes_callback Method which is passed the key-value pairs of every received update
+    void Set_Attribute_Invalidation_Callback(Delegate<void, JsonObjectConst const &> invalidate_attributes_callback) {
+        m_invalidate_attributes_callback.Set_Callback(invalidate_attributes_callback);
+    }
+
     API_Process_Type Get_Process_Type() const override {
         return API_Process_Type::JSON;
     }
@@ -105,57 +127,46 @@ class Shared_Attribute_Update : public IAPI_Implementation {
         if (object.containsKey(SHARED_RESPONSE_KEY)) {
             object = object[SHARED_RESPONSE_KEY];
         }
+        // Inform the optionally connected attribute cache about the updated keys, so their cached values are invalidated
+        m_invalidate_attributes_callback.Call_Callback(object);
 
-#if THINGSBOARD_ENABLE_STL
-#if THINGSBOARD_ENABLE_CXX20
-#if THINGSBOARD_ENABLE_DYNAMIC
-        auto filtered_shared_attribute_update_callbacks = m_shared_attribute_update_callbacks | std::views::filter([&object](Shared_Attribute_Callback const & shared_attribute) {
-#else
-        auto filtered_shared_attribute_update_callbacks = m_shared_attribute_update_callbacks | std::views::filter([&object](Shared_Attribute_Callback<MaxAttributes> const & shared_attribute) {
-#endif // THINGSBOARD_ENABLE_DYNAMIC
-#else
-#if THINGSBOARD_ENABLE_DYNAMIC
-        Vector<Shared_Attribute_Callback> filtered_shared_attribute_update_callbacks = {};
-        std::copy_if(m_shared_attribute_update_callbacks.begin(), m_shared_attribute_update_callbacks.end(), std::back_inserter(filtered_shared_attribute_update_callbacks), [&object](Shared_Attribute_Callback const & shared_attribute) {
-#else
-        Array<Shared_Attribute_Callback<MaxAttributes>, MaxSubscriptions> filtered_shared_attribute_update_callbacks = {};
-        std::copy_if(m_shared_attribute_update_callbacks.begin(), m_shared_attribute_update_callbacks.end(), std::back_inserter(filtered_shared_attribute_update_callbacks), [&object](Shared_Attribute_Callback<MaxAttributes> const & shared_attribute) {
-#endif // THINGSBOARD_ENABLE_DYNAMIC
-#endif // THINGSBOARD_ENABLE_CXX20
-            return (shared_attribute.Get_Attributes().empty() || std::find_if(shared_attribute.Get_Attributes().begin(), shared_attribute.Get_Attributes().end(), [&object](const char * att) {
-                return object.containsKey(att);
-            }) != shared_attribute.Get_Attributes().end());
-        });
-
-        for (auto const & shared_attribute : filtered_shared_attribute_update_callbacks) {
-#else
-        for (auto const & shared_attribute : m_shared_attribute_update_callbacks) {
-            if (shared_attribute.Get_Attributes().empty()) {
-                // No specifc keys were subscribed so we call the callback anyway, assumed to be subscribed to any update
-                shared_attribute.Call_Callback(object);
-                continue;
-            }
-
-            char const * requested_att = nullptr;
+        for (size_t index = 0U; index < m_matched_callbacks.size(); index++) {
+            m_matched_callbacks[index] = false;
+        }
 
-            for (auto const & att : shared_attribute.Get_Attributes()) {
-                if (Helper::stringIsNullorEmpty(att)) {
-                    continue;
+        // One pass over the received keys, every key finds the callbacks that subscribed it with a binary search
+        // over the inverted index that was presorted by the precomputed key hashes once at subscribe time.
+        // This only touches the callbacks that actually subscribed a received key,
+        // instead of string comparing every subscribed key of every callback against every received key
+        for (JsonPairConst kv : object) {
+            uint32_t const key_hash = Helper::hashString(kv.key().c_str());
+            size_t lower_bound = 0U;
+            size_t upper_bound = m_dispatch_table.size();
+            while (lower_bound < upper_bound) {
+                size_t const middle = lower_bound + ((upper_bound - lower_bound) / 2U);
+                if (m_dispatch_table[middle].hash < key_hash) {
+                    lower_bound = middle + 1U;
                 }
-                // Check if the request contained any of our requested keys and
-                // break early if the key was requested from this callback.
-                if (object.containsKey(att)) {
-                    requested_att = att;
-                    break;
+                else {
+                    upper_bound = middle;
                 }
             }
+            // Walk all entries that share the found hash and confirm the actual match with a single string comparison each,
+            // required because different keys can collide on the same hash value
+            for (size_t index = lower_bound; index < m_dispatch_table.size() && m_dispatch_table[index].hash == key_hash; index++) {
+                if (strcmp(m_dispatch_table[index].key, kv.key().c_str()) == 0) {
+                    m_matched_callbacks[m_dispatch_table[index].index] = true;
+                }
+            }
+        }
 
-            // Check if this callback did not request any keys that were in this response,
-            // if there were not we simply continue with the next subscribed callback.
-            if (requested_att == nullptr) {
+        // Call the matched callbacks in subscription order, callbacks that did not subscribe any specific keys
+        // are assumed to be subscribed to any update and are therefore always called
+        for (size_t index = 0U; index < m_shared_attribute_update_callbacks.size(); index++) {
+            auto const & shared_attribute = m_shared_attribute_update_callbacks[index];
+            if (!m_matched_callbacks[index] && !shared_attribute.Get_Attributes().empty()) {
                 continue;
             }
-#endif // THINGSBOARD_ENABLE_STL
             shared_attribute.Call_Callback(object);
         }
     }
@@ -164,6 +175,18 @@ class Shared_Attribute_Update : public IAPI_Implementation {
         return strncmp(ATTRIBUTE_TOPIC, topic, strlen(ATTRIBUTE_TOPIC) + 1) == 0;
     }
 
+    char const * Get_Response_Topic_Prefix() const override {
+        return ATTRIBUTE_TOPIC;
+    }
+
+    JsonDocument * Get_Response_Filter() override {
+#if THINGSBOARD_ENABLE_DYNAMIC
+        return m_response_filter;
+#else
+        return m_response_filter_enabled ? &m_response_filter : nullptr;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    }
+
     bool Unsubscribe() override {
         return Shared_Attributes_Unsubscribe();
     }
@@ -186,14 +209,95 @@ class Shared_Attribute_Update : public IAPI_Implementation {
         // Nothing to do
     }
 
-    void Set_Client_Callbacks(Callback<void, IAPI_Implementation &>::function subscribe_api_callback, Callback<bool, char const * const, JsonDocument const &, size_t const &>::function send_json_callback, Callback<bool, char const * const, char const * const>::function send_json_string_callback, Callback<bool, char const * const>::function subscribe_topic_callback, Callback<bool, char const * const>::function unsubscribe_topic_callback, Callback<uint16_t>::function get_receive_size_callback, Callback<uint16_t>::function get_send_size_callback, Callback<bool, uint16_t, uint16_t>::function set_buffer_size_callback, Callback<size_t *>::function get_request_id_callback) override {
+    void Set_Client_Callbacks(Delegate<void, IAPI_Implementation &> subscribe_api_callback, Delegate<bool, char const * const, JsonDocument const &, size_t const &> send_json_callback, Delegate<bool, char const * const, char const * const> send_json_string_callback, Delegate<bool, char const * const> subscribe_topic_callback, Delegate<bool, char const * const> unsubscribe_topic_callback, Delegate<uint16_t> get_receive_size_callback, Delegate<uint16_t> get_send_size_callback, Delegate<bool, uint16_t, uint16_t> set_buffer_size_callback, Delegate<size_t *> get_request_id_callback) override {
         m_subscribe_topic_callback.Set_Callback(subscribe_topic_callback);
         m_unsubscribe_topic_callback.Set_Callback(unsubscribe_topic_callback);
     }
 
   private:
-    Callback<bool, char const * const>                                       m_subscribe_topic_callback = {};          // Subscribe mqtt topic client callback
-    Callback<bool, char const * const>                                       m_unsubscribe_topic_callback = {};        // Unubscribe mqtt topic client callback
+    /// @brief One entry of the inverted key index, connecting the precomputed hash of a subscribed attribute key
+    /// with the index of the callback that subscribed it, the index is stored instead of a pointer,
+    /// because subscribing additional callbacks can reallocate the underlying container and invalidate pointers into it.
+    /// The key pointer itself stays valid, because the subscribed callbacks only ever store pointers to user owned constant strings
+    struct Key_Dispatch_Entry {
+        uint32_t     hash;  // Precomputed hash of the subscribed attribute key
+        char const * key;   // Subscribed attribute key, used to confirm a hash match
+        size_t       index; // Index of the subscribing callback in m_shared_attribute_update_callbacks
+    };
+
+    /// @brief Rebuilds the inverted key index from the currently subscribed callbacks and sorts it by the precomputed key hashes.
+    /// Called whenever the subscribed callbacks change, so received updates can find the interested callbacks
+    /// with one binary search per received key, instead of string comparing every subscribed key of every callback
+    void Build_Key_Dispatch_Table() {
+        m_dispatch_table.clear();
+        m_matched_callbacks.clear();
+        for (size_t index = 0U; index < m_shared_attribute_update_callbacks.size(); index++) {
+            m_matched_callbacks.push_back(false);
+            for (auto const & att : m_shared_attribute_update_callbacks[index].Get_Attributes()) {
+                if (Helper::stringIsNullorEmpty(att)) {
+                    continue;
+                }
+                Key_Dispatch_Entry const entry = {Helper::hashString(att), att, index};
+                m_dispatch_table.push_back(entry);
+            }
+        }
+        // Insertion sort by hash, efficient for the small and mostly presorted table and does not require any additional allocations
+        for (size_t index = 1U; index < m_dispatch_table.size(); index++) {
+            Key_Dispatch_Entry const entry = m_dispatch_table[index];
+            size_t previous = index;
+            for (; previous > 0U && m_dispatch_table[previous - 1U].hash > entry.hash; previous--) {
+                m_dispatch_table[previous] = m_dispatch_table[previous - 1U];
+            }
+            m_dispatch_table[previous] = entry;
+        }
+    }
+
+    /// @brief Rebuilds the deserialization filter from the attribute keys of the currently subscribed callbacks.
+    /// Called whenever the subscribed callbacks change, so the filter does not have to be recalculated for every received update.
+    /// If at least one subscribed callback did not restrict the attribute keys it wants to receive, the filter is disabled completely,
+    /// because that callback is assumed to be subscribed to any update and therefore requires the complete payload
+    void Rebuild_Response_Filter() {
+#if THINGSBOARD_ENABLE_DYNAMIC
+        delete m_response_filter;
+        m_response_filter = nullptr;
+#else
+        m_response_filter.clear();
+        m_response_filter_enabled = false;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+        if (m_shared_attribute_update_callbacks.empty()) {
+            return;
+        }
+        size_t attribute_amount = 0U;
+        for (auto const & shared_attribute : m_shared_attribute_update_callbacks) {
+            if (shared_attribute.Get_Attributes().empty()) {
+                return;
+            }
+            attribute_amount += shared_attribute.Get_Attributes().size();
+        }
+#if THINGSBOARD_ENABLE_DYNAMIC
+        // Subscribed keys are flagged both at the top level and wrapped below the shared key, requiring two objects with all subscribed keys and one wrapper key-value pair.
+        // See https://arduinojson.org/v6/assistant/ for more information on the needed size for the JsonDocument
+        m_response_filter = new TBJsonDocument((2U * JSON_OBJECT_SIZE(attribute_amount)) + JSON_OBJECT_SIZE(1U));
+        auto & filter = *m_response_filter;
+#else
+        auto & filter = m_response_filter;
+        m_response_filter_enabled = true;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+        // Updates can arrive both as a flat object and wrapped below the shared key, therefore the subscribed keys are flagged in both locations
+        for (auto const & shared_attribute : m_shared_attribute_update_callbacks) {
+            for (auto const & att : shared_attribute.Get_Attributes()) {
+                if (Helper::stringIsNullorEmpty(att)) {
+                    continue;
+                }
+                filter[att] = true;
+                filter[SHARED_RESPONSE_KEY][att] = true;
+            }
+        }
+    }
+
+    Delegate<bool, char const * const>                                       m_subscribe_topic_callback = {};          // Subscribe mqtt topic client callback
+    Delegate<bool, char const * const>                                       m_unsubscribe_topic_callback = {};        // Unubscribe mqtt topic client callback
+    Delegate<void, JsonObjectConst const &>                                  m_invalidate_attributes_callback = {};    // Optional callback informed about the keys of every received update, used to invalidate the local attribute cache
 
     // Vectors or array (depends on wheter if THINGSBOARD_ENABLE_DYNAMIC is set to 1 or 0), hold copy of the actual passed data, this is to ensure they stay valid,
     // even if the user only temporarily created the object before the method was called.
@@ -205,8 +309,15 @@ class Shared_Attribute_Update : public IAPI_Implementation {
     // especially because at most we copy internal vectors or array, that will only ever contain a few pointers
 #if THINGSBOARD_ENABLE_DYNAMIC
     Vector<Shared_Attribute_Callback>                                        m_shared_attribute_update_callbacks = {}; // Shared attribute update callbacks vector
+    TBJsonDocument *                                                         m_response_filter = {};                   // Deserialization filter built from the subscribed attribute keys, nullptr if a callback is subscribed to any update
+    Vector<Key_Dispatch_Entry>                                               m_dispatch_table = {};                    // Inverted key index sorted by the precomputed hashes of the subscribed attribute keys
+    Vector<bool>                                                             m_matched_callbacks = {};                 // Scratch flags marking which callbacks subscribed a key of the currently processed update
 #else
     Array<Shared_Attribute_Callback<MaxAttributes>, MaxSubscriptions>        m_shared_attribute_update_callbacks = {}; // Shared attribute update callbacks array
+    StaticJsonDocument<(2U * JSON_OBJECT_SIZE(MaxSubscriptions * MaxAttributes)) + JSON_OBJECT_SIZE(1U)> m_response_filter = {}; // Deserialization filter built from the subscribed attribute keys
+    bool                                                                     m_response_filter_enabled = {};           // Whether the deserialization filter is used, disabled if a callback is subscribed to any update
+    Array<Key_Dispatch_Entry, MaxSubscriptions * MaxAttributes>              m_dispatch_table = {};                    // Inverted key index sorted by the precomputed hashes of the subscribed attribute keys
+    Array<bool, MaxSubscriptions>                                            m_matched_callbacks = {};                 // Scratch flags marking which callbacks subscribed a key of the currently processed update
 #endif // THINGSBOARD_ENABLE_DYNAMIC
 };
 
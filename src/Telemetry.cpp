@@ -1,6 +1,16 @@
 // Header include.
 #include "Telemetry.h"
 
+// Library includes.
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+
+// Maximum amount of decimal places a floating point value can be rounded to,
+// a bigger scale would exceed the exactly representable integer range of a double and the default formatting does not emit more decimal places anyway
+uint8_t constexpr MAX_PRECISION_DECIMALS = 9U;
+
 Telemetry::Telemetry()
   : m_type(DataType::TYPE_NONE)
   , m_key(nullptr)
@@ -22,9 +32,70 @@ Telemetry::Telemetry(char const * key, char const * value)
   , m_key(key)
   , m_value()
 {
+    // Values short enough to fit the small string buffer are copied into the record itself,
+    // meaning the record stays valid even if the passed value does not and can be queued or buffered safely
+    if (value != nullptr && strlen(value) < sizeof(m_value.small_str)) {
+        m_type = DataType::TYPE_SMALL_STR;
+        (void)snprintf(m_value.small_str, sizeof(m_value.small_str), "%s", value);
+        return;
+    }
     m_value.str = value;
 }
 
 bool Telemetry::IsEmpty() const {
     return (m_key == nullptr) && m_type == DataType::TYPE_NONE;
 }
+
+void Telemetry::SetTimestamp(uint64_t const & timestamp) {
+    m_timestamp = timestamp;
+}
+
+uint64_t const & Telemetry::GetTimestamp() const {
+    return m_timestamp;
+}
+
+bool Telemetry::HasTimestamp() const {
+    return m_timestamp != 0U;
+}
+
+char const * Telemetry::GetKey() const {
+    return m_key;
+}
+
+void Telemetry::SetPrecision(uint8_t decimals) {
+    m_precision = decimals;
+}
+
+uint8_t Telemetry::GetPrecision() const {
+    return m_precision;
+}
+
+bool Telemetry::GetNumericValue(double & value) const {
+    switch (m_type) {
+        case DataType::TYPE_BOOL:
+            value = m_value.boolean ? 1.0 : 0.0;
+            return true;
+        case DataType::TYPE_INT:
+            value = static_cast<double>(m_value.integer);
+            return true;
+        case DataType::TYPE_REAL:
+            value = m_value.real;
+            return true;
+        default:
+            // String and empty records have no numeric representation
+            break;
+    }
+    return false;
+}
+
+double Telemetry::Rounded_Real_Value() const {
+    if (m_precision == TELEMETRY_PRECISION_NONE) {
+        return m_value.real;
+    }
+    uint8_t const decimals = (m_precision > MAX_PRECISION_DECIMALS) ? MAX_PRECISION_DECIMALS : m_precision;
+    double scale = 1.0;
+    for (uint8_t i = 0; i < decimals; ++i) {
+        scale *= 10.0;
+    }
+    return round(m_value.real * scale) / scale;
+}
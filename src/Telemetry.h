@@ -11,6 +11,11 @@
 #endif // THINGSBOARD_ENABLE_STL
 
 
+// Value of the serialization precision hint that leaves floating point values untouched,
+// meaning they are serialized with the default ArduinoJson formatting
+uint8_t constexpr TELEMETRY_PRECISION_NONE = 0xFFU;
+
+
 /// @brief Telemetry record class, allows to store different data using a common interface,
 /// is used to allow to easily create a key-value pair of multiple different types that can then be deserialized into a json message
 class Telemetry {
@@ -65,7 +70,10 @@ class Telemetry {
     /// @param value Value of the key value pair we want to create	
     Telemetry(char const * key, bool value);
 
-    /// @brief Constructs telemetry record from string value
+    /// @brief Constructs telemetry record from string value.
+    /// Values short enough to fit the internal small string storage are copied into the record itself,
+    /// meaning the passed value does not need to stay allocated and the record can be queued or buffered safely.
+    /// Longer values are stored as a pointer instead and require the passed value to stay allocated until the record has been serialized
     /// @param key Key of the key value pair we want to create
     /// @param value Value of the key value pair we want to create
     Telemetry(char const * key, char const * value);
@@ -74,6 +82,42 @@ class Telemetry {
     /// @return Whether there is any data in this record or not
     bool IsEmpty() const;
 
+    /// @brief Sets the unix timestamp in milliseconds this record was sampled at.
+    /// Allows to aggregate multiple sample instants into one single message with the multi-point time-series format ({"ts":...,"values":{...}}),
+    /// instead of having to publish one message per sample instant. See https://thingsboard.io/docs/reference/mqtt-api/#timeseries-data-upload-api for more information
+    /// @param timestamp Unix timestamp in milliseconds the value of this record was sampled at
+    void SetTimestamp(uint64_t const & timestamp);
+
+    /// @brief Gets the unix timestamp in milliseconds this record was sampled at
+    /// @return Unix timestamp in milliseconds previously set with SetTimestamp() or 0 if this record has no timestamp attached
+    uint64_t const & GetTimestamp() const;
+
+    /// @brief Whether this record has a timestamp attached and should therefore be serialized with the multi-point time-series format
+    /// @return Whether SetTimestamp() has been called with a non 0 timestamp on this record or not
+    bool HasTimestamp() const;
+
+    /// @brief Gets the key of the key-value pair this record holds
+    /// @return Key this record was constructed with or nullptr if this record is empty or holds only a value
+    char const * GetKey() const;
+
+    /// @brief Gets the value this record holds converted to a double, only possible for numeric values.
+    /// Used to compare the value against configured suppression rules without having to care about the underlying data type
+    /// @param value Output parameter the converted value is written into, stays untouched if the held value is not numeric
+    /// @return Whether the held value is numeric (boolean, integral or floating point) and has been written into the output parameter or not
+    bool GetNumericValue(double & value) const;
+
+    /// @brief Sets the amount of decimal places a floating point value is rounded to before it is serialized.
+    /// Sensor readings often carry all real information in a few decimal places, but are serialized with the maximum amount of significant digits by default,
+    /// inflating every payload and slowing down the float to string conversion. Rounding beforehand shortens the emitted representation accordingly,
+    /// has no effect on non floating point values and the raw value is still used for deadband comparisons
+    /// @param decimals Amount of decimal places the value is rounded to before serializing, clamped internally to a maximum of 9,
+    /// pass TELEMETRY_PRECISION_NONE if the value should be serialized with the default formatting again
+    void SetPrecision(uint8_t decimals);
+
+    /// @brief Gets the amount of decimal places the value of this record is rounded to before it is serialized
+    /// @return Amount of decimal places previously set with SetPrecision() or TELEMETRY_PRECISION_NONE if this record serializes with the default formatting
+    uint8_t GetPrecision() const;
+
     /// @brief Serializes a key-value pair or a value, depending on the constructor used
     /// @tparam TSource Source class that the given key value pair or a value, should be copied into
     /// @param source Data source that should contain the key value pair or a value
@@ -93,18 +137,26 @@ class Telemetry {
                     return source.containsKey(m_key);
                 }
                 return source.set(m_value.integer);
-            case DataType::TYPE_REAL:
+            case DataType::TYPE_REAL: {
+                double const value = Rounded_Real_Value();
                 if (m_key) {
-                    source[m_key] = m_value.real;
+                    source[m_key] = value;
                     return source.containsKey(m_key);
                 }
-                return source.set(m_value.real);
+                return source.set(value);
+            }
             case DataType::TYPE_STR:
                 if (m_key) {
                     source[m_key] = m_value.str;
                     return source.containsKey(m_key);
                 }
                 return source.set(m_value.str);
+            case DataType::TYPE_SMALL_STR:
+                if (m_key) {
+                    source[m_key] = static_cast<char const *>(m_value.small_str);
+                    return source.containsKey(m_key);
+                }
+                return source.set(static_cast<char const *>(m_value.small_str));
             default:
                 // Nothing to do
                 break;
@@ -113,9 +165,12 @@ class Telemetry {
     }
 
   private:
-    /// @brief Data container, which contains one of the possibly passed values
+    /// @brief Data container, which contains one of the possibly passed values.
+    /// The small string buffer holds string values short enough to fit it directly inside the record,
+    /// which keeps the record trivially copyable without requiring the original value to stay allocated
     union Data {
         const char  *str;
+        char        small_str[16];
         bool        boolean;
         int64_t     integer;
         double      real;
@@ -127,12 +182,19 @@ class Telemetry {
         TYPE_BOOL, ///< Telemetry instance is a key value-pair with a boolean value
         TYPE_INT, ///< Telemetry instance is a key value-pair with an integral value
         TYPE_REAL, ///< Telemetry instance is a key value-pair with a real (float, double) value
-        TYPE_STR ///< Telemetry isntance is a key value-pair with a string value
+        TYPE_STR, ///< Telemetry isntance is a key value-pair with a string value stored as a pointer
+        TYPE_SMALL_STR ///< Telemetry isntance is a key value-pair with a string value stored inside the record itself
     };
 
-    DataType     m_type = {};  // Data type flag, showing which value is saved in the class instance
-    const char   *m_key = {};  // Data key of the key-value pair
-    Data         m_value = {}; // Data value of the key-value pair
+    /// @brief Calculates the held floating point value rounded to the configured amount of decimal places
+    /// @return Held value rounded to the configured precision or unchanged if no precision is configured
+    double Rounded_Real_Value() const;
+
+    DataType     m_type = {};                               // Data type flag, showing which value is saved in the class instance
+    const char   *m_key = {};                               // Data key of the key-value pair
+    Data         m_value = {};                              // Data value of the key-value pair
+    uint64_t     m_timestamp = {};                          // Optional unix timestamp in milliseconds the value was sampled at, 0 meaning no timestamp is attached
+    uint8_t      m_precision = TELEMETRY_PRECISION_NONE;    // Amount of decimal places a floating point value is rounded to before serializing, TELEMETRY_PRECISION_NONE meaning no rounding is applied
 };
 
 /// @brief Telemetry and attributes are only different on the database side (one has a history the other one does not), but both are simply key-value pairs
@@ -7,20 +7,59 @@
 #include "IMQTT_Client.h"
 #include "DefaultLogger.h"
 #include "Telemetry.h"
+#include "Callback_Watchdog.h"
+#include "ITelemetry_Store.h"
+#include "ICredentials_Store.h"
+#include "Aggregation_Type.h"
+#include "Connection_State.h"
+#include "Profiler.h"
+#include "Memory_Metrics.h"
 
 // Library includes.
 #if THINGSBOARD_ENABLE_STREAM_UTILS
 #include <StreamUtils.h>
 #endif // THINGSBOARD_ENABLE_STREAM_UTILS
+#if THINGSBOARD_ENABLE_WORKER_TASK
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif // THINGSBOARD_ENABLE_WORKER_TASK
 
 
 uint16_t constexpr DEFAULT_MQTT_PORT = 1883U;
 char constexpr PROV_ACCESS_TOKEN[] = "provision";
+// Telemetry aggregation defaults.
+uint64_t constexpr DEFAULT_AGGREGATION_INTERVAL_MS = 1000U;
+// Asynchronous connect defaults.
+uint64_t constexpr DEFAULT_CONNECT_RETRY_INTERVAL_MS = 5000U;
+uint8_t constexpr DEFAULT_IN_FLIGHT_WINDOW = 8U;
+uint64_t constexpr DEFAULT_BUFFER_SHRINK_QUIET_PERIOD_MS = 60U * 1000U;
+uint16_t constexpr MINIMUM_ADAPTIVE_BUFFER_SIZE = 256U;
+#if THINGSBOARD_ENABLE_WORKER_TASK
+// Worker task defaults.
+size_t constexpr DEFAULT_WORKER_RING_SIZE = 64U;
+uint8_t constexpr DEFAULT_WORKER_TASK_PRIORITY = 5U;
+uint16_t constexpr DEFAULT_WORKER_TASK_STACK_SIZE = 4096U;
+// Maximum amount of enqueued telemetry records the worker task drains from the ring into one combined publish message per iteration
+size_t constexpr WORKER_PUBLISH_BATCH_SIZE = 16U;
+#endif // THINGSBOARD_ENABLE_WORKER_TASK
+// Amount of scratch buffer usages after which the high-water-mark shrink policy is evaluated,
+// keeping the reusable serialization buffer from staying at the size of a single unusually big payload forever
+size_t constexpr SCRATCH_SHRINK_INTERVAL = 32U;
 // Log messages.
 char constexpr UNABLE_TO_DE_SERIALIZE_JSON[] = "Unable to de-serialize received json data with error (DeserializationError::%s)";
 char constexpr INVALID_BUFFER_SIZE[] = "Send buffer size (%u) to small for the given payloads size (%u), increase with setBufferSize accordingly or install the StreamUtils library";
 char constexpr UNABLE_TO_ALLOCATE_BUFFER[] = "Allocating memory for the internal MQTT buffer failed";
 char constexpr MAX_ENDPOINTS_AMOUNT_TEMPLATE_NAME[] = "MaxEndpointsAmount";
+char constexpr STORED_TELEMETRY_DROPPED[] = "Store-and-forward buffer full, dropped oldest stored telemetry record (%u bytes)";
+char constexpr STORED_TELEMETRY_TOO_BIG[] = "Serialized telemetry record (%u bytes) does not fit into the store-and-forward buffer (%u bytes) and was discarded";
+#if THINGSBOARD_ENABLE_WORKER_TASK
+char constexpr WORKER_RING_SIZE_INVALID[] = "Worker ring size (%u) has to be a power of two and at least 2";
+char constexpr WORKER_TASK_CREATE_FAILED[] = "Creating the telemetry worker task failed, ensure there is enough heap memory left for its stack";
+#endif // THINGSBOARD_ENABLE_WORKER_TASK
+#if !THINGSBOARD_ENABLE_DYNAMIC
+char constexpr DEADBAND_RULES_EXCEEDED[] = "Too many (%u) deadband rules, increase MaxDeadbandRulesAmount or remove rules with clearTelemetryDeadband";
+char constexpr AGGREGATED_KEYS_EXCEEDED[] = "Too many (%u) aggregated telemetry keys, increase MaxAggregatedKeysAmount";
+#endif // !THINGSBOARD_ENABLE_DYNAMIC
 #if THINGSBOARD_ENABLE_DYNAMIC
 char constexpr MAXIMUM_RESPONSE_EXCEEDED[] = "Prevented allocation on the heap (%u) for JsonDocument. Discarding message that is bigger than maximum response size (%u)";
 char constexpr HEAP_ALLOCATION_FAILED[] = "Failed allocating required size (%u) for JsonDocument. Ensure there is enough heap memory left";
@@ -36,6 +75,9 @@ char constexpr CLAIM_TOPIC[] = "v1/devices/me/claim";
 // Claim data keys.
 char constexpr SECRET_KEY[] = "secretKey";
 char constexpr DURATION_KEY[] = "durationMs";
+// Multi-point time-series data keys.
+char constexpr TIMESTAMP_KEY[] = "ts";
+char constexpr VALUES_KEY[] = "values";
 
 
 #if THINGSBOARD_ENABLE_DYNAMIC
@@ -59,7 +101,10 @@ template <typename Logger = DefaultLogger>
 /// @tparam MaxResponse Maximum amount of key value pair that will ever be received by ThingsBoard in one call, default = Default_Response_Amount (8)
 /// @tparam MaxEndpointsAmount Maximum amount of subscribed API endpoints, Default_Endpoints_Amount is used as the default value because it is big enough to hold one instance of every possible API Implementation, default = Default_Endpoints_Amount (7)
 /// @tparam Logger Implementation that should be used to print error messages generated by internal processes and additional debugging messages if THINGSBOARD_ENABLE_DEBUG is set, default = DefaultLogger
-template<size_t MaxResponse = Default_Response_Amount, size_t MaxEndpointsAmount = Default_Endpoints_Amount, typename Logger = DefaultLogger>
+/// @tparam MaxQueuedTelemetryAmount Maximum amount of telemetry key value pairs that can be queued with queueTelemetryData() before the queue is flushed automatically, default = Default_Queued_Telemetry_Amount (16)
+/// @tparam MaxDeadbandRulesAmount Maximum amount of per-key telemetry suppression rules that can be configured with setTelemetryDeadband(), default = Default_Deadband_Rules_Amount (8)
+/// @tparam MaxAggregatedKeysAmount Maximum amount of per-key telemetry accumulators that can be configured with setTelemetryAggregation(), default = Default_Aggregated_Keys_Amount (8)
+template<size_t MaxResponse = Default_Response_Amount, size_t MaxEndpointsAmount = Default_Endpoints_Amount, typename Logger = DefaultLogger, size_t MaxQueuedTelemetryAmount = Default_Queued_Telemetry_Amount, size_t MaxDeadbandRulesAmount = Default_Deadband_Rules_Amount, size_t MaxAggregatedKeysAmount = Default_Aggregated_Keys_Amount>
 #endif // THINGSBOARD_ENABLE_DYNAMIC
 class ThingsBoardSized {
   public:
@@ -123,25 +168,42 @@ class ThingsBoardSized {
             if (api == nullptr) {
                 continue;
             }
-#if THINGSBOARD_ENABLE_STL
-            api->Set_Client_Callbacks(std::bind(&ThingsBoardSized::Subscribe_API_Implementation, this, std::placeholders::_1), std::bind(&ThingsBoardSized::Send_Json, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3), std::bind(&ThingsBoardSized::Send_Json_String, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoardSized::clientSubscribe, this, std::placeholders::_1), std::bind(&ThingsBoardSized::clientUnsubscribe, this, std::placeholders::_1), std::bind(&ThingsBoardSized::getClientReceiveBufferSize, this), std::bind(&ThingsBoardSized::getClientSendBufferSize, this), std::bind(&ThingsBoardSized::setBufferSize, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoardSized::getRequestID, this));
-#else
-            api->Set_Client_Callbacks(ThingsBoardSized::staticSubscribeImplementation, ThingsBoardSized::staticSendJson, ThingsBoardSized::staticSendJsonString, ThingsBoardSized::staticClientSubscribe, ThingsBoardSized::staticClientUnsubscribe, ThingsBoardSized::staticGetClientReceiveBufferSize, ThingsBoardSized::staticGetClientSendBufferSize, ThingsBoardSized::staticSetBufferSize, ThingsBoardSized::staticGetRequestID);
-#endif // THINGSBOARD_ENABLE_STL
+            api->Set_Client_Callbacks(Delegate<void, IAPI_Implementation &>::Create<ThingsBoardSized, &ThingsBoardSized::Subscribe_API_Implementation>(this), Delegate<bool, char const * const, JsonDocument const &, size_t const &>::Create<ThingsBoardSized, &ThingsBoardSized::Send_Json>(this), Delegate<bool, char const * const, char const * const>::Create<ThingsBoardSized, &ThingsBoardSized::Send_Json_String>(this), Delegate<bool, char const * const>::Create<ThingsBoardSized, &ThingsBoardSized::clientSubscribe>(this), Delegate<bool, char const * const>::Create<ThingsBoardSized, &ThingsBoardSized::clientUnsubscribe>(this), Delegate<uint16_t>::Create<ThingsBoardSized, &ThingsBoardSized::getClientReceiveBufferSize>(this), Delegate<uint16_t>::Create<ThingsBoardSized, &ThingsBoardSized::getClientSendBufferSize>(this), Delegate<bool, uint16_t, uint16_t>::Create<ThingsBoardSized, &ThingsBoardSized::setBufferSize>(this), Delegate<size_t *>::Create<ThingsBoardSized, &ThingsBoardSized::getRequestID>(this));
             api->Initialize();
         }
+        Build_Topic_Dispatch_Table();
         (void)setBufferSize(receive_buffer_size, send_buffer_size);
         // Initialize callback.
 #if THINGSBOARD_ENABLE_STL
         m_client.set_data_callback(std::bind(&ThingsBoardSized::onMQTTMessage, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+        m_client.set_fragment_data_callback(std::bind(&ThingsBoardSized::onMQTTMessageFragment, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4, std::placeholders::_5));
+        m_client.set_publish_completion_callback(std::bind(&ThingsBoardSized::onPublishCompleted, this, std::placeholders::_1));
         m_client.set_connect_callback(std::bind(&ThingsBoardSized::Resubscribe_Topics, this));
 #else
         m_client.set_data_callback(ThingsBoardSized::onStaticMQTTMessage);
+        m_client.set_fragment_data_callback(ThingsBoardSized::onStaticMQTTMessageFragment);
+        m_client.set_publish_completion_callback(ThingsBoardSized::onStaticPublishCompleted);
         m_client.set_connect_callback(ThingsBoardSized::staticMQTTConnect);
         m_subscribedInstance = this;
 #endif // THINGSBOARD_ENABLE_STL
     }
 
+    /// @brief Destructor
+    ~ThingsBoardSized() {
+        if (m_scratch_buffer != nullptr) {
+            Memory_Metrics::record_deallocation(Memory_Subsystem::SCRATCH_BUFFER, m_scratch_capacity);
+        }
+        delete[] m_scratch_buffer;
+        m_scratch_buffer = nullptr;
+#if THINGSBOARD_ENABLE_DYNAMIC
+        if (m_receive_document != nullptr) {
+            Memory_Metrics::record_deallocation(Memory_Subsystem::RECEIVE_DOCUMENT, m_receive_document->capacity());
+        }
+        delete m_receive_document;
+        m_receive_document = nullptr;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    }
+
     /// @brief Gets the currently connected MQTT Client implementation as a reference.
     /// Allows for calling method directly on the client itself, not advised in normal use cases,
     /// as it might cause problems if the library expects the client to be sending / receiving data
@@ -177,6 +239,19 @@ class ThingsBoardSized {
     void setMaxResponseSize(size_t const & max_response_size) {
         m_max_response_size = max_response_size;
     }
+
+    /// @brief Frees the reusable receive document that all received messages are deserialized into.
+    /// The document is allocated once at the biggest capacity a received message required so far and is then reused,
+    /// meaning steady-state message processing performs no heap allocations and does not fragment the heap on long-running devices.
+    /// Calling this method releases that memory again, useful after a known burst of big messages (for example the initial attribute synchronization),
+    /// the document is simply reallocated at the required capacity once the next message is received
+    void trimReceiveDocument() {
+        if (m_receive_document != nullptr) {
+            Memory_Metrics::record_deallocation(Memory_Subsystem::RECEIVE_DOCUMENT, m_receive_document->capacity());
+        }
+        delete m_receive_document;
+        m_receive_document = nullptr;
+    }
 #endif // THINGSBOARD_ENABLE_DYNAMIC
 
     /// @brief Sets the size of the buffer for the underlying network client that will be used to establish the connection to ThingsBoard.
@@ -193,13 +268,54 @@ class ThingsBoardSized {
     /// This can be done by simply using Arduino as the framework and installing the StreamUtils (https://github.com/bblanchon/ArduinoStreamUtils) library
     /// @return Whether allocating the needed memory for the given buffer sizes was successful or not
     bool setBufferSize(uint16_t receive_buffer_size, uint16_t send_buffer_size) {
+        size_t const previous_buffer_size = m_client.get_receive_buffer_size() + m_client.get_send_buffer_size();
         bool const result = m_client.set_buffer_size(receive_buffer_size, send_buffer_size);
         if (!result) {
             Logger::printfln(UNABLE_TO_ALLOCATE_BUFFER);
+            return result;
         }
+        Memory_Metrics::record_resize(Memory_Subsystem::CLIENT_BUFFER, previous_buffer_size, receive_buffer_size + send_buffer_size);
         return result;
     }
 
+    /// @brief Enables adapting the buffer sizes of the underlying MQTT client to the actually sent and received payload sizes,
+    /// instead of keeping the fixed sizes chosen with setBufferSize() at integration time, which either permanently wastes memory or fails rare bursts.
+    /// The send buffer is grown on demand once a payload does not fit anymore and both buffers are shrunk back
+    /// to the biggest payload size that actually occured in the given quiet period, the same way the internal scratch buffer already rightsizes itself.
+    /// The all time high water marks stay queryable with sentPayloadHighWaterMark() and receivedPayloadHighWaterMark(),
+    /// which allows right-sizing the initally configured buffer sizes of a complete fleet from reported telemetry.
+    /// Be aware that shrinking is based purely on the payload sizes that occured in the quiet period,
+    /// meaning a response that is only received very rarely but is bigger than the current steady state (firmware chunks), pays one growth cycle again
+    /// @param shrink_quiet_period_ms Amount of milliseconds without a bigger payload after which the buffers are shrunk back
+    /// to the biggest recently occured payload size, default = DEFAULT_BUFFER_SHRINK_QUIET_PERIOD_MS (60000)
+    void enableAdaptiveBufferSizing(uint64_t const & shrink_quiet_period_ms = DEFAULT_BUFFER_SHRINK_QUIET_PERIOD_MS) {
+        m_adaptive_buffer_enabled = true;
+        m_buffer_shrink_quiet_period = (shrink_quiet_period_ms != 0U) ? shrink_quiet_period_ms : DEFAULT_BUFFER_SHRINK_QUIET_PERIOD_MS;
+        m_last_buffer_shrink_check = Helper::getUptimeMilliseconds();
+        m_recent_sent_high_water = 0U;
+        m_recent_received_high_water = 0U;
+    }
+
+    /// @brief Disables the previously with enableAdaptiveBufferSizing() enabled adaptive buffer sizing policy,
+    /// the buffers simply keep their current sizes until they are changed with setBufferSize() again
+    void disableAdaptiveBufferSizing() {
+        m_adaptive_buffer_enabled = false;
+    }
+
+    /// @brief Gets the size in bytes of the biggest payload that was attempted to be sent since the client was constructed.
+    /// Tracked even while adaptive buffer sizing is disabled, allowing to right-size the configured send buffer size from reported telemetry
+    /// @return Size of the biggest sent payload in bytes
+    uint16_t sentPayloadHighWaterMark() const {
+        return m_sent_payload_high_water;
+    }
+
+    /// @brief Gets the size in bytes of the biggest payload that was received since the client was constructed.
+    /// Tracked even while adaptive buffer sizing is disabled, allowing to right-size the configured receive buffer size from reported telemetry
+    /// @return Size of the biggest received payload in bytes
+    uint16_t receivedPayloadHighWaterMark() const {
+        return m_received_payload_high_water;
+    }
+
     /// @brief Clears all currently subscribed callbacks and unsubscribed from all
     /// currently subscribed MQTT topics, any response that will stil be received is discarded
     /// and any ongoing firmware update is aborted and will not be finished.
@@ -228,15 +344,78 @@ class ThingsBoardSized {
     /// @param password Client password that can be used to authenticate the user that is connecting the given device to ThingsBoard, default = nullptr
     /// @return Whether connecting to ThingsBoard was successful or not
     bool connect(char const * host, char const * access_token = PROV_ACCESS_TOKEN, uint16_t port = DEFAULT_MQTT_PORT, char const * client_id = nullptr, char const * password = nullptr) {
+        if (host == nullptr) {
+            return false;
+        }
+        // A previously started asynchronous connect is stopped, because the synchronous connect below replays the subscriptions directly from the connect callback
+        m_async_connect_enabled = false;
+        m_client.set_server(host, port);
+        bool const connection_result = connectToHost(access_token, Helper::stringIsNullorEmpty(client_id) ? access_token : client_id, Helper::stringIsNullorEmpty(password) ? nullptr : password);
+        m_connection_state = connection_result ? Connection_State::CONNECTED : Connection_State::DISCONNECTED;
+        return connection_result;
+    }
+
+    /// @brief Connects to the specified ThingsBoard server over the given port with credentials previously issued by the provision API
+    /// and persisted in the given credentials store, see the Set_Credentials_Store() method of the Provision API implementation.
+    /// Skips the complete provision exchange on boots where persisted credentials exist, which significantly reduces the wake-to-first-telemetry time
+    /// of devices that sleep between transmissions, because connecting does not require the provision request round trip and the reconnect afterwards anymore.
+    /// If no credentials are persisted yet this method simply fails, the caller is then expected to connect with the provision access token
+    /// and perform the provision exchange once, which persists the issued credentials for all subsequent boots
+    /// @param host ThingsBoard server instance we want to connect to
+    /// @param credentials_store Credentials store implementation the previously issued credentials are read from
+    /// @param port Port that will be used to establish a connection and send / receive data from ThingsBoard over, default = DEFAULT_MQTT_PORT (1883)
+    /// @return Whether persisted credentials existed and connecting to ThingsBoard with them was successful or not
+    bool connect(char const * host, ICredentials_Store & credentials_store, uint16_t port = DEFAULT_MQTT_PORT) {
+        // Credentials are copied into a member, because the underlying client only stores pointers to them
+        // and requires them to stay allocated for as long as the connection should be kept established
+        m_cached_credentials = Provisioned_Credentials();
+        if (!credentials_store.retrieve(m_cached_credentials) || Helper::stringIsNullorEmpty(m_cached_credentials.access_token)) {
+            return false;
+        }
+        return connect(host, m_cached_credentials.access_token, port, m_cached_credentials.client_id, m_cached_credentials.password);
+    }
+
+    /// @brief Starts connecting to the specified ThingsBoard server over the given port as the given device, without blocking the calling task until the connection is established.
+    /// The actual connection attempts, retries and the replay of the previously subscribed topics are instead performed incrementally from loop(),
+    /// bounded to at most one connection attempt or one subscribe packet per loop() iteration, meaning the control loop never stalls for the full handshake duration.
+    /// The current progress can be polled with connectionState(), once it returns Connection_State::CONNECTED the connection is fully established and all topics are resubscribed.
+    /// If the connection is lost afterwards the state machine falls back to Connection_State::CONNECTING and reconnects with the same credentials automatically
+    /// @param host ThingsBoard server instance we want to connect to, requires to stay allocated for as long as the asynchronous connect is active
+    /// @param access_token Access token that connects this device with a created device on the ThingsBoard server,
+    /// can be "provision", if the device creates itself instead, requires to stay allocated for as long as the asynchronous connect is active, default = PROV_ACCESS_TOKEN ("provision")
+    /// @param port Port that will be used to establish a connection and send / receive data from ThingsBoard over, default = DEFAULT_MQTT_PORT (1883)
+    /// @param client_id Client username that can be used to differentiate the user that is connecting the given device to ThingsBoard, recommended to be a unique identifier
+    /// so it possible to discern which device is communicating, requires to stay allocated for as long as the asynchronous connect is active, default = Value of passed access token
+    /// @param password Client password that can be used to authenticate the user that is connecting the given device to ThingsBoard, default = nullptr
+    /// @param retry_interval_ms Amount of milliseconds we wait after a failed connection attempt before the next one is started, default = DEFAULT_CONNECT_RETRY_INTERVAL_MS (5000)
+    /// @return Whether starting the asynchronous connect was successful or not, the actual connection result has to be polled with connectionState()
+    bool connectAsync(char const * host, char const * access_token = PROV_ACCESS_TOKEN, uint16_t port = DEFAULT_MQTT_PORT, char const * client_id = nullptr, char const * password = nullptr, uint64_t const & retry_interval_ms = DEFAULT_CONNECT_RETRY_INTERVAL_MS) {
         if (host == nullptr) {
             return false;
         }
         m_client.set_server(host, port);
-        return connectToHost(access_token, Helper::stringIsNullorEmpty(client_id) ? access_token : client_id, Helper::stringIsNullorEmpty(password) ? nullptr : password);
+        m_connect_access_token = access_token;
+        m_connect_client_id = Helper::stringIsNullorEmpty(client_id) ? access_token : client_id;
+        m_connect_password = Helper::stringIsNullorEmpty(password) ? nullptr : password;
+        m_connect_retry_interval = retry_interval_ms;
+        m_last_connect_attempt = 0U;
+        m_async_connect_enabled = true;
+        m_connection_state = Connection_State::CONNECTING;
+        return true;
+    }
+
+    /// @brief Returns the current state of the asynchronous connect state machine started with connectAsync().
+    /// Requires loop() to be called continuously, because the state machine only makes progress from there
+    /// @return Current state of the asynchronous connect state machine
+    Connection_State connectionState() const {
+        return m_connection_state;
     }
 
-    /// @brief Disconnects any connection that has been established already
+    /// @brief Disconnects any connection that has been established already,
+    /// additionally stops a previously started asynchronous connect so no automatic reconnect is performed anymore
     void disconnect() {
+        m_async_connect_enabled = false;
+        m_connection_state = Connection_State::DISCONNECTED;
         m_client.disconnect();
     }
 
@@ -258,10 +437,80 @@ class ThingsBoardSized {
             }
             api->loop();
         }
+        m_telemetry_flush_timer.update();
+        m_aggregation_flush_timer.update();
 #endif // !THINGSBOARD_USE_ESP_TIMER
+        // Advance the asynchronous connect state machine, if one has been started with connectAsync()
+        if (m_async_connect_enabled) {
+            Process_Connection_State_Machine();
+        }
+        // Continues forwarding stored telemetry whose drain was paused, because the configured window of unconfirmed published messages was exhausted
+        if (m_publish_quality_of_service != 0U && m_client.connected() && storeEnabled() && storedTelemetryAmount() != 0U) {
+            (void)drainStoredTelemetry();
+        }
+        // Shrinks the client buffers back to the recently occured payload sizes, if adaptive buffer sizing has been enabled
+        if (m_adaptive_buffer_enabled) {
+            Shrink_Buffers_To_High_Water_Mark();
+        }
         return m_client.loop();
     }
 
+    /// @brief Configures the quality of service all payloads are published with, the default is 0 meaning payloads are published fire-and-forget.
+    /// With a quality of service of 1 every published message is confirmed by the broker and retransmitted by the underlying client until it is,
+    /// which guarantees delivery without application level acknowledgments, but only if the used client implementation supports it (Espressif_MQTT_Client),
+    /// implementations that do not simply keep publishing with quality of service 0.
+    /// The given in-flight window bounds how many published messages may be unconfirmed simultaneously,
+    /// meaning messages are pipelined instead of waiting for each confirmation individually, which keeps the throughput close to quality of service 0.
+    /// Publishes that would exceed the window fail immediately, stored telemetry that could not be forwarded because of an exhausted window
+    /// simply stays stored and the forwarding is continued automatically from loop() once previously sent messages have been confirmed
+    /// @param quality_of_service Quality of service all payloads are published with (0 or 1)
+    /// @param in_flight_window Maximum amount of simultaneously unconfirmed published messages, default = DEFAULT_IN_FLIGHT_WINDOW (8)
+    void setPublishQualityOfService(uint8_t quality_of_service, uint8_t in_flight_window = DEFAULT_IN_FLIGHT_WINDOW) {
+        m_publish_quality_of_service = quality_of_service;
+        m_in_flight_window = (in_flight_window != 0U) ? in_flight_window : DEFAULT_IN_FLIGHT_WINDOW;
+    }
+
+    /// @brief Gets the current amount of published messages whose delivery has not been confirmed by the broker yet.
+    /// Always 0 if the quality of service has not been changed from its default of 0 with setPublishQualityOfService().
+    /// Useful to ensure all sent data has actually arrived on the cloud, before the device enters deep sleep
+    /// @return Amount of currently unconfirmed published messages
+    uint8_t inFlightPublishAmount() const {
+        return __atomic_load_n(&m_in_flight_count, __ATOMIC_ACQUIRE);
+    }
+
+#if THINGSBOARD_ENABLE_PROFILING
+    /// @brief Gets the accumulated latency statistics of the given instrumented stage of the hot send and receive paths.
+    /// Each stage accumulates the total and maximum duration, the amount of samples and a power of two histogram of the recorded durations,
+    /// useful to narrow down where the time goes when the publish or receive latency regresses in the field
+    /// @param stage Stage the statistics should be returned for
+    /// @return Reference to the accumulated statistics of the given stage, stays valid for the complete lifetime of the program
+    Profile_Stage_Stats const & profilingStats(Profile_Stage stage) const {
+        return Profiler::stats(stage);
+    }
+
+    /// @brief Resets the accumulated latency statistics of every instrumented stage back to zero,
+    /// useful to measure a specific phase of the program in isolation
+    void resetProfilingStats() {
+        Profiler::reset();
+    }
+#endif // THINGSBOARD_ENABLE_PROFILING
+
+    /// @brief Gets a snapshot of the accumulated heap usage statistics of the given subsystem of the library.
+    /// Contains the currently allocated bytes, the biggest amount of simultaneously allocated bytes and the total amount of allocations,
+    /// useful to publish the memory behaviour of the library itself as telemetry and right-size the template arguments
+    /// and buffer parameters (MaxFieldsAmount, buffer sizes, ring sizes) of a complete fleet from reported data
+    /// @param subsystem Subsystem the statistics should be returned for
+    /// @return Copied snapshot of the accumulated statistics, copied because the counters keep changing while they are read
+    Memory_Subsystem_Stats memoryStats(Memory_Subsystem subsystem) const {
+        return Memory_Metrics::stats(subsystem);
+    }
+
+    /// @brief Gets the total amount of bytes the library currently has allocated over all accounted subsystems
+    /// @return Sum of the currently allocated bytes of every subsystem
+    size_t totalLiveBytes() const {
+        return Memory_Metrics::total_live_bytes();
+    }
+
     /// @brief Attempts to send key value pairs from custom source over the given topic to the server
     /// @param topic Topic we want to send the data over
     /// @param source JsonDocument containing our json key value pairs we want to send,
@@ -283,10 +532,12 @@ class ThingsBoardSized {
         }
         bool result = false;
 
-#if THINGSBOARD_ENABLE_STREAM_UTILS
+        // With adaptive buffer sizing enabled the send buffer is grown instead of falling back to the slower streamed serialization below
+        Grow_Send_Buffer(json_size);
         // Check if the size of the given message would be too big for the actual client,
-        // if it is utilize the serialize json work around, so that the internal client buffer can be circumvented
-        if (m_client.get_buffer_size() < json_size)  {
+        // if it is the payload is streamed chunk by chunk straight from the serializer into the client instead,
+        // so that the internal client buffer can be circumvented
+        if (m_client.get_send_buffer_size() < json_size)  {
 #if THINGSBOARD_ENABLE_DEBUG
             Logger::printfln(SEND_MESSAGE, topic, SEND_SERIALIZED);
 #endif // THINGSBOARD_ENABLE_DEBUG
@@ -294,28 +545,47 @@ class ThingsBoardSized {
         }
         // Check if the remaining stack size of the current task would overflow the stack,
         // if it would allocate the memory on the heap instead to ensure no stack overflow occurs
-        else
-#endif // THINGSBOARD_ENABLE_STREAM_UTILS
-        if (json_size > getMaximumStackSize()) {
-            char* json = new char[json_size]();
-            if (serializeJson(source, json, json_size) < json_size - 1) {
+        else if (json_size > getMaximumStackSize()) {
+            // Payloads that are too big for the stack are serialized into transport-owned memory if the underlying client can lend some,
+            // which skips the intermediate copy out of our own buffer, and otherwise into a reusable scratch buffer owned by this instance,
+            // instead of allocating and immediately freeing a fresh heap buffer on every single send, which fragments the heap at high publish rates
+            char* json = reinterpret_cast<char*>(m_client.borrow_publish_buffer(json_size));
+            if (json == nullptr) {
+                json = getScratchBuffer(json_size);
+            }
+#if THINGSBOARD_ENABLE_MSGPACK
+            // MessagePack is a binary format without a null terminator, meaning the payload can not be forwarded as a string
+            // and the serialized size has to be exactly the measured size instead of the measured size - 1
+            if (Serialize_Payload(source, json, json_size) < json_size) {
+                Logger::printfln(UNABLE_TO_SERIALIZE_JSON);
+            }
+            else {
+                result = Publish_Payload(topic, reinterpret_cast<uint8_t const *>(json), json_size);
+            }
+#else
+            if (Serialize_Payload(source, json, json_size) < json_size - 1) {
                 Logger::printfln(UNABLE_TO_SERIALIZE_JSON);
             }
             else {
                 result = Send_Json_String(topic, json);
             }
-            // Ensure to actually delete the memory placed onto the heap, to make sure we do not create a memory leak
-            // and set the pointer to null so we do not have a dangling reference.
-            delete[] json;
-            json = nullptr;
+#endif // THINGSBOARD_ENABLE_MSGPACK
         }
         else {
             char json[json_size] = {};
-            if (serializeJson(source, json, json_size) < json_size - 1) {
+#if THINGSBOARD_ENABLE_MSGPACK
+            if (Serialize_Payload(source, json, json_size) < json_size) {
+                Logger::printfln(UNABLE_TO_SERIALIZE_JSON);
+                return result;
+            }
+            result = Publish_Payload(topic, reinterpret_cast<uint8_t const *>(json), json_size);
+#else
+            if (Serialize_Payload(source, json, json_size) < json_size - 1) {
                 Logger::printfln(UNABLE_TO_SERIALIZE_JSON);
                 return result;
             }
             result = Send_Json_String(topic, json);
+#endif // THINGSBOARD_ENABLE_MSGPACK
         }
 
         return result;
@@ -330,8 +600,9 @@ class ThingsBoardSized {
             return false;
         }
 
-        uint16_t current_send_buffer_size = m_client.get_send_buffer_size();
         size_t const json_size = strlen(json);
+        Grow_Send_Buffer(json_size);
+        uint16_t current_send_buffer_size = m_client.get_send_buffer_size();
 
         if (current_send_buffer_size < json_size) {
             Logger::printfln(INVALID_BUFFER_SIZE, current_send_buffer_size, json_size);
@@ -341,7 +612,106 @@ class ThingsBoardSized {
 #if THINGSBOARD_ENABLE_DEBUG
         Logger::printfln(SEND_MESSAGE, topic, json);
 #endif // THINGSBOARD_ENABLE_DEBUG
-        return m_client.publish(topic, reinterpret_cast<uint8_t const *>(json), json_size);
+        return Publish_Payload(topic, reinterpret_cast<uint8_t const *>(json), json_size);
+    }
+
+    /// @brief Serializes the given source into the given buffer, with the binary MessagePack format if THINGSBOARD_ENABLE_MSGPACK is enabled and as json text otherwise
+    /// @param source JsonDocument containing our json key value pairs we want to serialize
+    /// @param json Buffer the serialized payload is written into
+    /// @param json_size Size of the given buffer in bytes
+    /// @return Amount of bytes that were written into the given buffer
+    size_t Serialize_Payload(JsonDocument const & source, char * json, size_t const & json_size) {
+#if THINGSBOARD_ENABLE_PROFILING
+        Profile_Probe const probe(Profile_Stage::SEND_SERIALIZE);
+#endif // THINGSBOARD_ENABLE_PROFILING
+#if THINGSBOARD_ENABLE_MSGPACK
+        return serializeMsgPack(source, json, json_size);
+#else
+        return serializeJson(source, json, json_size);
+#endif // THINGSBOARD_ENABLE_MSGPACK
+    }
+
+    /// @brief Publishes the given payload over the given topic with the quality of service configured with setPublishQualityOfService().
+    /// With the default quality of service 0 the payload is simply published fire-and-forget.
+    /// With a quality of service of 1 the message occupies one slot of the configured in-flight window until the broker has confirmed its delivery,
+    /// which pipelines multiple unconfirmed messages instead of waiting for each confirmation individually.
+    /// Fails immediately if the window is exhausted, the caller is expected to retry once previously sent messages have been confirmed
+    /// @param topic Topic we want to send the payload over
+    /// @param payload Payload that should be published
+    /// @param length Length of the payload in bytes
+    /// @return Whether publishing the payload was successful or not
+    bool Publish_Payload(char const * topic, uint8_t const * payload, size_t const & length) {
+#if THINGSBOARD_ENABLE_PROFILING
+        Profile_Probe const probe(Profile_Stage::SEND_PUBLISH);
+#endif // THINGSBOARD_ENABLE_PROFILING
+        Record_Sent_Payload_Size(length);
+        if (m_publish_quality_of_service == 0U) {
+            return m_client.publish(topic, payload, length);
+        }
+        if (__atomic_load_n(&m_in_flight_count, __ATOMIC_ACQUIRE) >= m_in_flight_window) {
+            return false;
+        }
+        int message_id = 0;
+        if (!m_client.publish(topic, payload, length, m_publish_quality_of_service, message_id)) {
+            return false;
+        }
+        // Messages with a message id of 0 were sent without expecting a delivery confirmation,
+        // either because the client does not support a quality of service bigger than 0 or downgraded it, those do not occupy the window
+        if (message_id > 0) {
+            (void)__atomic_add_fetch(&m_in_flight_count, 1U, __ATOMIC_ACQ_REL);
+        }
+        return true;
+    }
+
+    /// @brief Callback that is called by the MQTT client once the broker has confirmed the delivery of a message published with a quality of service bigger than 0.
+    /// Frees one slot of the configured in-flight window, the message id itself is not needed, because the window only bounds the amount of unconfirmed messages.
+    /// Is called from the task of the underlying MQTT client, therefore the counter is updated with atomic builtins
+    /// @param message_id Message id of the message whose delivery was confirmed
+    void onPublishCompleted(int message_id) {
+        uint8_t current_amount = __atomic_load_n(&m_in_flight_count, __ATOMIC_ACQUIRE);
+        // The counter is never decremented below 0, guards against confirmations of messages that were published before the quality of service was reconfigured
+        while (current_amount != 0U && !__atomic_compare_exchange_n(&m_in_flight_count, &current_amount, current_amount - 1U, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {}
+    }
+
+    /// @brief Records the size of a payload that is about to be sent into the all time and the recent high water marks.
+    /// The all time mark is queryable with sentPayloadHighWaterMark(), the recent mark decides what size the send buffer is shrunk back to
+    /// @param length Length of the payload in bytes
+    void Record_Sent_Payload_Size(size_t const & length) {
+        uint16_t const clamped_length = (length > UINT16_MAX) ? UINT16_MAX : static_cast<uint16_t>(length);
+        if (clamped_length > m_sent_payload_high_water) {
+            m_sent_payload_high_water = clamped_length;
+        }
+        if (clamped_length > m_recent_sent_high_water) {
+            m_recent_sent_high_water = clamped_length;
+        }
+    }
+
+    /// @brief Grows the send buffer of the underlying MQTT client on demand, so the given payload fits into it.
+    /// Does nothing if adaptive buffer sizing has not been enabled with enableAdaptiveBufferSizing(), the payload already fits
+    /// or it could never fit, because it exceeds the maximum buffer size an MQTT message can require (uint16_t)
+    /// @param needed_size Size in bytes the payload that is about to be sent requires
+    void Grow_Send_Buffer(size_t const & needed_size) {
+        if (!m_adaptive_buffer_enabled || needed_size > UINT16_MAX || m_client.get_send_buffer_size() >= needed_size) {
+            return;
+        }
+        (void)setBufferSize(m_client.get_receive_buffer_size(), static_cast<uint16_t>(needed_size));
+    }
+
+    /// @brief Shrinks the buffers of the underlying MQTT client back to the biggest payload sizes that actually occured in the last quiet period.
+    /// Called from loop() once the configured quiet period has passed, does nothing if no buffer exceeds its recent high water mark
+    void Shrink_Buffers_To_High_Water_Mark() {
+        uint64_t const now = Helper::getUptimeMilliseconds();
+        if (now - m_last_buffer_shrink_check < m_buffer_shrink_quiet_period) {
+            return;
+        }
+        m_last_buffer_shrink_check = now;
+        uint16_t const send_target = (m_recent_sent_high_water > MINIMUM_ADAPTIVE_BUFFER_SIZE) ? m_recent_sent_high_water : MINIMUM_ADAPTIVE_BUFFER_SIZE;
+        uint16_t const receive_target = (m_recent_received_high_water > MINIMUM_ADAPTIVE_BUFFER_SIZE) ? m_recent_received_high_water : MINIMUM_ADAPTIVE_BUFFER_SIZE;
+        if (m_client.get_send_buffer_size() > send_target || m_client.get_receive_buffer_size() > receive_target) {
+            (void)setBufferSize(receive_target, send_target);
+        }
+        m_recent_sent_high_water = 0U;
+        m_recent_received_high_water = 0U;
     }
 
     /// @brief Copies a non-owning pointer to the given API implementation, into the local data container.
@@ -354,13 +724,10 @@ class ThingsBoardSized {
             return;
         }
 #endif // !THINGSBOARD_ENABLE_DYNAMIC
-#if THINGSBOARD_ENABLE_STL
-        api.Set_Client_Callbacks(std::bind(&ThingsBoardSized::Subscribe_API_Implementation, this, std::placeholders::_1), std::bind(&ThingsBoardSized::Send_Json, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3), std::bind(&ThingsBoardSized::Send_Json_String, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoardSized::clientSubscribe, this, std::placeholders::_1), std::bind(&ThingsBoardSized::clientUnsubscribe, this, std::placeholders::_1), std::bind(&ThingsBoardSized::getClientReceiveBufferSize, this), std::bind(&ThingsBoardSized::getClientSendBufferSize, this), std::bind(&ThingsBoardSized::setBufferSize, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoardSized::getRequestID, this));
-#else
-        api.Set_Client_Callbacks(ThingsBoardSized::staticSubscribeImplementation, ThingsBoardSized::staticSendJson, ThingsBoardSized::staticSendJsonString, ThingsBoardSized::staticClientSubscribe, ThingsBoardSized::staticClientUnsubscribe, ThingsBoardSized::staticGetClientReceiveBufferSize, ThingsBoardSized::staticGetClientSendBufferSize, ThingsBoardSized::staticSetBufferSize, ThingsBoardSized::staticGetRequestID);
-#endif // THINGSBOARD_ENABLE_STL
+        api.Set_Client_Callbacks(Delegate<void, IAPI_Implementation &>::Create<ThingsBoardSized, &ThingsBoardSized::Subscribe_API_Implementation>(this), Delegate<bool, char const * const, JsonDocument const &, size_t const &>::Create<ThingsBoardSized, &ThingsBoardSized::Send_Json>(this), Delegate<bool, char const * const, char const * const>::Create<ThingsBoardSized, &ThingsBoardSized::Send_Json_String>(this), Delegate<bool, char const * const>::Create<ThingsBoardSized, &ThingsBoardSized::clientSubscribe>(this), Delegate<bool, char const * const>::Create<ThingsBoardSized, &ThingsBoardSized::clientUnsubscribe>(this), Delegate<uint16_t>::Create<ThingsBoardSized, &ThingsBoardSized::getClientReceiveBufferSize>(this), Delegate<uint16_t>::Create<ThingsBoardSized, &ThingsBoardSized::getClientSendBufferSize>(this), Delegate<bool, uint16_t, uint16_t>::Create<ThingsBoardSized, &ThingsBoardSized::setBufferSize>(this), Delegate<size_t *>::Create<ThingsBoardSized, &ThingsBoardSized::getRequestID>(this));
         api.Initialize();
         m_api_implementations.push_back(&api);
+        Build_Topic_Dispatch_Table();
     }
 
     /// @brief Copies the non-owning pointers to the given API implementations, into the local data container.
@@ -385,14 +752,11 @@ class ThingsBoardSized {
             if (api == nullptr) {
                 continue;
             }
-#if THINGSBOARD_ENABLE_STL
-            api->Set_Client_Callbacks(std::bind(&ThingsBoardSized::Subscribe_API_Implementation, this, std::placeholders::_1), std::bind(&ThingsBoardSized::Send_Json, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3), std::bind(&ThingsBoardSized::Send_Json_String, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoardSized::clientSubscribe, this, std::placeholders::_1), std::bind(&ThingsBoardSized::clientUnsubscribe, this, std::placeholders::_1), std::bind(&ThingsBoardSized::getClientReceiveBufferSize, this), std::bind(&ThingsBoardSized::getClientSendBufferSize, this), std::bind(&ThingsBoardSized::setBufferSize, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoardSized::getRequestID, this));
-#else
-            api->Set_Client_Callbacks(ThingsBoardSized::staticSubscribeImplementation, ThingsBoardSized::staticSendJson, ThingsBoardSized::staticSendJsonString, ThingsBoardSized::staticClientSubscribe, ThingsBoardSized::staticClientUnsubscribe, ThingsBoardSized::staticGetClientReceiveBufferSize, ThingsBoardSized::staticGetClientSendBufferSize, ThingsBoardSized::staticSetBufferSize, ThingsBoardSized::staticGetRequestID);
-#endif // THINGSBOARD_ENABLE_STL
+            api->Set_Client_Callbacks(Delegate<void, IAPI_Implementation &>::Create<ThingsBoardSized, &ThingsBoardSized::Subscribe_API_Implementation>(this), Delegate<bool, char const * const, JsonDocument const &, size_t const &>::Create<ThingsBoardSized, &ThingsBoardSized::Send_Json>(this), Delegate<bool, char const * const, char const * const>::Create<ThingsBoardSized, &ThingsBoardSized::Send_Json_String>(this), Delegate<bool, char const * const>::Create<ThingsBoardSized, &ThingsBoardSized::clientSubscribe>(this), Delegate<bool, char const * const>::Create<ThingsBoardSized, &ThingsBoardSized::clientUnsubscribe>(this), Delegate<uint16_t>::Create<ThingsBoardSized, &ThingsBoardSized::getClientReceiveBufferSize>(this), Delegate<uint16_t>::Create<ThingsBoardSized, &ThingsBoardSized::getClientSendBufferSize>(this), Delegate<bool, uint16_t, uint16_t>::Create<ThingsBoardSized, &ThingsBoardSized::setBufferSize>(this), Delegate<size_t *>::Create<ThingsBoardSized, &ThingsBoardSized::getRequestID>(this));
             api->Initialize();
         }
         m_api_implementations.insert(m_api_implementations.end(), first, last);
+        Build_Topic_Dispatch_Table();
     }
 
     //----------------------------------------------------------------------------
@@ -427,6 +791,14 @@ class ThingsBoardSized {
     /// @return Whether sending the data was successful or not
     template<typename T>
     bool sendTelemetryData(char const * key, T const & value) {
+        Telemetry const t(key, value);
+        if (t.IsEmpty()) {
+            return false;
+        }
+        // Suppressed data points are reported as successfully sent, because dropping them is the expected behaviour of the configured rule
+        if (Should_Suppress_Telemetry(t)) {
+            return true;
+        }
         return sendKeyValue(key, value);
     }
 
@@ -453,46 +825,17 @@ class ThingsBoardSized {
 #endif // THINGSBOARD_ENABLE_DYNAMIC
     }
 
-    /// @brief Attempts to send custom json telemetry string.
-    /// See https://thingsboard.io/docs/user-guide/telemetry/ for more information
-    /// @param json String containing our json key value pairs we want to attempt to send
-    /// @return Whether sending the data was successful or not
-    bool sendTelemetryString(char const * json) {
-        return Send_Json_String(TELEMETRY_TOPIC, json);
-    }
-
-    /// @brief Attempts to send telemetry key value pairs from custom source to the server.
-    /// See https://thingsboard.io/docs/user-guide/telemetry/ for more information
-    /// @param source JsonDocument containing our json key value pairs we want to send,
-    /// is checked before usage for any possible occuring internal errors. See https://arduinojson.org/v6/api/jsondocument/ for more information
-    /// @param json_size Size of the data inside the source
-    /// @return Whether sending the data was successful or not
-    bool sendTelemetryJson(JsonDocument const & source, size_t const & json_size) {
-        return Send_Json(TELEMETRY_TOPIC, source, json_size);
-    }
-
-    //----------------------------------------------------------------------------
-    // Attribute API
-
-    /// @brief Attempts to send attribute data with the given key and value of the given type.
-    /// See https://thingsboard.io/docs/user-guide/attributes/ for more information
-    /// @tparam T Type of the passed value
-    /// @param key Key of the key value pair we want to send
-    /// @param value Value of the key value pair we want to send
-    /// @return Whether sending the data was successful or not
-    template<typename T>
-    bool sendAttributeData(char const * key, T const & value) {
-        return sendKeyValue(key, value, false);
-    }
-
-    /// @brief Attempts to send aggregated attribute data, expects iterators to a container containing Attribute class instances.
-    /// See https://thingsboard.io/docs/user-guide/attributes/ for more information
+    /// @brief Attempts to send aggregated timestamped telemetry data, expects iterators to a container containing Telemetry class instances,
+    /// that have been given a sample timestamp with SetTimestamp(). Records are grouped by their timestamp and serialized into the multi-point time-series format
+    /// ([{"ts":...,"values":{...}},...]), which allows to aggregate multiple sample instants into one single publish message,
+    /// instead of having to publish one message per sample instant. Records without a timestamp are grouped into one shared instant with the timestamp 0,
+    /// which the cloud interprets as the current server time. See https://thingsboard.io/docs/reference/mqtt-api/#timeseries-data-upload-api for more information
     /// @tparam InputIterator Class that points to the begin and end iterator
     /// of the given data container, allows for using / passing either std::vector or std::array.
     /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
     /// @param first Iterator pointing to the first element in the data container
     /// @param last Iterator pointing to the end of the data container (last element + 1)
-    /// @return Whether sending the aggregated attribute data was successful or not
+    /// @return Whether sending the aggregated timestamped telemetry data was successful or not
 #if THINGSBOARD_ENABLE_DYNAMIC
     template<typename InputIterator>
 #else
@@ -500,93 +843,778 @@ class ThingsBoardSized {
     /// Should simply be the biggest distance between first and last iterator this method is ever called with
     template<size_t MaxKeyValuePairAmount, typename InputIterator>
 #endif // THINGSBOARD_ENABLE_DYNAMIC
-    bool sendAttributes(InputIterator const & first, InputIterator const & last) {
+    bool sendTimeseries(InputIterator const & first, InputIterator const & last) {
+        size_t const size = Helper::distance(first, last);
 #if THINGSBOARD_ENABLE_DYNAMIC
-        return sendDataArray(first, last, false);
+        // Worst case is that every record was sampled at a different instant, meaning the surrounding array contains one object with a nested values object per record.
+        // See https://arduinojson.org/v6/assistant/ for more information on the needed size for the JsonDocument
+        TBJsonDocument json_buffer(JSON_ARRAY_SIZE(size) + (size * (JSON_OBJECT_SIZE(2) + JSON_OBJECT_SIZE(1))));
 #else
-        return sendDataArray<MaxKeyValuePairAmount>(first, last, false);
+        if (size > MaxKeyValuePairAmount) {
+            Logger::printfln(TOO_MANY_JSON_FIELDS, size, "MaxKeyValuePairAmount", MaxKeyValuePairAmount);
+            return false;
+        }
+        StaticJsonDocument<JSON_ARRAY_SIZE(MaxKeyValuePairAmount) + (MaxKeyValuePairAmount * (JSON_OBJECT_SIZE(2) + JSON_OBJECT_SIZE(1)))> json_buffer;
 #endif // THINGSBOARD_ENABLE_DYNAMIC
+        JsonArray instants = json_buffer.template to<JsonArray>();
+        for (auto it = first; it != last; ++it) {
+            // Copied, so the per-key configured serialization precision can be applied without altering the record of the caller
+            Telemetry data = *it;
+            Apply_Telemetry_Precision(data);
+            JsonObject values;
+            // Reuse the instant object of a previously serialized record with the same timestamp,
+            // so records that were sampled at the same instant share one single "ts" and "values" object
+            for (JsonObject instant : instants) {
+                if (instant[TIMESTAMP_KEY] == data.GetTimestamp()) {
+                    values = instant[VALUES_KEY];
+                    break;
+                }
+            }
+            if (values.isNull()) {
+                JsonObject instant = instants.createNestedObject();
+                instant[TIMESTAMP_KEY] = data.GetTimestamp();
+                values = instant.createNestedObject(VALUES_KEY);
+            }
+            if (!data.SerializeKeyValue(values)) {
+                Logger::printfln(UNABLE_TO_SERIALIZE);
+                return false;
+            }
+        }
+        return sendTelemetryJson(json_buffer, Helper::Measure_Json(json_buffer));
     }
 
-    /// @brief Attempts to send custom json attribute string.
-    /// See https://thingsboard.io/docs/user-guide/attributes/ for more information
+    /// @brief Attempts to send custom json telemetry string.
+    /// See https://thingsboard.io/docs/user-guide/telemetry/ for more information
     /// @param json String containing our json key value pairs we want to attempt to send
     /// @return Whether sending the data was successful or not
-    bool sendAttributeString(char const * json) {
-        return Send_Json_String(ATTRIBUTE_TOPIC, json);
+    bool sendTelemetryString(char const * json) {
+        if (!m_client.connected() && storeEnabled() && json != nullptr) {
+            storeTelemetryRecord(reinterpret_cast<uint8_t const *>(json), strlen(json));
+            return true;
+        }
+        return Send_Json_String(TELEMETRY_TOPIC, json);
     }
 
-    /// @brief Attempts to send attribute key value pairs from custom source to the server.
-    /// See https://thingsboard.io/docs/user-guide/attributes/ for more information
-    /// @param source JsonDocument containing our json key value pairs we want to send,
-    /// is checked before usage for any possible occuring internal errors. See https://arduinojson.org/v6/api/jsondocument/ for more information
-    /// @param json_size Size of the data inside the source
-    /// @return Whether sending the data was successful or not
-    bool sendAttributeJson(JsonDocument const & source, size_t const & json_size) {
-        return Send_Json(ATTRIBUTE_TOPIC, source, json_size);
+    //----------------------------------------------------------------------------
+    // Telemetry batching API
+
+    /// @brief Enables coalescing of single telemetry data points queued with queueTelemetryData() into one combined MQTT publish message.
+    /// Hugely reduces the amount of sent messages and therefore the topic, MQTT header and json envelope overhead,
+    /// if a lot of data points are sent in a short amount of time, at the cost of the data arriving on the cloud slightly delayed.
+    /// The queue is flushed automatically once the estimated payload size exceeds the given byte threshold or once the given interval has passed, whichever happens first
+    /// @param flush_threshold_bytes Estimated serialized payload size in bytes at which the queue is flushed immediately,
+    /// pass 0 if the queue should only ever be flushed because of the passed interval, default = DEFAULT_FLUSH_THRESHOLD_BYTES (0)
+    /// @param flush_interval_ms Amount of milliseconds after which the queued telemetry is flushed, even if the byte threshold has not been reached yet,
+    /// pass 0 if the queue should only ever be flushed because of the byte threshold or manual calls to flushTelemetry(), default = DEFAULT_FLUSH_INTERVAL_MS (1000)
+    void enableTelemetryBatching(uint16_t flush_threshold_bytes = DEFAULT_FLUSH_THRESHOLD_BYTES, uint64_t const & flush_interval_ms = DEFAULT_FLUSH_INTERVAL_MS) {
+        m_flush_threshold = flush_threshold_bytes;
+        m_flush_interval = flush_interval_ms;
+        m_batching_enabled = true;
+#if THINGSBOARD_ENABLE_STL
+        m_telemetry_flush_timer.Set_Callback(std::bind(&ThingsBoardSized::onTelemetryFlushTimeout, this));
+#else
+        m_telemetry_flush_timer.Set_Callback(ThingsBoardSized::staticTelemetryFlushTimeout);
+#endif // THINGSBOARD_ENABLE_STL
+        if (m_flush_interval != 0U) {
+            m_telemetry_flush_timer.once(m_flush_interval * 1000U);
+        }
     }
 
-  private:
-#if THINGSBOARD_ENABLE_STREAM_UTILS
-    /// @brief Serialize the custom attribute source into the underlying client.
-    /// Sends the given bytes to the client without requiring any temporary buffer at the cost of hugely increased send times
-    /// @param topic Topic we want to send the data over
-    /// @param source JsonDocument containing our json key value pairs we want to send,
-    /// is checked before usage for any possible occuring internal errors. See https://arduinojson.org/v6/api/jsondocument/ for more information
-    /// @param json_size Size of the data inside the source
-    /// @return Whether sending the data was successful or not
-    bool Serialize_Json(char const * topic, JsonDocument const & source, size_t const & json_size) {
-        if (!m_client.begin_publish(topic, json_size)) {
-            Logger::printfln(UNABLE_TO_SERIALIZE_JSON);
-            return false;
+    /// @brief Disables the previously with enableTelemetryBatching() enabled coalescing of telemetry data points,
+    /// any still queued telemetry is flushed beforehand so no queued data points are lost
+    void disableTelemetryBatching() {
+        m_batching_enabled = false;
+        m_telemetry_flush_timer.detach();
+        (void)flushTelemetry();
+    }
+
+    /// @brief Queues telemetry data with the given key and value of the given type, to be sent as one combined message with other queued data points.
+    /// Expects enableTelemetryBatching() to have been called beforehand, if it was not the data is simply sent immediately with sendTelemetryData() instead.
+    /// Be aware that queueing the same key twice before a flush occured, results in the previously queued value being overwritten on the cloud side,
+    /// because both values are serialized into the same json object. If multiple values of the same key should arrive ensure to call flushTelemetry() in between
+    /// @tparam T Type of the passed value
+    /// @param key Key of the key value pair we want to queue, requires to stay allocated until the queue has been flushed
+    /// @param value Value of the key value pair we want to queue
+    /// @return Whether queueing (or if a flush was caused, sending) the data was successful or not
+    template<typename T>
+    bool queueTelemetryData(char const * key, T const & value) {
+        if (!m_batching_enabled) {
+            return sendTelemetryData(key, value);
         }
-        BufferingPrint buffered_print(m_client, getBufferingSize());
-        size_t const bytes_serialized = serializeJson(source, buffered_print);
-        if (bytes_serialized < json_size) {
-            Logger::printfln(UNABLE_TO_SERIALIZE_JSON);
+        Telemetry const t(key, value);
+        if (t.IsEmpty()) {
             return false;
         }
-        buffered_print.flush();
-        return m_client.end_publish();
+#if !THINGSBOARD_ENABLE_DYNAMIC
+        // Queue is full, flush the already queued data points to make space for the new one instead of discarding it
+        if (m_telemetry_queue.size() + 1 > m_telemetry_queue.capacity()) {
+            (void)flushTelemetry();
+        }
+#endif // !THINGSBOARD_ENABLE_DYNAMIC
+        m_telemetry_queue.push_back(t);
+        // Serialized size is only estimated conservatively instead of actually serializing the queued data points on every insert,
+        // because serializing would cost the CPU time we are trying to save by batching in the first place
+        m_queued_payload_estimate += strlen(key) + MAX_SERIALIZED_VALUE_SIZE;
+        if (m_flush_threshold != 0U && m_queued_payload_estimate >= m_flush_threshold) {
+            return flushTelemetry();
+        }
+        return true;
     }
-#endif // THINGSBOARD_ENABLE_STREAM_UTILS
 
-    /// @brief Returns the maximum amount of bytes that we want to allocate on the stack, before the memory is allocated on the heap instead
-    /// @return Maximum amount of bytes we want to allocate on the stack
-    size_t const & getMaximumStackSize() const {
-        return m_max_stack;
+    /// @brief Immediately sends all currently queued telemetry data points as one combined MQTT publish message and clears the queue.
+    /// Is called automatically once the configured byte threshold or flush interval of enableTelemetryBatching() has been exceeded
+    /// @return Whether sending the queued telemetry data was successful or not, if the queue was empty there is nothing to do and we return true
+    bool flushTelemetry() {
+        if (m_telemetry_queue.empty()) {
+            return true;
+        }
+#if THINGSBOARD_ENABLE_DYNAMIC
+        bool const result = sendTelemetry(m_telemetry_queue.begin(), m_telemetry_queue.end());
+#else
+        bool const result = sendTelemetry<MaxQueuedTelemetryAmount>(m_telemetry_queue.begin(), m_telemetry_queue.end());
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+        m_telemetry_queue.clear();
+        m_queued_payload_estimate = 0U;
+        return result;
     }
 
-    /// @brief Returns the current receive buffer size of the underlying client interface
-    /// @return Current internal send buffer size
-    uint16_t getClientReceiveBufferSize() {
-        return m_client.get_receive_buffer_size();
+    //----------------------------------------------------------------------------
+    // Telemetry suppression API
+
+    /// @brief Configures a per-key suppression rule that drops telemetry data points whose value has not meaningfully changed, before they are ever serialized.
+    /// Hugely reduces the amount of published messages for keys that are sampled often but change rarely, without requiring any changes to the application code,
+    /// because suppressed data points only cost a compare against the last published value and are reported as successfully sent.
+    /// Applies to sendTelemetryData() and sendTelemetry() (and therefore also to flushed batched telemetry), only numeric values are compared,
+    /// string values for a configured key always pass the suppression stage. Calling this method again with the same key overwrites the previously configured rule
+    /// @param key Key of the telemetry data points the rule should apply to, requires to stay allocated for as long as the rule is configured
+    /// @param absolute_delta Minimum absolute difference to the last published value a data point requires to be published,
+    /// pass 0.0 if the rule should not contain an absolute deadband
+    /// @param relative_delta Minimum difference to the last published value relative to its magnitude (0.1 meaning 10 percent) a data point requires to be published,
+    /// pass 0.0 if the rule should not contain a relative deadband, default = 0.0
+    /// @param minimum_interval_ms Minimum amount of milliseconds that has to pass between two published data points of the given key,
+    /// data points arriving earlier are suppressed even if they exceed the configured deltas, pass 0 if the rule should not contain a rate limit, default = 0
+    /// @return Whether configuring the rule was successful or not
+    bool setTelemetryDeadband(char const * key, double const & absolute_delta, double const & relative_delta = 0.0, uint64_t const & minimum_interval_ms = 0U) {
+        if (Helper::stringIsNullorEmpty(key)) {
+            return false;
+        }
+        Deadband_Rule * const existing_rule = Find_Deadband_Rule(key);
+        if (existing_rule != nullptr) {
+            existing_rule->absolute_delta = absolute_delta;
+            existing_rule->relative_delta = relative_delta;
+            existing_rule->minimum_interval_ms = minimum_interval_ms;
+            return true;
+        }
+#if !THINGSBOARD_ENABLE_DYNAMIC
+        if (m_deadband_rules.size() + 1 > m_deadband_rules.capacity()) {
+            Logger::printfln(DEADBAND_RULES_EXCEEDED, m_deadband_rules.capacity());
+            return false;
+        }
+#endif // !THINGSBOARD_ENABLE_DYNAMIC
+        Deadband_Rule const rule = {key, absolute_delta, relative_delta, minimum_interval_ms, TELEMETRY_PRECISION_NONE, 0.0, 0U, false};
+        m_deadband_rules.push_back(rule);
+        return true;
     }
 
-    /// @brief Returns the current send buffer size of the underlying client interface
-    /// @return Current internal receive buffer size
-    uint16_t getClientSendBufferSize() {
-        return m_client.get_send_buffer_size();
+    /// @brief Removes the previously with setTelemetryDeadband() configured suppression rule for the given key,
+    /// data points of the given key are published unconditionally again afterwards.
+    /// A serialization precision configured with setTelemetryPrecision() for the same key stays untouched
+    /// @param key Key the rule was previously configured for
+    /// @return Whether a rule for the given key existed and has been removed or not
+    bool clearTelemetryDeadband(char const * key) {
+        if (Helper::stringIsNullorEmpty(key)) {
+            return false;
+        }
+        for (auto it = m_deadband_rules.begin(); it != m_deadband_rules.end(); ++it) {
+            if (strcmp(it->key, key) == 0) {
+                // Rules that also hold a configured serialization precision only have their thresholds cleared,
+                // because the precision is configured independently and should survive removing the deadband
+                if (it->precision != TELEMETRY_PRECISION_NONE) {
+                    it->absolute_delta = 0.0;
+                    it->relative_delta = 0.0;
+                    it->minimum_interval_ms = 0U;
+                    return true;
+                }
+                Helper::remove(m_deadband_rules, it);
+                return true;
+            }
+        }
+        return false;
     }
 
-    /// @brief Subscribes the given topic with the underlying client interface
-    /// @param topic Topic that should be subscribed
-    /// @return Whether subscribing was successfull or not
-    bool clientSubscribe(char const * topic) {
-        return m_client.subscribe(topic);
+    /// @brief Removes all previously with setTelemetryDeadband() configured suppression rules
+    /// and all previously with setTelemetryPrecision() configured serialization precisions
+    void clearTelemetryDeadbands() {
+        m_deadband_rules.clear();
     }
 
-    /// @brief Unsubscribes the given topic with the underlying client interface
-    /// @param topic Topic that should be unsubscribed
-    /// @return Whether unsubscribing was successfull or not
-    bool clientUnsubscribe(char const * topic) {
-        return m_client.unsubscribe(topic);
+    /// @brief Configures the amount of decimal places floating point telemetry data points of the given key are rounded to before they are serialized.
+    /// Sensor readings often carry all real information in a few decimal places, but are serialized with the maximum amount of significant digits by default,
+    /// inflating every payload and making the float to string conversion one of the most expensive parts of serializing a message.
+    /// Applies to sendTelemetryData(), sendTelemetry() and sendTimeseries() (and therefore also to flushed batched and aggregated telemetry),
+    /// a precision set directly on a record with the SetPrecision() method of the Telemetry class takes priority over the per-key configuration.
+    /// Shares the rule storage with setTelemetryDeadband(), both can be configured for the same key independently,
+    /// the suppression stage always compares the raw unrounded values. A rule containing only a precision never suppresses any data point
+    /// @param key Key of the telemetry data points the precision should apply to, requires to stay allocated for as long as the precision is configured
+    /// @param decimals Amount of decimal places the values are rounded to before serializing, clamped internally to a maximum of 9
+    /// @return Whether configuring the precision was successful or not
+    bool setTelemetryPrecision(char const * key, uint8_t decimals) {
+        if (Helper::stringIsNullorEmpty(key)) {
+            return false;
+        }
+        Deadband_Rule * const existing_rule = Find_Deadband_Rule(key);
+        if (existing_rule != nullptr) {
+            existing_rule->precision = decimals;
+            return true;
+        }
+#if !THINGSBOARD_ENABLE_DYNAMIC
+        if (m_deadband_rules.size() + 1 > m_deadband_rules.capacity()) {
+            Logger::printfln(DEADBAND_RULES_EXCEEDED, m_deadband_rules.capacity());
+            return false;
+        }
+#endif // !THINGSBOARD_ENABLE_DYNAMIC
+        Deadband_Rule const rule = {key, 0.0, 0.0, 0U, decimals, 0.0, 0U, false};
+        m_deadband_rules.push_back(rule);
+        return true;
     }
 
-    /// @brief Gets a mutable pointer to the request id, the current value is the id of the last sent request.
-    /// Is used because each request to the cloud of the same type (attribute request, rpc request, over the air firmware update), has to use a different id to differentiate request and response.
-    /// To ensure that we therefore simply provide a global request id that can be used and incremented by all request types
-    /// @return Mutable reference to the request id
+    /// @brief Removes the previously with setTelemetryPrecision() configured serialization precision for the given key,
+    /// floating point data points of the given key are serialized with the default formatting again afterwards.
+    /// A suppression rule configured with setTelemetryDeadband() for the same key stays untouched
+    /// @param key Key the precision was previously configured for
+    /// @return Whether a precision for the given key existed and has been removed or not
+    bool clearTelemetryPrecision(char const * key) {
+        Deadband_Rule * const rule = Find_Deadband_Rule(key);
+        if (rule == nullptr || rule->precision == TELEMETRY_PRECISION_NONE) {
+            return false;
+        }
+        rule->precision = TELEMETRY_PRECISION_NONE;
+        // Rules that hold neither a deadband nor a rate limit anymore are removed completely to free their slot
+        if (rule->absolute_delta == 0.0 && rule->relative_delta == 0.0 && rule->minimum_interval_ms == 0U) {
+            (void)clearTelemetryDeadband(key);
+        }
+        return true;
+    }
+
+    //----------------------------------------------------------------------------
+    // Telemetry aggregation API
+
+    /// @brief Enables on-device downsampling of high-rate samples recorded with recordTelemetryData() into per-key aggregates.
+    /// The accumulators are flushed into one combined publish message once the given interval has passed,
+    /// meaning a key that is sampled at a high rate only ever costs a few accumulator instructions per sample
+    /// and no json serialization or publish happens until the flush. Which keys are aggregated
+    /// and as which aggregate they are published has to be configured with setTelemetryAggregation() beforehand
+    /// @param flush_interval_ms Amount of milliseconds after which the accumulated aggregates are published and the accumulators are reset, default = DEFAULT_AGGREGATION_INTERVAL_MS (1000)
+    void enableTelemetryAggregation(uint64_t const & flush_interval_ms = DEFAULT_AGGREGATION_INTERVAL_MS) {
+        m_aggregation_interval = flush_interval_ms;
+        m_aggregation_enabled = true;
+#if THINGSBOARD_ENABLE_STL
+        m_aggregation_flush_timer.Set_Callback(std::bind(&ThingsBoardSized::onAggregationFlushTimeout, this));
+#else
+        m_aggregation_flush_timer.Set_Callback(ThingsBoardSized::staticAggregationFlushTimeout);
+#endif // THINGSBOARD_ENABLE_STL
+        if (m_aggregation_interval != 0U) {
+            m_aggregation_flush_timer.once(m_aggregation_interval * 1000U);
+        }
+    }
+
+    /// @brief Disables the previously with enableTelemetryAggregation() enabled downsampling,
+    /// any not yet flushed aggregates are published beforehand so no recorded samples are lost
+    void disableTelemetryAggregation() {
+        m_aggregation_enabled = false;
+        m_aggregation_flush_timer.detach();
+        (void)flushAggregatedTelemetry();
+    }
+
+    /// @brief Configures which aggregate the samples recorded for the given key with recordTelemetryData() are published as.
+    /// Has to be called once per key before any samples for it can be recorded, because preregistering the keys
+    /// keeps the hot recording path free of any allocations. Calling this method again with the same key changes the published aggregate
+    /// and resets the accumulated statistics of the current flush interval
+    /// @param key Key the recorded samples are accumulated under and published with, requires to stay allocated for as long as the key is configured
+    /// @param aggregation Aggregate the accumulated samples are published as on flush
+    /// @return Whether configuring the aggregation was successful or not
+    bool setTelemetryAggregation(char const * key, Aggregation_Type aggregation) {
+        if (Helper::stringIsNullorEmpty(key)) {
+            return false;
+        }
+        Aggregation_Accumulator * const existing_accumulator = Find_Aggregation_Accumulator(key);
+        if (existing_accumulator != nullptr) {
+            existing_accumulator->aggregation = aggregation;
+            existing_accumulator->count = 0U;
+            return true;
+        }
+#if !THINGSBOARD_ENABLE_DYNAMIC
+        if (m_aggregation_accumulators.size() + 1 > m_aggregation_accumulators.capacity()) {
+            Logger::printfln(AGGREGATED_KEYS_EXCEEDED, m_aggregation_accumulators.capacity());
+            return false;
+        }
+#endif // !THINGSBOARD_ENABLE_DYNAMIC
+        Aggregation_Accumulator const accumulator = {key, aggregation, 0.0, 0.0, 0.0, 0.0, 0U};
+        m_aggregation_accumulators.push_back(accumulator);
+        return true;
+    }
+
+    /// @brief Records one sample for the given previously with setTelemetryAggregation() configured key.
+    /// Only updates the in-memory accumulator of the key, no json serialization or publish happens until the accumulators are flushed,
+    /// making this method cheap enough to be called directly from high-rate sampling loops
+    /// @param key Key the sample should be accumulated under, has to have been configured with setTelemetryAggregation() beforehand
+    /// @param value Sampled value that should be accumulated
+    /// @return Whether the sample was recorded or no accumulator for the given key exists
+    bool recordTelemetryData(char const * key, double const & value) {
+        Aggregation_Accumulator * const accumulator = Find_Aggregation_Accumulator(key);
+        if (accumulator == nullptr) {
+            return false;
+        }
+        if (accumulator->count == 0U) {
+            accumulator->minimum = value;
+            accumulator->maximum = value;
+            accumulator->sum = 0.0;
+        }
+        else if (value < accumulator->minimum) {
+            accumulator->minimum = value;
+        }
+        else if (value > accumulator->maximum) {
+            accumulator->maximum = value;
+        }
+        accumulator->sum += value;
+        accumulator->last = value;
+        accumulator->count++;
+        return true;
+    }
+
+    /// @brief Immediately publishes the configured aggregate of every key that recorded at least one sample
+    /// as one combined publish message and resets the accumulators for the next flush interval.
+    /// Is called automatically once the flush interval of enableTelemetryAggregation() has passed
+    /// @return Whether sending the aggregated telemetry was successful or not, if no samples were recorded there is nothing to do and we return true
+    bool flushAggregatedTelemetry() {
+#if THINGSBOARD_ENABLE_DYNAMIC
+        Vector<Telemetry> aggregates = {};
+#else
+        Array<Telemetry, MaxAggregatedKeysAmount> aggregates = {};
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+        for (auto & accumulator : m_aggregation_accumulators) {
+            // Keys that did not record any samples in the flush interval are simply skipped instead of publishing stale values
+            if (accumulator.count == 0U) {
+                continue;
+            }
+            aggregates.push_back(Telemetry(accumulator.key, Calculate_Aggregate(accumulator)));
+            accumulator.count = 0U;
+        }
+        if (aggregates.empty()) {
+            return true;
+        }
+#if THINGSBOARD_ENABLE_DYNAMIC
+        return sendTelemetry(aggregates.begin(), aggregates.end());
+#else
+        return sendTelemetry<MaxAggregatedKeysAmount>(aggregates.begin(), aggregates.end());
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    }
+
+    //----------------------------------------------------------------------------
+    // Worker task API
+
+#if THINGSBOARD_ENABLE_WORKER_TASK
+    /// @brief Starts the optional worker task publish mode, which creates a dedicated FreeRTOS task that serializes and publishes telemetry records,
+    /// that any other task can hand over through the lock-free ring with enqueueTelemetryData(), without blocking on the network or requiring a mutex.
+    /// On multi-core targets the task can be pinned to a specific core, keeping serialization and publishing entirely off the sampling core.
+    /// Threading contract: once the worker task has been started, telemetry has to be published exclusively through enqueueTelemetryData() or enqueueTelemetry(),
+    /// every other method of this class (subscriptions, requests, loop()) remains owned by the single task that used the instance before,
+    /// and server-side callbacks keep being dispatched from the task that drives the underlying MQTT client
+    /// (the internal MQTT event task for the Espressif_MQTT_Client or the task that calls loop() for clients that require polling)
+    /// @param ring_size Amount of telemetry records the lock-free ring can hold before enqueueing fails, has to be a power of two because ring positions are mapped to slots with a bitwise and, default = DEFAULT_WORKER_RING_SIZE (64)
+    /// @param priority Task priority with which the worker task should run, higher priority means it takes more precedence over other tasks, default = DEFAULT_WORKER_TASK_PRIORITY (5)
+    /// @param stack_size Task stack size in bytes the worker task can use before the device crashes with a StackOverflow, default = DEFAULT_WORKER_TASK_STACK_SIZE (4096)
+    /// @param core Core the worker task is pinned to, simply pass tskNO_AFFINITY if the scheduler should pick the core itself instead, default = tskNO_AFFINITY
+    /// @return Whether starting the worker task was successful or not, if it is already running there is nothing to do and we return true
+    bool startWorkerTask(size_t const & ring_size = DEFAULT_WORKER_RING_SIZE, uint8_t priority = DEFAULT_WORKER_TASK_PRIORITY, uint16_t stack_size = DEFAULT_WORKER_TASK_STACK_SIZE, BaseType_t core = tskNO_AFFINITY) {
+        if (m_worker_task != nullptr) {
+            return true;
+        }
+        if (ring_size < 2U || (ring_size & (ring_size - 1U)) != 0U) {
+            Logger::printfln(WORKER_RING_SIZE_INVALID, ring_size);
+            return false;
+        }
+        m_worker_ring = new Worker_Ring_Slot[ring_size];
+        Memory_Metrics::record_allocation(Memory_Subsystem::WORKER_RING, ring_size * sizeof(Worker_Ring_Slot));
+        m_worker_ring_mask = ring_size - 1U;
+        // Every slot initially carries its own position as the sequence, marking it as free for the producer that claims that position first
+        for (size_t slot = 0U; slot < ring_size; slot++) {
+            __atomic_store_n(&m_worker_ring[slot].sequence, slot, __ATOMIC_RELAXED);
+        }
+        m_worker_enqueue_position = 0U;
+        m_worker_dequeue_position = 0U;
+        m_worker_stop_requested = false;
+        m_worker_task_running = true;
+        if (xTaskCreatePinnedToCore(&ThingsBoardSized::Static_Worker_Task, "tb_worker", stack_size, this, priority, &m_worker_task, core) != pdPASS) {
+            m_worker_task_running = false;
+            Memory_Metrics::record_deallocation(Memory_Subsystem::WORKER_RING, ring_size * sizeof(Worker_Ring_Slot));
+            delete[] m_worker_ring;
+            m_worker_ring = nullptr;
+            Logger::printfln(WORKER_TASK_CREATE_FAILED);
+            return false;
+        }
+        return true;
+    }
+
+    /// @brief Stops the previously with startWorkerTask() started worker task, all already enqueued telemetry records are drained and published beforehand so none are lost.
+    /// Blocks until the worker task has finished its current publish and deleted itself, has to be called once no producer task enqueues records anymore,
+    /// because enqueueing while the ring is being torn down is not safe
+    void stopWorkerTask() {
+        if (m_worker_task == nullptr) {
+            return;
+        }
+        __atomic_store_n(&m_worker_stop_requested, true, __ATOMIC_RELEASE);
+        while (__atomic_load_n(&m_worker_task_running, __ATOMIC_ACQUIRE)) {
+            vTaskDelay(1U);
+        }
+        m_worker_task = nullptr;
+        Memory_Metrics::record_deallocation(Memory_Subsystem::WORKER_RING, (m_worker_ring_mask + 1U) * sizeof(Worker_Ring_Slot));
+        delete[] m_worker_ring;
+        m_worker_ring = nullptr;
+    }
+
+    /// @brief Enqueues a single telemetry key value pair for the worker task to serialize and publish, safe to call from multiple producer tasks simultaneously.
+    /// Only claims a ring slot and copies the record into it, meaning the call never blocks on the network and is cheap enough for high priority tasks.
+    /// The configured suppression rules and the store-and-forward mechanism still apply, because the worker task publishes through the normal telemetry path
+    /// @tparam T Type of the passed value, is required to be serializable into a json value by ArduinoJson
+    /// @param key Key of the key value pair we want to publish, requires to stay allocated until the worker task has published the record
+    /// @param value Value of the key value pair we want to publish, string values equally require to stay allocated until the worker task has published the record
+    /// @return Whether enqueueing the record was successful or whether the worker task is not running or the ring is currently full
+    template<typename T>
+    bool enqueueTelemetryData(char const * key, T const & value) {
+        return enqueueTelemetry(Telemetry(key, value));
+    }
+
+    /// @brief Enqueues a single telemetry record for the worker task to serialize and publish, safe to call from multiple producer tasks simultaneously.
+    /// Producers claim their ring slot with an atomic compare and swap on the enqueue position and publish the copied record by bumping the slot sequence,
+    /// meaning no lock is ever taken and a preempted producer can not block the others or the worker task
+    /// @param record Telemetry record we want to publish, contained strings require to stay allocated until the worker task has published the record
+    /// @return Whether enqueueing the record was successful or whether the worker task is not running or the ring is currently full
+    bool enqueueTelemetry(Telemetry const & record) {
+        if (m_worker_ring == nullptr) {
+            return false;
+        }
+        size_t position = __atomic_load_n(&m_worker_enqueue_position, __ATOMIC_RELAXED);
+        while (true) {
+            Worker_Ring_Slot & slot = m_worker_ring[position & m_worker_ring_mask];
+            size_t const sequence = __atomic_load_n(&slot.sequence, __ATOMIC_ACQUIRE);
+            intptr_t const difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0) {
+                // The slot at our position is free, attempt to claim it before any other producer does
+                if (__atomic_compare_exchange_n(&m_worker_enqueue_position, &position, position + 1U, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                    slot.record = record;
+                    __atomic_store_n(&slot.sequence, position + 1U, __ATOMIC_RELEASE);
+                    return true;
+                }
+                // Another producer claimed the position first, the compare and swap updated our position to the current one and we simply retry
+            }
+            else if (difference < 0) {
+                // The slot still holds a record the worker task has not dequeued yet, meaning the ring is currently full
+                return false;
+            }
+            else {
+                position = __atomic_load_n(&m_worker_enqueue_position, __ATOMIC_RELAXED);
+            }
+        }
+    }
+#endif // THINGSBOARD_ENABLE_WORKER_TASK
+
+    /// @brief Attempts to send telemetry key value pairs from custom source to the server.
+    /// If the connection to the cloud is currently lost and store-and-forward has been enabled with enableStoreAndForward(),
+    /// the serialized data is stored instead of being discarded and forwarded once the connection has been established again.
+    /// See https://thingsboard.io/docs/user-guide/telemetry/ for more information
+    /// @param source JsonDocument containing our json key value pairs we want to send,
+    /// is checked before usage for any possible occuring internal errors. See https://arduinojson.org/v6/api/jsondocument/ for more information
+    /// @param json_size Size of the data inside the source
+    /// @return Whether sending (or if the connection is lost, storing) the data was successful or not
+    bool sendTelemetryJson(JsonDocument const & source, size_t const & json_size) {
+        if (!m_client.connected() && storeEnabled()) {
+            return storeTelemetryJson(source, json_size);
+        }
+        return Send_Json(TELEMETRY_TOPIC, source, json_size);
+    }
+
+    //----------------------------------------------------------------------------
+    // Store-and-forward API
+
+    /// @brief Enables storing of serialized telemetry records while the connection to the cloud is lost, instead of discarding the data points.
+    /// Records are stored with a small length prefix into the given RAM ring buffer, once the buffer is full the oldest records are either dropped
+    /// or handed to the optionally given backing store, which can persist them on flash, NVS or an SD card instead.
+    /// Once the connection has been established again the stored records are drained automatically, joined into large combined array publishes,
+    /// meaning catch-up after an outage requires only a fraction of the publish messages the stored data points would have needed originally.
+    /// Be aware the cloud attaches the server time on arrival, meaning drained records receive the reconnect time as their timestamp,
+    /// if the actual sample time is relevant ensure to use timestamped records and sendTimeseries() so the sample instant is part of the stored payload
+    /// @param buffer RAM buffer the serialized telemetry records are stored into, requires to stay allocated for as long as store-and-forward is enabled
+    /// @param buffer_size Size of the given RAM buffer in bytes
+    /// @param backing_store Optional store implementation that oldest records are handed to once the RAM buffer is full,
+    /// pass nullptr if overflowing records should simply be dropped instead, default = nullptr
+    void enableStoreAndForward(uint8_t * buffer, size_t const & buffer_size, ITelemetry_Store * backing_store = nullptr) {
+        m_store_buffer = buffer;
+        m_store_capacity = buffer_size;
+        m_store_head = 0U;
+        m_store_tail = 0U;
+        m_store_used = 0U;
+        m_store_count = 0U;
+        m_backing_store = backing_store;
+    }
+
+    /// @brief Disables the previously with enableStoreAndForward() enabled storing of telemetry records while the connection is lost.
+    /// Any still stored records are discarded, if they should arrive on the cloud instead ensure to call drainStoredTelemetry() beforehand
+    void disableStoreAndForward() {
+        m_store_buffer = nullptr;
+        m_store_capacity = 0U;
+        m_store_used = 0U;
+        m_store_count = 0U;
+        m_backing_store = nullptr;
+    }
+
+    /// @brief Gets the amount of currently stored telemetry records, including records that overflowed into the optional backing store
+    /// @return Amount of stored telemetry records that have not been forwarded to the cloud yet
+    size_t storedTelemetryAmount() const {
+        return m_store_count + ((m_backing_store != nullptr) ? m_backing_store->amount() : 0U);
+    }
+
+    /// @brief Immediately forwards all currently stored telemetry records to the cloud, joining as many records as fit into the send buffer
+    /// into one combined array publish each. Is called automatically once the connection to the cloud has been established again
+    /// @return Whether forwarding all stored telemetry records was successful or not, if no record was stored there is nothing to do and we return true
+    bool drainStoredTelemetry() {
+        if (!m_client.connected()) {
+            return false;
+        }
+        uint16_t const send_buffer_size = m_client.get_send_buffer_size();
+        char * batch = getScratchBuffer(send_buffer_size);
+        bool result = true;
+        while (result && (m_store_used != 0U || ((m_backing_store != nullptr) && m_backing_store->amount() != 0U))) {
+            // Pauses the drain once the configured window of unconfirmed published messages is exhausted,
+            // the remaining records simply stay stored and the drain is continued from loop() once previously sent messages have been confirmed
+            if (m_publish_quality_of_service != 0U && __atomic_load_n(&m_in_flight_count, __ATOMIC_ACQUIRE) >= m_in_flight_window) {
+                break;
+            }
+#if THINGSBOARD_ENABLE_MSGPACK
+            // MessagePack records are binary and can not be joined into a json array, therefore they are published one at a time instead
+            uint16_t const length = nextStoredRecordLength();
+            if (length > send_buffer_size) {
+                Logger::printfln(INVALID_BUFFER_SIZE, send_buffer_size, length);
+                (void)consumeNextStoredRecord(nullptr);
+                continue;
+            }
+            uint16_t const consumed = consumeNextStoredRecord(reinterpret_cast<uint8_t *>(batch));
+            result = (consumed != 0U) && Publish_Payload(TELEMETRY_TOPIC, reinterpret_cast<uint8_t const *>(batch), consumed);
+#else
+            size_t batch_size = 0U;
+            batch[batch_size++] = '[';
+            while (true) {
+                uint16_t const length = nextStoredRecordLength();
+                // Additionally reserve space for the separating comma and the closing bracket of the array
+                if (length == 0U || (batch_size + length + 2U) > send_buffer_size) {
+                    break;
+                }
+                if (batch_size > 1U) {
+                    batch[batch_size++] = ',';
+                }
+                if (consumeNextStoredRecord(reinterpret_cast<uint8_t *>(batch) + batch_size) == 0U) {
+                    break;
+                }
+                batch_size += length;
+            }
+            if (batch_size == 1U) {
+                // The oldest record does not even fit into the send buffer on its own and can therefore never be sent, drop it so the drain does not loop forever
+                Logger::printfln(INVALID_BUFFER_SIZE, send_buffer_size, nextStoredRecordLength());
+                (void)consumeNextStoredRecord(nullptr);
+                continue;
+            }
+            batch[batch_size++] = ']';
+            result = Publish_Payload(TELEMETRY_TOPIC, reinterpret_cast<uint8_t const *>(batch), batch_size);
+#endif // THINGSBOARD_ENABLE_MSGPACK
+        }
+        return result;
+    }
+
+    //----------------------------------------------------------------------------
+    // Attribute API
+
+    /// @brief Attempts to send attribute data with the given key and value of the given type.
+    /// See https://thingsboard.io/docs/user-guide/attributes/ for more information
+    /// @tparam T Type of the passed value
+    /// @param key Key of the key value pair we want to send
+    /// @param value Value of the key value pair we want to send
+    /// @return Whether sending the data was successful or not
+    template<typename T>
+    bool sendAttributeData(char const * key, T const & value) {
+        return sendKeyValue(key, value, false);
+    }
+
+    /// @brief Attempts to send aggregated attribute data, expects iterators to a container containing Attribute class instances.
+    /// See https://thingsboard.io/docs/user-guide/attributes/ for more information
+    /// @tparam InputIterator Class that points to the begin and end iterator
+    /// of the given data container, allows for using / passing either std::vector or std::array.
+    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
+    /// @param first Iterator pointing to the first element in the data container
+    /// @param last Iterator pointing to the end of the data container (last element + 1)
+    /// @return Whether sending the aggregated attribute data was successful or not
+#if THINGSBOARD_ENABLE_DYNAMIC
+    template<typename InputIterator>
+#else
+    /// @tparam MaxKeyValuePairAmount Maximum amount of json key value pairs, which will ever be sent with this method to the cloud.
+    /// Should simply be the biggest distance between first and last iterator this method is ever called with
+    template<size_t MaxKeyValuePairAmount, typename InputIterator>
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    bool sendAttributes(InputIterator const & first, InputIterator const & last) {
+#if THINGSBOARD_ENABLE_DYNAMIC
+        return sendDataArray(first, last, false);
+#else
+        return sendDataArray<MaxKeyValuePairAmount>(first, last, false);
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    }
+
+    /// @brief Attempts to send custom json attribute string.
+    /// See https://thingsboard.io/docs/user-guide/attributes/ for more information
+    /// @param json String containing our json key value pairs we want to attempt to send
+    /// @return Whether sending the data was successful or not
+    bool sendAttributeString(char const * json) {
+        return Send_Json_String(ATTRIBUTE_TOPIC, json);
+    }
+
+    /// @brief Attempts to send attribute key value pairs from custom source to the server.
+    /// See https://thingsboard.io/docs/user-guide/attributes/ for more information
+    /// @param source JsonDocument containing our json key value pairs we want to send,
+    /// is checked before usage for any possible occuring internal errors. See https://arduinojson.org/v6/api/jsondocument/ for more information
+    /// @param json_size Size of the data inside the source
+    /// @return Whether sending the data was successful or not
+    bool sendAttributeJson(JsonDocument const & source, size_t const & json_size) {
+        return Send_Json(ATTRIBUTE_TOPIC, source, json_size);
+    }
+
+  private:
+    /// @brief Minimal writer that forwards the output of the ArduinoJson serializer chunk by chunk directly into the underlying client.
+    /// Fulfills the custom writer requirements of ArduinoJson (https://arduinojson.org/news/2020/03/22/version-6-15-0/),
+    /// removing the dependency on the StreamUtils library for streaming oversized payloads into the client
+    class MQTT_Client_Writer {
+      public:
+        MQTT_Client_Writer(IMQTT_Client & client)
+          : m_client(client)
+        {
+            // Nothing to do
+        }
+
+        size_t write(uint8_t payload_byte) {
+            return m_client.write(payload_byte);
+        }
+
+        size_t write(uint8_t const * buffer, size_t length) {
+            return m_client.write(buffer, length);
+        }
+
+      private:
+        IMQTT_Client & m_client; // Client the serializer output is forwarded into
+    };
+
+    /// @brief Serialize the custom attribute source into the underlying client.
+    /// Streams the payload chunk by chunk straight from the serializer into the client between begin_publish() and end_publish(),
+    /// meaning no payload sized temporary buffer is required, at the cost of increased send times.
+    /// If the StreamUtils library is installed the single byte writes the serializer produces are additionally coalesced into bigger packets before they reach the client
+    /// @param topic Topic we want to send the data over
+    /// @param source JsonDocument containing our json key value pairs we want to send,
+    /// is checked before usage for any possible occuring internal errors. See https://arduinojson.org/v6/api/jsondocument/ for more information
+    /// @param json_size Size of the data inside the source
+    /// @return Whether sending the data was successful or not
+    bool Serialize_Json(char const * topic, JsonDocument const & source, size_t const & json_size) {
+        if (!m_client.begin_publish(topic, json_size)) {
+            Logger::printfln(UNABLE_TO_SERIALIZE_JSON);
+            return false;
+        }
+#if THINGSBOARD_ENABLE_STREAM_UTILS
+        BufferingPrint buffered_print(m_client, getBufferingSize());
+#if THINGSBOARD_ENABLE_MSGPACK
+        size_t const bytes_serialized = serializeMsgPack(source, buffered_print);
+#else
+        size_t const bytes_serialized = serializeJson(source, buffered_print);
+#endif // THINGSBOARD_ENABLE_MSGPACK
+        if (bytes_serialized < json_size) {
+            Logger::printfln(UNABLE_TO_SERIALIZE_JSON);
+            return false;
+        }
+        buffered_print.flush();
+#else
+        MQTT_Client_Writer writer(m_client);
+#if THINGSBOARD_ENABLE_MSGPACK
+        size_t const bytes_serialized = serializeMsgPack(source, writer);
+#else
+        size_t const bytes_serialized = serializeJson(source, writer);
+#endif // THINGSBOARD_ENABLE_MSGPACK
+        if (bytes_serialized < json_size) {
+            Logger::printfln(UNABLE_TO_SERIALIZE_JSON);
+            return false;
+        }
+#endif // THINGSBOARD_ENABLE_STREAM_UTILS
+        return m_client.end_publish();
+    }
+
+    /// @brief Returns the maximum amount of bytes that we want to allocate on the stack, before the memory is allocated on the heap instead
+    /// @return Maximum amount of bytes we want to allocate on the stack
+    size_t const & getMaximumStackSize() const {
+        return m_max_stack;
+    }
+
+    /// @brief Gets the reusable serialization scratch buffer, lazily grown to atleast the given size.
+    /// Removes the need to allocate and immediately free a fresh heap buffer on every single send, which fragments the heap at high publish rates.
+    /// Every SCRATCH_SHRINK_INTERVAL usages the buffer is shrunk back to the biggest size that was actually requested in that window,
+    /// so a single unusually big payload does not keep the buffer at its maximum size forever
+    /// @param size Minimum size in bytes the returned buffer needs to have
+    /// @return Pointer to the scratch buffer, valid until the next call to this method
+    char * getScratchBuffer(size_t const & size) {
+        if (m_scratch_capacity < size) {
+            delete[] m_scratch_buffer;
+            m_scratch_buffer = new char[size]();
+            Memory_Metrics::record_resize(Memory_Subsystem::SCRATCH_BUFFER, m_scratch_capacity, size);
+            m_scratch_capacity = size;
+        }
+        if (size > m_scratch_high_water) {
+            m_scratch_high_water = size;
+        }
+        if (++m_scratch_uses >= SCRATCH_SHRINK_INTERVAL) {
+            if (m_scratch_capacity > (2U * m_scratch_high_water)) {
+                delete[] m_scratch_buffer;
+                m_scratch_buffer = new char[m_scratch_high_water]();
+                Memory_Metrics::record_resize(Memory_Subsystem::SCRATCH_BUFFER, m_scratch_capacity, m_scratch_high_water);
+                m_scratch_capacity = m_scratch_high_water;
+            }
+            m_scratch_uses = 0U;
+            m_scratch_high_water = 0U;
+        }
+        return m_scratch_buffer;
+    }
+
+    /// @brief Returns the current receive buffer size of the underlying client interface
+    /// @return Current internal send buffer size
+    uint16_t getClientReceiveBufferSize() {
+        return m_client.get_receive_buffer_size();
+    }
+
+    /// @brief Returns the current send buffer size of the underlying client interface
+    /// @return Current internal receive buffer size
+    uint16_t getClientSendBufferSize() {
+        return m_client.get_send_buffer_size();
+    }
+
+    /// @brief Subscribes the given topic with the underlying client interface
+    /// @param topic Topic that should be subscribed
+    /// @return Whether subscribing was successfull or not
+    bool clientSubscribe(char const * topic) {
+        return m_client.subscribe(topic);
+    }
+
+    /// @brief Unsubscribes the given topic with the underlying client interface
+    /// @param topic Topic that should be unsubscribed
+    /// @return Whether unsubscribing was successfull or not
+    bool clientUnsubscribe(char const * topic) {
+        return m_client.unsubscribe(topic);
+    }
+
+    /// @brief Gets a mutable pointer to the request id, the current value is the id of the last sent request.
+    /// Is used because each request to the cloud of the same type (attribute request, rpc request, over the air firmware update), has to use a different id to differentiate request and response.
+    /// To ensure that we therefore simply provide a global request id that can be used and incremented by all request types
+    /// @return Mutable reference to the request id
     size_t * getRequestID() {
         return &m_request_id;
     }
@@ -600,6 +1628,241 @@ class ThingsBoardSized {
     }
 #endif // THINGSBOARD_ENABLE_STREAM_UTILS
 
+    /// @brief Returns whether storing of telemetry records while the connection is lost has been enabled with a usable buffer
+    /// @return Whether store-and-forward is currently enabled or not
+    bool storeEnabled() const {
+        return m_store_buffer != nullptr && m_store_capacity > sizeof(uint16_t);
+    }
+
+    /// @brief Serializes the given source and stores the resulting record, is used instead of sending if the connection to the cloud is currently lost
+    /// @param source JsonDocument containing our json key value pairs we want to store
+    /// @param json_size Size of the data inside the source
+    /// @return Whether serializing and storing the data was successful or not
+    bool storeTelemetryJson(JsonDocument const & source, size_t const & json_size) {
+        if (source.isNull()) {
+            Logger::printfln(UNABLE_TO_ALLOCATE_JSON);
+            return false;
+        }
+        if (source.overflowed()) {
+            Logger::printfln(JSON_SIZE_TO_SMALL);
+            return false;
+        }
+        char * json = getScratchBuffer(json_size);
+#if THINGSBOARD_ENABLE_MSGPACK
+        bool const result = serializeMsgPack(source, json, json_size) >= json_size;
+        uint16_t const record_length = json_size;
+#else
+        bool const result = serializeJson(source, json, json_size) >= json_size - 1;
+        // The null terminator is not stored, because the records are later joined into one combined payload anyway
+        uint16_t const record_length = json_size - 1;
+#endif // THINGSBOARD_ENABLE_MSGPACK
+        if (!result) {
+            Logger::printfln(UNABLE_TO_SERIALIZE_JSON);
+        }
+        else {
+            storeTelemetryRecord(reinterpret_cast<uint8_t const *>(json), record_length);
+        }
+        return result;
+    }
+
+    /// @brief Stores the given serialized telemetry record with a small length prefix into the RAM ring buffer,
+    /// once the buffer is full the oldest records are either handed to the optional backing store or dropped to make space
+    /// @param payload Serialized telemetry record that should be stored
+    /// @param length Length of the serialized telemetry record in bytes
+    void storeTelemetryRecord(uint8_t const * payload, uint16_t length) {
+#if !THINGSBOARD_ENABLE_MSGPACK
+        // Records that already are json arrays (multi-point time-series) are stored without their surrounding brackets,
+        // because their elements are joined into the surrounding array that is built when the stored records are drained anyway
+        if (length >= 2U && payload[0] == '[' && payload[length - 1U] == ']') {
+            payload++;
+            length -= 2U;
+        }
+#endif // !THINGSBOARD_ENABLE_MSGPACK
+        if (length == 0U) {
+            return;
+        }
+        if ((length + sizeof(uint16_t)) > m_store_capacity) {
+            // Record does not even fit into the empty ring buffer, hand it to the backing store directly if one is attached
+            if (m_backing_store == nullptr || !m_backing_store->store(payload, length)) {
+                Logger::printfln(STORED_TELEMETRY_TOO_BIG, length, m_store_capacity);
+            }
+            return;
+        }
+        while ((m_store_capacity - m_store_used) < (length + sizeof(uint16_t))) {
+            dropOldestStoredRecord();
+        }
+        uint8_t const length_prefix[sizeof(uint16_t)] = {static_cast<uint8_t>(length & 0xFFU), static_cast<uint8_t>(length >> 8U)};
+        writeStoreBytes(length_prefix, sizeof(uint16_t));
+        writeStoreBytes(payload, length);
+        m_store_count++;
+    }
+
+    /// @brief Writes the given bytes at the current write position of the RAM ring buffer, wrapping around at the end of the buffer
+    /// @param data Bytes that should be written
+    /// @param length Amount of bytes that should be written
+    void writeStoreBytes(uint8_t const * data, size_t const & length) {
+        for (size_t i = 0U; i < length; ++i) {
+            m_store_buffer[m_store_tail] = data[i];
+            m_store_tail = (m_store_tail + 1U) % m_store_capacity;
+        }
+        m_store_used += length;
+    }
+
+    /// @brief Gets the length of the oldest record in the RAM ring buffer without consuming it
+    /// @return Length of the oldest record in bytes or 0 if the ring buffer is empty
+    uint16_t peekStoredRecordLength() const {
+        if (m_store_used == 0U) {
+            return 0U;
+        }
+        uint16_t length = m_store_buffer[m_store_head];
+        length |= static_cast<uint16_t>(m_store_buffer[(m_store_head + 1U) % m_store_capacity]) << 8U;
+        return length;
+    }
+
+    /// @brief Copies the oldest record of the RAM ring buffer into the given destination and removes it from the buffer
+    /// @param destination Buffer the record should be copied into, if nullptr is passed the record is simply discarded instead
+    /// @return Length of the consumed record in bytes or 0 if the ring buffer was empty
+    uint16_t consumeStoredRecord(uint8_t * destination) {
+        uint16_t const length = peekStoredRecordLength();
+        if (length == 0U) {
+            return 0U;
+        }
+        m_store_head = (m_store_head + sizeof(uint16_t)) % m_store_capacity;
+        for (uint16_t i = 0U; i < length; ++i) {
+            if (destination != nullptr) {
+                destination[i] = m_store_buffer[m_store_head];
+            }
+            m_store_head = (m_store_head + 1U) % m_store_capacity;
+        }
+        m_store_used -= (length + sizeof(uint16_t));
+        m_store_count--;
+        return length;
+    }
+
+    /// @brief Removes the oldest record from the RAM ring buffer to make space for a newer one,
+    /// hands it to the optional backing store so it can be persisted instead of being dropped
+    void dropOldestStoredRecord() {
+        uint16_t const length = peekStoredRecordLength();
+        if (length == 0U) {
+            return;
+        }
+        if (m_backing_store != nullptr) {
+            uint8_t * record = new uint8_t[length]();
+            (void)consumeStoredRecord(record);
+            if (!m_backing_store->store(record, length)) {
+                Logger::printfln(STORED_TELEMETRY_DROPPED, length);
+            }
+            delete[] record;
+            record = nullptr;
+            return;
+        }
+        (void)consumeStoredRecord(nullptr);
+        Logger::printfln(STORED_TELEMETRY_DROPPED, length);
+    }
+
+    /// @brief Gets the length of the oldest stored record overall, records that overflowed into the backing store are older
+    /// than the ones in the RAM ring buffer and therefore take precedence, to keep the original sample order on the cloud
+    /// @return Length of the oldest stored record in bytes or 0 if no record is stored
+    uint16_t nextStoredRecordLength() {
+        if (m_backing_store != nullptr && m_backing_store->amount() != 0U) {
+            return m_backing_store->oldest_record_length();
+        }
+        return peekStoredRecordLength();
+    }
+
+    /// @brief Copies the oldest stored record overall into the given destination and removes it, backing store records take precedence
+    /// @param destination Buffer the record should be copied into, if nullptr is passed the record is simply discarded instead
+    /// @return Length of the consumed record in bytes or 0 if no record was stored
+    uint16_t consumeNextStoredRecord(uint8_t * destination) {
+        if (m_backing_store != nullptr && m_backing_store->amount() != 0U) {
+            uint16_t const length = m_backing_store->oldest_record_length();
+            return m_backing_store->retrieve_oldest_record(destination) ? length : 0U;
+        }
+        return consumeStoredRecord(destination);
+    }
+
+    /// @brief Timer callback that is called once the configured telemetry flush interval has passed.
+    /// Flushes the currently queued telemetry data points and restarts the timer for the next interval, as long as batching is still enabled
+    void onTelemetryFlushTimeout() {
+        (void)flushTelemetry();
+        if (m_batching_enabled && m_flush_interval != 0U) {
+            m_telemetry_flush_timer.once(m_flush_interval * 1000U);
+        }
+    }
+
+    /// @brief Timer callback that is called once the configured aggregation flush interval has passed.
+    /// Publishes the accumulated aggregates and restarts the timer for the next interval, as long as aggregation is still enabled
+    void onAggregationFlushTimeout() {
+        (void)flushAggregatedTelemetry();
+        if (m_aggregation_enabled && m_aggregation_interval != 0U) {
+            m_aggregation_flush_timer.once(m_aggregation_interval * 1000U);
+        }
+    }
+
+#if THINGSBOARD_ENABLE_WORKER_TASK
+    /// @brief Single slot of the lock-free ring the producer tasks enqueue telemetry records into.
+    /// The sequence carries the position the slot is currently valid for, producers claim a free slot by compare and swapping the enqueue position
+    /// and publish the copied record by bumping the sequence, which the single consuming worker task in turn bumps by the ring size once it dequeued the record
+    struct Worker_Ring_Slot {
+        Telemetry record;   // Telemetry record that was copied into the slot by the producer task
+        size_t    sequence; // Position the slot is currently valid for, accessed atomically to synchronize producers and the worker task
+    };
+
+    /// @brief Dequeues the oldest enqueued telemetry record from the lock-free ring, only ever called from the worker task
+    /// @param record Output parameter the dequeued telemetry record is copied into
+    /// @return Whether a record was dequeued or the ring is currently empty
+    bool Dequeue_Telemetry_Record(Telemetry & record) {
+        Worker_Ring_Slot & slot = m_worker_ring[m_worker_dequeue_position & m_worker_ring_mask];
+        size_t const sequence = __atomic_load_n(&slot.sequence, __ATOMIC_ACQUIRE);
+        if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(m_worker_dequeue_position + 1U) < 0) {
+            return false;
+        }
+        record = slot.record;
+        // Mark the slot as free for the producer that claims the position one ring revolution later
+        __atomic_store_n(&slot.sequence, m_worker_dequeue_position + m_worker_ring_mask + 1U, __ATOMIC_RELEASE);
+        m_worker_dequeue_position++;
+        return true;
+    }
+
+    /// @brief Main loop of the dedicated worker task, drains the enqueued telemetry records in batches into one combined publish message each.
+    /// Once a stop has been requested the remaining records are drained and published before the task deletes itself, so no enqueued records are lost
+    void Worker_Task() {
+        Telemetry batch[WORKER_PUBLISH_BATCH_SIZE] = {};
+        while (true) {
+            // The stop request is read before draining, ensuring records that were enqueued before the stop are still drained and published
+            bool const stop_requested = __atomic_load_n(&m_worker_stop_requested, __ATOMIC_ACQUIRE);
+            size_t drained = 0U;
+            while (drained < WORKER_PUBLISH_BATCH_SIZE && Dequeue_Telemetry_Record(batch[drained])) {
+                drained++;
+            }
+            if (drained != 0U) {
+#if THINGSBOARD_ENABLE_DYNAMIC
+                (void)sendTelemetry(batch, batch + drained);
+#else
+                (void)sendTelemetry<WORKER_PUBLISH_BATCH_SIZE>(batch, batch + drained);
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+            }
+            else if (stop_requested) {
+                break;
+            }
+            else {
+                // Ring is currently empty, yield to lower priority tasks until new records have been enqueued
+                vTaskDelay(1U);
+            }
+        }
+        __atomic_store_n(&m_worker_task_running, false, __ATOMIC_RELEASE);
+        vTaskDelete(nullptr);
+    }
+
+    static void Static_Worker_Task(void * instance) {
+        if (instance == nullptr) {
+            vTaskDelete(nullptr);
+            return;
+        }
+        static_cast<ThingsBoardSized *>(instance)->Worker_Task();
+    }
+#endif // THINGSBOARD_ENABLE_WORKER_TASK
+
     /// @brief Connects to the previously set ThingsBoard server, as the given client with the given access token
     /// @param access_token Access token that connects this device with a created device on the ThingsBoard server,
     /// can be "provision", if the device creates itself instead
@@ -614,12 +1877,84 @@ class ThingsBoardSized {
         return connection_result;
     }
 
+    /// @brief Advances the asynchronous connect state machine started with connectAsync() by at most one step.
+    /// Performs at most one connection attempt or replays at most one subscription per call,
+    /// bounding the time a single loop() iteration can spend on establishing the connection
+    void Process_Connection_State_Machine() {
+        switch (m_connection_state) {
+            case Connection_State::CONNECTING: {
+                if (m_client.connected()) {
+                    // Connection has been established, possibly by the background task of the underlying client, start replaying the subscriptions
+                    m_resubscribe_index = 0U;
+                    m_connection_state = Connection_State::RESUBSCRIBING;
+                    break;
+                }
+                uint64_t const now = Helper::getUptimeMilliseconds();
+                if (m_last_connect_attempt != 0U && now - m_last_connect_attempt < m_connect_retry_interval) {
+                    break;
+                }
+                m_last_connect_attempt = now;
+                if (!m_client.connect(m_connect_client_id, m_connect_access_token, m_connect_password)) {
+                    Logger::printfln(CONNECT_FAILED);
+                }
+                break;
+            }
+            case Connection_State::RESUBSCRIBING: {
+                if (!m_client.connected()) {
+                    m_connection_state = Connection_State::CONNECTING;
+                    break;
+                }
+                // Replay one subscription per call, result is ignored because the important part of clearing internal data structures always succeeds
+                while (m_resubscribe_index < m_api_implementations.size()) {
+                    IAPI_Implementation * const api = m_api_implementations[m_resubscribe_index];
+                    m_resubscribe_index++;
+                    if (api != nullptr) {
+                        (void)api->Resubscribe_Topic();
+                        return;
+                    }
+                }
+                // All subscriptions have been replayed, forward any telemetry that was stored while the connection to the cloud was lost
+                if (storeEnabled() && storedTelemetryAmount() != 0U) {
+                    (void)drainStoredTelemetry();
+                }
+                m_connection_state = Connection_State::CONNECTED;
+                break;
+            }
+            case Connection_State::CONNECTED: {
+                // Once the established connection is lost the state machine reconnects with the same credentials automatically
+                if (!m_client.connected()) {
+                    m_last_connect_attempt = 0U;
+                    m_connection_state = Connection_State::CONNECTING;
+                }
+                break;
+            }
+            case Connection_State::DISCONNECTED:
+            default: {
+                break;
+            }
+        }
+    }
+
     /// @brief Resubscribes to topics that establish a permanent connection with MQTT, meaning they may receive more than one event over their lifetime,
     /// whereas other events that are only ever called once and then deleted after they have been handled are not resubscribed.
     /// Only the topics that establish a permanent connection are resubscribed, because all not yet received data is discard on the MQTT broker,
     // once we establish a connection again. This is the case because we connect with the cleanSession attribute set to true.
     // Therefore we can also clear the buffer of all non-permanent topics.
     void Resubscribe_Topics() {
+        // The constant topics the client publishes on are registered as MQTT 5 topic aliases on every established connection,
+        // because aliases only survive for a single MQTT session. Does nothing on clients that do not support or have not enabled the MQTT 5 protocol.
+        // Results are ignored, because publishes to topics whose alias could not be registered simply keep carrying the complete topic string.
+        // The topics that carry a request id as a parameter (RPC, Attribute Request) can not be aliased, because their topic string differs for every request
+        (void)m_client.register_topic_alias(TELEMETRY_TOPIC);
+        (void)m_client.register_topic_alias(ATTRIBUTE_TOPIC);
+        (void)m_client.register_topic_alias(CLAIM_TOPIC);
+        // While the asynchronous connect state machine is active the replay is instead performed incrementally from loop(),
+        // one subscription per iteration, so the connect callback of the client does not block for the whole replay duration
+        if (m_async_connect_enabled) {
+            m_resubscribe_index = 0U;
+            m_connection_state = Connection_State::RESUBSCRIBING;
+            return;
+        }
         // Results are ignored, because the important part of clearing internal data structures always succeeds
         for (auto & api : m_api_implementations) {
             if (api == nullptr) {
@@ -627,6 +1962,141 @@ class ThingsBoardSized {
             }
             (void)api->Resubscribe_Topic();
         }
+        // Forward any telemetry that was stored while the connection to the cloud was lost
+        if (storeEnabled() && storedTelemetryAmount() != 0U) {
+            (void)drainStoredTelemetry();
+        }
+    }
+
+    /// @brief One per-key telemetry rule configured with setTelemetryDeadband() or setTelemetryPrecision(),
+    /// holds the configured suppression thresholds, the configured serialization precision and the small last-value cache suppressed data points are compared against
+    struct Deadband_Rule {
+        char const * key;                 // Key of the telemetry data points the rule applies to
+        double       absolute_delta;      // Minimum absolute difference to the last published value required to publish, 0.0 meaning no absolute deadband is configured
+        double       relative_delta;      // Minimum difference relative to the magnitude of the last published value required to publish, 0.0 meaning no relative deadband is configured
+        uint64_t     minimum_interval_ms; // Minimum amount of milliseconds between two published data points, 0 meaning no rate limit is configured
+        uint8_t      precision;           // Amount of decimal places floating point data points are rounded to before serializing, TELEMETRY_PRECISION_NONE meaning no rounding is configured
+        double       last_value;          // Last published value the deltas of following data points are compared against
+        uint64_t     last_publish_time;   // Uptime in milliseconds the last data point was published at
+        bool         has_published;       // Whether a data point of the key has been published yet, the first data point always passes the suppression stage
+    };
+
+    /// @brief One per-key telemetry accumulator configured with setTelemetryAggregation(),
+    /// tracks every statistic of the samples recorded in the current flush interval with a few instructions per sample
+    struct Aggregation_Accumulator {
+        char const *     key;         // Key the recorded samples are accumulated under and published with
+        Aggregation_Type aggregation; // Aggregate the accumulated samples are published as on flush
+        double           minimum;     // Smallest value that was recorded in the current flush interval
+        double           maximum;     // Biggest value that was recorded in the current flush interval
+        double           sum;         // Sum of all values that were recorded in the current flush interval
+        double           last;        // Value that was recorded last in the current flush interval
+        size_t           count;       // Amount of values that were recorded in the current flush interval, 0 meaning the accumulator is empty
+    };
+
+    /// @brief Finds the previously configured accumulator for the given key.
+    /// Compares the pointers before falling back to an actual string comparison,
+    /// because high-rate sampling loops usually pass the exact same string literal for every sample
+    /// @param key Key the accumulator was configured for
+    /// @return Accumulator configured for the given key or nullptr if no accumulator for the key exists
+    Aggregation_Accumulator * Find_Aggregation_Accumulator(char const * key) {
+        if (Helper::stringIsNullorEmpty(key)) {
+            return nullptr;
+        }
+        for (auto & accumulator : m_aggregation_accumulators) {
+            if (accumulator.key == key || strcmp(accumulator.key, key) == 0) {
+                return &accumulator;
+            }
+        }
+        return nullptr;
+    }
+
+    /// @brief Calculates the value the given accumulator publishes, depending on its configured aggregate
+    /// @param accumulator Accumulator holding the statistics of the current flush interval, expects at least one recorded sample
+    /// @return Value that should be published for the key of the accumulator
+    static double Calculate_Aggregate(Aggregation_Accumulator const & accumulator) {
+        switch (accumulator.aggregation) {
+            case Aggregation_Type::MIN:
+                return accumulator.minimum;
+            case Aggregation_Type::MAX:
+                return accumulator.maximum;
+            case Aggregation_Type::MEAN:
+                return accumulator.sum / static_cast<double>(accumulator.count);
+            case Aggregation_Type::SUM:
+                return accumulator.sum;
+            case Aggregation_Type::COUNT:
+                return static_cast<double>(accumulator.count);
+            case Aggregation_Type::LAST:
+            default:
+                return accumulator.last;
+        }
+    }
+
+    /// @brief Finds the previously configured suppression rule for the given key
+    /// @param key Key the rule was configured for
+    /// @return Rule configured for the given key or nullptr if no rule for the key exists
+    Deadband_Rule * Find_Deadband_Rule(char const * key) {
+        if (Helper::stringIsNullorEmpty(key)) {
+            return nullptr;
+        }
+        for (auto & rule : m_deadband_rules) {
+            if (strcmp(rule.key, key) == 0) {
+                return &rule;
+            }
+        }
+        return nullptr;
+    }
+
+    /// @brief Evaluates the configured suppression rules for the given telemetry data point and records it as published if it passes them.
+    /// Data points without a configured rule for their key, non numeric values and the first data point of a key always pass
+    /// @param data Telemetry data point that should be evaluated
+    /// @return Whether the data point should be suppressed instead of being serialized and published or not
+    bool Should_Suppress_Telemetry(Telemetry const & data) {
+        Deadband_Rule * const rule = Find_Deadband_Rule(data.GetKey());
+        if (rule == nullptr) {
+            return false;
+        }
+        double value = 0.0;
+        // Only numeric values can be compared against the configured deltas, everything else always passes the suppression stage
+        if (!data.GetNumericValue(value)) {
+            return false;
+        }
+        uint64_t const now = Helper::getUptimeMilliseconds();
+        if (rule->has_published) {
+            if (rule->minimum_interval_ms != 0U && (now - rule->last_publish_time) < rule->minimum_interval_ms) {
+                return true;
+            }
+            double const delta = value > rule->last_value ? value - rule->last_value : rule->last_value - value;
+            double const last_magnitude = rule->last_value < 0.0 ? -rule->last_value : rule->last_value;
+            // A rule without any configured delta only rate limits and passes every data point that exceeds the minimum interval
+            bool changed = rule->absolute_delta == 0.0 && rule->relative_delta == 0.0;
+            if (rule->absolute_delta != 0.0 && delta >= rule->absolute_delta) {
+                changed = true;
+            }
+            if (rule->relative_delta != 0.0 && delta >= (rule->relative_delta * last_magnitude)) {
+                changed = true;
+            }
+            if (!changed) {
+                return true;
+            }
+        }
+        // Data point passed every configured rule and is recorded as the last published value the following data points are compared against
+        rule->last_value = value;
+        rule->last_publish_time = now;
+        rule->has_published = true;
+        return false;
+    }
+
+    /// @brief Applies the per-key configured serialization precision to the given telemetry data point.
+    /// A precision set directly on the record with the SetPrecision() method of the Telemetry class takes priority and stays untouched
+    /// @param data Telemetry data point the configured precision should be applied to
+    void Apply_Telemetry_Precision(Telemetry & data) {
+        if (data.GetPrecision() != TELEMETRY_PRECISION_NONE) {
+            return;
+        }
+        Deadband_Rule const * const rule = Find_Deadband_Rule(data.GetKey());
+        if (rule != nullptr && rule->precision != TELEMETRY_PRECISION_NONE) {
+            data.SetPrecision(rule->precision);
+        }
     }
 
     /// @brief Attempts to send a single key-value pair with the given key and value of the given type
@@ -637,10 +2107,13 @@ class ThingsBoardSized {
     /// @return Whether sending the data was successful or not
     template<typename T>
     bool sendKeyValue(char const * key, T const & value, bool telemetry = true) {
-        const Telemetry t(key, value);
+        Telemetry t(key, value);
         if (t.IsEmpty()) {
             return false;
         }
+        if (telemetry) {
+            Apply_Telemetry_Precision(t);
+        }
 
         StaticJsonDocument<JSON_OBJECT_SIZE(1)> json_buffer;
         if (!t.SerializeKeyValue(json_buffer)) {
@@ -680,20 +2153,27 @@ class ThingsBoardSized {
         StaticJsonDocument<JSON_OBJECT_SIZE(MaxKeyValuePairAmount)> json_buffer;
 #endif // THINGSBOARD_ENABLE_DYNAMIC
 
-#if THINGSBOARD_ENABLE_STL
-        if (std::any_of(first, last, [&json_buffer](Telemetry const & data) { return !data.SerializeKeyValue(json_buffer); })) {
-            Logger::printfln(UNABLE_TO_SERIALIZE);
-            return false;
-        }
-#else
+        size_t serialized_amount = 0U;
         for (auto it = first; it != last; ++it) {
-            auto const & data = *it;
+            // Copied, so the per-key configured serialization precision can be applied without altering the record of the caller
+            auto data = *it;
+            // Telemetry data points that a configured suppression rule drops are simply skipped, the remaining data points are still serialized and sent
+            if (telemetry && Should_Suppress_Telemetry(data)) {
+                continue;
+            }
+            if (telemetry) {
+                Apply_Telemetry_Precision(data);
+            }
             if (!data.SerializeKeyValue(json_buffer)) {
                 Logger::printfln(UNABLE_TO_SERIALIZE);
                 return false;
             }
+            serialized_amount++;
+        }
+        // All data points were suppressed, there is nothing to publish and the data is reported as successfully sent
+        if (serialized_amount == 0U) {
+            return true;
         }
-#endif // THINGSBOARD_ENABLE_STL
         return telemetry ? sendTelemetryJson(json_buffer, Helper::Measure_Json(json_buffer)) : sendAttributeJson(json_buffer, Helper::Measure_Json(json_buffer));
     }
 
@@ -711,67 +2191,97 @@ class ThingsBoardSized {
 #if THINGSBOARD_ENABLE_DEBUG
         Logger::printfln(RECEIVE_MESSAGE, length, topic);
 #endif // THINGSBOARD_ENABLE_DEBUG
+        uint16_t const clamped_length = (length > UINT16_MAX) ? UINT16_MAX : static_cast<uint16_t>(length);
+        if (clamped_length > m_received_payload_high_water) {
+            m_received_payload_high_water = clamped_length;
+        }
+        if (clamped_length > m_recent_received_high_water) {
+            m_recent_received_high_water = clamped_length;
+        }
 
-#if THINGSBOARD_ENABLE_STL
-#if THINGSBOARD_ENABLE_CXX20
-        auto filtered_raw_api_implementations = m_api_implementations | std::views::filter([&topic](IAPI_Implementation const * api) {
-#else
 #if THINGSBOARD_ENABLE_DYNAMIC
-        Vector<IAPI_Implementation *> filtered_raw_api_implementations = {};
+        Vector<IAPI_Implementation *> matched_api_implementations = {};
 #else
-        Array<IAPI_Implementation *, MaxEndpointsAmount> filtered_raw_api_implementations = {};
+        Array<IAPI_Implementation *, MaxEndpointsAmount> matched_api_implementations = {};
 #endif // THINGSBOARD_ENABLE_DYNAMIC
-        std::copy_if(m_api_implementations.begin(), m_api_implementations.end(), std::back_inserter(filtered_raw_api_implementations), [&topic](IAPI_Implementation const * api) {
-#endif // THINGSBOARD_ENABLE_CXX20
-            return (api != nullptr && api->Get_Process_Type() == API_Process_Type::RAW && api->Compare_Response_Topic(topic));
-        });
-
-        for (auto & api : filtered_raw_api_implementations) {
-            api->Process_Response(topic, payload, length);
-        }
-
-        // If the filtered api implementations was not emtpy it means the response was processed as its raw bytes representation atleast once,
-        // and because we interpreted it as raw bytes instead of json, we skip the further processing of those raw bytes as json.
-        // We do that because the received response is in that case not even valid json in the first place and would therefore simply fail deserialization
-        if (!filtered_raw_api_implementations.empty()) {
+#if THINGSBOARD_ENABLE_PROFILING
+        uint64_t const match_start = Profiler::timestamp();
+#endif // THINGSBOARD_ENABLE_PROFILING
+        Match_Response_Topic(topic, matched_api_implementations);
+#if THINGSBOARD_ENABLE_PROFILING
+        Profiler::record(Profile_Stage::RECEIVE_TOPIC_MATCH, match_start);
+#endif // THINGSBOARD_ENABLE_PROFILING
+        // Messages that no subscribed api implementation handles are discarded immediately, before the payload is ever deserialized
+        if (matched_api_implementations.empty()) {
             return;
         }
-#else
+
+#if THINGSBOARD_ENABLE_PROFILING
+        uint64_t const raw_dispatch_start = Profiler::timestamp();
+#endif // THINGSBOARD_ENABLE_PROFILING
         bool processed_response_as_raw = false;
-        for (auto & api : m_api_implementations) {
-            if (api == nullptr || api->Get_Process_Type() != API_Process_Type::RAW || !api->Compare_Response_Topic(topic)) {
+        for (auto & api : matched_api_implementations) {
+            if (api->Get_Process_Type() != API_Process_Type::RAW) {
                 continue;
             }
             api->Process_Response(topic, payload, length);
             processed_response_as_raw = true;
         }
+#if THINGSBOARD_ENABLE_PROFILING
+        if (processed_response_as_raw) {
+            Profiler::record(Profile_Stage::RECEIVE_DISPATCH, raw_dispatch_start);
+        }
+#endif // THINGSBOARD_ENABLE_PROFILING
 
+        // If the response was processed as its raw bytes representation atleast once,
+        // we skip the further processing of those raw bytes as json.
+        // We do that because the received response is in that case not even valid json in the first place and would therefore simply fail deserialization
         if (processed_response_as_raw) {
             return;
         }
-#endif // THINGSBOARD_ENABLE_STL
+
+        // Deserialization filter of the matched api implementation, restricts which members of the received payload are materialized.
+        // Only used if exactly one api implementation matched the received topic, because the filters of multiple endpoints can not be combined safely
+        JsonDocument * const response_filter = matched_api_implementations.size() == 1U ? matched_api_implementations[0U]->Get_Response_Filter() : nullptr;
 
         // Calculate size with the total amount of commas, always denotes the end of a key-value pair besides for the last element in an array or in an object where the comma is not permitted,
         // therfore we have to add the space for another key-value pair for all the occurences of thoose symbols as well
-        size_t const size = Helper::getOccurences(payload, ',', length) + Helper::getOccurences(payload, '{', length) + Helper::getOccurences(payload, '[', length);
+#if THINGSBOARD_ENABLE_PROFILING
+        uint64_t const size_scan_start = Profiler::timestamp();
+#endif // THINGSBOARD_ENABLE_PROFILING
+        size_t const size = Helper::getJsonDelimiterOccurences(payload, length);
+#if THINGSBOARD_ENABLE_PROFILING
+        Profiler::record(Profile_Stage::RECEIVE_SIZE_SCAN, size_scan_start);
+#endif // THINGSBOARD_ENABLE_PROFILING
 #if THINGSBOARD_ENABLE_DYNAMIC
         // Buffer that we deserialize is writeable and not read only and therefore stored as a pointer inside the JsonDocument --> zero copy, meaning the size for the received payload is 0 bytes.
         // Data structure size, therefore only depends on the amount of key value pairs received.
         // See https://arduinojson.org/v6/assistant/ for more information on the needed size for the JsonDocument
-        size_t const document_size = JSON_OBJECT_SIZE(size);
+        size_t document_size = JSON_OBJECT_SIZE(size);
+        if (response_filter != nullptr) {
+            // Filtered deserialization only materializes the subscribed members, meaning the document does not have to grow with the received payload.
+            // Nested values below a subscribed member can exceed this estimation, if that happens the deserialization is retried with the payload based capacity below
+            size_t const filtered_size = response_filter->memoryUsage() + JSON_OBJECT_SIZE(1U);
+            if (filtered_size < document_size) {
+                document_size = filtered_size;
+            }
+        }
         if (m_max_response_size != 0U && document_size > m_max_response_size) {
             Logger::printfln(MAXIMUM_RESPONSE_EXCEEDED, document_size, m_max_response_size);
             return;
         }
-        TBJsonDocument json_buffer(document_size);
         // Because we calcualte the allocation dynamically fromt he payload, which is user input, it could theoretically be malicious ({ "malicious" : "{{{{{{{{{..."}) and contain a lot of the symbols used to calculate the size.
-        // But if that is the case adn the allocation still succeeds we delete the allocated memory relatively fast again so it shouldn't be a problem and if the allocation fails we simply return at this point with an appropriate error message
-        if (json_buffer.capacity() != document_size) {
+        // But if that is the case the reusable receive document is trimmed again on the next trimReceiveDocument() call so it shouldn't be a problem and if the allocation fails we simply return at this point with an appropriate error message
+        TBJsonDocument * const receive_document = getReceiveDocument(document_size);
+        if (receive_document == nullptr) {
             Logger::printfln(HEAP_ALLOCATION_FAILED, document_size);
             return;
         }
+        TBJsonDocument & json_buffer = *receive_document;
 #else
-        if (size > MaxResponse) {
+        // Payloads that are deserialized with a filter can contain more key-value pairs than we materialize,
+        // because every member that is not subscribed is skipped over without requiring any document memory
+        if (response_filter == nullptr && size > MaxResponse) {
             Logger::printfln(TOO_MANY_JSON_FIELDS, size, "MaxResponse", MaxResponse);
             return;
         }
@@ -785,115 +2295,239 @@ class ThingsBoardSized {
         // The deserializeJson method we use, can use the zero copy mode because a writeable input was passed,
         // if that were not the case the needed allocated memory would drastically increase, because the keys would need to be copied as well.
         // See https://arduinojson.org/v6/doc/deserialization/ for more info on ArduinoJson deserialization
-        DeserializationError const error = deserializeJson(json_buffer, payload, length);
+#if THINGSBOARD_ENABLE_PROFILING
+        uint64_t const deserialize_start = Profiler::timestamp();
+#endif // THINGSBOARD_ENABLE_PROFILING
+        DeserializationError const error = response_filter != nullptr ? deserializeJson(json_buffer, payload, length, DeserializationOption::Filter(*response_filter)) : deserializeJson(json_buffer, payload, length);
+#if THINGSBOARD_ENABLE_PROFILING
+        Profiler::record(Profile_Stage::RECEIVE_DESERIALIZE, deserialize_start);
+#endif // THINGSBOARD_ENABLE_PROFILING
+#if THINGSBOARD_ENABLE_DYNAMIC
+        if (error == DeserializationError::NoMemory && response_filter != nullptr && document_size < JSON_OBJECT_SIZE(size)) {
+            // Nested values below a subscribed member needed more memory than the filter based estimation, retry once with the capacity calculated from the received payload
+            size_t const retry_size = JSON_OBJECT_SIZE(size);
+            if (m_max_response_size != 0U && retry_size > m_max_response_size) {
+                Logger::printfln(MAXIMUM_RESPONSE_EXCEEDED, retry_size, m_max_response_size);
+                return;
+            }
+            TBJsonDocument * const retry_document = getReceiveDocument(retry_size);
+            if (retry_document == nullptr) {
+                Logger::printfln(HEAP_ALLOCATION_FAILED, retry_size);
+                return;
+            }
+            DeserializationError const retry_error = deserializeJson(*retry_document, payload, length, DeserializationOption::Filter(*response_filter));
+            if (retry_error) {
+                Logger::printfln(UNABLE_TO_DE_SERIALIZE_JSON, retry_error.c_str());
+                return;
+            }
+#if THINGSBOARD_ENABLE_PROFILING
+            uint64_t const retry_dispatch_start = Profiler::timestamp();
+#endif // THINGSBOARD_ENABLE_PROFILING
+            Process_Json_Api_Implementations(topic, matched_api_implementations, *retry_document);
+#if THINGSBOARD_ENABLE_PROFILING
+            Profiler::record(Profile_Stage::RECEIVE_DISPATCH, retry_dispatch_start);
+#endif // THINGSBOARD_ENABLE_PROFILING
+            return;
+        }
+#endif // THINGSBOARD_ENABLE_DYNAMIC
         if (error) {
             Logger::printfln(UNABLE_TO_DE_SERIALIZE_JSON, error.c_str());
             return;
         }
 
-#if THINGSBOARD_ENABLE_STL
-#if THINGSBOARD_ENABLE_CXX20
-        auto filtered_json_api_implementations = m_api_implementations | std::views::filter([&topic](IAPI_Implementation const * api) {
-#else
+#if THINGSBOARD_ENABLE_PROFILING
+        uint64_t const dispatch_start = Profiler::timestamp();
+#endif // THINGSBOARD_ENABLE_PROFILING
+        Process_Json_Api_Implementations(topic, matched_api_implementations, json_buffer);
+#if THINGSBOARD_ENABLE_PROFILING
+        Profiler::record(Profile_Stage::RECEIVE_DISPATCH, dispatch_start);
+#endif // THINGSBOARD_ENABLE_PROFILING
+    }
+
 #if THINGSBOARD_ENABLE_DYNAMIC
-        Vector<IAPI_Implementation *> filtered_json_api_implementations = {};
-#else
-        Array<IAPI_Implementation *, MaxEndpointsAmount> filtered_json_api_implementations = {};
+    /// @brief Gets the reusable receive document, grown to at least the given capacity.
+    /// The document is kept allocated at the biggest capacity that was required so far and simply cleared for reuse,
+    /// so steady-state message processing performs no heap allocations, it can be released again with trimReceiveDocument()
+    /// @param document_size Capacity in bytes the receive document requires to hold the next deserialized payload
+    /// @return Cleared receive document with at least the given capacity or nullptr if the required allocation failed
+    TBJsonDocument * getReceiveDocument(size_t const & document_size) {
+        if (m_receive_document != nullptr && m_receive_document->capacity() < document_size) {
+            Memory_Metrics::record_deallocation(Memory_Subsystem::RECEIVE_DOCUMENT, m_receive_document->capacity());
+            delete m_receive_document;
+            m_receive_document = nullptr;
+        }
+        if (m_receive_document == nullptr) {
+            m_receive_document = new TBJsonDocument(document_size);
+            if (m_receive_document->capacity() < document_size) {
+                delete m_receive_document;
+                m_receive_document = nullptr;
+                return nullptr;
+            }
+            Memory_Metrics::record_allocation(Memory_Subsystem::RECEIVE_DOCUMENT, m_receive_document->capacity());
+        }
+        m_receive_document->clear();
+        return m_receive_document;
+    }
 #endif // THINGSBOARD_ENABLE_DYNAMIC
-        std::copy_if(m_api_implementations.begin(), m_api_implementations.end(), std::back_inserter(filtered_json_api_implementations), [&topic](IAPI_Implementation const * api) {
-#endif // THINGSBOARD_ENABLE_CXX20
-            return (api != nullptr && api->Get_Process_Type() == API_Process_Type::JSON && api->Compare_Response_Topic(topic));
-        });
 
-        for (auto & api : filtered_json_api_implementations) {
-            api->Process_Json_Response(topic, json_buffer);
-        }
+    /// @brief Forwards the already deserialized response to every matched API implementation that processes its responses as json
+    /// @param topic Topic the received message was sent over
+    /// @param matched_api_implementations API implementations that handle responses on the given topic
+    /// @param json_buffer Payload sent by the server over our given topic, deserialized into a json document
+#if THINGSBOARD_ENABLE_DYNAMIC
+    void Process_Json_Api_Implementations(char const * topic, Vector<IAPI_Implementation *> & matched_api_implementations, JsonDocument const & json_buffer) {
 #else
-        for (auto & api : m_api_implementations) {
-            if (api == nullptr || api->Get_Process_Type() != API_Process_Type::JSON || !api->Compare_Response_Topic(topic)) {
+    void Process_Json_Api_Implementations(char const * topic, Array<IAPI_Implementation *, MaxEndpointsAmount> & matched_api_implementations, JsonDocument const & json_buffer) {
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+        for (auto & api : matched_api_implementations) {
+            if (api->Get_Process_Type() != API_Process_Type::JSON) {
                 continue;
             }
             api->Process_Json_Response(topic, json_buffer);
         }
-#endif // THINGSBOARD_ENABLE_STL
     }
 
-#if !THINGSBOARD_ENABLE_STL
-    static void onStaticMQTTMessage(char * topic, uint8_t * payload, unsigned int length) {
-        if (m_subscribedInstance == nullptr) {
-            return;
+    /// @brief Rebuilds the sorted topic dispatch table from the currently subscribed API implementations.
+    /// Called once whenever the subscribed API implementations change, so that received messages can be routed with a binary search
+    /// over the lexicographically sorted topic prefixes instead of comparing the received topic against every subscribed API implementation.
+    /// API implementations that do not report a constant topic prefix are collected seperately and compared directly for every received message instead
+    void Build_Topic_Dispatch_Table() {
+        m_dispatch_table.clear();
+        m_fallback_api_implementations.clear();
+        for (auto & api : m_api_implementations) {
+            if (api == nullptr) {
+                continue;
+            }
+            char const * const prefix = api->Get_Response_Topic_Prefix();
+            if (prefix == nullptr) {
+                m_fallback_api_implementations.push_back(api);
+                continue;
+            }
+            Topic_Dispatch_Entry const entry = {prefix, strlen(prefix), api};
+            m_dispatch_table.push_back(entry);
+            // Insertion sort that keeps the dispatch table lexicographically sorted by topic prefix, required for the binary search on received messages
+            for (size_t index = m_dispatch_table.size() - 1U; index > 0U && strcmp(m_dispatch_table[index - 1U].prefix, m_dispatch_table[index].prefix) > 0; index--) {
+                Topic_Dispatch_Entry const swapped = m_dispatch_table[index - 1U];
+                m_dispatch_table[index - 1U] = m_dispatch_table[index];
+                m_dispatch_table[index] = swapped;
+            }
         }
-        m_subscribedInstance->onMQTTMessage(topic, payload, length);
     }
 
-    static void staticMQTTConnect() {
-        if (m_subscribedInstance == nullptr) {
-            return;
+    /// @brief Finds all subscribed API implementations that handle responses on the given received topic.
+    /// Routes over the sorted topic dispatch table with a binary search, meaning the routing cost grows logarithmically
+    /// with the amount of subscribed API implementations instead of linearly and the received topic is compared at most against the few candidate prefixes.
+    /// Every candidate found in the table is confirmed with Compare_Response_Topic() before it is added, because the table prefixes can be shorter than the actually compared topic
+    /// @param topic Topic the received message was sent over
+    /// @param matched_api_implementations Data container the API implementations that handle the given topic are copied into
+#if THINGSBOARD_ENABLE_DYNAMIC
+    void Match_Response_Topic(char const * topic, Vector<IAPI_Implementation *> & matched_api_implementations) const {
+#else
+    void Match_Response_Topic(char const * topic, Array<IAPI_Implementation *, MaxEndpointsAmount> & matched_api_implementations) const {
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+        // Binary search for the first entry that is lexicographically greater than the received topic,
+        // every entry whose prefix can match the received topic has to be located before that insertion point
+        size_t lower_bound = 0U;
+        size_t upper_bound = m_dispatch_table.size();
+        while (lower_bound < upper_bound) {
+            size_t const middle = lower_bound + ((upper_bound - lower_bound) / 2U);
+            if (strcmp(m_dispatch_table[middle].prefix, topic) <= 0) {
+                lower_bound = middle + 1U;
+            }
+            else {
+                upper_bound = middle;
+            }
         }
-        m_subscribedInstance->Resubscribe_Topics();
-    }
-
-    static void staticSubscribeImplementation(IAPI_Implementation & api) {
-        if (m_subscribedInstance == nullptr) {
-            return;
+        // Walk backwards over the candidate entries, stopping once the entries can not contain a matching prefix anymore.
+        // Entries before the insertion point are lexicographically smaller or equal to the received topic,
+        // meaning once the first character differs no earlier entry can start with the required character either
+        for (size_t index = lower_bound; index-- > 0U;) {
+            auto const & entry = m_dispatch_table[index];
+            if (entry.prefix[0U] != topic[0U]) {
+                break;
+            }
+            if (strncmp(entry.prefix, topic, entry.prefix_length) == 0 && entry.api->Compare_Response_Topic(topic)) {
+                matched_api_implementations.push_back(entry.api);
+            }
         }
-        m_subscribedInstance->Subscribe_API_Implementation(api);
-    }
-
-    static bool staticSendJson(char const * topic, JsonDocument const & source, size_t const & json_size) {
-        if (m_subscribedInstance == nullptr) {
-            return false;
+        // API implementations without a constant topic prefix can not be presorted and are simply compared directly
+        for (auto const & api : m_fallback_api_implementations) {
+            if (api->Compare_Response_Topic(topic)) {
+                matched_api_implementations.push_back(api);
+            }
         }
-        return m_subscribedInstance->Send_Json(topic, source, json_size);
     }
 
-    static bool staticSendJsonString(char const * topic, char const * json) {
-        if (m_subscribedInstance == nullptr) {
-            return false;
+    /// @brief Attempts to process a single received fragment of a message that did not fit into the receive buffer of the MQTT client at once.
+    /// Only routed to api implementations that process their response as raw binary data (OTA Firmware Update),
+    /// because json responses can only be deserialized once the complete payload has been received.
+    /// Allows the receive buffer of the MQTT client to be multiple times smaller than the biggest expected binary payload,
+    /// because the buffer only ever has to hold one fragment instead of the complete message
+    /// @param topic Previously subscribed topic, we got the response over
+    /// @param payload Fragment of the payload that was sent over the cloud and received over the given topic
+    /// @param length Amount of bytes in the received fragment
+    /// @param current_offset Offset of the fragment inside the complete payload
+    /// @param total_length Total length of the complete payload the fragment belongs to
+    void onMQTTMessageFragment(char * topic, uint8_t * payload, unsigned int length, size_t const & current_offset, size_t const & total_length) {
+#if THINGSBOARD_ENABLE_DEBUG
+        Logger::printfln(RECEIVE_MESSAGE, length, topic);
+#endif // THINGSBOARD_ENABLE_DEBUG
+
+#if THINGSBOARD_ENABLE_DYNAMIC
+        Vector<IAPI_Implementation *> matched_api_implementations = {};
+#else
+        Array<IAPI_Implementation *, MaxEndpointsAmount> matched_api_implementations = {};
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+        Match_Response_Topic(topic, matched_api_implementations);
+        for (auto & api : matched_api_implementations) {
+            if (api->Get_Process_Type() != API_Process_Type::RAW) {
+                continue;
+            }
+            api->Process_Response_Fragment(topic, payload, length, current_offset, total_length);
         }
-        return m_subscribedInstance->Send_Json_String(topic, json);
     }
 
-    static bool staticClientSubscribe(char const * topic) {
+#if !THINGSBOARD_ENABLE_STL
+    static void onStaticMQTTMessage(char * topic, uint8_t * payload, unsigned int length) {
         if (m_subscribedInstance == nullptr) {
-            return false;
+            return;
         }
-        return m_subscribedInstance->clientSubscribe(topic);
+        m_subscribedInstance->onMQTTMessage(topic, payload, length);
     }
 
-    static bool staticClientUnsubscribe(char const * topic) {
+    static void onStaticMQTTMessageFragment(char * topic, uint8_t * payload, unsigned int length, size_t const & current_offset, size_t const & total_length) {
         if (m_subscribedInstance == nullptr) {
-            return false;
+            return;
         }
-        return m_subscribedInstance->clientUnsubscribe(topic);
+        m_subscribedInstance->onMQTTMessageFragment(topic, payload, length, current_offset, total_length);
     }
 
-    static size_t * staticGetRequestID() {
+    static void onStaticPublishCompleted(int message_id) {
         if (m_subscribedInstance == nullptr) {
-            return nullptr;
+            return;
         }
-        return m_subscribedInstance->getRequestID();
+        m_subscribedInstance->onPublishCompleted(message_id);
     }
 
-    static uint16_t staticGetClientReceiveBufferSize() {
+    static void staticMQTTConnect() {
         if (m_subscribedInstance == nullptr) {
-            return 0U;
+            return;
         }
-        return m_subscribedInstance->getClientReceiveBufferSize();
+        m_subscribedInstance->Resubscribe_Topics();
     }
 
-    static uint16_t staticGetClientSendBufferSize() {
+    static void staticTelemetryFlushTimeout() {
         if (m_subscribedInstance == nullptr) {
-            return 0U;
+            return;
         }
-        return m_subscribedInstance->getClientSendBufferSize();
+        m_subscribedInstance->onTelemetryFlushTimeout();
     }
 
-    static bool staticSetBufferSize(uint16_t receive_buffer_size, uint16_t send_buffer_size) {
+    static void staticAggregationFlushTimeout() {
         if (m_subscribedInstance == nullptr) {
-            return false;
+            return;
         }
-        return m_subscribedInstance->setBufferSize(receive_buffer_size, send_buffer_size);
+        m_subscribedInstance->onAggregationFlushTimeout();
     }
 
     // PubSub client cannot call a instanced method when message arrives on subscribed topic.
@@ -908,18 +2542,88 @@ class ThingsBoardSized {
 #if THINGSBOARD_ENABLE_STREAM_UTILS
     size_t                                          m_buffering_size = {};      // Buffering size used to serialize directly into client.
 #endif // THINGSBOARD_ENABLE_STREAM_UTILS
+    Connection_State                                m_connection_state = {};       // Current state of the asynchronous connect state machine started with connectAsync()
+    bool                                            m_async_connect_enabled = {};  // Whether an asynchronous connect has been started, meaning the state machine is advanced from loop()
+    char const *                                    m_connect_access_token = {};   // Access token the asynchronous connect state machine connects with
+    char const *                                    m_connect_client_id = {};      // Client id the asynchronous connect state machine connects with
+    char const *                                    m_connect_password = {};       // Password the asynchronous connect state machine connects with, nullptr if none was given
+    Provisioned_Credentials                         m_cached_credentials = {};     // Credentials read from a credentials store on connect, kept as a member because the underlying client only stores pointers to them
+    uint64_t                                        m_connect_retry_interval = {}; // Amount of milliseconds we wait after a failed connection attempt before the next one is started
+    uint64_t                                        m_last_connect_attempt = {};   // Uptime in milliseconds the last asynchronous connection attempt was started at
+    size_t                                          m_resubscribe_index = {};      // Index of the next API implementation whose subscription is replayed by the incremental resubscribe
+    uint8_t                                         m_publish_quality_of_service = {}; // Quality of service all payloads are published with, configured with setPublishQualityOfService(), 0 per default
+    uint8_t                                         m_in_flight_window = {};       // Maximum amount of simultaneously unconfirmed published messages, only used with a quality of service bigger than 0
+    uint8_t                                         m_in_flight_count = {};        // Current amount of published messages whose delivery has not been confirmed by the broker yet, updated from the task of the MQTT client
+    bool                                            m_adaptive_buffer_enabled = {}; // Whether the client buffers are grown on demand and shrunk back after a quiet period, configured with enableAdaptiveBufferSizing()
+    uint64_t                                        m_buffer_shrink_quiet_period = {}; // Amount of milliseconds without a bigger payload after which the client buffers are shrunk back to the recent high water marks
+    uint64_t                                        m_last_buffer_shrink_check = {}; // Uptime in milliseconds the recent high water marks were last evaluated for shrinking the client buffers
+    uint16_t                                        m_sent_payload_high_water = {}; // Size in bytes of the biggest payload that was attempted to be sent since the client was constructed
+    uint16_t                                        m_received_payload_high_water = {}; // Size in bytes of the biggest payload that was received since the client was constructed
+    uint16_t                                        m_recent_sent_high_water = {}; // Size in bytes of the biggest payload that was attempted to be sent in the current quiet period
+    uint16_t                                        m_recent_received_high_water = {}; // Size in bytes of the biggest payload that was received in the current quiet period
+    /// @brief Single entry of the sorted topic dispatch table, precomputed once at subscribe time.
+    /// Holds the constant topic prefix an API implementation handles responses on, its precalculated length
+    /// and the API implementation the received message is routed to if the prefix matches
+    struct Topic_Dispatch_Entry {
+        char const *          prefix;        // Constant topic prefix the API implementation handles responses on
+        size_t                prefix_length; // Precalculated length of the topic prefix, so it does not have to be recalculated for every received message
+        IAPI_Implementation * api;           // API implementation the received message is routed to if the topic prefix matches
+    };
+
 #if !THINGSBOARD_ENABLE_DYNAMIC
-    Array<IAPI_Implementation*, MaxEndpointsAmount> m_api_implementations = {}; // Can hold a pointer to all possible API implementations (Server side RPC, Client side RPC, Shared attribute update, Client-side or shared attribute request, Provision)   
+    Array<IAPI_Implementation*, MaxEndpointsAmount> m_api_implementations = {}; // Can hold a pointer to all possible API implementations (Server side RPC, Client side RPC, Shared attribute update, Client-side or shared attribute request, Provision)
+    Array<Topic_Dispatch_Entry, MaxEndpointsAmount> m_dispatch_table = {};      // Topic dispatch table sorted lexicographically by topic prefix, rebuilt whenever the subscribed API implementations change
+    Array<IAPI_Implementation*, MaxEndpointsAmount> m_fallback_api_implementations = {}; // API implementations without a constant topic prefix, compared directly for every received message instead
 #else
     size_t                                          m_max_response_size = {};   // Maximum size allocated on the heap to hold the Json data structure for received cloud response payload, prevents possible malicious payload allocaitng a lot of memory
-    Vector<IAPI_Implementation*>                    m_api_implementations = {}; // Can hold a pointer to all  possible API implementations (Server side RPC, Client side RPC, Shared attribute update, Client-side or shared attribute request, Provision)   
-#endif // !THINGSBOARD_ENABLE_DYNAMIC                
+    TBJsonDocument *                                m_receive_document = {};    // Reusable receive document all received messages are deserialized into, kept allocated at the biggest capacity that was required so far
+    Vector<IAPI_Implementation*>                    m_api_implementations = {}; // Can hold a pointer to all  possible API implementations (Server side RPC, Client side RPC, Shared attribute update, Client-side or shared attribute request, Provision)
+    Vector<Topic_Dispatch_Entry>                    m_dispatch_table = {};      // Topic dispatch table sorted lexicographically by topic prefix, rebuilt whenever the subscribed API implementations change
+    Vector<IAPI_Implementation*>                    m_fallback_api_implementations = {}; // API implementations without a constant topic prefix, compared directly for every received message instead
+#endif // !THINGSBOARD_ENABLE_DYNAMIC
+    bool                                            m_batching_enabled = {};        // Whether coalescing of queued telemetry data points into one combined publish message is currently enabled or not
+    uint16_t                                        m_flush_threshold = {};         // Estimated payload size in bytes at which the queued telemetry is flushed immediately, 0 meaning the threshold is ignored
+    uint64_t                                        m_flush_interval = {};          // Amount of milliseconds after which the queued telemetry is flushed automatically, 0 meaning the interval is ignored
+    size_t                                          m_queued_payload_estimate = {}; // Conservatively estimated serialized payload size of the currently queued telemetry data points
+    Callback_Watchdog                               m_telemetry_flush_timer = {};   // Timer that causes the queued telemetry to be flushed once the configured flush interval has passed
+#if THINGSBOARD_ENABLE_DYNAMIC
+    Vector<Telemetry>                               m_telemetry_queue = {};         // Queued telemetry data points that will be coalesced into one combined publish message on the next flush
+    Vector<Deadband_Rule>                           m_deadband_rules = {};          // Per-key telemetry suppression rules with their last published value cache
+    Vector<Aggregation_Accumulator>                 m_aggregation_accumulators = {}; // Per-key accumulators high-rate samples are downsampled into until the next aggregation flush
+#else
+    Array<Telemetry, MaxQueuedTelemetryAmount>      m_telemetry_queue = {};         // Queued telemetry data points that will be coalesced into one combined publish message on the next flush
+    Array<Deadband_Rule, MaxDeadbandRulesAmount>    m_deadband_rules = {};          // Per-key telemetry suppression rules with their last published value cache
+    Array<Aggregation_Accumulator, MaxAggregatedKeysAmount> m_aggregation_accumulators = {}; // Per-key accumulators high-rate samples are downsampled into until the next aggregation flush
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    bool                                            m_aggregation_enabled = {};     // Whether downsampling of recorded samples into per-key aggregates is currently enabled or not
+    uint64_t                                        m_aggregation_interval = {};    // Amount of milliseconds after which the accumulated aggregates are published automatically, 0 meaning the interval is ignored
+    Callback_Watchdog                               m_aggregation_flush_timer = {}; // Timer that causes the accumulated aggregates to be published once the configured flush interval has passed
+#if THINGSBOARD_ENABLE_WORKER_TASK
+    Worker_Ring_Slot *                              m_worker_ring = {};             // Lock-free ring the producer tasks enqueue telemetry records into for the worker task to publish, allocated in startWorkerTask()
+    size_t                                          m_worker_ring_mask = {};        // Bitmask that maps ring positions to slot indices, ring size - 1 because the ring size is a power of two
+    size_t                                          m_worker_enqueue_position = {}; // Position the next enqueued telemetry record claims its ring slot for, compare and swapped by the producer tasks
+    size_t                                          m_worker_dequeue_position = {}; // Position the worker task dequeues the next telemetry record from, only ever touched by the worker task itself
+    bool                                            m_worker_stop_requested = {};   // Whether the worker task has been requested to drain the remaining records and stop, accessed atomically
+    bool                                            m_worker_task_running = {};     // Whether the worker task is still running, cleared by the worker task itself right before it deletes itself
+    TaskHandle_t                                    m_worker_task = {};             // Handle of the dedicated FreeRTOS task that serializes and publishes the enqueued telemetry records
+#endif // THINGSBOARD_ENABLE_WORKER_TASK
+    uint8_t *                                       m_store_buffer = {};            // RAM ring buffer holding length prefixed serialized telemetry records while the connection to the cloud is lost
+    size_t                                          m_store_capacity = {};          // Size of the store-and-forward RAM ring buffer in bytes
+    size_t                                          m_store_head = {};              // Read position of the oldest stored record in the RAM ring buffer
+    size_t                                          m_store_tail = {};              // Write position for the next stored record in the RAM ring buffer
+    size_t                                          m_store_used = {};              // Amount of bytes of the RAM ring buffer that are currently in use
+    size_t                                          m_store_count = {};             // Amount of records currently stored in the RAM ring buffer
+    ITelemetry_Store *                              m_backing_store = {};           // Optional store implementation that oldest records overflow into once the RAM ring buffer is full
+    char *                                          m_scratch_buffer = {};          // Reusable serialization scratch buffer, lazily grown to the biggest payload that did not fit onto the stack
+    size_t                                          m_scratch_capacity = {};        // Currently allocated size of the scratch buffer in bytes
+    size_t                                          m_scratch_high_water = {};      // Biggest size that was requested from the scratch buffer in the current shrink window
+    size_t                                          m_scratch_uses = {};            // Amount of scratch buffer usages since the shrink policy was last evaluated
 };
 
 #if !THINGSBOARD_ENABLE_STL
 #if !THINGSBOARD_ENABLE_DYNAMIC
-template<size_t MaxResponse, size_t MaxEndpointsAmount, typename Logger>
-ThingsBoardSized<MaxResponse, MaxEndpointsAmount, Logger> *ThingsBoardSized<MaxResponse, MaxEndpointsAmount, Logger>::m_subscribedInstance = nullptr;
+template<size_t MaxResponse, size_t MaxEndpointsAmount, typename Logger, size_t MaxQueuedTelemetryAmount, size_t MaxDeadbandRulesAmount, size_t MaxAggregatedKeysAmount>
+ThingsBoardSized<MaxResponse, MaxEndpointsAmount, Logger, MaxQueuedTelemetryAmount, MaxDeadbandRulesAmount, MaxAggregatedKeysAmount> *ThingsBoardSized<MaxResponse, MaxEndpointsAmount, Logger, MaxQueuedTelemetryAmount, MaxDeadbandRulesAmount, MaxAggregatedKeysAmount>::m_subscribedInstance = nullptr;
 #else
 template<typename Logger>
 ThingsBoardSized<Logger> *ThingsBoardSized<Logger>::m_subscribedInstance = nullptr;
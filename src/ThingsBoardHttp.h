@@ -13,6 +13,11 @@
 #include "Helper.h"
 #include "IHTTP_Client.h"
 #include "DefaultLogger.h"
+#if THINGSBOARD_ENABLE_DYNAMIC
+#include "Vector.h"
+#else
+#include "Array.h"
+#endif // THINGSBOARD_ENABLE_DYNAMIC
 
 
 // HTTP topics.
@@ -26,6 +31,7 @@ int constexpr HTTP_RESPONSE_SUCCESS_RANGE_END = 299;
 char constexpr POST[] = "POST";
 char constexpr GET[] = "GET";
 char constexpr HTTP_FAILED[] = "(%s) failed HTTP response (%d)";
+char constexpr RESPONSE_BODY_TO_LARGE[] = "Response body size (%d) to large for the given buffer size (%u), increase the buffer size accordingly";
 
 
 /// @brief Wrapper around the ArduinoHttpClient or HTTPClient to allow connecting and sending / retrieving data from ThingsBoard over the HTTP orHTTPS protocol.
@@ -33,7 +39,8 @@ char constexpr HTTP_FAILED[] = "(%s) failed HTTP response (%d)";
 /// Changing is only possible if a new instance of this class is created. If theese values should be changeable and dynamic instead.
 /// Simply set THINGSBOARD_ENABLE_DYNAMIC to 1, before including ThingsBoardHttp.h.
 /// @tparam Logger Implementation that should be used to print error messages generated by internal processes and additional debugging messages if THINGSBOARD_ENABLE_DEBUG is set, default = DefaultLogger
-template<typename Logger = DefaultLogger>
+/// @tparam MaxQueuedTelemetryAmount Maximum amount of telemetry key value pairs that can be queued with queueTelemetryData() before the queue is flushed automatically, default = Default_Queued_Telemetry_Amount (16)
+template<typename Logger = DefaultLogger, size_t MaxQueuedTelemetryAmount = Default_Queued_Telemetry_Amount>
 class ThingsBoardHttpSized {
   public:
     /// @brief Initalizes the underlying client with the needed information
@@ -43,12 +50,17 @@ class ThingsBoardHttpSized {
     /// @param access_token Token used to verify the devices identity with the ThingsBoard server
     /// @param host Host server we want to establish a connection to (example: "demo.thingsboard.io")
     /// @param port Port we want to establish a connection over (80 for HTTP, 443 for HTTPS)
-    /// @param keep_alive Attempts to keep the establishes TCP connection alive to make sending data faster
+    /// @param keep_alive Attempts to keep the established TCP connection alive across requests instead of closing it after every single one,
+    /// which makes sending data significantly faster because the TCP setup and on HTTPS the complete TLS handshake is only paid once.
+    /// The connection is then only closed with an explicit call to disconnect() and transparently re-established if it was dropped in the meantime
     /// @param max_stack_size Maximum amount of bytes we want to allocate on the stack, default = Default_Max_Stack_Size
     ThingsBoardHttpSized(IHTTP_Client & client, char const * access_token, char const * host, uint16_t port = 80U, bool keep_alive = true, size_t const & max_stack_size = Default_Max_Stack_Size)
       : m_client(client)
       , m_max_stack(max_stack_size)
       , m_token(access_token)
+      , m_host(host)
+      , m_port(port)
+      , m_keep_alive(keep_alive)
     {
         m_client.set_keep_alive(keep_alive);
         if (m_client.connect(host, port) != 0) {
@@ -56,6 +68,13 @@ class ThingsBoardHttpSized {
         }
     }
 
+    /// @brief Closes the connection to the server and clears any remaining bytes still in the response body.
+    /// Only needed if keep alive is enabled, because the connection is then deliberately kept open across requests
+    /// and this method is the only point it is closed explicitly, a following request simply re-establishes it again
+    void disconnect() {
+        clearConnection();
+    }
+
     /// @brief Sets the maximum amount of bytes that we want to allocate on the stack, before the memory is allocated on the heap instead
     /// @param max_stack_size Maximum amount of bytes we want to allocate on the stack
     void setMaximumStackSize(size_t const & max_stack_size) {
@@ -88,7 +107,7 @@ class ThingsBoardHttpSized {
                 Logger::printfln(UNABLE_TO_SERIALIZE_JSON);
             }
             else {
-                result = Send_Json_String(topic, json);
+                result = Send_Json_String(topic, json, json_size - 1);
             }
             // Ensure to actually delete the memory placed onto the heap, to make sure we do not create a memory leak
             // and set the pointer to null so we do not have a dangling reference.
@@ -101,7 +120,7 @@ class ThingsBoardHttpSized {
                 Logger::printfln(UNABLE_TO_SERIALIZE_JSON);
                 return result;
             }
-            result = Send_Json_String(topic, json);
+            result = Send_Json_String(topic, json, json_size - 1);
         }
         return result;
     }
@@ -111,13 +130,27 @@ class ThingsBoardHttpSized {
     /// @param json String containing our json key value pairs we want to attempt to send
     /// @return Whether sending the data was successful or not
     bool Send_Json_String(char const * topic, char const * json) {
+        if (json == nullptr) {
+            return false;
+        }
+        return Send_Json_String(topic, json, strlen(json));
+    }
+
+    /// @brief Attempts to send custom json string of the given size over the given topic to the server.
+    /// Overload that receives the already measured size of the json string,
+    /// so the underlying client does not have to measure the payload again before it is sent
+    /// @param topic Topic we want to send the data over
+    /// @param json String containing our json key value pairs we want to attempt to send
+    /// @param json_size Size of the json string in bytes, not including a possible null terminator
+    /// @return Whether sending the data was successful or not
+    bool Send_Json_String(char const * topic, char const * json, size_t const & json_size) {
         if (json == nullptr || m_token == nullptr) {
             return false;
         }
 
         char path[Helper::detectSize(topic, m_token)] = {};
         (void)snprintf(path, sizeof(path), topic, m_token);
-        return postMessage(path, json);
+        return postMessage(path, json, json_size);
     }
 
     //----------------------------------------------------------------------------
@@ -175,6 +208,87 @@ class ThingsBoardHttpSized {
         return Send_Json(HTTP_TELEMETRY_TOPIC, source, json_size);
     }
 
+    //----------------------------------------------------------------------------
+    // Telemetry batching API
+
+    /// @brief Enables coalescing of single telemetry data points queued with queueTelemetryData() into one combined POST request body.
+    /// Hugely reduces the amount of sent requests and therefore the HTTP header, TCP and on HTTPS the TLS overhead,
+    /// which dominates the cost of a single data point on HTTP even more than the MQTT envelope does, at the cost of the data arriving on the cloud slightly delayed.
+    /// The queue is flushed automatically once the estimated payload size exceeds the given byte threshold or once the given interval has passed, whichever happens first.
+    /// Because this class has no loop() method that could poll a software timer and a flush from a timer task would race the blocking HTTP client,
+    /// the interval is instead checked whenever a data point is queued, meaning an expired interval only causes a flush on the next queueTelemetryData() call
+    /// @param flush_threshold_bytes Estimated serialized payload size in bytes at which the queue is flushed immediately,
+    /// pass 0 if the queue should only ever be flushed because of the passed interval, default = DEFAULT_FLUSH_THRESHOLD_BYTES (0)
+    /// @param flush_interval_ms Amount of milliseconds after which the queued telemetry is flushed, even if the byte threshold has not been reached yet,
+    /// pass 0 if the queue should only ever be flushed because of the byte threshold or manual calls to flushTelemetry(), default = DEFAULT_FLUSH_INTERVAL_MS (1000)
+    void enableTelemetryBatching(uint16_t flush_threshold_bytes = DEFAULT_FLUSH_THRESHOLD_BYTES, uint64_t const & flush_interval_ms = DEFAULT_FLUSH_INTERVAL_MS) {
+        m_flush_threshold = flush_threshold_bytes;
+        m_flush_interval = flush_interval_ms;
+        m_batching_enabled = true;
+        m_last_flush_time = Helper::getUptimeMilliseconds();
+    }
+
+    /// @brief Disables the previously with enableTelemetryBatching() enabled coalescing of telemetry data points,
+    /// any still queued telemetry is flushed beforehand so no queued data points are lost
+    void disableTelemetryBatching() {
+        m_batching_enabled = false;
+        (void)flushTelemetry();
+    }
+
+    /// @brief Queues telemetry data with the given key and value of the given type, to be sent as one combined POST request with other queued data points.
+    /// Expects enableTelemetryBatching() to have been called beforehand, if it was not the data is simply sent immediately with sendTelemetryData() instead.
+    /// Be aware that queueing the same key twice before a flush occured, results in the previously queued value being overwritten on the cloud side,
+    /// because both values are serialized into the same json object. If multiple values of the same key should arrive ensure to call flushTelemetry() in between
+    /// @tparam T Type of the passed value
+    /// @param key Key of the key value pair we want to queue, requires to stay allocated until the queue has been flushed
+    /// @param value Value of the key value pair we want to queue
+    /// @return Whether queueing (or if a flush was caused, sending) the data was successful or not
+    template<typename T>
+    bool queueTelemetryData(char const * key, T const & value) {
+        if (!m_batching_enabled) {
+            return sendTelemetryData(key, value);
+        }
+        Telemetry const t(key, value);
+        if (t.IsEmpty()) {
+            return false;
+        }
+#if !THINGSBOARD_ENABLE_DYNAMIC
+        // Queue is full, flush the already queued data points to make space for the new one instead of discarding it
+        if (m_telemetry_queue.size() + 1 > m_telemetry_queue.capacity()) {
+            (void)flushTelemetry();
+        }
+#endif // !THINGSBOARD_ENABLE_DYNAMIC
+        m_telemetry_queue.push_back(t);
+        // Serialized size is only estimated conservatively instead of actually serializing the queued data points on every insert,
+        // because serializing would cost the CPU time we are trying to save by batching in the first place
+        m_queued_payload_estimate += strlen(key) + MAX_SERIALIZED_VALUE_SIZE;
+        if (m_flush_threshold != 0U && m_queued_payload_estimate >= m_flush_threshold) {
+            return flushTelemetry();
+        }
+        if (m_flush_interval != 0U && Helper::getUptimeMilliseconds() - m_last_flush_time >= m_flush_interval) {
+            return flushTelemetry();
+        }
+        return true;
+    }
+
+    /// @brief Immediately sends all currently queued telemetry data points as one combined POST request and clears the queue.
+    /// Is called automatically once the configured byte threshold or flush interval of enableTelemetryBatching() has been exceeded
+    /// @return Whether sending the queued telemetry data was successful or not, if the queue was empty there is nothing to do and we return true
+    bool flushTelemetry() {
+        m_last_flush_time = Helper::getUptimeMilliseconds();
+        if (m_telemetry_queue.empty()) {
+            return true;
+        }
+#if THINGSBOARD_ENABLE_DYNAMIC
+        bool const result = sendTelemetry(m_telemetry_queue.begin(), m_telemetry_queue.end());
+#else
+        bool const result = sendTelemetry<MaxQueuedTelemetryAmount>(m_telemetry_queue.begin(), m_telemetry_queue.end());
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+        m_telemetry_queue.clear();
+        m_queued_payload_estimate = 0U;
+        return result;
+    }
+
     /// @brief Attempts to send a GET request over HTTP or HTTPS
     /// @param path API path we want to get data from (example: /api/v1/$TOKEN/rpc)
     /// @param response String the GET response will be copied into,
@@ -188,12 +302,27 @@ class ThingsBoardHttpSized {
         return getMessage(path, response);
     }
 
+    /// @brief Attempts to send a GET request over HTTP or HTTPS and reads the response body directly into the given caller allocated buffer.
+    /// Overload that requires neither a heap allocation nor a copy of the complete response,
+    /// because the body is streamed into the given buffer instead of being returned as a string object
+    /// @param path API path we want to get data from (example: /api/v1/$TOKEN/rpc)
+    /// @param response_buffer Caller allocated buffer the response body is copied into and null terminated,
+    /// only contains the complete response body if the GET request was successful
+    /// @param response_buffer_size Maximum amount of bytes that can be written into the given buffer, including the null terminator
+    /// @return Whether sending the GET request was successful or not
+    bool sendGetRequest(char const * path, char * response_buffer, size_t const & response_buffer_size) {
+        return getMessage(path, response_buffer, response_buffer_size);
+    }
+
     /// @brief Attempts to send a POST request over HTTP or HTTPS
     /// @param path API path we want to send data to (example: /api/v1/$TOKEN/attributes)
     /// @param json String containing our json key value pairs we want to attempt to send
     /// @return Whetherr sending the POST request was successful or not
     bool sendPostRequest(char const * path, char const * json) {
-        return postMessage(path, json);
+        if (json == nullptr) {
+            return false;
+        }
+        return postMessage(path, json, strlen(json));
     }
 
     //----------------------------------------------------------------------------
@@ -264,12 +393,50 @@ class ThingsBoardHttpSized {
         m_client.stop();
     }
 
+    /// @brief Re-establishes the connection to the server after it was closed or dropped,
+    /// used to transparently recover a kept alive connection that the server or the network closed in the meantime
+    /// @return Whether re-establishing the connection was successful or not
+    bool reestablishConnection() {
+        clearConnection();
+        if (m_client.connect(m_host, m_port) != 0) {
+            Logger::printfln(CONNECT_FAILED);
+            return false;
+        }
+        return true;
+    }
+
+    /// @brief Finishes the current request and prepares the connection for the next one.
+    /// If keep alive is disabled or the request failed the connection is simply closed, a failed request additionally ensures
+    /// a possibly poisoned session (half received response, dropped connection) is not reused for the following request.
+    /// If keep alive is enabled and the request succeeded the connection is deliberately kept open instead,
+    /// only the remaining response body is drained, because leftover bytes would otherwise be parsed as part of the next response
+    /// @param success Whether the finished request was successful or not
+    void finishRequest(bool success) {
+        if (!m_keep_alive || !success) {
+            clearConnection();
+            return;
+        }
+        // Drain the remaining response body in small chunks instead of with get_response_body(),
+        // which would heap allocate and copy the complete body just to discard it again
+        uint8_t drain_buffer[Default_Payload_Size] = {};
+        while (m_client.read_response_body(drain_buffer, sizeof(drain_buffer)) != 0U) {
+            // Nothing to do
+        }
+    }
+
     /// @brief Attempts to send a POST request over HTTP or HTTPS
     /// @param path API path we want to send data to (example: /api/v1/$TOKEN/attributes)
     /// @param json String containing our json key value pairs we want to attempt to send
+    /// @param json_size Size of the json string in bytes, not including a possible null terminator
     /// @return Whetherr sending the POST request was successful or not
-    bool postMessage(char const * path, char const * json) {
-        bool success = m_client.post(path, HTTP_POST_PATH, json) == 0;
+    bool postMessage(char const * path, char const * json, size_t const & json_size) {
+        int result = m_client.post(path, HTTP_POST_PATH, reinterpret_cast<uint8_t const *>(json), json_size);
+        // A transport error on a kept alive connection usually means the server or the network dropped it in the meantime,
+        // the connection is re-established transparently and the request retried once before a failure is reported
+        if (result != 0 && m_keep_alive && reestablishConnection()) {
+            result = m_client.post(path, HTTP_POST_PATH, reinterpret_cast<uint8_t const *>(json), json_size);
+        }
+        bool success = result == 0;
         int const status = m_client.get_response_status_code();
 
         if (!success || status < HTTP_RESPONSE_SUCCESS_RANGE_START || status > HTTP_RESPONSE_SUCCESS_RANGE_END) {
@@ -277,7 +444,7 @@ class ThingsBoardHttpSized {
             success = false;
         }
 
-        clearConnection();
+        finishRequest(success);
         return success;
     }
 
@@ -291,18 +458,78 @@ class ThingsBoardHttpSized {
 #else
     bool getMessage(char const * path, String& response) {
 #endif // THINGSBOARD_ENABLE_STL
-        bool success = m_client.get(path);
+        int result = m_client.get(path);
+        // A transport error on a kept alive connection usually means the server or the network dropped it in the meantime,
+        // the connection is re-established transparently and the request retried once before a failure is reported
+        if (result != 0 && m_keep_alive && reestablishConnection()) {
+            result = m_client.get(path);
+        }
+        bool success = result == 0;
         int const status = m_client.get_response_status_code();
 
         if (!success || status < HTTP_RESPONSE_SUCCESS_RANGE_START || status > HTTP_RESPONSE_SUCCESS_RANGE_END) {
             Logger::printfln(HTTP_FAILED, GET, status);
             success = false;
-            goto cleanup;
         }
-        response = m_client.get_response_body();
+        else {
+            // Reading the response body additionally drains the connection, meaning it can be reused for the next request directly
+            response = m_client.get_response_body();
+        }
 
-        cleanup:
-        clearConnection();
+        if (!m_keep_alive || !success) {
+            clearConnection();
+        }
+        return success;
+    }
+
+    /// @brief Attempts to send a GET request over HTTP or HTTPS and reads the response body directly into the given caller allocated buffer
+    /// @param path API path we want to get data from (example: /api/v1/$TOKEN/rpc)
+    /// @param response_buffer Caller allocated buffer the response body is copied into and null terminated,
+    /// only contains the complete response body if the GET request was successful
+    /// @param response_buffer_size Maximum amount of bytes that can be written into the given buffer, including the null terminator
+    /// @return Whether sending the GET request was successful or not
+    bool getMessage(char const * path, char * response_buffer, size_t const & response_buffer_size) {
+        if (response_buffer == nullptr || response_buffer_size == 0U) {
+            return false;
+        }
+        int result = m_client.get(path);
+        // A transport error on a kept alive connection usually means the server or the network dropped it in the meantime,
+        // the connection is re-established transparently and the request retried once before a failure is reported
+        if (result != 0 && m_keep_alive && reestablishConnection()) {
+            result = m_client.get(path);
+        }
+        bool success = result == 0;
+        int const status = m_client.get_response_status_code();
+
+        if (!success || status < HTTP_RESPONSE_SUCCESS_RANGE_START || status > HTTP_RESPONSE_SUCCESS_RANGE_END) {
+            Logger::printfln(HTTP_FAILED, GET, status);
+            success = false;
+        }
+        else {
+            int const body_length = m_client.get_response_body_length();
+            // Response body has to fit into the given buffer including the null terminator, because a partially read body
+            // would leave its remaining bytes on the connection and poison the following response
+            if (body_length < 0 || static_cast<size_t>(body_length) >= response_buffer_size) {
+                Logger::printfln(RESPONSE_BODY_TO_LARGE, body_length, response_buffer_size);
+                success = false;
+            }
+            else {
+                size_t read_bytes = 0U;
+                while (read_bytes < static_cast<size_t>(body_length)) {
+                    size_t const chunk = m_client.read_response_body(reinterpret_cast<uint8_t *>(response_buffer) + read_bytes, body_length - read_bytes);
+                    if (chunk == 0U) {
+                        break;
+                    }
+                    read_bytes += chunk;
+                }
+                response_buffer[read_bytes] = '\0';
+                success = read_bytes == static_cast<size_t>(body_length);
+            }
+        }
+
+        if (!m_keep_alive || !success) {
+            clearConnection();
+        }
         return success;
     }
 
@@ -372,9 +599,22 @@ class ThingsBoardHttpSized {
         return telemetry ? sendTelemetryJson(json_buffer, Helper::Measure_Json(json_buffer)) : sendAttributeJson(json_buffer, Helper::Measure_Json(json_buffer));
     }
 
-    IHTTP_Client& m_client = {};     // HttpClient instance
-    size_t        m_max_stack = {};  // Maximum stack size we allocate at once on the stack.
-    char const    *m_token = {};     // Access token used to connect with
+    IHTTP_Client& m_client = {};                  // HttpClient instance
+    size_t        m_max_stack = {};               // Maximum stack size we allocate at once on the stack.
+    char const    *m_token = {};                  // Access token used to connect with
+    char const    *m_host = {};                   // Host the connection is established to, kept to transparently re-establish a dropped connection
+    uint16_t      m_port = {};                    // Port the connection is established over, kept to transparently re-establish a dropped connection
+    bool          m_keep_alive = {};              // Whether the connection is kept open across requests or closed after every single one
+    bool          m_batching_enabled = {};        // Whether coalescing of queued telemetry data points into one combined POST request is currently enabled or not
+    uint16_t      m_flush_threshold = {};         // Estimated payload size in bytes at which the queued telemetry is flushed immediately, 0 meaning the threshold is ignored
+    uint64_t      m_flush_interval = {};          // Amount of milliseconds after which the queued telemetry is flushed, checked at queue time, 0 meaning the interval is ignored
+    uint64_t      m_last_flush_time = {};         // Uptime in milliseconds the queued telemetry was last flushed at, used to check the flush interval whenever a data point is queued
+    size_t        m_queued_payload_estimate = {}; // Conservatively estimated serialized payload size of the currently queued telemetry data points
+#if THINGSBOARD_ENABLE_DYNAMIC
+    Vector<Telemetry> m_telemetry_queue = {};     // Queued telemetry data points that will be coalesced into one combined POST request on the next flush
+#else
+    Array<Telemetry, MaxQueuedTelemetryAmount> m_telemetry_queue = {}; // Queued telemetry data points that will be coalesced into one combined POST request on the next flush
+#endif // THINGSBOARD_ENABLE_DYNAMIC
 };
 
 using ThingsBoardHttp = ThingsBoardHttpSized<>;
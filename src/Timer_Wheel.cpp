@@ -0,0 +1,183 @@
+// Header include.
+#include "Timer_Wheel.h"
+
+#if THINGSBOARD_USE_ESP_TIMER
+
+constexpr char TIMER_WHEEL_NAME[] = "timer_wheel";
+// Sentinel index that marks the end of a bucket or the free list, or that an entry is not linked anywhere
+constexpr uint16_t ENTRY_UNUSED = 0xFFFFU;
+// Mask the expiry tick is mapped to its bucket with, works because the bucket count is a power of two
+constexpr uint64_t BUCKET_MASK = TIMER_WHEEL_BUCKET_COUNT - 1U;
+
+Timer_Wheel & Timer_Wheel::instance() {
+    static Timer_Wheel wheel;
+    return wheel;
+}
+
+uint32_t Timer_Wheel::arm(uint64_t const & timeout_microseconds, void (*callback)(void * argument), void * argument) {
+    if (callback == nullptr || !initialize()) {
+        return 0U;
+    }
+    // Round the timeout up to the next full tick, a deadline always has to expire at least one tick in the future,
+    // because the bucket the current tick maps to has already been processed for this revolution
+    uint64_t ticks = (timeout_microseconds + TIMER_WHEEL_TICK_MICROSECONDS - 1U) / TIMER_WHEEL_TICK_MICROSECONDS;
+    if (ticks == 0U) {
+        ticks = 1U;
+    }
+
+    taskENTER_CRITICAL(&m_lock);
+    uint16_t const entry_index = m_free_head;
+    if (entry_index == ENTRY_UNUSED) {
+        taskEXIT_CRITICAL(&m_lock);
+        return 0U;
+    }
+    Wheel_Entry & entry = m_entries[entry_index];
+    m_free_head = entry.next;
+
+    entry.callback = callback;
+    entry.argument = argument;
+    entry.expire_tick = m_current_tick + ticks;
+    entry.armed = true;
+    // Link the entry to the front of the bucket its expiry tick hashes to
+    uint16_t const bucket = static_cast<uint16_t>(entry.expire_tick & BUCKET_MASK);
+    entry.next = m_buckets[bucket];
+    entry.prev = ENTRY_UNUSED;
+    if (m_buckets[bucket] != ENTRY_UNUSED) {
+        m_entries[m_buckets[bucket]].prev = entry_index;
+    }
+    m_buckets[bucket] = entry_index;
+    m_armed_count++;
+
+    uint32_t const handle = (static_cast<uint32_t>(entry.generation) << 16U) | (entry_index + 1U);
+    taskEXIT_CRITICAL(&m_lock);
+    return handle;
+}
+
+void Timer_Wheel::cancel(uint32_t const & handle) {
+    if (handle == 0U || !m_initialized) {
+        return;
+    }
+    uint16_t const entry_index = static_cast<uint16_t>(handle & 0xFFFFU) - 1U;
+    uint16_t const generation = static_cast<uint16_t>(handle >> 16U);
+    if (entry_index >= TIMER_WHEEL_CAPACITY) {
+        return;
+    }
+
+    taskENTER_CRITICAL(&m_lock);
+    Wheel_Entry & entry = m_entries[entry_index];
+    // A differing generation means the handle is stale, because the deadline has already fired or been cancelled
+    // and the entry has possibly been claimed for a completly different deadline since
+    if (!entry.armed || entry.generation != generation) {
+        taskEXIT_CRITICAL(&m_lock);
+        return;
+    }
+    free_entry(entry_index);
+    m_armed_count--;
+    taskEXIT_CRITICAL(&m_lock);
+}
+
+bool Timer_Wheel::initialize() {
+    if (m_initialized) {
+        return true;
+    }
+
+    m_entries = new Wheel_Entry[TIMER_WHEEL_CAPACITY];
+    if (m_entries == nullptr) {
+        return false;
+    }
+    // Initially every entry is part of the free list and every bucket is empty
+    for (uint16_t entry_index = 0U; entry_index < TIMER_WHEEL_CAPACITY; entry_index++) {
+        m_entries[entry_index].next = (entry_index + 1U < TIMER_WHEEL_CAPACITY) ? (entry_index + 1U) : ENTRY_UNUSED;
+        m_entries[entry_index].prev = ENTRY_UNUSED;
+        m_entries[entry_index].generation = 0U;
+        m_entries[entry_index].armed = false;
+    }
+    m_free_head = 0U;
+    for (uint16_t bucket = 0U; bucket < TIMER_WHEEL_BUCKET_COUNT; bucket++) {
+        m_buckets[bucket] = ENTRY_UNUSED;
+    }
+
+    const esp_timer_create_args_t tick_timer_args = {
+        .callback = &Timer_Wheel::static_tick,
+        .arg = this,
+        .dispatch_method = esp_timer_dispatch_t::ESP_TIMER_TASK,
+        .name = TIMER_WHEEL_NAME,
+        .skip_unhandled_events = true
+    };
+    if (esp_timer_create(&tick_timer_args, &m_tick_timer) != ESP_OK) {
+        delete[] m_entries;
+        m_entries = nullptr;
+        return false;
+    }
+    (void)esp_timer_start_periodic(m_tick_timer, TIMER_WHEEL_TICK_MICROSECONDS);
+    m_initialized = true;
+    return true;
+}
+
+void Timer_Wheel::free_entry(uint16_t entry_index) {
+    Wheel_Entry & entry = m_entries[entry_index];
+    // Unlink the entry from its bucket, the doubly linked neighbours make this possible without traversing the bucket
+    if (entry.prev != ENTRY_UNUSED) {
+        m_entries[entry.prev].next = entry.next;
+    }
+    else {
+        m_buckets[entry.expire_tick & BUCKET_MASK] = entry.next;
+    }
+    if (entry.next != ENTRY_UNUSED) {
+        m_entries[entry.next].prev = entry.prev;
+    }
+    // Bump the generation so handles that still point to this entry are detected as stale and return it to the free list
+    entry.generation++;
+    entry.armed = false;
+    entry.prev = ENTRY_UNUSED;
+    entry.next = m_free_head;
+    m_free_head = entry_index;
+}
+
+void Timer_Wheel::tick() {
+    taskENTER_CRITICAL(&m_lock);
+    m_current_tick++;
+    uint64_t const current_tick = m_current_tick;
+    bool const wheel_empty = (m_armed_count == 0U);
+    taskEXIT_CRITICAL(&m_lock);
+    if (wheel_empty) {
+        return;
+    }
+
+    // Expired deadlines are searched and freed one at a time under the critical section, but their callbacks are called outside of it.
+    // The bucket is traversed from its head again for every expired deadline, because the callback might have armed or cancelled
+    // other deadlines in the same bucket in the meantime, entries that expire one or more bucket revolutions later are simply skipped
+    while (true) {
+        void (*expired_callback)(void * argument) = nullptr;
+        void * expired_argument = nullptr;
+
+        taskENTER_CRITICAL(&m_lock);
+        uint16_t entry_index = m_buckets[current_tick & BUCKET_MASK];
+        while (entry_index != ENTRY_UNUSED) {
+            Wheel_Entry & entry = m_entries[entry_index];
+            if (entry.expire_tick <= current_tick) {
+                expired_callback = entry.callback;
+                expired_argument = entry.argument;
+                free_entry(entry_index);
+                m_armed_count--;
+                break;
+            }
+            entry_index = entry.next;
+        }
+        taskEXIT_CRITICAL(&m_lock);
+
+        if (expired_callback == nullptr) {
+            return;
+        }
+        expired_callback(expired_argument);
+    }
+}
+
+void Timer_Wheel::static_tick(void * instance) {
+    if (instance == nullptr) {
+        return;
+    }
+    static_cast<Timer_Wheel *>(instance)->tick();
+}
+
+#endif // THINGSBOARD_USE_ESP_TIMER
@@ -0,0 +1,101 @@
+#ifndef Timer_Wheel_h
+#define Timer_Wheel_h
+
+// Local include.
+#include "Configuration.h"
+
+#if THINGSBOARD_USE_ESP_TIMER
+
+// Library includes.
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <stdint.h>
+#include <stddef.h>
+
+
+// Resolution of the shared wheel tick in microseconds, every armed deadline is rounded up to the next full tick.
+// The used timeouts (chunk requests, attribute requests, client-side rpc) are all in the range of seconds,
+// meaning a coarse tick keeps the periodic timer overhead negligible without measurably changing when a timeout fires
+uint64_t constexpr TIMER_WHEEL_TICK_MICROSECONDS = 100U * 1000U;
+// Amount of buckets the deadlines are hashed into, has to be a power of two because ticks are mapped to buckets with a bitwise and
+uint16_t constexpr TIMER_WHEEL_BUCKET_COUNT = 64U;
+// Amount of deadlines that can be armed simultaneously, entries are lazily allocated once on the first armed deadline.
+// If all entries are in use arming fails and the caller falls back to its own dedicated timer instead
+uint16_t constexpr TIMER_WHEEL_CAPACITY = 256U;
+
+
+/// @brief Shared timer service that multiplexes all pending timeout deadlines onto one single periodic esp timer.
+/// Every pending request watchdog previously created, armed and disarmed its own kernel timer object,
+/// which churns one create/arm/disarm cycle per request and pressures the timer task with one object per in-flight request.
+/// Instead this class keeps a hashed timing wheel of deadlines: arming claims an entry from a free list and links it into the bucket
+/// its expiry tick hashes to, cancelling unlinks it again, both in constant time and without any allocation,
+/// and a single periodic tick only traverses the one bucket the current tick maps to.
+/// The periodic tick timer is created and started once on the first armed deadline and simply kept running from then on,
+/// because a tick without any expired deadline only checks one bucket and costs next to nothing,
+/// while starting and stopping it with the armed amount would require synchronizing the timer state across tasks as well.
+/// Arming, cancelling and the tick synchronize with a critical section, because deadlines are armed from any task
+/// while the tick runs in the esp timer task, the registered callbacks themselves are called outside of the critical section
+class Timer_Wheel {
+  public:
+    /// @brief Returns the single shared wheel instance all timeout deadlines are multiplexed onto
+    /// @return Reference to the shared wheel instance
+    static Timer_Wheel & instance();
+
+    /// @brief Arms a new timeout deadline, the given callback is called from the esp timer task once the timeout has passed without the deadline being cancelled
+    /// @param timeout_microseconds Amount of microseconds until the given callback is called, rounded up to the next full wheel tick
+    /// @param callback Callback method that is called once the timeout has passed, is expected to handle a nullptr argument gracefully
+    /// @param argument Argument the callback is called with
+    /// @return Handle the armed deadline can be cancelled with, or 0 if the wheel is exhausted and the caller has to fall back to its own dedicated timer
+    uint32_t arm(uint64_t const & timeout_microseconds, void (*callback)(void * argument), void * argument);
+
+    /// @brief Cancels a previously armed timeout deadline and ensures its callback is not called.
+    /// Cancelling a handle whose deadline has already fired or been cancelled is detected through the contained generation and simply does nothing
+    /// @param handle Handle of the armed deadline that was returned by arm()
+    void cancel(uint32_t const & handle);
+
+  private:
+    /// @brief Single entry of the wheel, links the armed deadline into the bucket its expiry tick hashes to.
+    /// Unused entries are linked into the free list through the next index instead
+    struct Wheel_Entry {
+        void     (*callback)(void * argument); // Callback method that is called once the deadline expires
+        void     *argument;                    // Argument the callback is called with
+        uint64_t expire_tick;                  // Wheel tick the deadline expires on, compared against the current tick because the wheel can hold deadlines further away than one full bucket revolution
+        uint16_t next;                         // Index of the next entry in the same bucket or the free list, or ENTRY_UNUSED if this is the last one
+        uint16_t prev;                         // Index of the previous entry in the same bucket, allows unlinking a cancelled deadline in constant time
+        uint16_t generation;                   // Incremented every time the entry is freed, lets a stale handle of an already fired or cancelled deadline be detected
+        bool     armed;                        // Whether the entry currently holds an armed deadline or is part of the free list
+    };
+
+    Timer_Wheel() = default;
+
+    /// @brief Lazily allocates the entry pool and creates the periodic tick timer, has to be done once before the first deadline is armed.
+    /// It can not be done in the constructor, because the shared instance might be constructed before the esp timer base is initalized yet
+    /// @return Whether the wheel is ready to arm deadlines or the allocation or timer creation failed
+    bool initialize();
+
+    /// @brief Unlinks the given entry from its bucket and returns it to the free list, has to be called with the critical section held
+    /// @param entry_index Index of the entry that should be freed
+    void free_entry(uint16_t entry_index);
+
+    /// @brief Advances the wheel by one tick and calls the callbacks of all deadlines that expired on it.
+    /// Only traverses the single bucket the current tick maps to, entries in it that expire one or more bucket revolutions later are simply skipped.
+    /// Expired entries are freed under the critical section, but their callbacks are called outside of it,
+    /// because the callbacks publish messages and must not run with the scheduler disabled
+    void tick();
+
+    static void static_tick(void * instance);
+
+    Wheel_Entry        *m_entries = {};                                  // Lazily allocated pool of entries the armed deadlines are stored in, entries are claimed from and returned to the free list
+    uint16_t           m_buckets[TIMER_WHEEL_BUCKET_COUNT] = {};         // Index of the first entry in each bucket, deadlines are hashed into buckets by their expiry tick
+    uint16_t           m_free_head = {};                                 // Index of the first entry in the free list, or ENTRY_UNUSED if all entries are armed
+    uint64_t           m_current_tick = {};                              // Tick the wheel has currently advanced to, incremented by the periodic timer while at least one deadline is armed
+    size_t             m_armed_count = {};                               // Amount of currently armed deadlines, only kept for debugging and to cheaply skip ticks while the wheel is completly empty
+    bool               m_initialized = {};                               // Whether the entry pool has been allocated and the periodic tick timer has been created yet
+    esp_timer_handle_t m_tick_timer = {};                                // Single shared periodic ESP Timer handle that drives the wheel for all armed deadlines
+    portMUX_TYPE       m_lock = portMUX_INITIALIZER_UNLOCKED;            // Critical section that synchronizes arming and cancelling from any task with the tick in the esp timer task
+};
+
+#endif // THINGSBOARD_USE_ESP_TIMER
+
+#endif // Timer_Wheel_h
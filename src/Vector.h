@@ -1,8 +1,9 @@
 #ifndef Vector_h
 #define Vector_h
 
-// Local include.
+// Local includes.
 #include "Helper.h"
+#include "Memory_Metrics.h"
 
 // Library includes.
 #include <assert.h>
@@ -50,6 +51,9 @@ class Vector {
 
     /// @brief Destructor
     ~Vector() {
+        if (m_elements != nullptr) {
+            Memory_Metrics::record_deallocation(Memory_Subsystem::VECTOR, m_capacity * sizeof(T));
+        }
         delete[] m_elements;
         m_elements = nullptr;
     }
@@ -94,6 +98,16 @@ class Vector {
         return m_capacity;
     }
 
+    /// @brief Ensures the underlying data container can hold at least the given amount of elements before it has to grow again.
+    /// Allows to allocate the needed capacity once up front, instead of the container having to reallocate and relocate
+    /// all already inserted elements multiple times while it grows towards the required size
+    /// @param new_capacity Amount of elements the underlying data container should be able to hold at least
+    void reserve(size_t const & new_capacity) {
+        if (new_capacity > m_capacity) {
+            Grow(new_capacity);
+        }
+    }
+
     /// @brief Returns a iterator to the first element of the underlying data container
     /// @return Iterator pointing to the first element of the underlying data container
     T * begin() {
@@ -137,28 +151,46 @@ class Vector {
         return m_elements + m_size;
     }
 
-    /// @brief Inserts the given element at the end of the underlying data container,
-    /// If the interal data structure is full already then this method will assert and stop the application.
-    /// Because if we do not we could cause an out of bounds write, which could possibly overwrite other memory.
-    /// Causing hard to debug issues, therefore this behaviour is not allowed in the first place
+    /// @brief Inserts a copy of the given element at the end of the underlying data container,
+    /// grows the underlying data container with doubled capacity beforehand if it is full already
     /// @param element Element that should be inserted at the end
     void push_back(T const & element) {
         if (m_size == m_capacity) {
-            m_capacity = (m_capacity == 0) ? 1 : 2 * m_capacity;
-            T* new_elements = new T[m_capacity]();
-            if (m_elements != nullptr) {
-                memcpy(new_elements, m_elements, m_size * sizeof(T));
-                delete[] m_elements;
-            }
-            m_elements = new_elements;
+            Grow((m_capacity == 0) ? 1 : 2 * m_capacity);
         }
         m_elements[m_size] = element;
         m_size++;
     }
 
+    /// @brief Inserts the given element at the end of the underlying data container by moving it,
+    /// leaves the passed element in a valid but unspecified state instead of copying its contents.
+    /// Grows the underlying data container with doubled capacity beforehand if it is full already
+    /// @param element Element that should be moved to the end
+    void push_back(T && element) {
+        if (m_size == m_capacity) {
+            Grow((m_capacity == 0) ? 1 : 2 * m_capacity);
+        }
+        m_elements[m_size] = static_cast<T&&>(element);
+        m_size++;
+    }
+
+    /// @brief Constructs an element at the end of the underlying data container directly from the given constructor arguments,
+    /// removing the temporary copy push_back would require when the element does not exist yet.
+    /// Grows the underlying data container with doubled capacity beforehand if it is full already
+    /// @tparam ...Args Holds the multiple arguments that are simply forwarded to the constructor of the element type
+    /// @param ...args Arguments the inserted element should be constructed with
+    template<typename... Args>
+    void emplace_back(Args &&... args) {
+        if (m_size == m_capacity) {
+            Grow((m_capacity == 0) ? 1 : 2 * m_capacity);
+        }
+        m_elements[m_size] = T(static_cast<Args&&>(args)...);
+        m_size++;
+    }
+
     /// @brief Inserts all element from the given start to the given end iterator into the underlying data container.
-    /// Simply calls push_back on each element, meaning if the initally allocated size if not big enough to hold all elements,
-    /// then this method will simply not insert those elements instead
+    /// Reserves enough capacity for all inserted elements up front, so the underlying data container grows at most once,
+    /// instead of possibly reallocating and relocating the already inserted elements multiple times
     /// @tparam InputIterator Class that points to the begin and end iterator
     /// of the given data container, allows for using / passing either std::vector or std::array.
     /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
@@ -167,6 +199,7 @@ class Vector {
     /// @param last Iterator pointing to one past the end of the elements we want to copy into our underlying data container
     template<typename InputIterator>
     void insert(T const * position, InputIterator const & first, InputIterator const & last) {
+        reserve(m_size + Helper::distance(first, last));
         for (auto it = first; it != last; ++it) {
             push_back(*it);
         }
@@ -184,7 +217,7 @@ class Vector {
         if (index < m_size) {
             // Move all elements after the index one position to the left
             for (size_t i = index; i < m_size - 1; ++i) {
-                m_elements[i] = m_elements[i + 1];
+                m_elements[i] = static_cast<T&&>(m_elements[i + 1]);
             }
             // Decrease the size of the vector to remove the last element, because either it was moved one index to the left or was the element we wanted to delete
             m_size--;
@@ -220,6 +253,29 @@ class Vector {
     }
 
   private:
+    /// @brief Grows the underlying data container to the given capacity and relocates all already inserted elements into it.
+    /// Trivially copyable element types are relocated with one single memcpy, all other types are moved element by element,
+    /// so element types that own resources (heap allocations, handles) hand them over instead of copying them on every grow
+    /// @param new_capacity Amount of elements the newly allocated underlying data container should be able to hold
+    void Grow(size_t const & new_capacity) {
+        T* new_elements = new T[new_capacity]();
+        Memory_Metrics::record_allocation(Memory_Subsystem::VECTOR, new_capacity * sizeof(T));
+        if (m_elements != nullptr) {
+            if (__is_trivially_copyable(T)) {
+                memcpy(static_cast<void*>(new_elements), static_cast<void const*>(m_elements), m_size * sizeof(T));
+            }
+            else {
+                for (size_t i = 0; i < m_size; ++i) {
+                    new_elements[i] = static_cast<T&&>(m_elements[i]);
+                }
+            }
+            delete[] m_elements;
+            Memory_Metrics::record_deallocation(Memory_Subsystem::VECTOR, m_capacity * sizeof(T));
+        }
+        m_elements = new_elements;
+        m_capacity = new_capacity;
+    }
+
     T      *m_elements = {}; // Pointer to the start of our elements
     size_t m_capacity = {};  // Allocated capacity that shows how many elements we could hold
     size_t m_size = {};      // Used size that shows how many elements we entered